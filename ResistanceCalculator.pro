@@ -56,6 +56,7 @@ DEFINES += QTADMOB_QML
 
 include ($$PWD/lib/QtAdMob/QtAdMob.pri)
 include ($$PWD/lib/ShareUtils-QML/ShareUtils-QML.pri)
+include ($$PWD/src/Core/Core.pri)
 
 #-------------------------------------------------------------------------------
 # Deploy configuration
@@ -109,11 +110,23 @@ RESOURCES += \
 
 HEADERS += \
     $$PWD/src/AppInfo.h \
-    $$PWD/src/ResistanceInfo.h
+    $$PWD/src/BatchDecoder.h \
+    $$PWD/src/CombinationCalculator.h \
+    $$PWD/src/DividerCalculator.h \
+    $$PWD/src/NetworkCalculator.h \
+    $$PWD/src/OpAmpCalculator.h \
+    $$PWD/src/ResistanceInfo.h \
+    $$PWD/src/ToleranceAnalysis.h
 
 SOURCES += \
     $$PWD/src/main.cpp \
-    $$PWD/src/ResistanceInfo.cpp
+    $$PWD/src/BatchDecoder.cpp \
+    $$PWD/src/CombinationCalculator.cpp \
+    $$PWD/src/DividerCalculator.cpp \
+    $$PWD/src/NetworkCalculator.cpp \
+    $$PWD/src/OpAmpCalculator.cpp \
+    $$PWD/src/ResistanceInfo.cpp \
+    $$PWD/src/ToleranceAnalysis.cpp
 
 OTHER_FILES += \
     $$PWD/assets/qml/Components/DrawerItem.qml \
@@ -122,10 +135,18 @@ OTHER_FILES += \
     $$PWD/assets/qml/Components/ResistanceCalculatorWidgets.qml \
     $$PWD/assets/qml/Components/SvgImage.qml \
     $$PWD/assets/qml/Pages/About.qml \
+    $$PWD/assets/qml/Pages/CapacitorCalculator.qml \
+    $$PWD/assets/qml/Pages/CombinationCalculator.qml \
+    $$PWD/assets/qml/Pages/DividerCalculator.qml \
+    $$PWD/assets/qml/Pages/ExpressionCalculator.qml \
+    $$PWD/assets/qml/Pages/InductorCalculator.qml \
+    $$PWD/assets/qml/Pages/NetworkCalculator.qml \
     $$PWD/assets/qml/Pages/OpAmpCalculator.qml \
     $$PWD/assets/qml/Pages/ResistanceCalculator.qml \
     $$PWD/assets/qml/Pages/Settings.qml \
+    $$PWD/assets/qml/Pages/SmdBatchDecoder.qml \
     $$PWD/assets/qml/Pages/SmdCalculator.qml \
+    $$PWD/assets/qml/Pages/ToleranceAnalysis.qml \
     $$PWD/assets/qml/Ads.qml \
     $$PWD/assets/qml/main.qml \
     $$PWD/assets/qml/UI.qml
@@ -24,6 +24,7 @@ import QtQuick 2.0
 import ResistanceInfo 1.0
 import QtQuick.Layouts 1.0
 import QtQuick.Controls 2.0
+import QtQuick.Controls.Material 2.0
 
 Item {
     id: widget
@@ -88,6 +89,20 @@ Item {
             Layout.alignment: Qt.AlignHCenter
             Layout.maximumWidth: Math.min (app.width - 4 * app.spacing, 360)
 
+            //
+            // Value input (e.g. "4k7" or "10kΩ ±1%"), changes the strips
+            //
+            TextField {
+                property bool valid: true
+
+                Layout.fillWidth: true
+                Layout.columnSpan: 2
+                color: valid ? Material.foreground : "#f44336"
+                placeholderText: qsTr ("Value (e.g. 4k7 ±1%)")
+                horizontalAlignment: TextInput.AlignHCenter
+                onTextChanged: valid = text.length === 0 || ResistanceInfo.loadValue (text)
+            }
+
             //
             // 1st Digit controls (removes black from digit names list, so that
             // we avoid having 0-ohm resistors)
@@ -210,6 +225,16 @@ Item {
                 text: qsTr ("Resistance") + ": " + ResistanceInfo.resistance
             }
 
+            Label {
+                Layout.fillWidth: true
+                horizontalAlignment: Label.AlignHCenter
+                font.pixelSize: !fourStrip ? app.smallLabel : app.mediumLabel
+                text: ResistanceInfo.isStandardValue ?
+                          qsTr ("Standard %1 value").arg (ResistanceInfo.standardSeries) :
+                          qsTr ("Nearest %1 value").arg (ResistanceInfo.standardSeries) +
+                          ": " + ResistanceInfo.nearestStandardValue
+            }
+
             Label {
                 Layout.fillWidth: true
                 horizontalAlignment: Label.AlignHCenter
@@ -231,6 +256,19 @@ Item {
                 horizontalAlignment: Label.AlignHCenter
                 text: qsTr ("Temp. Coefficient") + ": " + ResistanceInfo.tempcoStr
             }
+
+            Label {
+                visible: sixStrip
+                Layout.fillWidth: true
+                font.pixelSize: app.smallLabel
+                horizontalAlignment: Label.AlignHCenter
+                text: {
+                    // Re-evaluate when the resistance or tempco change
+                    var resistance = ResistanceInfo.resistance + ResistanceInfo.tempcoStr
+                    var range = ResistanceInfo.temperatureRange (-40, 125)
+                    return qsTr ("-40 °C to 125 °C") + ": " + range.minStr + " - " + range.maxStr
+                }
+            }
         }
 
         //
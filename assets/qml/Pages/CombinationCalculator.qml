@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick 2.0
+import ResistanceInfo 1.0
+import QtQuick.Layouts 1.0
+import QtQuick.Controls 2.0
+
+Item {
+    id: page
+
+    //
+    // Searches the networks for the current target
+    //
+    function solve() {
+        var target = ResistanceInfo.parseValue (targetInput.text)
+        if (!isNaN (target) && target > 0)
+            solver.solve (target)
+    }
+
+    //
+    // Solver backend
+    //
+    CombinationSolver {
+        id: solver
+        maxParts: partsSpin.value
+        series: seriesBox.currentIndex
+        tolerance: [0.0001, 0.001, 0.005, 0.01, 0.02, 0.05][toleranceBox.currentIndex]
+    }
+
+    //
+    // Main UI layout
+    //
+    ColumnLayout {
+        anchors.fill: parent
+        spacing: app.spacing
+
+        //
+        // Instructions
+        //
+        Label {
+            font.italic: true
+            Layout.fillWidth: true
+            font.pixelSize: app.normalLabel
+            horizontalAlignment: Text.AlignHCenter
+            wrapMode: Label.WrapAtWordBoundaryOrAnywhere
+            text: qsTr ("Type the resistance that you need (e.g. 4k7)...")
+        }
+
+        //
+        // Search parameters
+        //
+        GridLayout {
+            columns: 2
+            Layout.fillWidth: true
+            rowSpacing: app.spacing
+            columnSpacing: app.spacing * 2
+            Layout.alignment: Qt.AlignHCenter
+            Layout.maximumWidth: Math.min (app.width - 4 * app.spacing, 360)
+
+            TextField {
+                id: targetInput
+                text: "1k234"
+                Layout.fillWidth: true
+                Layout.columnSpan: 2
+                font.pixelSize: app.largeLabel
+                horizontalAlignment: TextInput.AlignHCenter
+                onTextChanged: page.solve()
+            }
+
+            ComboBox {
+                id: seriesBox
+                currentIndex: 3
+                Layout.fillWidth: true
+                model: solver.seriesNames
+                onCurrentIndexChanged: page.solve()
+            }
+
+            ComboBox {
+                id: toleranceBox
+                currentIndex: 1
+                Layout.fillWidth: true
+                model: ["0.01%", "0.1%", "0.5%", "1%", "2%", "5%"]
+                onCurrentIndexChanged: page.solve()
+            }
+
+            Label {
+                Layout.fillWidth: true
+                text: qsTr ("Maximum parts")
+            }
+
+            SpinBox {
+                id: partsSpin
+                to: 4
+                from: 1
+                value: 3
+                Layout.fillWidth: true
+                onValueChanged: page.solve()
+            }
+        }
+
+        //
+        // Search indicator
+        //
+        BusyIndicator {
+            running: solver.searching
+            visible: solver.searching
+            Layout.alignment: Qt.AlignHCenter
+        }
+
+        //
+        // Search results
+        //
+        ListView {
+            clip: true
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            model: solver.results
+
+            delegate: ColumnLayout {
+                spacing: 0
+                width: parent.width
+
+                Label {
+                    Layout.fillWidth: true
+                    font.pixelSize: app.mediumLabel
+                    horizontalAlignment: Label.AlignHCenter
+                    wrapMode: Label.WrapAtWordBoundaryOrAnywhere
+                    text: modelData.description
+                }
+
+                Label {
+                    opacity: 0.7
+                    Layout.fillWidth: true
+                    font.pixelSize: app.smallLabel
+                    horizontalAlignment: Label.AlignHCenter
+                    text: qsTr ("%1 parts, error %2%").arg (modelData.parts)
+                                                      .arg ((modelData.error * 100).toFixed (4))
+                }
+
+                Item {
+                    height: app.spacing
+                }
+            }
+        }
+
+        //
+        // Search time
+        //
+        Label {
+            opacity: 0.5
+            Layout.fillWidth: true
+            font.pixelSize: app.smallLabel
+            horizontalAlignment: Label.AlignHCenter
+            text: qsTr ("Search time: %1 ms").arg (solver.elapsed.toFixed (1))
+        }
+    }
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick 2.0
+import ResistanceInfo 1.0
+import QtQuick.Layouts 1.0
+import QtQuick.Controls 2.0
+
+Item {
+    id: page
+
+    //
+    // Limits the total resistance so that the divider draws at most the
+    // maximum current from Vin, depends on both fields
+    //
+    function updateCurrentBudget() {
+        var current = parseFloat (currentInput.text) / 1000
+        if (current > 0)
+            solver.setCurrentBudget (parseFloat (inputInput.text), current)
+        else
+            solver.minimumTotal = 0
+    }
+
+    //
+    // Solver backend
+    //
+    DividerSolver {
+        id: solver
+        series: seriesBox.currentIndex
+        tolerance: toleranceBox.currentIndex
+        ratio: parseFloat (outputInput.text) / parseFloat (inputInput.text)
+    }
+
+    //
+    // Main UI layout
+    //
+    ColumnLayout {
+        anchors.fill: parent
+        spacing: app.spacing
+
+        //
+        // Instructions
+        //
+        Label {
+            font.italic: true
+            Layout.fillWidth: true
+            font.pixelSize: app.normalLabel
+            horizontalAlignment: Text.AlignHCenter
+            wrapMode: Label.WrapAtWordBoundaryOrAnywhere
+            text: qsTr ("Type the input and output voltages of the divider...")
+        }
+
+        //
+        // Search parameters
+        //
+        GridLayout {
+            columns: 2
+            Layout.fillWidth: true
+            rowSpacing: app.spacing
+            columnSpacing: app.spacing * 2
+            Layout.alignment: Qt.AlignHCenter
+            Layout.maximumWidth: Math.min (app.width - 4 * app.spacing, 360)
+
+            Label {
+                text: qsTr ("Vin (V)")
+            }
+
+            TextField {
+                id: inputInput
+                text: "5"
+                Layout.fillWidth: true
+                inputMethodHints: Qt.ImhFormattedNumbersOnly
+                onTextChanged: page.updateCurrentBudget()
+            }
+
+            Label {
+                text: qsTr ("Vout (V)")
+            }
+
+            TextField {
+                id: outputInput
+                text: "3.3"
+                Layout.fillWidth: true
+                inputMethodHints: Qt.ImhFormattedNumbersOnly
+            }
+
+            Label {
+                text: qsTr ("Max. current (mA)")
+            }
+
+            TextField {
+                id: currentInput
+                text: ""
+                Layout.fillWidth: true
+                inputMethodHints: Qt.ImhFormattedNumbersOnly
+                onTextChanged: page.updateCurrentBudget()
+            }
+
+            Label {
+                text: qsTr ("Series")
+            }
+
+            ComboBox {
+                id: seriesBox
+                currentIndex: 3
+                Layout.fillWidth: true
+                model: ["E3", "E6", "E12", "E24", "E48", "E96", "E192"]
+            }
+
+            Label {
+                text: qsTr ("Tolerance")
+            }
+
+            ComboBox {
+                id: toleranceBox
+                Layout.fillWidth: true
+                currentIndex: RI.ToleranceGold
+                model: ResistanceInfo.toleranceNames
+            }
+        }
+
+        //
+        // Search results
+        //
+        ListView {
+            clip: true
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            model: solver.results
+
+            delegate: ColumnLayout {
+                spacing: 0
+                width: parent.width
+
+                Label {
+                    Layout.fillWidth: true
+                    font.pixelSize: app.mediumLabel
+                    horizontalAlignment: Label.AlignHCenter
+                    text: "R1 = " + modelData.r1Str + ", R2 = " + modelData.r2Str
+                }
+
+                Label {
+                    opacity: 0.7
+                    Layout.fillWidth: true
+                    font.pixelSize: app.smallLabel
+                    horizontalAlignment: Label.AlignHCenter
+                    text: qsTr ("Error %1%, worst case ±%2%")
+                          .arg ((modelData.error * 100).toFixed (3))
+                          .arg ((modelData.worstCaseError * 100).toFixed (2))
+                }
+
+                Item {
+                    height: app.spacing
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick 2.0
+import ResistanceInfo 1.0
+import QtQuick.Layouts 1.0
+import QtQuick.Controls 2.0
+
+Item {
+    id: page
+
+    //
+    // Returns the given value with an engineering prefix and unit
+    //
+    function format (value, unit) {
+        var prefixes = ["p", "n", "µ", "m", "", "k", "M", "G"]
+        var magnitude = Math.abs (value)
+        if (magnitude < 1e-12)
+            return "0 " + unit
+
+        var exponent = Math.max (-4, Math.min (3, Math.floor (Math.log (magnitude) / Math.LN10 / 3)))
+        return (value / Math.pow (1000, exponent)).toPrecision (4) + " " +
+                prefixes [exponent + 4] + unit
+    }
+
+    //
+    // Result of the current expression, updated on every edit
+    //
+    property var result: ResistanceInfo.evaluateExpression (expressionInput.text)
+
+    //
+    // Main UI layout
+    //
+    ColumnLayout {
+        anchors.fill: parent
+        spacing: app.spacing
+
+        //
+        // Instructions
+        //
+        Label {
+            font.italic: true
+            Layout.fillWidth: true
+            font.pixelSize: app.normalLabel
+            horizontalAlignment: Text.AlignHCenter
+            wrapMode: Label.WrapAtWordBoundaryOrAnywhere
+            text: qsTr ("Type an expression with +, -, *, / and || (parallel), " +
+                        "values can be written as 4k7, 12V, 2mA, " +
+                        "bands=yellow-violet-red-gold or smd=103...")
+        }
+
+        //
+        // Spacer
+        //
+        Item {
+            Layout.fillHeight: true
+        }
+
+        //
+        // Expression editor
+        //
+        TextField {
+            id: expressionInput
+            Layout.fillWidth: true
+            font.family: "monospace"
+            text: "(4k7 + 220) || 10k"
+            Layout.alignment: Qt.AlignHCenter
+            horizontalAlignment: TextInput.AlignHCenter
+            inputMethodHints: Qt.ImhNoAutoUppercase | Qt.ImhNoPredictiveText
+            Layout.maximumWidth: Math.min (app.width - 4 * app.spacing, 360)
+        }
+
+        //
+        // Result
+        //
+        Label {
+            Layout.fillWidth: true
+            font.pixelSize: app.largeLabel
+            horizontalAlignment: Label.AlignHCenter
+            text: result.valid ? "= " + format (result.value, result.unit) : "—"
+        }
+
+        //
+        // Error message
+        //
+        Label {
+            color: "#e53935"
+            Layout.fillWidth: true
+            text: result.error
+            visible: !result.valid && expressionInput.text.length > 0
+            font.pixelSize: app.smallLabel
+            horizontalAlignment: Label.AlignHCenter
+            wrapMode: Label.WrapAtWordBoundaryOrAnywhere
+        }
+
+        //
+        // Spacer
+        //
+        Item {
+            Layout.fillHeight: true
+        }
+    }
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick 2.0
+import ResistanceInfo 1.0
+import QtQuick.Layouts 1.0
+import QtQuick.Controls 2.0
+
+Item {
+    id: page
+
+    //
+    // Decoded values of the printed code and of the color bands
+    //
+    property var codeResult: ResistanceInfo.decodeInductorCode (codeInput.text)
+    property var colorResult: ResistanceInfo.decodeInductorColors ([firstBand.currentIndex,
+                                                                    secondBand.currentIndex,
+                                                                    multiplierBand.currentIndex,
+                                                                    toleranceBand.currentIndex])
+
+    //
+    // Main UI layout
+    //
+    ColumnLayout {
+        anchors.fill: parent
+        spacing: app.spacing
+
+        //
+        // Spacer
+        //
+        Item {
+            Layout.fillHeight: true
+        }
+
+        //
+        // Instructions
+        //
+        Label {
+            font.italic: true
+            Layout.fillWidth: true
+            font.pixelSize: app.normalLabel
+            Layout.alignment: Qt.AlignHCenter
+            horizontalAlignment: Text.AlignHCenter
+            wrapMode: Label.WrapAtWordBoundaryOrAnywhere
+
+            Layout.maximumWidth: {
+                if (app.width > app.height)
+                    app.width * 0.8
+                else
+                    app.width - 4 * app.spacing
+            }
+
+            text: qsTr ("Type the marking on the inductor (e.g. 101, 4R7 or 221K), " +
+                        "or select the colors of its bands...")
+        }
+
+        //
+        // Printed code
+        //
+        TextField {
+            id: codeInput
+            text: "4R7"
+            Layout.fillWidth: true
+            font.family: "Roboto Mono"
+            Layout.alignment: Qt.AlignHCenter
+            horizontalAlignment: TextInput.AlignHCenter
+            inputMethodHints: Qt.ImhNoAutoUppercase | Qt.ImhNoPredictiveText
+            Layout.maximumWidth: Math.min (app.width - 4 * app.spacing, 360)
+        }
+
+        Label {
+            Layout.fillWidth: true
+            font.pixelSize: app.largeLabel
+            horizontalAlignment: Label.AlignHCenter
+            text: qsTr ("Inductance") + ": " + (codeResult.valid ? codeResult.text : "—") +
+                  (codeResult.valid && codeResult.tolerance > 0 ? " ±" + codeResult.tolerance + "%" : "")
+        }
+
+        //
+        // Spacer
+        //
+        Item {
+            height: 2 * app.spacing
+        }
+
+        //
+        // Color bands
+        //
+        GridLayout {
+            columns: 2
+            Layout.fillWidth: true
+            rowSpacing: app.spacing
+            columnSpacing: app.spacing * 2
+            Layout.alignment: Qt.AlignHCenter
+            Layout.maximumWidth: Math.min (app.width - 4 * app.spacing, 360)
+
+            ComboBox {
+                id: firstBand
+                currentIndex: 1
+                Layout.fillWidth: true
+                displayText: qsTr ("1st Digit")
+                model: ResistanceInfo.multiplierNames.slice (0, 10)
+                popup.height: Math.min (height * count, app.height * 0.29)
+            }
+
+            ComboBox {
+                id: secondBand
+                currentIndex: 0
+                Layout.fillWidth: true
+                displayText: qsTr ("2nd Digit")
+                model: ResistanceInfo.multiplierNames.slice (0, 10)
+                popup.height: Math.min (height * count, app.height * 0.29)
+            }
+
+            ComboBox {
+                id: multiplierBand
+                currentIndex: 1
+                Layout.fillWidth: true
+                displayText: qsTr ("Multiplier")
+                model: ResistanceInfo.multiplierNames
+                popup.height: Math.min (height * count, app.height * 0.29)
+            }
+
+            ComboBox {
+                id: toleranceBand
+                currentIndex: 11
+                Layout.fillWidth: true
+                displayText: qsTr ("Tolerance")
+                model: ResistanceInfo.multiplierNames
+                popup.height: Math.min (height * count, app.height * 0.29)
+            }
+        }
+
+        Label {
+            Layout.fillWidth: true
+            font.pixelSize: app.largeLabel
+            horizontalAlignment: Label.AlignHCenter
+            text: qsTr ("Inductance") + ": " + (colorResult.valid ? colorResult.text : "—") +
+                  (colorResult.valid && colorResult.tolerance > 0 ? " ±" + colorResult.tolerance + "%" : "")
+        }
+
+        //
+        // Spacer
+        //
+        Item {
+            Layout.fillHeight: true
+        }
+    }
+}
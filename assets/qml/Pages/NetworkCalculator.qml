@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick 2.0
+import ResistanceInfo 1.0
+import QtQuick.Layouts 1.0
+import QtQuick.Controls 2.0
+
+Item {
+    id: page
+
+    //
+    // Returns the given value with an engineering prefix and unit
+    //
+    function format (value, unit) {
+        var prefixes = ["p", "n", "µ", "m", "", "k", "M", "G"]
+        var magnitude = Math.abs (value)
+        if (magnitude < 1e-12)
+            return "0 " + unit
+
+        var exponent = Math.max (-4, Math.min (3, Math.floor (Math.log (magnitude) / Math.LN10 / 3)))
+        return (value / Math.pow (1000, exponent)).toPrecision (4) + " " +
+                prefixes [exponent + 4] + unit
+    }
+
+    //
+    // Solver backend
+    //
+    NetworkSolver {
+        id: solver
+        netlist: netlistInput.text
+    }
+
+    //
+    // Main UI layout
+    //
+    ColumnLayout {
+        anchors.fill: parent
+        spacing: app.spacing
+
+        //
+        // Instructions
+        //
+        Label {
+            font.italic: true
+            Layout.fillWidth: true
+            font.pixelSize: app.normalLabel
+            horizontalAlignment: Text.AlignHCenter
+            wrapMode: Label.WrapAtWordBoundaryOrAnywhere
+            text: qsTr ("Type a SPICE netlist, the first line is its title. Resistor " +
+                        "values can be written as bands=yellow-violet-red-gold or smd=4R7...")
+        }
+
+        //
+        // Netlist editor
+        //
+        TextArea {
+            id: netlistInput
+            Layout.fillWidth: true
+            Layout.preferredHeight: app.height / 4
+            font.family: "monospace"
+            wrapMode: TextArea.NoWrap
+            inputMethodHints: Qt.ImhNoAutoUppercase | Qt.ImhNoPredictiveText
+            text: "Voltage divider\n" +
+                  "V1 in 0 DC 5\n" +
+                  "R1 in out bands=brown-black-red-gold\n" +
+                  "R2 out 0 smd=103\n"
+        }
+
+        //
+        // Error message
+        //
+        Label {
+            color: "#e53935"
+            Layout.fillWidth: true
+            text: solver.error
+            visible: solver.error.length > 0
+            font.pixelSize: app.smallLabel
+            horizontalAlignment: Label.AlignHCenter
+            wrapMode: Label.WrapAtWordBoundaryOrAnywhere
+        }
+
+        //
+        // Equivalent resistance between two nodes
+        //
+        RowLayout {
+            spacing: app.spacing
+            Layout.fillWidth: true
+            Layout.alignment: Qt.AlignHCenter
+            Layout.maximumWidth: Math.min (app.width - 4 * app.spacing, 360)
+
+            Label {
+                text: qsTr ("Req")
+            }
+
+            TextField {
+                id: nodeA
+                text: "out"
+                Layout.fillWidth: true
+                inputMethodHints: Qt.ImhNoAutoUppercase
+            }
+
+            TextField {
+                id: nodeB
+                text: "0"
+                Layout.fillWidth: true
+                inputMethodHints: Qt.ImhNoAutoUppercase
+            }
+
+            Label {
+                text: {
+                    // Depend on the solution so the value is updated with it
+                    var nodes = solver.nodes
+                    var r = solver.equivalentResistance (nodeA.text, nodeB.text)
+                    return r < 0 ? "—" : format (r, "Ω")
+                }
+            }
+        }
+
+        //
+        // Node voltages and element currents
+        //
+        ListView {
+            clip: true
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            model: solver.nodes.concat (solver.elements)
+
+            delegate: Label {
+                width: parent.width
+                font.pixelSize: app.smallLabel
+                horizontalAlignment: Label.AlignHCenter
+                text: {
+                    if (modelData.type === undefined)
+                        return "V(" + modelData.name + ") = " + format (modelData.voltage, "V")
+
+                    return qsTr ("%1: %2, %3").arg (modelData.name)
+                                              .arg (format (modelData.current, "A"))
+                                              .arg (format (modelData.power, "W"))
+                }
+            }
+        }
+    }
+}
@@ -21,11 +21,28 @@
  */
 
 import QtQuick 2.0
+import ResistanceInfo 1.0
 import QtQuick.Layouts 1.0
 import QtQuick.Controls 2.0
 import QtQuick.Controls.Material 2.0
 
 Item {
+    id: page
+
+    //
+    // Solver backend (also the model of the stages that it finds)
+    //
+    GainSolver {
+        id: solver
+        type: tabBar.currentIndex
+        series: seriesBox.currentIndex
+        gain: parseFloat (gainInput.text)
+        maximumError: parseFloat (errorInput.text) / 100
+        minimumFeedback: parseFloat (minFeedbackInput.text) * 1000
+        maximumFeedback: parseFloat (maxFeedbackInput.text) * 1000
+        minimumInputImpedance: parseFloat (impedanceInput.text) * 1000
+    }
+
     //
     // Main layout
     //
@@ -37,6 +54,7 @@ Item {
         // Tab Layout
         //
         TabBar {
+            id: tabBar
             Layout.fillWidth: true
 
             Material.elevation: 4
@@ -54,10 +72,128 @@ Item {
         }
 
         //
-        // Spacer
+        // Search parameters
+        //
+        GridLayout {
+            columns: 2
+            Layout.fillWidth: true
+            rowSpacing: app.spacing
+            columnSpacing: app.spacing * 2
+            Layout.alignment: Qt.AlignHCenter
+            Layout.maximumWidth: Math.min (app.width - 4 * app.spacing, 360)
+
+            Label {
+                text: qsTr ("Gain")
+            }
+
+            TextField {
+                id: gainInput
+                text: "10"
+                Layout.fillWidth: true
+                inputMethodHints: Qt.ImhFormattedNumbersOnly
+            }
+
+            Label {
+                text: qsTr ("Max. gain error (%)")
+            }
+
+            TextField {
+                id: errorInput
+                text: "5"
+                Layout.fillWidth: true
+                inputMethodHints: Qt.ImhFormattedNumbersOnly
+            }
+
+            Label {
+                visible: tabBar.currentIndex === 0
+                text: qsTr ("Min. input impedance (kΩ)")
+            }
+
+            TextField {
+                id: impedanceInput
+                text: "10"
+                Layout.fillWidth: true
+                visible: tabBar.currentIndex === 0
+                inputMethodHints: Qt.ImhFormattedNumbersOnly
+            }
+
+            Label {
+                text: qsTr ("Min. feedback (kΩ)")
+            }
+
+            TextField {
+                id: minFeedbackInput
+                text: "1"
+                Layout.fillWidth: true
+                inputMethodHints: Qt.ImhFormattedNumbersOnly
+            }
+
+            Label {
+                text: qsTr ("Max. feedback (kΩ)")
+            }
+
+            TextField {
+                id: maxFeedbackInput
+                text: "1000"
+                Layout.fillWidth: true
+                inputMethodHints: Qt.ImhFormattedNumbersOnly
+            }
+
+            Label {
+                text: qsTr ("Series")
+            }
+
+            ComboBox {
+                id: seriesBox
+                currentIndex: 3
+                Layout.fillWidth: true
+                model: ["E3", "E6", "E12", "E24", "E48", "E96", "E192"]
+            }
+        }
+
+        //
+        // Search indicator
+        //
+        BusyIndicator {
+            running: solver.searching
+            visible: solver.searching
+            Layout.alignment: Qt.AlignHCenter
+        }
+
+        //
+        // Search results
         //
-        Item {
+        ListView {
+            clip: true
+            model: solver
+            Layout.fillWidth: true
             Layout.fillHeight: true
+
+            delegate: ColumnLayout {
+                spacing: 0
+                width: parent.width
+
+                Label {
+                    Layout.fillWidth: true
+                    font.pixelSize: app.mediumLabel
+                    horizontalAlignment: Label.AlignHCenter
+                    text: "Rf = " + rfStr + ", Rg = " + rgStr
+                }
+
+                Label {
+                    opacity: 0.7
+                    Layout.fillWidth: true
+                    font.pixelSize: app.smallLabel
+                    horizontalAlignment: Label.AlignHCenter
+                    text: qsTr ("Gain %1, error %2%")
+                          .arg (stageGain.toFixed (4))
+                          .arg ((stageError * 100).toFixed (3))
+                }
+
+                Item {
+                    height: app.spacing
+                }
+            }
         }
     }
 }
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick 2.0
+import ResistanceInfo 1.0
+import QtQuick.Layouts 1.0
+import QtQuick.Controls 2.0
+
+Item {
+    id: page
+
+    //
+    // Result of the last job
+    //
+    property string status: ""
+
+    //
+    // Decoder backend
+    //
+    BatchDecoder {
+        id: decoder
+        threadCount: threadsSpin.value
+        onCancelled: page.status = qsTr ("Cancelled")
+        onFailed: page.status = error
+        onFinished: page.status = qsTr ("%1 codes written to %2").arg (codes).arg (output)
+    }
+
+    //
+    // Main UI layout
+    //
+    ColumnLayout {
+        anchors.fill: parent
+        spacing: app.spacing
+
+        //
+        // Instructions
+        //
+        Label {
+            font.italic: true
+            Layout.fillWidth: true
+            font.pixelSize: app.normalLabel
+            horizontalAlignment: Text.AlignHCenter
+            wrapMode: Label.WrapAtWordBoundaryOrAnywhere
+            text: qsTr ("Decode a text file with one SMD code per line into a CSV file " +
+                        "with the resistance and tolerance of each code...")
+        }
+
+        //
+        // Job parameters
+        //
+        GridLayout {
+            columns: 2
+            Layout.fillWidth: true
+            rowSpacing: app.spacing
+            columnSpacing: app.spacing * 2
+            Layout.alignment: Qt.AlignHCenter
+            Layout.maximumWidth: Math.min (app.width - 4 * app.spacing, 360)
+
+            Label {
+                text: qsTr ("Input file")
+            }
+
+            TextField {
+                id: inputPath
+                Layout.fillWidth: true
+                enabled: !decoder.running
+                inputMethodHints: Qt.ImhNoAutoUppercase | Qt.ImhNoPredictiveText
+            }
+
+            Label {
+                text: qsTr ("Output file")
+            }
+
+            TextField {
+                id: outputPath
+                Layout.fillWidth: true
+                enabled: !decoder.running
+                inputMethodHints: Qt.ImhNoAutoUppercase | Qt.ImhNoPredictiveText
+            }
+
+            Label {
+                text: qsTr ("Threads (0 = all)")
+            }
+
+            SpinBox {
+                id: threadsSpin
+                to: 64
+                from: 0
+                value: 0
+                Layout.fillWidth: true
+                enabled: !decoder.running
+            }
+        }
+
+        //
+        // Start/cancel button
+        //
+        Button {
+            Layout.alignment: Qt.AlignHCenter
+            enabled: decoder.running || (inputPath.length > 0 && outputPath.length > 0)
+            text: decoder.running ? qsTr ("Cancel") : qsTr ("Decode file")
+            onClicked: {
+                if (decoder.running)
+                    decoder.cancel()
+
+                else if (decoder.decodeSmdFile (inputPath.text, outputPath.text))
+                    page.status = ""
+            }
+        }
+
+        ProgressBar {
+            Layout.fillWidth: true
+            visible: decoder.running
+            value: decoder.progress
+        }
+
+        //
+        // Job result
+        //
+        Label {
+            opacity: 0.7
+            Layout.fillWidth: true
+            text: page.status
+            visible: text.length > 0
+            font.pixelSize: app.smallLabel
+            horizontalAlignment: Label.AlignHCenter
+            wrapMode: Label.WrapAtWordBoundaryOrAnywhere
+        }
+
+        Item {
+            Layout.fillHeight: true
+        }
+    }
+}
@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+import QtQuick 2.0
+import ResistanceInfo 1.0
+import QtQuick.Layouts 1.0
+import QtQuick.Controls 2.0
+import QtQuick.Controls.Material 2.0
+
+Item {
+    id: page
+
+    //
+    // Formats an output of the analysis, networks of the first two
+    // models are resistances and the rest are ratios or gains
+    //
+    function formatOutput (value) {
+        if (value === undefined)
+            return "-"
+
+        if (modelBox.currentIndex < 2)
+            return value.toPrecision (6) + " Ω"
+
+        return value.toPrecision (6)
+    }
+
+    //
+    // Returns the name of the part with the given index
+    //
+    function partName (index) {
+        if (modelBox.currentIndex < 3)
+            return "R" + (index + 1)
+
+        return index === 0 ? "Rf" : "Rg"
+    }
+
+    //
+    // Analysis backend
+    //
+    MonteCarloAnalysis {
+        id: analysis
+        model: modelBox.currentIndex
+        tolerance: toleranceBox.currentIndex
+        tempco: tempcoBox.currentIndex - 1
+        distribution: distributionBox.currentIndex
+        samples: Math.pow (10, samplesBox.currentIndex + 4)
+        specification: parseFloat (specInput.text) / 100
+        minimumTemperature: parseFloat (minTemperatureInput.text)
+        maximumTemperature: parseFloat (maxTemperatureInput.text)
+        values: [parseFloat (r1Input.text) * 1000, parseFloat (r2Input.text) * 1000]
+    }
+
+    //
+    // Main UI layout
+    //
+    Flickable {
+        clip: true
+        anchors.fill: parent
+        contentHeight: layout.implicitHeight
+
+        ColumnLayout {
+            id: layout
+            width: parent.width
+            spacing: app.spacing
+
+            //
+            // Analysis parameters
+            //
+            GridLayout {
+                columns: 2
+                Layout.fillWidth: true
+                rowSpacing: app.spacing
+                columnSpacing: app.spacing * 2
+                Layout.alignment: Qt.AlignHCenter
+                Layout.maximumWidth: Math.min (app.width - 4 * app.spacing, 360)
+
+                Label {
+                    text: qsTr ("Network")
+                }
+
+                ComboBox {
+                    id: modelBox
+                    currentIndex: 2
+                    Layout.fillWidth: true
+                    model: [qsTr ("Series"), qsTr ("Parallel"), qsTr ("Voltage divider"),
+                        qsTr ("Inverting gain"), qsTr ("Non-inverting gain")]
+                }
+
+                Label {
+                    text: modelBox.currentIndex < 3 ? qsTr ("R1 (kΩ)") : qsTr ("Rf (kΩ)")
+                }
+
+                TextField {
+                    id: r1Input
+                    text: "10"
+                    Layout.fillWidth: true
+                    inputMethodHints: Qt.ImhFormattedNumbersOnly
+                }
+
+                Label {
+                    text: modelBox.currentIndex < 3 ? qsTr ("R2 (kΩ)") : qsTr ("Rg (kΩ)")
+                }
+
+                TextField {
+                    id: r2Input
+                    text: "10"
+                    Layout.fillWidth: true
+                    inputMethodHints: Qt.ImhFormattedNumbersOnly
+                }
+
+                Label {
+                    text: qsTr ("Tolerance")
+                }
+
+                ComboBox {
+                    id: toleranceBox
+                    Layout.fillWidth: true
+                    currentIndex: RI.ToleranceGold
+                    model: ResistanceInfo.toleranceNames
+                }
+
+                Label {
+                    text: qsTr ("Tempco")
+                }
+
+                ComboBox {
+                    id: tempcoBox
+                    Layout.fillWidth: true
+                    model: [qsTr ("None")].concat (ResistanceInfo.tempcoNames)
+                }
+
+                Label {
+                    text: qsTr ("Distribution")
+                }
+
+                ComboBox {
+                    id: distributionBox
+                    Layout.fillWidth: true
+                    model: [qsTr ("Uniform"), qsTr ("Normal"), qsTr ("Truncated normal")]
+                }
+
+                Label {
+                    text: qsTr ("Min. temperature (°C)")
+                }
+
+                TextField {
+                    id: minTemperatureInput
+                    text: "25"
+                    Layout.fillWidth: true
+                    inputMethodHints: Qt.ImhFormattedNumbersOnly
+                }
+
+                Label {
+                    text: qsTr ("Max. temperature (°C)")
+                }
+
+                TextField {
+                    id: maxTemperatureInput
+                    text: "25"
+                    Layout.fillWidth: true
+                    inputMethodHints: Qt.ImhFormattedNumbersOnly
+                }
+
+                Label {
+                    text: qsTr ("Specification (±%)")
+                }
+
+                TextField {
+                    id: specInput
+                    text: "1"
+                    Layout.fillWidth: true
+                    inputMethodHints: Qt.ImhFormattedNumbersOnly
+                }
+
+                Label {
+                    text: qsTr ("Samples")
+                }
+
+                ComboBox {
+                    id: samplesBox
+                    currentIndex: 2
+                    Layout.fillWidth: true
+                    model: ["10⁴", "10⁵", "10⁶", "10⁷", "10⁸"]
+                }
+            }
+
+            //
+            // Worst-case bounds and dominant part
+            //
+            ColumnLayout {
+                spacing: app.spacing
+                Layout.fillWidth: true
+                visible: analysis.worstCase.parts !== undefined
+
+                Label {
+                    Layout.fillWidth: true
+                    font.pixelSize: app.mediumLabel
+                    horizontalAlignment: Label.AlignHCenter
+                    text: qsTr ("Worst case: %1 to %2").arg (formatOutput (analysis.worstCase.lower))
+                                                        .arg (formatOutput (analysis.worstCase.upper))
+                }
+
+                Label {
+                    Layout.fillWidth: true
+                    font.pixelSize: app.smallLabel
+                    horizontalAlignment: Label.AlignHCenter
+                    visible: analysis.worstCase.linearDeviation > 0
+                    text: {
+                        var index = analysis.worstCase.dominantPart
+                        var parts = analysis.worstCase.parts
+                        if (parts === undefined)
+                            return ""
+
+                        return qsTr ("%1 dominates the error (%2%, sensitivity %3)")
+                               .arg (partName (index))
+                               .arg ((parts[index].share * 100).toFixed (1))
+                               .arg (parts[index].sensitivity.toFixed (3))
+                    }
+                }
+            }
+
+            //
+            // Run/cancel button
+            //
+            Button {
+                Layout.alignment: Qt.AlignHCenter
+                text: analysis.running ? qsTr ("Cancel") : qsTr ("Run analysis")
+                onClicked: analysis.running ? analysis.cancel() : analysis.start()
+            }
+
+            ProgressBar {
+                Layout.fillWidth: true
+                visible: analysis.running
+                value: analysis.progress
+            }
+
+            //
+            // Histogram
+            //
+            Row {
+                id: histogram
+                height: 120
+                Layout.alignment: Qt.AlignHCenter
+                width: Math.min (app.width - 4 * app.spacing, 360)
+                visible: analysis.histogram.length > 0
+
+                Repeater {
+                    model: analysis.histogram
+
+                    delegate: Rectangle {
+                        anchors.bottom: parent.bottom
+                        color: Material.accent
+                        height: histogram.height * modelData
+                        width: histogram.width / analysis.histogram.length
+                    }
+                }
+            }
+
+            RowLayout {
+                Layout.alignment: Qt.AlignHCenter
+                visible: analysis.histogram.length > 0
+                Layout.maximumWidth: Math.min (app.width - 4 * app.spacing, 360)
+
+                Label {
+                    opacity: 0.7
+                    font.pixelSize: app.smallLabel
+                    text: formatOutput (analysis.result.histogramMin)
+                }
+
+                Item {
+                    Layout.fillWidth: true
+                }
+
+                Label {
+                    opacity: 0.7
+                    font.pixelSize: app.smallLabel
+                    text: formatOutput (analysis.result.histogramMax)
+                }
+            }
+
+            //
+            // Analysis summary
+            //
+            ColumnLayout {
+                spacing: app.spacing
+                Layout.fillWidth: true
+                visible: analysis.histogram.length > 0
+
+                Label {
+                    Layout.fillWidth: true
+                    font.pixelSize: app.mediumLabel
+                    horizontalAlignment: Label.AlignHCenter
+                    text: qsTr ("Yield: %1%").arg ((analysis.result.yield * 100).toFixed (3))
+                }
+
+                Label {
+                    Layout.fillWidth: true
+                    font.pixelSize: app.smallLabel
+                    horizontalAlignment: Label.AlignHCenter
+                    text: qsTr ("Mean: %1, σ: %2").arg (formatOutput (analysis.result.mean))
+                                                  .arg (formatOutput (analysis.result.stddev))
+                }
+
+                Label {
+                    Layout.fillWidth: true
+                    font.pixelSize: app.smallLabel
+                    horizontalAlignment: Label.AlignHCenter
+                    text: qsTr ("99.73% between %1 and %2").arg (formatOutput (analysis.result.low))
+                                                           .arg (formatOutput (analysis.result.high))
+                }
+
+                Label {
+                    opacity: 0.7
+                    Layout.fillWidth: true
+                    font.pixelSize: app.smallLabel
+                    horizontalAlignment: Label.AlignHCenter
+                    text: qsTr ("%1 samples in %2 ms (%3 M samples/s)")
+                          .arg (analysis.result.samples)
+                          .arg ((analysis.result.elapsed || 0).toFixed (0))
+                          .arg (((analysis.result.throughput || 0) / 1e6).toFixed (1))
+                }
+            }
+        }
+    }
+}
@@ -212,16 +212,25 @@ Page {
 
         //
         // Define the actions to take for each drawer item
-        // Drawers 5 and 6 are ignored, because they are used for
-        // displaying a spacer and a separator
+        // Drawer 11 is ignored, because it is used for displaying
+        // a separator
         //
         actions: {
             0: function() {loadPage (resistanceCalculator, 0)},
             1: function() {loadPage (smdCalculator, 1)},
-            // 2: ignored (separator)
-            3: function() {learnAboutResistors()},
-            4: function() {featureRequests()},
-            5: function() {rateApplication()}
+            2: function() {loadPage (combinationCalculator, 2)},
+            3: function() {loadPage (dividerCalculator, 3)},
+            4: function() {loadPage (opAmpCalculator, 4)},
+            5: function() {loadPage (toleranceAnalysis, 5)},
+            6: function() {loadPage (networkCalculator, 6)},
+            7: function() {loadPage (expressionCalculator, 7)},
+            8: function() {loadPage (capacitorCalculator, 8)},
+            9: function() {loadPage (inductorCalculator, 9)},
+            10: function() {loadPage (smdBatchDecoder, 10)},
+            // 11: ignored (separator)
+            12: function() {learnAboutResistors()},
+            13: function() {featureRequests()},
+            14: function() {rateApplication()}
         }
 
         //
@@ -240,6 +249,51 @@ Page {
                 pageIcon: "qrc:/icons/smd.svg"
             }
 
+            ListElement {
+                pageTitle: qsTr ("Combination Calculator")
+                pageIcon: "qrc:/icons/calculator.svg"
+            }
+
+            ListElement {
+                pageTitle: qsTr ("Voltage Divider")
+                pageIcon: "qrc:/icons/calculator.svg"
+            }
+
+            ListElement {
+                pageTitle: qsTr ("Op-Amp Calculator")
+                pageIcon: "qrc:/icons/calculator.svg"
+            }
+
+            ListElement {
+                pageTitle: qsTr ("Tolerance Analysis")
+                pageIcon: "qrc:/icons/calculator.svg"
+            }
+
+            ListElement {
+                pageTitle: qsTr ("Network Solver")
+                pageIcon: "qrc:/icons/calculator.svg"
+            }
+
+            ListElement {
+                pageTitle: qsTr ("Expression Calculator")
+                pageIcon: "qrc:/icons/calculator.svg"
+            }
+
+            ListElement {
+                pageTitle: qsTr ("Capacitor Codes")
+                pageIcon: "qrc:/icons/smd.svg"
+            }
+
+            ListElement {
+                pageTitle: qsTr ("Inductor Codes")
+                pageIcon: "qrc:/icons/smd.svg"
+            }
+
+            ListElement {
+                pageTitle: qsTr ("Batch SMD Decoder")
+                pageIcon: "qrc:/icons/smd.svg"
+            }
+
             ListElement {
                 separator: true
             }
@@ -299,5 +353,64 @@ Page {
             id: smdCalculator
             anchors.fill: parent
         }
+
+        CombinationCalculator {
+            visible: false
+            anchors.fill: parent
+            id: combinationCalculator
+        }
+
+        DividerCalculator {
+            visible: false
+            anchors.fill: parent
+            id: dividerCalculator
+        }
+
+        OpAmpCalculator {
+            visible: false
+            id: opAmpCalculator
+            onVisibleChanged: ui.toolbarShadow = !visible
+
+            anchors {
+                fill: parent
+                margins: -app.spacing
+            }
+        }
+
+        ToleranceAnalysis {
+            visible: false
+            anchors.fill: parent
+            id: toleranceAnalysis
+        }
+
+        NetworkCalculator {
+            visible: false
+            anchors.fill: parent
+            id: networkCalculator
+        }
+
+        ExpressionCalculator {
+            visible: false
+            anchors.fill: parent
+            id: expressionCalculator
+        }
+
+        CapacitorCalculator {
+            visible: false
+            anchors.fill: parent
+            id: capacitorCalculator
+        }
+
+        InductorCalculator {
+            visible: false
+            anchors.fill: parent
+            id: inductorCalculator
+        }
+
+        SmdBatchDecoder {
+            visible: false
+            anchors.fill: parent
+            id: smdBatchDecoder
+        }
     }
 }
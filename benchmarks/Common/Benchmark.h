@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <thread>
+#include <utility>
+#include <time.h>
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+
+/**
+ * Minimal benchmark runner used by the benchmark targets.
+ *
+ * Each case is repeated until it has run for at least @c MIN_TIME seconds,
+ * the fastest repetition is reported as the throughput of the case.
+ *
+ * When the program is started with "--benchmark_out=<file>", the results
+ * are also written to the given file using the JSON format of Google
+ * Benchmark, so that the output of two builds can be compared with the
+ * usual tools (e.g. compare.py).
+ */
+class Benchmark
+{
+public:
+    static constexpr double MIN_TIME = 0.25;
+    static constexpr size_t MAX_REPETITIONS = 100;
+
+    struct Result {
+        std::string name;
+        size_t items;
+        size_t repetitions;
+        double seconds;
+    };
+
+    /**
+     * Runs the given @a function, which processes @a items elements per
+     * call, and prints the throughput of the benchmark with the given
+     * @a name.
+     */
+    template <typename Function>
+    static double run (const char* name, const size_t items, Function function) {
+        return run (name, items, function, []() {});
+    }
+
+    /**
+     * Same as above, but calls @a setup before each repetition of the
+     * benchmark. The time spent in @a setup is not measured.
+     */
+    template <typename Function, typename Setup>
+    static double run (const char* name, const size_t items,
+                       Function function, Setup setup) {
+        typedef std::chrono::steady_clock Clock;
+
+        double best = 0;
+        double total = 0;
+        size_t repetitions = 0;
+
+        while (total < MIN_TIME || repetitions < 3) {
+            setup();
+
+            const Clock::time_point start = Clock::now();
+            function();
+            const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+            if (repetitions == 0 || elapsed.count() < best)
+                best = elapsed.count();
+
+            total += elapsed.count();
+            ++repetitions;
+
+            if (repetitions >= MAX_REPETITIONS)
+                break;
+        }
+
+        const double throughput = best > 0 ? items / best : 0;
+        printf ("%-48s %12.2f Mitems/s %10.3f ns/item\n",
+                name, throughput / 1e6, best * 1e9 / items);
+
+        const Result result = { name, items, repetitions, best };
+        results().push_back (result);
+
+        return throughput;
+    }
+
+    /**
+     * Reads the command line arguments of the benchmark program, returns
+     * @c false (after printing the usage) if an argument is not valid.
+     */
+    static bool init (int argc, char** argv) {
+        const char* outputFlag = "--benchmark_out=";
+        executable() = argc > 0 ? argv [0] : "";
+
+        for (int i = 1; i < argc; ++i) {
+            if (strncmp (argv [i], outputFlag, strlen (outputFlag)) == 0)
+                outputFile() = argv [i] + strlen (outputFlag);
+
+            else {
+                printf ("Usage: %s [--benchmark_out=<file.json>]\n", argv [0]);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Adds the given @a key and @a value to the "context" object of the
+     * JSON report (e.g. the build configuration of the measured code).
+     */
+    static void setContext (const std::string& key, const std::string& value) {
+        context().push_back (std::make_pair (key, value));
+    }
+
+    /**
+     * Writes the JSON report (if requested by the user), returns the exit
+     * code of the benchmark program.
+     */
+    static int finish() {
+        if (outputFile().empty())
+            return 0;
+
+        FILE* file = fopen (outputFile().c_str(), "w");
+        if (!file) {
+            printf ("Cannot write to %s\n", outputFile().c_str());
+            return 1;
+        }
+
+        char date [32];
+        const time_t now = time (NULL);
+        strftime (date, sizeof (date), "%Y-%m-%dT%H:%M:%S", localtime (&now));
+
+        fprintf (file, "{\n  \"context\": {\n");
+        fprintf (file, "    \"date\": \"%s\",\n", date);
+        fprintf (file, "    \"executable\": \"%s\",\n", escape (executable()).c_str());
+        fprintf (file, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+        for (size_t i = 0; i < context().size(); ++i)
+            fprintf (file, "    \"%s\": \"%s\",\n",
+                     escape (context() [i].first).c_str(),
+                     escape (context() [i].second).c_str());
+#ifdef NDEBUG
+        fprintf (file, "    \"library_build_type\": \"release\"\n");
+#else
+        fprintf (file, "    \"library_build_type\": \"debug\"\n");
+#endif
+        fprintf (file, "  },\n  \"benchmarks\": [");
+
+        for (size_t i = 0; i < results().size(); ++i) {
+            const Result& result = results() [i];
+            const std::string name = escape (result.name);
+            const double time = result.seconds * 1e9;
+            const double throughput = result.seconds > 0 ? result.items / result.seconds : 0;
+
+            fprintf (file, "%s\n    {\n", i > 0 ? "," : "");
+            fprintf (file, "      \"name\": \"%s\",\n", name.c_str());
+            fprintf (file, "      \"run_name\": \"%s\",\n", name.c_str());
+            fprintf (file, "      \"run_type\": \"iteration\",\n");
+            fprintf (file, "      \"iterations\": %zu,\n", result.repetitions);
+            fprintf (file, "      \"real_time\": %.3f,\n", time);
+            fprintf (file, "      \"cpu_time\": %.3f,\n", time);
+            fprintf (file, "      \"time_unit\": \"ns\",\n");
+            fprintf (file, "      \"items_per_second\": %.3f\n", throughput);
+            fprintf (file, "    }");
+        }
+
+        fprintf (file, "\n  ]\n}\n");
+        fclose (file);
+
+        printf ("\nResults written to %s\n", outputFile().c_str());
+        return 0;
+    }
+
+    /**
+     * Evicts the CPU caches by writing to a buffer that is larger than
+     * the last level cache of common CPUs.
+     */
+    static void flushCaches() {
+        static std::vector<char> buffer (64 * 1024 * 1024);
+        for (size_t i = 0; i < buffer.size(); i += 64)
+            buffer [i] = static_cast<char> (buffer [i] + 1);
+
+        doNotOptimize (buffer [buffer.size() - 1]);
+    }
+
+    /**
+     * Prevents the compiler from optimizing away the computation of
+     * the given @a value.
+     */
+    template <typename T>
+    static void doNotOptimize (const T& value) {
+#ifdef __GNUC__
+        asm volatile ("" : : "g" (&value) : "memory");
+#else
+        volatile const T* sink = &value;
+        (void) sink;
+#endif
+    }
+
+private:
+    static std::vector<Result>& results() {
+        static std::vector<Result> list;
+        return list;
+    }
+
+    static std::vector<std::pair<std::string, std::string>>& context() {
+        static std::vector<std::pair<std::string, std::string>> list;
+        return list;
+    }
+
+    static std::string& executable() {
+        static std::string path;
+        return path;
+    }
+
+    static std::string& outputFile() {
+        static std::string path;
+        return path;
+    }
+
+    /**
+     * Escapes the quotes and backslashes of the given @a text
+     */
+    static std::string escape (const std::string& text) {
+        std::string escaped;
+        for (size_t i = 0; i < text.length(); ++i) {
+            if (text [i] == '"' || text [i] == '\\')
+                escaped += '\\';
+
+            escaped += text [i];
+        }
+
+        return escaped;
+    }
+};
+
+#endif
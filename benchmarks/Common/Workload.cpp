@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Workload.h"
+#include "SmdDecoder.h"
+
+#include <math.h>
+#include <random>
+
+using namespace ResistorCore;
+
+/**
+ * Significant digits of the E12 and E24 series
+ */
+static const int E12_VALUES [12] = {
+    10, 12, 15, 18, 22, 27, 33, 39, 47, 56, 68, 82
+};
+
+static const int E24_VALUES [24] = {
+    10, 11, 12, 13, 15, 16, 18, 20, 22, 24, 27, 30,
+    33, 36, 39, 43, 47, 51, 56, 62, 68, 75, 82, 91
+};
+
+/**
+ * Returns the three significant digits of the E96 value with the given
+ * @a index (0 to 95), the E96 series has no exceptions to this formula.
+ */
+static int e96Value (const int index) {
+    return static_cast<int> (lround (100 * pow (10, index / 96.0)));
+}
+
+/**
+ * Picks a random element of the given @a values array
+ */
+template <typename T, int Count>
+static T pick (std::mt19937& generator, const T (&values) [Count]) {
+    return values [generator() % Count];
+}
+
+/**
+ * Creates a band code with the given settings
+ */
+static BandCode bandCode (const ResistorType type,
+                          const int digitA,
+                          const int digitB,
+                          const int digitC,
+                          const Multiplier multiplier,
+                          const Tolerance tolerance,
+                          const Tempco tempco) {
+    BandCode code;
+    code.type = type;
+    code.digits [0] = static_cast<Digit> (digitA);
+    code.digits [1] = static_cast<Digit> (digitB);
+    code.digits [2] = static_cast<Digit> (digitC);
+    code.multiplier = multiplier;
+    code.tolerance = tolerance;
+    code.tempco = tempco;
+    return code;
+}
+
+/**
+ * Generates @a count band codes, see the documentation of the
+ * Workload namespace for the distribution of the generated values.
+ */
+std::vector<BandCode> Workload::bandCodes (const size_t count, const uint32_t seed) {
+    std::mt19937 generator (seed);
+    std::uniform_int_distribution<int> share (0, 99);
+
+    // Decades of 2-digit (E12/E24) and 3-digit (E96) values
+    const Multiplier multipliers [7] = {
+        MultiplierGold, MultiplierBlack, MultiplierBrown, MultiplierRed,
+        MultiplierOrange, MultiplierYellow, MultiplierGreen
+    };
+    std::discrete_distribution<int> twoDigitDecade ({ 2, 10, 20, 25, 23, 15, 5 });
+    std::discrete_distribution<int> threeDigitDecade ({ 2, 20, 30, 28, 15, 5, 0 });
+
+    // Common tolerances and tempcos of each series
+    const Tolerance e12Tolerances [2] = { ToleranceGold, ToleranceSilver };
+    const Tolerance e24Tolerances [3] = { ToleranceGold, ToleranceRed, ToleranceBrown };
+    const Tolerance e96Tolerances [5] = {
+        ToleranceBrown, ToleranceRed, ToleranceGreen, ToleranceBlue, ToleranceViolet
+    };
+    const Tempco tempcos [4] = { TempcoBrown, TempcoRed, TempcoYellow, TempcoOrange };
+    std::discrete_distribution<int> e12Tolerance ({ 70, 30 });
+    std::discrete_distribution<int> e24Tolerance ({ 70, 15, 15 });
+    std::discrete_distribution<int> e96Tolerance ({ 70, 10, 10, 5, 5 });
+    std::discrete_distribution<int> tempco ({ 60, 25, 10, 5 });
+
+    std::vector<BandCode> codes (count);
+    for (size_t i = 0; i < count; ++i) {
+        const int kind = share (generator);
+
+        // E12 value on a 4-strip resistor
+        if (kind < E12_SHARE) {
+            const int value = pick (generator, E12_VALUES);
+            codes [i] = bandCode (FourStripResistor, value / 10, value % 10, 0,
+                                  multipliers [twoDigitDecade (generator)],
+                                  e12Tolerances [e12Tolerance (generator)],
+                                  TempcoBrown);
+        }
+
+        // E24 value on a 4-strip resistor
+        else if (kind < E12_SHARE + E24_SHARE) {
+            const int value = pick (generator, E24_VALUES);
+            codes [i] = bandCode (FourStripResistor, value / 10, value % 10, 0,
+                                  multipliers [twoDigitDecade (generator)],
+                                  e24Tolerances [e24Tolerance (generator)],
+                                  TempcoBrown);
+        }
+
+        // E96 value on a 5-strip or 6-strip resistor
+        else if (kind < E12_SHARE + E24_SHARE + E96_SHARE) {
+            const int value = e96Value (generator() % 96);
+            const ResistorType type = generator() % 4 == 0 ? SixStripResistor
+                                                           : FiveStripResistor;
+            codes [i] = bandCode (type, value / 100, (value / 10) % 10, value % 10,
+                                  multipliers [threeDigitDecade (generator)],
+                                  e96Tolerances [e96Tolerance (generator)],
+                                  tempcos [tempco (generator)]);
+        }
+
+        // Arbitrary code
+        else {
+            codes [i] = bandCode (static_cast<ResistorType> (generator() % 3),
+                                  1 + generator() % 9,
+                                  generator() % 10,
+                                  generator() % 10,
+                                  static_cast<Multiplier> (generator() % 12),
+                                  static_cast<Tolerance> (generator() % 8),
+                                  static_cast<Tempco> (generator() % 6));
+        }
+    }
+
+    return codes;
+}
+
+/**
+ * Generates @a count resistance values with the same distribution as
+ * the band codes generated by @c bandCodes().
+ */
+std::vector<double> Workload::resistances (const size_t count, const uint32_t seed) {
+    const std::vector<BandCode> codes = bandCodes (count, seed);
+
+    std::vector<double> values (count);
+    for (size_t i = 0; i < count; ++i)
+        values [i] = decodeBands (codes [i]).resistance;
+
+    return values;
+}
+
+/**
+ * Generates a single SMD code, which may not match the requested
+ * @a scheme (e.g. if the random letters form a valid code)
+ */
+static std::string smdCode (std::mt19937& generator, const SmdScheme scheme) {
+    const char eia96Letters [8] = { 'A', 'B', 'C', 'D', 'X', 'Y', 'E', 'F' };
+    std::discrete_distribution<int> eia96Letter ({ 15, 25, 30, 15, 5, 5, 3, 2 });
+    std::discrete_distribution<int> threeDigitExponent ({ 5, 15, 30, 30, 15, 5 });
+    std::discrete_distribution<int> fourDigitExponent ({ 10, 35, 35, 15, 5 });
+
+    char code [32] = { 0 };
+    switch (scheme) {
+    case SmdThreeDigit:
+        snprintf (code, sizeof (code), "%02d%d",
+                  pick (generator, E24_VALUES),
+                  threeDigitExponent (generator));
+        break;
+    case SmdFourDigit:
+        snprintf (code, sizeof (code), "%03d%d",
+                  e96Value (generator() % 96),
+                  fourDigitExponent (generator));
+        break;
+    case SmdRadix: {
+        const int value = pick (generator, E24_VALUES);
+        const int form = generator() % 20;
+        if (form < 12)
+            snprintf (code, sizeof (code), "%dR%d", value / 10, value % 10);
+        else if (form < 17)
+            snprintf (code, sizeof (code), "%dR%d", value, static_cast<int> (generator() % 10));
+        else {
+            const int precise = e96Value (generator() % 96);
+            snprintf (code, sizeof (code), "%dR%02d", precise / 100, precise % 100);
+        }
+        break;
+    }
+    case SmdEia96:
+        snprintf (code, sizeof (code), "%02d%c",
+                  1 + static_cast<int> (generator() % 96),
+                  eia96Letters [eia96Letter (generator)]);
+        break;
+    case SmdJumper:
+        snprintf (code, sizeof (code), "%s", generator() % 4 ? "000" : "0");
+        break;
+    default: {
+        const char* symbols = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+        for (int i = 0; i < 3; ++i)
+            code [i] = symbols [generator() % 36];
+        break;
+    }
+    }
+
+    return code;
+}
+
+/**
+ * Generates @a count SMD codes that use the given @a scheme, using
+ * E24 values for 3-digit and radix codes and E96 values for 4-digit
+ * and EIA-96 codes. Codes of the @c SmdInvalid scheme are random
+ * characters that the decoder rejects.
+ */
+std::vector<std::string> Workload::smdCodes (const SmdScheme scheme,
+                                             const size_t count,
+                                             const uint32_t seed) {
+    std::mt19937 generator (seed);
+
+    std::vector<std::string> codes;
+    codes.reserve (count);
+    while (codes.size() < count) {
+        const std::string code = smdCode (generator, scheme);
+        if (decodeSmd (code.data(), code.length()).scheme == scheme)
+            codes.push_back (code);
+    }
+
+    return codes;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "ResistorCore.h"
+
+/**
+ * Generates synthetic resistor readings for the benchmarks.
+ *
+ * Values follow the distribution of a typical parts bin instead of being
+ * uniform over the code space: most values come from the E12 and E24
+ * series (4-strip resistors, 5% and 10% tolerance), followed by E96
+ * values (5 and 6-strip resistors, 1% tolerance and better), and only a
+ * small share of arbitrary (mostly non-standard) codes.
+ */
+namespace Workload
+{
+
+/**
+ * Share (in percent) of each kind of value in the generated workloads
+ */
+static const int E12_SHARE = 45;
+static const int E24_SHARE = 30;
+static const int E96_SHARE = 20;
+static const int RANDOM_SHARE = 100 - E12_SHARE - E24_SHARE - E96_SHARE;
+
+std::vector<ResistorCore::BandCode> bandCodes (const size_t count,
+                                               const uint32_t seed = 42);
+std::vector<double> resistances (const size_t count,
+                                 const uint32_t seed = 42);
+std::vector<std::string> smdCodes (const ResistorCore::SmdScheme scheme,
+                                   const size_t count,
+                                   const uint32_t seed = 42);
+
+}
+
+#endif
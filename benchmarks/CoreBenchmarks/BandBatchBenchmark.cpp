@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <vector>
+#include <random>
+
+#include "Benchmark.h"
+#include "BandBatch.h"
+
+using namespace ResistorCore;
+
+/**
+ * Compares the throughput of the per-resistor decoder with the batch
+ * decoder for every resistor layout and every supported kernel.
+ */
+void benchmarkBandBatch() {
+    const size_t count = 1 << 20;
+
+    // Generate random band readings
+    std::mt19937 generator (42);
+    std::vector<uint8_t> digitA (count), digitB (count), digitC (count);
+    std::vector<uint8_t> multiplier (count), tolerance (count);
+    for (size_t i = 0; i < count; ++i) {
+        digitA [i] = 1 + generator() % 9;
+        digitB [i] = generator() % 10;
+        digitC [i] = generator() % 10;
+        multiplier [i] = generator() % 12;
+        tolerance [i] = generator() % 8;
+    }
+
+    const BandArrays bands = {
+        digitA.data(), digitB.data(), digitC.data(),
+        multiplier.data(), tolerance.data()
+    };
+
+    std::vector<double> resistance (count);
+    std::vector<double> minResistance (count);
+    std::vector<double> maxResistance (count);
+
+    const char* typeNames [3] = { "4-strip", "5-strip", "6-strip" };
+    for (int t = FourStripResistor; t <= SixStripResistor; ++t) {
+        const ResistorType type = static_cast<ResistorType> (t);
+        char name [64];
+
+        // Baseline: one decodeBands() call per resistor
+        snprintf (name, sizeof (name), "decodeBands/%s", typeNames [t]);
+        Benchmark::run (name, count, [&]() {
+            BandCode code;
+            code.type = type;
+            code.tempco = TempcoBrown;
+            for (size_t i = 0; i < count; ++i) {
+                code.digits [0] = static_cast<Digit> (digitA [i]);
+                code.digits [1] = static_cast<Digit> (digitB [i]);
+                code.digits [2] = static_cast<Digit> (digitC [i]);
+                code.multiplier = static_cast<Multiplier> (multiplier [i]);
+                code.tolerance = static_cast<Tolerance> (tolerance [i]);
+
+                const BandResult result = decodeBands (code);
+                resistance [i] = result.resistance;
+                minResistance [i] = result.minResistance;
+                maxResistance [i] = result.maxResistance;
+            }
+
+            Benchmark::doNotOptimize (resistance [count - 1]);
+        });
+
+        // Batch decoder with every kernel that runs on this CPU
+        for (int k = BatchScalar; k <= BatchAvx2; ++k) {
+            const BatchKernel kernel = static_cast<BatchKernel> (k);
+            if (!batchKernelSupported (kernel))
+                continue;
+
+            snprintf (name, sizeof (name), "decodeBandsBatch/%s/%s",
+                      typeNames [t], batchKernelName (kernel));
+            Benchmark::run (name, count, [&]() {
+                decodeBandsBatch (type, bands, count,
+                                  resistance.data(),
+                                  minResistance.data(),
+                                  maxResistance.data(),
+                                  kernel);
+                Benchmark::doNotOptimize (resistance [count - 1]);
+            });
+        }
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <stdio.h>
+
+#include "BandOrder.h"
+#include "Benchmark.h"
+#include "BatchExecutor.h"
+
+using namespace ResistorCore;
+
+/**
+ * Measures the construction of the band order table and the ranking of
+ * random readings with 4 to 6 bands, in both directions and with random
+ * spacing hints, alone and through the batch executor.
+ */
+void benchmarkBandOrder() {
+    const size_t count = 1 << 20;
+    std::mt19937 generator (42);
+
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point start = Clock::now();
+    const BandOrder& order = BandOrder::instance();
+    const std::chrono::duration<double> build = Clock::now() - start;
+    printf ("BandOrder: %.3f ms to build, %zu bytes (%zu ambiguous codes)\n",
+            build.count() * 1e3, order.memoryUsage(), order.ambiguousCodes());
+
+    // Readings of valid codes, reversed half of the time
+    std::vector<BandReading> readings (count);
+    for (size_t i = 0; i < count; ++i) {
+        BandReading& reading = readings [i];
+        reading.count = static_cast<uint8_t> (4 + generator() % 3);
+        reading.spacing = static_cast<uint8_t> (generator() % 3);
+
+        const size_t digits = reading.count == 4 ? 2 : 3;
+        const uint8_t tolerances [] = { 1, 2, 5, 6, 7, 8, 10, 11 };
+        const uint8_t tempcos [] = { 1, 2, 3, 4, 6, 7 };
+        for (size_t d = 0; d < digits; ++d)
+            reading.colors [d] = static_cast<uint8_t> ((d == 0 ? 1 : 0) + generator() % (d == 0 ? 9 : 10));
+
+        reading.colors [digits] = static_cast<uint8_t> (generator() % 12);
+        reading.colors [digits + 1] = tolerances [generator() % 8];
+        if (reading.count == 6)
+            reading.colors [5] = tempcos [generator() % 6];
+
+        if (generator() % 2)
+            std::reverse (reading.colors, reading.colors + reading.count);
+    }
+
+    std::vector<BandRanking> rankings (count);
+    Benchmark::run ("BandOrder/rank", count, [&]() {
+        for (size_t i = 0; i < count; ++i)
+            rankings [i] = order.rank (readings [i]);
+
+        Benchmark::doNotOptimize (rankings [count - 1]);
+    });
+    Benchmark::run ("BandOrder/rankBatch", count, [&]() {
+        order.rankBatch (readings.data(), count, rankings.data());
+        Benchmark::doNotOptimize (rankings [count - 1]);
+    });
+
+    BatchExecutor executor;
+    Benchmark::run ("BandOrder/rankBatch/parallel", count, [&]() {
+        order.rankBatch (readings.data(), count, rankings.data(), &executor);
+        Benchmark::doNotOptimize (rankings [count - 1]);
+    });
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <vector>
+#include <random>
+#include <string>
+
+#include "Benchmark.h"
+#include "BandTable.h"
+
+using namespace ResistorCore;
+
+/**
+ * Compares the arithmetic decoding path (decodeBands() + formatResistance())
+ * with the precomputed band table, with cold and warm CPU caches.
+ */
+void benchmarkBandTable() {
+    typedef std::chrono::steady_clock Clock;
+
+    // Measure the time required to build the table
+    const Clock::time_point start = Clock::now();
+    const BandTable& table = BandTable::instance();
+    const std::chrono::duration<double> build = Clock::now() - start;
+    printf ("BandTable (%s): %.3f ms to build, %zu bytes\n",
+            BandTable::isStatic() ? "static" : "lazy",
+            build.count() * 1e3, BandTable::memoryUsage());
+
+    // Generate random band codes over the whole code space
+    const size_t count = 1 << 16;
+    std::mt19937 generator (42);
+    std::vector<BandCode> codes (count);
+    for (size_t i = 0; i < count; ++i) {
+        BandCode& code = codes [i];
+        code.type = static_cast<ResistorType> (generator() % 3);
+        code.digits [0] = static_cast<Digit> (1 + generator() % 9);
+        code.digits [1] = static_cast<Digit> (generator() % 10);
+        code.digits [2] = static_cast<Digit> (generator() % 10);
+        code.multiplier = static_cast<Multiplier> (generator() % 12);
+        code.tolerance = static_cast<Tolerance> (generator() % 8);
+        code.tempco = static_cast<Tempco> (generator() % 6);
+    }
+
+    // Arithmetic path
+    auto arithmetic = [&]() {
+        size_t length = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const BandResult result = decodeBands (codes [i]);
+            length += formatResistance (result.resistance).length();
+            Benchmark::doNotOptimize (result);
+        }
+
+        Benchmark::doNotOptimize (length);
+    };
+
+    // Table path
+    auto lookup = [&]() {
+        size_t length = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const BandTableEntry* entry = table.lookup (codes [i]);
+            length += table.label (*entry) [0];
+            Benchmark::doNotOptimize (*entry);
+        }
+
+        Benchmark::doNotOptimize (length);
+    };
+
+    Benchmark::run ("BandTable/arithmetic/warm", count, arithmetic);
+    Benchmark::run ("BandTable/lookup/warm", count, lookup);
+    Benchmark::run ("BandTable/arithmetic/cold", count, arithmetic, Benchmark::flushCaches);
+    Benchmark::run ("BandTable/lookup/cold", count, lookup, Benchmark::flushCaches);
+}
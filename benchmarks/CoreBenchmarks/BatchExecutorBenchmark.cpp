@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <vector>
+#include <string>
+
+#include "Workload.h"
+#include "Benchmark.h"
+#include "SmdDecoder.h"
+#include "BatchExecutor.h"
+
+using namespace ResistorCore;
+
+/**
+ * Returns the thread counts of the scaling curve: powers of two up to
+ * the number of hardware threads, and the number of hardware threads
+ */
+static std::vector<size_t> threadCounts() {
+    const size_t maximum = BatchExecutor::defaultThreadCount();
+
+    std::vector<size_t> counts;
+    for (size_t threads = 1; threads < maximum; threads *= 2)
+        counts.push_back (threads);
+
+    counts.push_back (maximum);
+    return counts;
+}
+
+/**
+ * Measures how the parallel band and SMD decoders scale from one thread
+ * to every hardware thread of the system
+ */
+void benchmarkBatchExecutor() {
+    const size_t count = 1 << 22;
+
+    // Generate band readings from the workload generator
+    const std::vector<BandCode> codes = Workload::bandCodes (count);
+    std::vector<uint8_t> digitA (count), digitB (count), digitC (count);
+    std::vector<uint8_t> multiplier (count), tolerance (count);
+    for (size_t i = 0; i < count; ++i) {
+        digitA [i] = static_cast<uint8_t> (codes [i].digits [0]);
+        digitB [i] = static_cast<uint8_t> (codes [i].digits [1]);
+        digitC [i] = static_cast<uint8_t> (codes [i].digits [2]);
+        multiplier [i] = static_cast<uint8_t> (codes [i].multiplier);
+        tolerance [i] = static_cast<uint8_t> (codes [i].tolerance);
+    }
+
+    const BandArrays bands = {
+        digitA.data(), digitB.data(), digitC.data(),
+        multiplier.data(), tolerance.data()
+    };
+
+    std::vector<double> resistance (count);
+    std::vector<double> minResistance (count);
+    std::vector<double> maxResistance (count);
+
+    // Generate fixed-width SMD codes (mixed schemes)
+    const SmdScheme schemes [4] = { SmdThreeDigit, SmdFourDigit, SmdRadix, SmdEia96 };
+    std::vector<char> smd (count * 4, '\0');
+    for (size_t s = 0; s < 4; ++s) {
+        const std::vector<std::string> list = Workload::smdCodes (schemes [s], count / 4, s);
+        for (size_t i = 0; i < list.size(); ++i)
+            list [i].copy (&smd [(i * 4 + s) * 4], 4);
+    }
+
+    std::vector<SmdResult> results (count);
+
+    // Scaling curves
+    const std::vector<size_t> threads = threadCounts();
+    for (size_t t = 0; t < threads.size(); ++t) {
+        BatchExecutor executor (threads [t]);
+        char name [64];
+
+        snprintf (name, sizeof (name), "BatchExecutor/decodeBands/threads:%zu", threads [t]);
+        Benchmark::run (name, count, [&]() {
+            decodeBandsParallel (executor, FiveStripResistor, bands, count,
+                                 resistance.data(),
+                                 minResistance.data(),
+                                 maxResistance.data());
+            Benchmark::doNotOptimize (resistance [count - 1]);
+        });
+
+        snprintf (name, sizeof (name), "BatchExecutor/decodeSmdFixed/threads:%zu", threads [t]);
+        Benchmark::run (name, count, [&]() {
+            decodeSmdFixedParallel (executor, smd.data(), count, 4, results.data());
+            Benchmark::doNotOptimize (results [count - 1]);
+        });
+    }
+}
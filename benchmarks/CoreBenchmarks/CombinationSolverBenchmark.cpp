@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+#include <random>
+#include <math.h>
+
+#include "Benchmark.h"
+#include "BatchExecutor.h"
+#include "CombinationSolver.h"
+
+using namespace ResistorCore;
+
+/**
+ * Measures the combination solver over E96 values across 8 decades (the
+ * interactive case), for each maximum number of parts.
+ */
+void benchmarkCombinationSolver() {
+    typedef std::chrono::steady_clock Clock;
+
+    BatchExecutor executor;
+    CombinationSolver solver (&executor);
+
+    // Measure the time required to build the inventory
+    const Clock::time_point start = Clock::now();
+    solver.setSeries (SeriesE96, 1, 99.9e6);
+    const std::chrono::duration<double> build = Clock::now() - start;
+    printf ("CombinationSolver: %zu values, %.3f ms to build\n",
+            solver.inventorySize(), build.count() * 1e3);
+
+    // Generate random targets
+    const size_t count = 16;
+    std::mt19937 generator (42);
+    std::uniform_real_distribution<double> exponent (1, 7);
+    std::vector<double> targets (count);
+    for (size_t i = 0; i < count; ++i)
+        targets [i] = pow (10, exponent (generator));
+
+    for (int parts = 2; parts <= 4; ++parts) {
+        const std::string name = "CombinationSolver/E96/" + std::to_string (parts) + "-parts";
+        Benchmark::run (name.c_str(), count, [&]() {
+            for (size_t i = 0; i < count; ++i) {
+                const CombinationQuery query = { targets [i], 1e-4, parts, 10 };
+                Benchmark::doNotOptimize (solver.solve (query).size());
+            }
+        });
+    }
+}
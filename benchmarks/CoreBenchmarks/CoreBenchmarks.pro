@@ -0,0 +1,69 @@
+#
+# Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+
+
+#-------------------------------------------------------------------------------
+# Project configuration
+#-------------------------------------------------------------------------------
+
+TEMPLATE = app
+TARGET = CoreBenchmarks
+
+CONFIG += console
+CONFIG += warn_on
+CONFIG += release
+CONFIG -= qt
+CONFIG -= app_bundle
+
+#-------------------------------------------------------------------------------
+# Make options
+#-------------------------------------------------------------------------------
+
+OBJECTS_DIR = obj
+
+#-------------------------------------------------------------------------------
+# Import source code
+#-------------------------------------------------------------------------------
+
+include ($$PWD/../Common/Common.pri)
+
+SOURCES += \
+    $$PWD/main.cpp \
+    $$PWD/BandBatchBenchmark.cpp \
+    $$PWD/BandOrderBenchmark.cpp \
+    $$PWD/BandTableBenchmark.cpp \
+    $$PWD/BatchExecutorBenchmark.cpp \
+    $$PWD/CombinationSolverBenchmark.cpp \
+    $$PWD/DividerSolverBenchmark.cpp \
+    $$PWD/ESeriesBenchmark.cpp \
+    $$PWD/ExactResistanceBenchmark.cpp \
+    $$PWD/ExpressionBenchmark.cpp \
+    $$PWD/GainSolverBenchmark.cpp \
+    $$PWD/MarkingBenchmark.cpp \
+    $$PWD/MonteCarloBenchmark.cpp \
+    $$PWD/NetworkSolverBenchmark.cpp \
+    $$PWD/ResistanceFormatterBenchmark.cpp \
+    $$PWD/ResistanceParserBenchmark.cpp \
+    $$PWD/ReverseLookupBenchmark.cpp \
+    $$PWD/SmdDecoderBenchmark.cpp \
+    $$PWD/ThermalBenchmark.cpp \
+    $$PWD/WorstCaseBenchmark.cpp
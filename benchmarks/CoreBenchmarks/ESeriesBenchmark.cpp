@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+#include <random>
+#include <math.h>
+
+#include "ESeries.h"
+#include "Benchmark.h"
+
+using namespace ResistorCore;
+
+/**
+ * Compares the single-value and batch nearest-value searches for every
+ * series, and measures the membership test.
+ */
+void benchmarkESeries() {
+    const size_t count = 1 << 20;
+
+    // Generate log-uniform values over the catalog range
+    std::mt19937 generator (42);
+    std::uniform_real_distribution<double> exponent (SERIES_MIN_DECADE,
+                                                     SERIES_MIN_DECADE + SERIES_DECADES);
+    std::vector<double> values (count);
+    for (size_t i = 0; i < count; ++i)
+        values [i] = pow (10, exponent (generator));
+
+    std::vector<double> nearest (count);
+    std::vector<double> errors (count);
+
+    for (int s = SeriesE3; s <= SeriesE192; ++s) {
+        const ESeries series = static_cast<ESeries> (s);
+        const std::string prefix = std::string ("ESeries/") + seriesName (series);
+
+        Benchmark::run ((prefix + "/nearest").c_str(), count, [&]() {
+            for (size_t i = 0; i < count; ++i)
+                nearest [i] = nearestStandardValue (values [i], series);
+
+            Benchmark::doNotOptimize (nearest [count - 1]);
+        });
+
+        Benchmark::run ((prefix + "/batch").c_str(), count, [&]() {
+            nearestStandardValues (series, values.data(), count,
+                                   nearest.data(), errors.data());
+            Benchmark::doNotOptimize (nearest [count - 1]);
+        });
+    }
+
+    Benchmark::run ("ESeries/E96/isStandardValue", count, [&]() {
+        size_t members = 0;
+        for (size_t i = 0; i < count; ++i)
+            members += isStandardValue (nearest [i], SeriesE96);
+
+        Benchmark::doNotOptimize (members);
+    });
+}
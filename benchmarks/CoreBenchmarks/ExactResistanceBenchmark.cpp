@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <vector>
+#include <algorithm>
+#include <unordered_set>
+
+#include "Workload.h"
+#include "Benchmark.h"
+#include "ExactResistance.h"
+#include "ResistanceFormatter.h"
+
+using namespace ResistorCore;
+
+/**
+ * Compares floating-point and exact decoding of band codes, and the
+ * deduplication of the decoded values with sorting and hashing
+ */
+void benchmarkExactResistance() {
+    const size_t count = 1 << 18;
+    const std::vector<BandCode> codes = Workload::bandCodes (count);
+
+    std::vector<double> values (count);
+    Benchmark::run ("ExactResistance/Decode bands (double)", count, [&]() {
+        for (size_t i = 0; i < count; ++i)
+            values [i] = decodeBands (codes [i]).resistance;
+
+        Benchmark::doNotOptimize (values.back());
+    });
+
+    std::vector<ExactResistance> exact (count);
+    Benchmark::run ("ExactResistance/Decode bands (exact)", count, [&]() {
+        for (size_t i = 0; i < count; ++i)
+            exact [i] = decodeBandsExact (codes [i]);
+
+        Benchmark::doNotOptimize (exact.back());
+    });
+
+    Benchmark::run ("ExactResistance/Dedupe (sort doubles)", count, [&]() {
+        std::vector<double> sorted (values);
+        std::sort (sorted.begin(), sorted.end());
+        const size_t unique = std::unique (sorted.begin(), sorted.end()) - sorted.begin();
+        Benchmark::doNotOptimize (unique);
+    });
+
+    Benchmark::run ("ExactResistance/Dedupe (sort exact)", count, [&]() {
+        std::vector<ExactResistance> sorted (exact);
+        std::sort (sorted.begin(), sorted.end());
+        const size_t unique = std::unique (sorted.begin(), sorted.end()) - sorted.begin();
+        Benchmark::doNotOptimize (unique);
+    });
+
+    Benchmark::run ("ExactResistance/Dedupe (hash exact)", count, [&]() {
+        std::unordered_set<ExactResistance> unique (exact.begin(), exact.end());
+        Benchmark::doNotOptimize (unique.size());
+    });
+
+    Benchmark::run ("ExactResistance/Format (lossless)", count, [&]() {
+        char buffer [RESISTANCE_STR_CAPACITY];
+        size_t length = 0;
+        for (size_t i = 0; i < count; ++i)
+            length += formatResistanceUtf8 (exact [i], buffer, sizeof (buffer));
+
+        Benchmark::doNotOptimize (length);
+    });
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+#include <random>
+
+#include "Benchmark.h"
+#include "Expression.h"
+#include "BatchExecutor.h"
+
+using namespace ResistorCore;
+
+/**
+ * Compiles expressions from text and from the cache, then evaluates a
+ * voltage divider for random tolerance corners one binding at a time and
+ * in blocks (single and multi-threaded)
+ */
+void benchmarkExpression() {
+    const std::string text = "12V * (R2 || 1M) / (R1 + (R2 || 1M))";
+    const std::string literals = "(bands=yellow-violet-red-gold + 220) || smd=103 * 2";
+
+    Expression expression;
+    Benchmark::run ("Expression/compile (variables)", 1, [&]() {
+        compileExpression (text.data(), text.size(), &expression);
+        Benchmark::doNotOptimize (expression);
+    });
+
+    Benchmark::run ("Expression/compile (band code and SMD)", 1, [&]() {
+        compileExpression (literals.data(), literals.size(), &expression);
+        Benchmark::doNotOptimize (expression);
+    });
+
+    ExpressionCache cache;
+    Benchmark::run ("Expression/compile (cached)", 1, [&]() {
+        Benchmark::doNotOptimize (cache.compile (literals));
+    });
+
+    // Random bindings within ±5% of 4k7 and 10k
+    const size_t count = 1 << 22;
+    std::mt19937 generator (42);
+    std::uniform_real_distribution<double> tolerance (0.95, 1.05);
+    std::vector<double> r1 (count);
+    std::vector<double> r2 (count);
+    for (size_t i = 0; i < count; ++i) {
+        r1 [i] = 4.7e3 * tolerance (generator);
+        r2 [i] = 10e3 * tolerance (generator);
+    }
+
+    compileExpression (text.data(), text.size(), &expression);
+    const size_t first = expression.variableIndex ("R1");
+    const double* columns [2];
+    columns [first] = r1.data();
+    columns [1 - first] = r2.data();
+
+    std::vector<double> results (count);
+    Benchmark::run ("Expression/evaluate (one binding)", count, [&]() {
+        double variables [2];
+        for (size_t i = 0; i < count; ++i) {
+            variables [0] = columns [0][i];
+            variables [1] = columns [1][i];
+            results [i] = expression.evaluate (variables);
+        }
+
+        Benchmark::doNotOptimize (results.back());
+    });
+
+    Benchmark::run ("Expression/evaluateBatch", count, [&]() {
+        expression.evaluateBatch (columns, count, results.data());
+        Benchmark::doNotOptimize (results.back());
+    });
+
+    BatchExecutor executor;
+    Benchmark::run ("Expression/evaluateBatch (threaded)", count, [&]() {
+        expression.evaluateBatch (columns, count, results.data(), &executor);
+        Benchmark::doNotOptimize (results.back());
+    });
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+#include <random>
+
+#include "Benchmark.h"
+#include "GainSolver.h"
+
+using namespace ResistorCore;
+
+/**
+ * Measures gain searches over every series (1 ohm to 10 Mohm), with and
+ * without a candidate callback
+ */
+void benchmarkGainSolver() {
+    // Generate random gains
+    const size_t count = 256;
+    std::mt19937 generator (42);
+    std::uniform_real_distribution<double> gain (1.1, 200);
+    std::vector<double> gains (count);
+    for (size_t i = 0; i < count; ++i)
+        gains [i] = gain (generator);
+
+    GainSolver solver;
+    for (int s = SeriesE12; s <= SeriesE192; ++s) {
+        const ESeries series = static_cast<ESeries> (s);
+        solver.setSeries (series, 1, 10e6);
+
+        const std::string name = std::string ("GainSolver/") + seriesName (series);
+        Benchmark::run (name.c_str(), count, [&]() {
+            for (size_t i = 0; i < count; ++i) {
+                const AmplifierType type = static_cast<AmplifierType> (i % 2);
+                const GainQuery query = { type, gains [i], 10e3, 1e3, 1e6, 0.05, 10 };
+                Benchmark::doNotOptimize (solver.solve (query).size());
+            }
+        });
+    }
+
+    // Measure the cost of streaming the candidates
+    size_t candidates = 0;
+    solver.setSeries (SeriesE96, 1, 10e6);
+    Benchmark::run ("GainSolver/E96 (streaming)", count, [&]() {
+        for (size_t i = 0; i < count; ++i) {
+            const GainQuery query = { AmplifierInverting, gains [i], 10e3, 1e3, 1e6, 0.05, 10 };
+            solver.solve (query, [&](const GainStage&) { ++candidates; });
+        }
+    });
+
+    Benchmark::doNotOptimize (candidates);
+}
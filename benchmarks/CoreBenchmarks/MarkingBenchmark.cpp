@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <vector>
+#include <random>
+#include <string>
+#include <string.h>
+
+#include "Marking.h"
+#include "Benchmark.h"
+#include "SmdDecoder.h"
+
+using namespace ResistorCore;
+
+/**
+ * Generates a random printed code of the given @a family, mixing every
+ * scheme that the family supports
+ */
+static std::string randomMarkingCode (std::mt19937& generator, const ComponentFamily family) {
+    const char* digits = "0123456789";
+    const char* capacitorRadix = "pnu";
+    const char* tolerances = "FGJKM";
+    const char* eia198Letters = "ABCDEFGHJKLMNPQRSTUVWXYZ";
+
+    std::string code;
+    switch (generator() % 3) {
+    case 0:
+        code += digits [1 + generator() % 9];
+        code += digits [generator() % 10];
+        code += digits [generator() % 6];
+        break;
+    case 1:
+        code += digits [1 + generator() % 9];
+        code += family == FamilyCapacitor ? capacitorRadix [generator() % 3] : 'R';
+        code += digits [generator() % 10];
+        break;
+    default:
+        if (family == FamilyCapacitor) {
+            code += eia198Letters [generator() % 24];
+            code += digits [generator() % 10];
+        } else {
+            code += digits [1 + generator() % 9];
+            code += digits [generator() % 10];
+            code += digits [generator() % 6];
+        }
+        break;
+    }
+
+    if (family != FamilyResistor && generator() % 2)
+        code += tolerances [generator() % 5];
+
+    return code;
+}
+
+/**
+ * Measures the marking engine for each family, the batch decoders over
+ * fixed-width records, newline-separated buffers and color bands, and
+ * compares the resistor family with the SMD decoder that wraps it.
+ */
+void benchmarkMarking() {
+    const size_t count = 1 << 20;
+    const size_t width = 6;
+    std::mt19937 generator (42);
+
+    const ComponentFamily families [] = {
+        FamilyResistor, FamilyCapacitor, FamilyInductor
+    };
+    const char* names [] = {
+        "resistor", "capacitor", "inductor"
+    };
+
+    std::vector<MarkingValue> results (count);
+    std::vector<double> values (count);
+    for (size_t f = 0; f < sizeof (families) / sizeof (families [0]); ++f) {
+        std::string lines;
+        std::vector<char> fixed (count * width, '\0');
+        for (size_t i = 0; i < count; ++i) {
+            const std::string code = randomMarkingCode (generator, families [f]);
+            code.copy (&fixed [i * width], code.length());
+            lines += code;
+            lines += '\n';
+        }
+
+        // Decode each code individually
+        const ComponentFamily family = families [f];
+        std::string name = std::string ("decodeMarking/") + names [f];
+        Benchmark::run (name.c_str(), count, [&]() {
+            for (size_t i = 0; i < count; ++i) {
+                const char* code = &fixed [i * width];
+                results [i] = decodeMarking (family, code, strnlen (code, width));
+            }
+
+            Benchmark::doNotOptimize (results [count - 1]);
+        });
+
+        // Batch decoders
+        name = std::string ("decodeMarkings/") + names [f];
+        Benchmark::run (name.c_str(), count, [&]() {
+            decodeMarkings (family, fixed.data(), count, width, results.data());
+            Benchmark::doNotOptimize (results [count - 1]);
+        });
+
+        name = std::string ("decodeMarkingLines/") + names [f];
+        Benchmark::run (name.c_str(), count, [&]() {
+            decodeMarkingLines (family, lines.data(), lines.length(), results.data(), count);
+            Benchmark::doNotOptimize (results [count - 1]);
+        });
+
+        // The resistor family through the SMD decoder, which must not be
+        // slower than the engine itself
+        if (family == FamilyResistor) {
+            std::vector<SmdResult> smd (count);
+            Benchmark::run ("decodeSmd/marking-codes", count, [&]() {
+                for (size_t i = 0; i < count; ++i) {
+                    const char* code = &fixed [i * width];
+                    smd [i] = decodeSmd (code, strnlen (code, width));
+                }
+
+                Benchmark::doNotOptimize (smd [count - 1]);
+            });
+        }
+    }
+
+    // Color bands of inductors (4 bands) and resistors (5 bands)
+    std::vector<uint8_t> colors (count * 5);
+    for (size_t i = 0; i < count * 5; ++i)
+        colors [i] = static_cast<uint8_t> (generator() % 12);
+
+    Benchmark::run ("decodeColorMarkings/inductor", count, [&]() {
+        decodeColorMarkings (FamilyInductor, colors.data(), count, 4, results.data());
+        Benchmark::doNotOptimize (results [count - 1]);
+    });
+    Benchmark::run ("decodeColorMarkings/resistor", count, [&]() {
+        decodeColorMarkings (FamilyResistor, colors.data(), count, 5, results.data());
+        Benchmark::doNotOptimize (results [count - 1]);
+    });
+
+    // Conversion of the decoded markings to doubles
+    Benchmark::run ("markingValues", count, [&]() {
+        markingValues (results.data(), count, values.data());
+        Benchmark::doNotOptimize (values [count - 1]);
+    });
+}
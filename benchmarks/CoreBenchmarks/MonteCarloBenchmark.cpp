@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string>
+
+#include "Benchmark.h"
+#include "MonteCarlo.h"
+
+using namespace ResistorCore;
+
+/**
+ * Measures the sampling throughput of every distribution, on one thread
+ * and on every CPU core
+ */
+void benchmarkMonteCarlo() {
+    const uint64_t samples = 1 << 22;
+    const char* names [] = { "Uniform", "Normal", "TruncatedNormal" };
+
+    BatchExecutor executor;
+    for (int d = DistributionUniform; d <= DistributionTruncatedNormal; ++d) {
+        const Distribution distribution = static_cast<Distribution> (d);
+        const MonteCarloPart parts [2] = {
+            { 10e3, 0.01, 100, distribution },
+            { 4.7e3, 0.01, 100, distribution }
+        };
+
+        MonteCarloSetup setup;
+        setup.model = ModelDivider;
+        setup.parts = parts;
+        setup.partCount = 2;
+        setup.minTemperature = -40;
+        setup.maxTemperature = 85;
+        setup.samples = samples;
+        setup.seed = 42;
+        setup.bins = MonteCarloEngine::DEFAULT_BINS;
+        setup.specMin = 0.31;
+        setup.specMax = 0.33;
+
+        MonteCarloResult result;
+        const MonteCarloEngine serial;
+        const MonteCarloEngine parallel (&executor);
+
+        const std::string name = std::string ("MonteCarlo/") + names [d];
+        Benchmark::run ((name + "/Serial").c_str(), samples, [&]() {
+            serial.run (setup, &result);
+            Benchmark::doNotOptimize (result.mean);
+        });
+        Benchmark::run ((name + "/Parallel").c_str(), samples, [&]() {
+            parallel.run (setup, &result);
+            Benchmark::doNotOptimize (result.mean);
+        });
+    }
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string>
+#include <random>
+#include <stdio.h>
+
+#include "Benchmark.h"
+#include "NetworkSolver.h"
+
+using namespace ResistorCore;
+
+/**
+ * Builds a ladder network (series resistors along the top rail, shunt
+ * resistors to ground) with the given number of @a stages
+ */
+static Netlist ladder (const size_t stages) {
+    Netlist netlist;
+    size_t previous = netlist.addNode ("in");
+
+    NetlistElement source = { ElementVoltageSource, "V1", { previous, GROUND_NODE }, 10 };
+    netlist.addElement (source);
+
+    for (size_t i = 0; i < stages; ++i) {
+        const size_t node = netlist.addNode ("n" + std::to_string (i));
+        NetlistElement series = { ElementResistor, "RS" + std::to_string (i), { previous, node }, 1e3 };
+        NetlistElement shunt = { ElementResistor, "RP" + std::to_string (i), { node, GROUND_NODE }, 10e3 };
+        netlist.addElement (series);
+        netlist.addElement (shunt);
+        previous = node;
+    }
+
+    return netlist;
+}
+
+/**
+ * Builds a square 2D resistor mesh with @a side x @a side nodes, driven by
+ * a current source at one corner and grounded at the opposite one
+ */
+static Netlist mesh (const size_t side) {
+    Netlist netlist;
+    std::vector<size_t> nodes (side * side);
+    for (size_t i = 0; i < nodes.size(); ++i)
+        nodes [i] = i == 0 ? GROUND_NODE : netlist.addNode ("n" + std::to_string (i));
+
+    std::mt19937 generator (42);
+    std::uniform_real_distribution<double> value (100, 10e3);
+
+    size_t count = 0;
+    for (size_t y = 0; y < side; ++y) {
+        for (size_t x = 0; x < side; ++x) {
+            const size_t node = nodes [y * side + x];
+            if (x + 1 < side) {
+                NetlistElement r = { ElementResistor, "R" + std::to_string (count++),
+                                     { node, nodes [y * side + x + 1] }, value (generator) };
+                netlist.addElement (r);
+            }
+
+            if (y + 1 < side) {
+                NetlistElement r = { ElementResistor, "R" + std::to_string (count++),
+                                     { node, nodes [(y + 1) * side + x] }, value (generator) };
+                netlist.addElement (r);
+            }
+        }
+    }
+
+    NetlistElement source = { ElementCurrentSource, "I1", { GROUND_NODE, nodes.back() }, 1e-3 };
+    netlist.addElement (source);
+    return netlist;
+}
+
+/**
+ * Measures the symbolic analysis, the numeric refactorization after a
+ * resistance change and the solve phase on a ladder and a 2D mesh with
+ * about 100k nodes each
+ */
+void benchmarkNetworkSolver() {
+    const Netlist circuits [] = { ladder (100000), mesh (316) };
+    const char* names [] = { "Ladder", "Mesh" };
+
+    for (size_t c = 0; c < 2; ++c) {
+        const Netlist& netlist = circuits [c];
+        const std::string name = std::string ("NetworkSolver/") + names [c];
+        const size_t nodes = netlist.nodeCount();
+
+        // First resistor and first source of the circuit
+        size_t resistor = 0;
+        size_t source = 0;
+        for (size_t e = netlist.elementCount(); e-- > 0;) {
+            if (netlist.element (e).type == ElementResistor)
+                resistor = e;
+            else
+                source = e;
+        }
+
+        NetworkSolver solver;
+        Benchmark::run ((name + " analyze").c_str(), nodes, [&]() {
+            solver.load (netlist);
+        });
+
+        // Changing one resistance only repeats the numeric factorization
+        NetworkSolution solution;
+        size_t iteration = 0;
+        Benchmark::run ((name + " refactorize + solve").c_str(), nodes, [&]() {
+            solver.setValue (resistor, 1e3 + static_cast<double> (++iteration % 100));
+            solver.solve (&solution);
+            Benchmark::doNotOptimize (solution.voltages.back());
+        });
+
+        // Changing a source does not refactorize
+        Benchmark::run ((name + " solve").c_str(), nodes, [&]() {
+            solver.setValue (source, static_cast<double> (++iteration % 100));
+            solver.solve (&solution);
+            Benchmark::doNotOptimize (solution.voltages.back());
+        });
+
+        printf ("%s: %zu unknowns, %zu nonzeros in L\n\n", name.c_str(),
+                solver.unknownCount(), solver.factorNonZeros());
+    }
+}
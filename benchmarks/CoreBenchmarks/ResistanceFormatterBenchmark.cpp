@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#include <math.h>
+#include <vector>
+#include <string>
+
+#include "Workload.h"
+#include "Benchmark.h"
+#include "ResistanceFormatter.h"
+
+using namespace ResistorCore;
+
+/**
+ * Copy of the original formatting code (pow() exponent search and
+ * std::string concatenation), kept here as a baseline.
+ */
+static std::string legacyFormat (const double resistance) {
+    int power = 9;
+    while (resistance < pow (10, power))
+        power -= 3;
+
+    std::string number;
+    long long cents = llround (resistance / pow (10, power) * 100);
+    if (cents % 100 == 0)
+        number = std::to_string (cents / 100);
+    else {
+        std::string decimals = std::to_string (cents % 100);
+        if (decimals.length() < 2)
+            decimals.insert (0, "0");
+
+        number = std::to_string (cents / 100) + "." + decimals;
+    }
+
+    std::string prefix;
+    switch (power) {
+    case -9: prefix = "n"; break;
+    case -6: prefix = "µ"; break;
+    case -3: prefix = "m"; break;
+    case 0:  prefix = ""; break;
+    case 3:  prefix = "k"; break;
+    case 6:  prefix = "M"; break;
+    case 9:  prefix = "G"; break;
+    default: prefix = "E" + std::to_string (power); break;
+    }
+
+    return number + " " + prefix + "Ω";
+}
+
+/**
+ * Compares the original string based formatter with the buffer based
+ * UTF-8, UTF-16 and batch formatters.
+ */
+void benchmarkResistanceFormatter() {
+    // Generate realistic resistance values (mostly E-series)
+    const size_t count = 1 << 16;
+    const std::vector<double> values = Workload::resistances (count);
+
+    std::vector<char> output (count * RESISTANCE_STR_CAPACITY);
+
+    Benchmark::run ("Formatter/legacy", count, [&]() {
+        size_t length = 0;
+        for (size_t i = 0; i < count; ++i)
+            length += legacyFormat (values [i]).length();
+
+        Benchmark::doNotOptimize (length);
+    });
+
+    Benchmark::run ("Formatter/utf8", count, [&]() {
+        char buffer [RESISTANCE_STR_CAPACITY];
+        size_t length = 0;
+        for (size_t i = 0; i < count; ++i)
+            length += formatResistanceUtf8 (values [i], buffer, sizeof (buffer));
+
+        Benchmark::doNotOptimize (length);
+    });
+
+    Benchmark::run ("Formatter/utf16", count, [&]() {
+        char16_t buffer [RESISTANCE_STR_CAPACITY];
+        size_t length = 0;
+        for (size_t i = 0; i < count; ++i)
+            length += formatResistanceUtf16 (values [i], buffer, RESISTANCE_STR_CAPACITY);
+
+        Benchmark::doNotOptimize (length);
+    });
+
+    Benchmark::run ("Formatter/batch", count, [&]() {
+        size_t written = 0;
+        formatResistances (values.data(), count, output.data(), output.size(), '\n', &written);
+        Benchmark::doNotOptimize (written);
+    });
+}
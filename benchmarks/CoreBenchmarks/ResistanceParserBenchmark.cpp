@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Workload.h"
+#include "Benchmark.h"
+#include "ResistanceParser.h"
+#include "ResistanceFormatter.h"
+
+using namespace ResistorCore;
+
+/**
+ * Returns the given @a value written in one of the styles found in BOMs:
+ * RKM ("4k7"), compact SI ("4.7k"), formatted ("4.70 kΩ") and with
+ * tolerance and tempco annotations
+ */
+static std::string writeValue (const double value, const int style) {
+    char text [RESISTANCE_STR_CAPACITY];
+    formatResistanceUtf8 (ExactResistance::fromDouble (value), text, sizeof (text));
+    if (style == 2)
+        return text;
+
+    // Split "4.70 kΩ" into integer part, decimals and prefix
+    const char* point = strchr (text, '.');
+    const char* space = strchr (text, ' ');
+    const std::string integer (text, (point ? point : space) - text);
+    std::string decimals = point ? std::string (point + 1, space - point - 1) : "";
+    while (!decimals.empty() && decimals.back() == '0')
+        decimals.pop_back();
+
+    std::string prefix;
+    if (space [1] != '\xCE')
+        prefix = space [1] == '\xC2' ? "u" : std::string (1, space [1]);
+
+    if (style == 1 || style == 4) {
+        std::string result = integer + (decimals.empty() ? "" : "." + decimals) + prefix;
+        return style == 1 ? result : result + "\xCE\xA9 5% 100ppm/K";
+    }
+
+    const std::string rkm = integer + (prefix.empty() ? "R" : prefix) + decimals;
+    return style == 0 ? rkm : rkm + " \xC2\xB1" "1%";
+}
+
+/**
+ * Measures the parser with single strings of every style, and with a
+ * newline-separated buffer of 10^7 values parsed in chunks
+ */
+void benchmarkResistanceParser() {
+    const size_t distinct = 1 << 16;
+    const std::vector<double> values = Workload::resistances (distinct);
+
+    std::vector<std::string> strings (distinct);
+    for (size_t i = 0; i < distinct; ++i)
+        strings [i] = writeValue (values [i], static_cast<int> (i % 5));
+
+    std::vector<ParsedResistance> results (distinct);
+    Benchmark::run ("ResistanceParser/single (mixed)", distinct, [&]() {
+        for (size_t i = 0; i < distinct; ++i)
+            parseResistance (strings [i].data(), strings [i].size(), &results [i]);
+
+        Benchmark::doNotOptimize (results.back());
+    });
+
+    // Baseline: strtod() and a prefix letter, compact SI strings only
+    std::vector<std::string> compact (distinct);
+    for (size_t i = 0; i < distinct; ++i)
+        compact [i] = writeValue (values [i], 1);
+
+    std::vector<double> doubles (distinct);
+    Benchmark::run ("ResistanceParser/strtod (SI only)", distinct, [&]() {
+        for (size_t i = 0; i < distinct; ++i) {
+            char* end;
+            double value = strtod (compact [i].c_str(), &end);
+            switch (*end) {
+            case 'k': value *= 1e3; break;
+            case 'M': value *= 1e6; break;
+            case 'G': value *= 1e9; break;
+            case 'm': value *= 1e-3; break;
+            default: break;
+            }
+
+            doubles [i] = value;
+        }
+
+        Benchmark::doNotOptimize (doubles.back());
+    });
+
+    Benchmark::run ("ResistanceParser/single (SI only)", distinct, [&]() {
+        for (size_t i = 0; i < distinct; ++i)
+            parseResistance (compact [i].data(), compact [i].size(), &results [i]);
+
+        Benchmark::doNotOptimize (results.back());
+    });
+
+    // Build a buffer with 10^7 lines
+    const size_t count = 10000000;
+    std::string buffer;
+    buffer.reserve (count * 10);
+    for (size_t i = 0; i < count; ++i) {
+        buffer += strings [i % distinct];
+        buffer += '\n';
+    }
+
+    const size_t chunk = 4096;
+    std::vector<ParsedResistance> chunkResults (chunk);
+    Benchmark::run ("ResistanceParser/lines (10^7)", count, [&]() {
+        size_t offset = 0;
+        size_t parsed = 0;
+        while (offset < buffer.size()) {
+            size_t used;
+            parsed += parseResistanceLines (buffer.data() + offset, buffer.size() - offset,
+                                            chunkResults.data(), chunk, &used);
+            offset += used;
+        }
+
+        Benchmark::doNotOptimize (parsed);
+    });
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <vector>
+
+#include "Workload.h"
+#include "Benchmark.h"
+#include "SmdDecoder.h"
+#include "ReverseLookup.h"
+
+using namespace ResistorCore;
+
+/**
+ * Measures the reverse lookup (value to bands and markings) and the
+ * EIA-96 encoder over a typical mix of resistance values.
+ */
+void benchmarkReverseLookup() {
+    typedef std::chrono::steady_clock Clock;
+
+    // Measure the time required to build the table
+    const Clock::time_point start = Clock::now();
+    const ReverseLookup& lookup = ReverseLookup::instance();
+    const std::chrono::duration<double> build = Clock::now() - start;
+    printf ("ReverseLookup: %.3f ms to build, %zu bytes\n",
+            build.count() * 1e3, lookup.memoryUsage());
+
+    const size_t count = 1 << 16;
+    const std::vector<double> values = Workload::resistances (count);
+
+    Benchmark::run ("ReverseLookup/lookup", count, [&]() {
+        size_t found = 0;
+        for (size_t i = 0; i < count; ++i)
+            found += lookup.lookup (values [i]) != NULL;
+
+        Benchmark::doNotOptimize (found);
+    });
+
+    Benchmark::run ("ReverseLookup/bandCode", count, [&]() {
+        ResistorCode code;
+        for (size_t i = 0; i < count; ++i) {
+            lookup.bandCode (values [i], FiveStripResistor,
+                             ToleranceBrown, TempcoBrown, &code);
+            Benchmark::doNotOptimize (code);
+        }
+    });
+
+    Benchmark::run ("ReverseLookup/encodeEia96", count, [&]() {
+        char marking [4];
+        size_t length = 0;
+        for (size_t i = 0; i < count; ++i)
+            length += encodeEia96 (values [i], marking, sizeof (marking));
+
+        Benchmark::doNotOptimize (length);
+    });
+}
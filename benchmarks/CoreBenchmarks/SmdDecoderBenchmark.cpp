@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <vector>
+#include <random>
+#include <string>
+
+#include "Benchmark.h"
+#include "SmdLookup.h"
+#include "SmdDecoder.h"
+
+using namespace ResistorCore;
+
+/**
+ * Generates a random SMD code that uses the given @a scheme
+ */
+static std::string randomSmdCode (std::mt19937& generator, const SmdScheme scheme) {
+    const char* eia96Letters = "ZYRXSABHCDEF";
+
+    std::string code;
+    switch (scheme) {
+    case SmdThreeDigit:
+        code += static_cast<char> ('1' + generator() % 9);
+        code += static_cast<char> ('0' + generator() % 10);
+        code += static_cast<char> ('0' + generator() % 7);
+        break;
+    case SmdFourDigit:
+        code += static_cast<char> ('1' + generator() % 9);
+        code += static_cast<char> ('0' + generator() % 10);
+        code += static_cast<char> ('0' + generator() % 10);
+        code += static_cast<char> ('0' + generator() % 7);
+        break;
+    case SmdRadix:
+        code += static_cast<char> ('0' + generator() % 10);
+        code += 'R';
+        code += static_cast<char> ('0' + generator() % 10);
+        if (generator() % 2)
+            code += static_cast<char> ('0' + generator() % 10);
+        break;
+    case SmdEia96: {
+        const int index = 1 + generator() % 96;
+        code += static_cast<char> ('0' + index / 10);
+        code += static_cast<char> ('0' + index % 10);
+        code += eia96Letters [generator() % 12];
+        break;
+    }
+    case SmdJumper:
+        code = "000";
+        break;
+    default:
+        code = "X1Y";
+        break;
+    }
+
+    return code;
+}
+
+/**
+ * Measures the SMD decoder for every scheme, the batch decoders over
+ * newline-separated and fixed-width buffers and the precomputed lookup.
+ */
+void benchmarkSmdDecoder() {
+    const size_t count = 1 << 20;
+    std::mt19937 generator (42);
+
+    const SmdScheme schemes [] = {
+        SmdThreeDigit, SmdFourDigit, SmdRadix, SmdEia96, SmdJumper, SmdInvalid
+    };
+    const char* names [] = {
+        "3-digit", "4-digit", "radix", "eia-96", "jumper", "invalid"
+    };
+
+    // Decode each scheme individually
+    std::vector<SmdResult> results (count);
+    for (size_t s = 0; s < sizeof (schemes) / sizeof (schemes [0]); ++s) {
+        std::vector<char> fixed (count * 4, '\0');
+        for (size_t i = 0; i < count; ++i) {
+            const std::string code = randomSmdCode (generator, schemes [s]);
+            code.copy (&fixed [i * 4], code.length());
+        }
+
+        std::string name = std::string ("decodeSmd/") + names [s];
+        Benchmark::run (name.c_str(), count, [&]() {
+            for (size_t i = 0; i < count; ++i) {
+                const char* code = &fixed [i * 4];
+                const size_t length = code [3] ? 4 : 3;
+                results [i] = decodeSmd (code, length);
+            }
+
+            Benchmark::doNotOptimize (results [count - 1]);
+        });
+    }
+
+    // Build mixed buffers
+    std::string lines;
+    std::vector<char> fixed (count * 4, '\0');
+    for (size_t i = 0; i < count; ++i) {
+        const SmdScheme scheme = schemes [generator() % 4];
+        const std::string code = randomSmdCode (generator, scheme);
+        code.copy (&fixed [i * 4], code.length());
+        lines += code;
+        lines += '\n';
+    }
+
+    // Decode mixed buffers
+    Benchmark::run ("decodeSmdLines/mixed", count, [&]() {
+        decodeSmdLines (lines.data(), lines.length(), results.data(), count);
+        Benchmark::doNotOptimize (results [count - 1]);
+    });
+    Benchmark::run ("decodeSmdFixed/mixed", count, [&]() {
+        decodeSmdFixed (fixed.data(), count, 4, results.data());
+        Benchmark::doNotOptimize (results [count - 1]);
+    });
+
+    // Resolve the same codes through the lookup structure
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point start = Clock::now();
+    const SmdLookup& lookup = SmdLookup::instance();
+    const std::chrono::duration<double> build = Clock::now() - start;
+    printf ("SmdLookup: %.3f ms to build, %zu bytes (%zu dense + %zu hashed entries)\n",
+            build.count() * 1e3, lookup.memoryUsage(),
+            lookup.denseEntries(), lookup.hashedEntries());
+
+    Benchmark::run ("SmdLookup/mixed", count, [&]() {
+        for (size_t i = 0; i < count; ++i) {
+            const char* code = &fixed [i * 4];
+            const size_t length = code [3] ? 4 : 3;
+            results [i] = lookup.lookup (code, length);
+        }
+
+        Benchmark::doNotOptimize (results [count - 1]);
+    });
+    Benchmark::run ("decodeSmd/mixed", count, [&]() {
+        for (size_t i = 0; i < count; ++i) {
+            const char* code = &fixed [i * 4];
+            const size_t length = code [3] ? 4 : 3;
+            results [i] = decodeSmd (code, length);
+        }
+
+        Benchmark::doNotOptimize (results [count - 1]);
+    });
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <vector>
+#include <random>
+
+#include "Benchmark.h"
+#include "Thermal.h"
+#include "BatchExecutor.h"
+
+using namespace ResistorCore;
+
+/**
+ * Evaluates R(T) curves of random NTC thermistors point by point and
+ * with the array sweep (single and multi-threaded), and measures the
+ * fitting of Steinhart-Hart coefficients from measured points
+ */
+void benchmarkThermal() {
+    const size_t modelCount = 1 << 12;
+    const size_t steps = 256;
+
+    // Generate random thermistors
+    std::mt19937 generator (42);
+    std::uniform_real_distribution<double> nominal (1e3, 100e3);
+    std::uniform_real_distribution<double> beta (3000, 4500);
+    std::vector<ThermalModel> models (modelCount);
+    for (size_t i = 0; i < modelCount; ++i)
+        models [i] = ThermalModel::beta (nominal (generator), beta (generator));
+
+    std::vector<double> temperatures (steps);
+    std::vector<double> resistances (modelCount * steps);
+    temperatureSteps (-40, 125, steps, temperatures.data());
+
+    Benchmark::run ("Thermal/Beta sweep (point by point)", modelCount * steps, [&]() {
+        for (size_t m = 0; m < modelCount; ++m)
+            for (size_t i = 0; i < steps; ++i)
+                resistances [m * steps + i] = models [m].resistance (temperatures [i]);
+
+        Benchmark::doNotOptimize (resistances.back());
+    });
+
+    Benchmark::run ("Thermal/Beta sweep (arrays)", modelCount * steps, [&]() {
+        sweepBatch (models.data(), modelCount, temperatures.data(), steps, resistances.data());
+        Benchmark::doNotOptimize (resistances.back());
+    });
+
+    BatchExecutor executor;
+    Benchmark::run ("Thermal/Beta sweep (arrays, threaded)", modelCount * steps, [&]() {
+        sweepBatch (models.data(), modelCount, temperatures.data(), steps,
+                    resistances.data(), &executor);
+        Benchmark::doNotOptimize (resistances.back());
+    });
+
+    // Fit Steinhart-Hart coefficients to 16 points of each thermistor
+    const size_t pointCount = 16;
+    std::vector<ThermalPoint> points (modelCount * pointCount);
+    for (size_t m = 0; m < modelCount; ++m) {
+        for (size_t i = 0; i < pointCount; ++i) {
+            ThermalPoint& point = points [m * pointCount + i];
+            point.temperature = -40 + 10.0 * static_cast<double> (i);
+            point.resistance = models [m].resistance (point.temperature);
+        }
+    }
+
+    std::vector<ThermalModel> fitted (modelCount);
+    Benchmark::run ("Thermal/Steinhart-Hart fit (16 points)", modelCount, [&]() {
+        for (size_t m = 0; m < modelCount; ++m)
+            ThermalModel::fitSteinhartHart (&points [m * pointCount], pointCount, &fitted [m]);
+
+        Benchmark::doNotOptimize (fitted.back());
+    });
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <vector>
+#include <random>
+
+#include "Benchmark.h"
+#include "WorstCase.h"
+
+using namespace ResistorCore;
+
+/**
+ * Compares the gradient of an 8-part parallel network obtained with dual
+ * numbers against forward finite differences (N + 1 evaluations), and
+ * measures the interval bounds of the same network
+ */
+void benchmarkWorstCase() {
+    const size_t parts = MonteCarloEngine::MAX_PARTS;
+    const size_t count = 1 << 14;
+
+    // Generate random networks
+    std::mt19937 generator (42);
+    std::uniform_real_distribution<double> value (10, 100e3);
+    std::vector<double> values (count * parts);
+    for (size_t i = 0; i < values.size(); ++i)
+        values [i] = value (generator);
+
+    std::vector<double> gradients (count * parts);
+    Benchmark::run ("WorstCase/Gradient (dual numbers)", count, [&]() {
+        for (size_t n = 0; n < count; ++n) {
+            Dual<parts> duals [parts];
+            for (size_t p = 0; p < parts; ++p)
+                duals [p] = Dual<parts>::variable (values [n * parts + p], p);
+
+            const Dual<parts> output = networkOutput (ModelParallel, duals, parts);
+            for (size_t p = 0; p < parts; ++p)
+                gradients [n * parts + p] = output.derivative [p];
+        }
+
+        Benchmark::doNotOptimize (gradients.back());
+    });
+
+    Benchmark::run ("WorstCase/Gradient (finite differences)", count, [&]() {
+        for (size_t n = 0; n < count; ++n) {
+            double x [parts];
+            for (size_t p = 0; p < parts; ++p)
+                x [p] = values [n * parts + p];
+
+            const double y = networkOutput (ModelParallel, x, parts);
+            for (size_t p = 0; p < parts; ++p) {
+                const double h = x [p] * 1e-7;
+                x [p] += h;
+                gradients [n * parts + p] = (networkOutput (ModelParallel, x, parts) - y) / h;
+                x [p] = values [n * parts + p];
+            }
+        }
+
+        Benchmark::doNotOptimize (gradients.back());
+    });
+
+    std::vector<Interval> bounds (count);
+    Benchmark::run ("WorstCase/Interval bounds", count, [&]() {
+        for (size_t n = 0; n < count; ++n) {
+            Interval intervals [parts];
+            for (size_t p = 0; p < parts; ++p)
+                intervals [p] = Interval::fromTolerance (values [n * parts + p], 0.01);
+
+            bounds [n] = networkOutput (ModelParallel, intervals, parts);
+        }
+
+        Benchmark::doNotOptimize (bounds.back());
+    });
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+
+#include "BandBatch.h"
+#include "BandTable.h"
+#include "Benchmark.h"
+
+extern void benchmarkBandBatch();
+extern void benchmarkBandOrder();
+extern void benchmarkBandTable();
+extern void benchmarkBatchExecutor();
+extern void benchmarkESeries();
+extern void benchmarkExactResistance();
+extern void benchmarkExpression();
+extern void benchmarkCombinationSolver();
+extern void benchmarkDividerSolver();
+extern void benchmarkGainSolver();
+extern void benchmarkMarking();
+extern void benchmarkMonteCarlo();
+extern void benchmarkNetworkSolver();
+extern void benchmarkWorstCase();
+extern void benchmarkSmdDecoder();
+extern void benchmarkThermal();
+extern void benchmarkResistanceFormatter();
+extern void benchmarkResistanceParser();
+extern void benchmarkReverseLookup();
+
+int main (int argc, char** argv) {
+    if (!Benchmark::init (argc, argv))
+        return 1;
+
+    const char* kernel = ResistorCore::batchKernelName (ResistorCore::BatchAuto);
+    Benchmark::setContext ("batch_kernel", kernel);
+    Benchmark::setContext ("band_table", ResistorCore::BandTable::isStatic() ? "static" : "lazy");
+    printf ("Best batch kernel: %s\n\n", kernel);
+
+    benchmarkBandBatch();
+    benchmarkBandTable();
+    benchmarkSmdDecoder();
+    benchmarkMarking();
+    benchmarkBandOrder();
+    benchmarkResistanceFormatter();
+    benchmarkResistanceParser();
+    benchmarkReverseLookup();
+    benchmarkESeries();
+    benchmarkExactResistance();
+    benchmarkCombinationSolver();
+    benchmarkDividerSolver();
+    benchmarkGainSolver();
+    benchmarkMonteCarlo();
+    benchmarkWorstCase();
+    benchmarkNetworkSolver();
+    benchmarkThermal();
+    benchmarkExpression();
+    benchmarkBatchExecutor();
+    return Benchmark::finish();
+}
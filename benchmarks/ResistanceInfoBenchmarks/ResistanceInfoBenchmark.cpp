@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <vector>
+#include <memory>
+
+#include "Workload.h"
+#include "Benchmark.h"
+#include "ResistanceInfo.h"
+
+using namespace ResistorCore;
+
+/**
+ * Measures the construction of ResistanceInfo objects, which includes
+ * the initial band and SMD calculations.
+ */
+static void benchmarkConstruction() {
+    const size_t count = 1 << 12;
+
+    Benchmark::run ("ResistanceInfo/construct", count, [&]() {
+        for (size_t i = 0; i < count; ++i) {
+            ResistanceInfo info;
+            Benchmark::doNotOptimize (info);
+        }
+    });
+}
+
+/**
+ * Measures calculateResistance() by loading band codes generated by the
+ * workload generator, each load triggers exactly one recalculation.
+ */
+static void benchmarkCalculateResistance() {
+    const size_t count = 1 << 16;
+    const std::vector<BandCode> codes = Workload::bandCodes (count);
+
+    ResistanceInfo info;
+    Benchmark::run ("ResistanceInfo/calculateResistance", count, [&]() {
+        for (size_t i = 0; i < count; ++i)
+            info.setResistorCode (ResistorCode (codes [i]));
+
+        Benchmark::doNotOptimize (info);
+    });
+}
+
+/**
+ * Measures calculateSmdResistance() for each SMD scheme
+ */
+static void benchmarkCalculateSmdResistance() {
+    const size_t count = 1 << 16;
+
+    const SmdScheme schemes [] = {
+        SmdThreeDigit, SmdFourDigit, SmdRadix, SmdEia96, SmdJumper, SmdInvalid
+    };
+    const char* names [] = {
+        "3-digit", "4-digit", "radix", "eia-96", "jumper", "invalid"
+    };
+
+    ResistanceInfo info;
+    for (size_t s = 0; s < sizeof (schemes) / sizeof (schemes [0]); ++s) {
+        QStringList codes;
+        codes.reserve (count);
+        for (const std::string& code : Workload::smdCodes (schemes [s], count))
+            codes.append (QString::fromStdString (code));
+
+        // Alternate with an empty code so that every call recalculates
+        const QString empty;
+        const std::string name = std::string ("ResistanceInfo/calculateSmdResistance/") + names [s];
+        Benchmark::run (name.c_str(), count, [&]() {
+            for (size_t i = 0; i < count; ++i) {
+                info.setSmdResistanceCode (codes.at (static_cast<int> (i)));
+                info.setSmdResistanceCode (empty);
+            }
+
+            Benchmark::doNotOptimize (info);
+        });
+    }
+}
+
+/**
+ * Measures the string and color getters that QML bindings evaluate after
+ * each recalculation, using objects loaded with workload values.
+ */
+static void benchmarkGetters() {
+    const size_t count = 1 << 10;
+    const std::vector<BandCode> codes = Workload::bandCodes (count);
+
+    std::vector<std::unique_ptr<ResistanceInfo>> objects (count);
+    for (size_t i = 0; i < count; ++i) {
+        objects [i].reset (new ResistanceInfo);
+        objects [i]->setResistorCode (ResistorCode (codes [i]));
+    }
+
+    Benchmark::run ("ResistanceInfo/resistanceStr", count, [&]() {
+        for (size_t i = 0; i < count; ++i) {
+            const QString text = objects [i]->resistanceStr();
+            Benchmark::doNotOptimize (text);
+        }
+    });
+    Benchmark::run ("ResistanceInfo/getResistanceStr", count, [&]() {
+        for (size_t i = 0; i < count; ++i) {
+            const QString min = objects [i]->minResistanceStr();
+            const QString max = objects [i]->maxResistanceStr();
+            Benchmark::doNotOptimize (min);
+            Benchmark::doNotOptimize (max);
+        }
+    });
+    Benchmark::run ("ResistanceInfo/resistanceStripColors", count, [&]() {
+        for (size_t i = 0; i < count; ++i) {
+            const QStringList colors = objects [i]->resistanceStripColors();
+            Benchmark::doNotOptimize (colors);
+        }
+    });
+    Benchmark::run ("ResistanceInfo/names", count, [&]() {
+        for (size_t i = 0; i < count; ++i) {
+            const ResistanceInfo& info = *objects [i];
+            const QStringList lists [5] = {
+                info.digitNames(),
+                info.firstDigitNames(),
+                info.tempcoNames(),
+                info.toleranceNames(),
+                info.multiplierNames()
+            };
+
+            Benchmark::doNotOptimize (lists);
+        }
+    });
+    Benchmark::run ("ResistanceInfo/colors", count, [&]() {
+        for (size_t i = 0; i < count; ++i) {
+            const ResistanceInfo& info = *objects [i];
+            const QStringList lists [4] = {
+                info.digitColors(),
+                info.tempcoColors(),
+                info.toleranceColors(),
+                info.multiplierColors()
+            };
+
+            Benchmark::doNotOptimize (lists);
+        }
+    });
+}
+
+/**
+ * Runs every ResistanceInfo benchmark
+ */
+void benchmarkResistanceInfo() {
+    benchmarkConstruction();
+    benchmarkCalculateResistance();
+    benchmarkCalculateSmdResistance();
+    benchmarkGetters();
+}
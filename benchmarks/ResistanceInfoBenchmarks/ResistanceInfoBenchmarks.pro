@@ -0,0 +1,59 @@
+#
+# Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+
+#-------------------------------------------------------------------------------
+# Project configuration
+#-------------------------------------------------------------------------------
+
+TEMPLATE = app
+TARGET = ResistanceInfoBenchmarks
+
+CONFIG += console
+CONFIG += warn_on
+CONFIG += release
+CONFIG -= app_bundle
+
+QT += core
+QT += qml
+
+#-------------------------------------------------------------------------------
+# Make options
+#-------------------------------------------------------------------------------
+
+MOC_DIR = moc
+OBJECTS_DIR = obj
+
+#-------------------------------------------------------------------------------
+# Import source code
+#-------------------------------------------------------------------------------
+
+include ($$PWD/../Common/Common.pri)
+
+INCLUDEPATH += $$PWD/../../src
+
+HEADERS += \
+    $$PWD/../../src/ResistanceInfo.h
+
+SOURCES += \
+    $$PWD/main.cpp \
+    $$PWD/ResistanceInfoBenchmark.cpp \
+    $$PWD/../../src/ResistanceInfo.cpp
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "SmdDecoder.h"
+#include "BatchDecoder.h"
+
+#include <vector>
+#include <algorithm>
+#include <string.h>
+#include <stdio.h>
+
+/**
+ * Number of lines that are read, decoded and written in each step of
+ * a job, which bounds the memory used by jobs over very large files
+ */
+static const size_t BLOCK_LINES = 1 << 20;
+
+/**
+ * A single line of the input file
+ */
+struct Line {
+    const char* data;
+    size_t length;
+};
+
+/**
+ * Appends the given @a field to the CSV @a text. Fields with commas,
+ * quotes or carriage returns are quoted and their quotes are doubled
+ * (RFC 4180), the rest are copied as they are.
+ */
+static void appendCsvField (std::string& text, const char* field, const size_t length) {
+    bool quoted = false;
+    for (size_t i = 0; i < length && !quoted; ++i)
+        quoted = field [i] == ',' || field [i] == '"' || field [i] == '\r';
+
+    if (!quoted) {
+        text.append (field, length);
+        return;
+    }
+
+    text.push_back ('"');
+    for (size_t i = 0; i < length; ++i) {
+        if (field [i] == '"')
+            text.push_back ('"');
+
+        text.push_back (field [i]);
+    }
+
+    text.push_back ('"');
+}
+
+BatchDecoder::BatchDecoder (QObject* parent) : QObject (parent),
+    m_running (false),
+    m_progress (0),
+    m_threadCount (0),
+    m_grainSize (ResistorCore::BatchExecutor::DEFAULT_GRAIN_SIZE),
+    m_cancelled (false)
+{
+    // The job thread emits these signals, handle them in this thread
+    connect (this, SIGNAL (jobProgress (qreal)),
+             this,   SLOT (onJobProgress (qreal)),
+             Qt::QueuedConnection);
+    connect (this, SIGNAL (jobFinished (int, qint64, QString)),
+             this,   SLOT (onJobFinished (int, qint64, QString)),
+             Qt::QueuedConnection);
+}
+
+/**
+ * Cancels the current job (if any) and waits for it to stop
+ */
+BatchDecoder::~BatchDecoder() {
+    cancel();
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+/**
+ * @returns @c true while a job is being processed
+ */
+bool BatchDecoder::running() const {
+    return m_running;
+}
+
+/**
+ * @returns The progress of the current job, from 0 to 1
+ */
+qreal BatchDecoder::progress() const {
+    return m_progress;
+}
+
+/**
+ * @returns The number of threads used by the following jobs, 0 means
+ *          one thread per CPU core
+ */
+int BatchDecoder::threadCount() const {
+    return m_threadCount;
+}
+
+/**
+ * @returns The number of codes in each chunk of work
+ */
+int BatchDecoder::grainSize() const {
+    return m_grainSize;
+}
+
+/**
+ * Cancels the current job, the @c cancelled() signal is emitted once the
+ * job has stopped
+ */
+void BatchDecoder::cancel() {
+    m_cancelled = true;
+    if (m_executor)
+        m_executor->cancel();
+}
+
+/**
+ * Changes the number of @a threads used by the following jobs
+ */
+void BatchDecoder::setThreadCount (const int threads) {
+    Q_ASSERT_X (threads >= 0, __func__, "Invalid argument");
+
+    if (m_threadCount != threads) {
+        m_threadCount = threads;
+        emit threadCountChanged();
+    }
+}
+
+/**
+ * Changes the number of codes in each chunk of the following jobs
+ */
+void BatchDecoder::setGrainSize (const int grainSize) {
+    Q_ASSERT_X (grainSize > 0, __func__, "Invalid argument");
+
+    if (m_grainSize != grainSize) {
+        m_grainSize = grainSize;
+        emit grainSizeChanged();
+    }
+}
+
+/**
+ * Starts decoding the @a input file, which contains one SMD code per
+ * line. Each code is written to the @a output file as a CSV row with
+ * its resistance (-1 for invalid codes) and tolerance, codes are quoted
+ * when they contain commas or quotes.
+ *
+ * Returns @c false if another job is still running.
+ */
+bool BatchDecoder::decodeSmdFile (const QString& input, const QString& output) {
+    if (m_running)
+        return false;
+
+    if (m_thread.joinable())
+        m_thread.join();
+
+    m_output = output;
+    m_cancelled = false;
+    m_executor.reset (new ResistorCore::BatchExecutor (
+                          static_cast<size_t> (m_threadCount),
+                          static_cast<size_t> (m_grainSize)));
+
+    m_running = true;
+    m_progress = 0;
+    emit runningChanged();
+    emit progressChanged();
+
+    m_thread = std::thread (&BatchDecoder::runSmdJob, this, input, output);
+    return true;
+}
+
+/**
+ * Updates the progress of the job (called through a queued connection)
+ */
+void BatchDecoder::onJobProgress (const qreal progress) {
+    if (m_running && m_progress != progress) {
+        m_progress = progress;
+        emit progressChanged();
+    }
+}
+
+/**
+ * Releases the job resources and reports the result of the job (called
+ * through a queued connection)
+ */
+void BatchDecoder::onJobFinished (const int status, const qint64 codes, const QString& error) {
+    if (m_thread.joinable())
+        m_thread.join();
+
+    m_executor.reset();
+    m_running = false;
+    emit runningChanged();
+
+    switch (status) {
+    case JobFinished:
+        emit finished (m_output, codes);
+        break;
+    case JobCancelled:
+        emit cancelled();
+        break;
+    default:
+        emit failed (error);
+        break;
+    }
+}
+
+/**
+ * Decodes the @a input file block by block and writes the results to the
+ * @a output file. Runs in the job thread, so it only communicates with
+ * the rest of the object through signals.
+ */
+void BatchDecoder::runSmdJob (const QString& input, const QString& output) {
+    // Open files
+    QFile in (input);
+    QFile out (output);
+    if (!in.open (QFile::ReadOnly)) {
+        emit jobFinished (JobFailed, 0, tr ("Cannot open %1").arg (input));
+        return;
+    }
+    if (!out.open (QFile::WriteOnly | QFile::Truncate)) {
+        emit jobFinished (JobFailed, 0, tr ("Cannot write %1").arg (output));
+        return;
+    }
+
+    // Map the input file to memory, read it if mapping is not supported
+    QByteArray contents;
+    const qint64 fileSize = in.size();
+    const char* data = reinterpret_cast<const char*> (fileSize > 0 ? in.map (0, fileSize) : NULL);
+    if (!data && fileSize > 0) {
+        contents = in.readAll();
+        data = contents.constData();
+    }
+
+    ResistorCore::BatchExecutor& executor = *m_executor;
+    const size_t grain = executor.grainSize();
+    const size_t size = static_cast<size_t> (fileSize);
+
+    std::vector<Line> lines;
+    std::vector<std::string> chunks;
+    lines.reserve (BLOCK_LINES);
+
+    qint64 codes = 0;
+    size_t position = 0;
+    out.write ("code,resistance,tolerance\n");
+    while (position < size && !m_cancelled) {
+        // Split the next block into lines
+        lines.clear();
+        while (position < size && lines.size() < BLOCK_LINES) {
+            const char* start = data + position;
+            const char* newline = static_cast<const char*> (memchr (start, '\n', size - position));
+            size_t length = newline ? static_cast<size_t> (newline - start) : size - position;
+            position += length + 1;
+
+            if (length > 0 && start [length - 1] == '\r')
+                --length;
+
+            const Line line = { start, length };
+            lines.push_back (line);
+        }
+
+        // Decode and format the lines of each chunk in parallel
+        chunks.resize ((lines.size() + grain - 1) / grain);
+        executor.run (lines.size(), [&](const size_t begin, const size_t end) {
+            std::string& text = chunks [begin / grain];
+            text.clear();
+
+            char number [32];
+            for (size_t i = begin; i < end; ++i) {
+                const ResistorCore::SmdResult result =
+                        ResistorCore::decodeSmd (lines [i].data, lines [i].length);
+                const int length = snprintf (number, sizeof (number), ",%.10g,%d\n",
+                                             result.resistance, result.tolerance);
+
+                appendCsvField (text, lines [i].data, lines [i].length);
+                text.append (number, static_cast<size_t> (length));
+            }
+        });
+
+        if (m_cancelled)
+            break;
+
+        // Write the chunks in order
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            if (out.write (chunks [i].data(), static_cast<qint64> (chunks [i].size())) < 0) {
+                emit jobFinished (JobFailed, codes, out.errorString());
+                return;
+            }
+        }
+
+        codes += static_cast<qint64> (lines.size());
+        emit jobProgress (static_cast<qreal> (std::min (position, size)) / size);
+    }
+
+    emit jobFinished (m_cancelled ? JobCancelled : JobFinished, codes, QString());
+}
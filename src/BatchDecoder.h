@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef BATCH_DECODER_H
+#define BATCH_DECODER_H
+
+#include <QtQml>
+#include <QObject>
+#include <QString>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "BatchExecutor.h"
+
+/**
+ * Decodes large files of SMD codes in the background, using every CPU
+ * core through the work-stealing executor of the core library.
+ *
+ * The job runs outside of the main thread, its progress and result are
+ * delivered to the object (and to QML) through queued signals.
+ */
+class BatchDecoder : public QObject
+{
+    Q_OBJECT
+
+#ifdef QT_QML_LIB
+    Q_PROPERTY (bool running
+                READ running
+                NOTIFY runningChanged)
+    Q_PROPERTY (qreal progress
+                READ progress
+                NOTIFY progressChanged)
+    Q_PROPERTY (int threadCount
+                READ threadCount
+                WRITE setThreadCount
+                NOTIFY threadCountChanged)
+    Q_PROPERTY (int grainSize
+                READ grainSize
+                WRITE setGrainSize
+                NOTIFY grainSizeChanged)
+#endif
+
+signals:
+    void runningChanged();
+    void progressChanged();
+    void threadCountChanged();
+    void grainSizeChanged();
+
+    void cancelled();
+    void failed (const QString& error);
+    void finished (const QString& output, const qint64 codes);
+
+    void jobProgress (const qreal progress);
+    void jobFinished (const int status, const qint64 codes, const QString& error);
+
+public:
+    enum JobStatus {
+        JobFinished  = 0,
+        JobCancelled = 1,
+        JobFailed    = 2
+    };
+
+    BatchDecoder (QObject* parent = 0);
+    ~BatchDecoder();
+
+    static void DeclareQml()
+    {
+#ifdef QT_QML_LIB
+        qmlRegisterType<BatchDecoder> ("ResistanceInfo", 1, 0, "BatchDecoder");
+#endif
+    }
+
+    bool running() const;
+    qreal progress() const;
+    int threadCount() const;
+    int grainSize() const;
+
+public slots:
+    void cancel();
+    void setThreadCount (const int threads);
+    void setGrainSize (const int grainSize);
+    bool decodeSmdFile (const QString& input, const QString& output);
+
+private slots:
+    void onJobProgress (const qreal progress);
+    void onJobFinished (const int status, const qint64 codes, const QString& error);
+
+private:
+    void runSmdJob (const QString& input, const QString& output);
+
+private:
+    bool m_running;
+    qreal m_progress;
+    int m_threadCount;
+    int m_grainSize;
+
+    QString m_output;
+    std::thread m_thread;
+    std::atomic<bool> m_cancelled;
+    std::unique_ptr<ResistorCore::BatchExecutor> m_executor;
+};
+
+#endif
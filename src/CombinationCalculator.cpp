@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "CombinationCalculator.h"
+#include "BatchExecutor.h"
+
+#include <QElapsedTimer>
+
+/**
+ * Value of the series property when a custom inventory is used
+ */
+static const int CUSTOM_INVENTORY = -1;
+
+CombinationCalculator::CombinationCalculator (QObject* parent) : QObject (parent),
+    m_series (ResistorCore::SeriesE24),
+    m_minimumValue (1),
+    m_maximumValue (10e6),
+    m_tolerance (0.001),
+    m_maxParts (3),
+    m_maxResults (10),
+    m_elapsed (0),
+    m_inventory (0),
+    m_search (0),
+    m_searching (false),
+    m_requestPending (false),
+    m_stopping (false)
+{
+    // The worker thread emits this signal, handle it in this thread
+    connect (this, SIGNAL (searchFinished (int, QVariantList, qreal)),
+             this,   SLOT (onSearchFinished (int, QVariantList, qreal)),
+             Qt::QueuedConnection);
+
+    m_thread = std::thread (&CombinationCalculator::workerLoop, this);
+}
+
+/**
+ * Stops the worker thread once it finishes the current search (if any)
+ */
+CombinationCalculator::~CombinationCalculator() {
+    {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        m_stopping = true;
+    }
+
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+/**
+ * @returns The standard series used as inventory, or -1 if a custom
+ *          inventory is used
+ */
+int CombinationCalculator::series() const {
+    return m_series;
+}
+
+/**
+ * @returns The lowest standard value of the inventory
+ */
+qreal CombinationCalculator::minimumValue() const {
+    return m_minimumValue;
+}
+
+/**
+ * @returns The highest standard value of the inventory
+ */
+qreal CombinationCalculator::maximumValue() const {
+    return m_maximumValue;
+}
+
+/**
+ * @returns The largest relative error accepted by the searches
+ */
+qreal CombinationCalculator::tolerance() const {
+    return m_tolerance;
+}
+
+/**
+ * @returns The maximum number of resistors of each network (1 to 4)
+ */
+int CombinationCalculator::maxParts() const {
+    return m_maxParts;
+}
+
+/**
+ * @returns The maximum number of networks returned by each search
+ */
+int CombinationCalculator::maxResults() const {
+    return m_maxResults;
+}
+
+/**
+ * @returns The time spent by the last search (in milliseconds)
+ */
+qreal CombinationCalculator::elapsed() const {
+    return m_elapsed;
+}
+
+/**
+ * @returns @c true while the worker thread runs a search
+ */
+bool CombinationCalculator::searching() const {
+    return m_searching;
+}
+
+/**
+ * @returns The networks found by the last search, each network is a map
+ *          with its "description", "resistance", "error" and "parts"
+ */
+QVariantList CombinationCalculator::results() const {
+    return m_results;
+}
+
+/**
+ * @returns The names of the standard series, in the order used by the
+ *          series property
+ */
+QStringList CombinationCalculator::seriesNames() const {
+    QStringList names;
+    for (int i = 0; i < ResistorCore::SERIES_COUNT; ++i)
+        names.append (ResistorCore::seriesName (static_cast<ResistorCore::ESeries> (i)));
+
+    return names;
+}
+
+/**
+ * Sends a search of the networks that approximate the given @a target
+ * resistance to the worker thread, replacing the pending search (if any)
+ */
+void CombinationCalculator::solve (const qreal target) {
+    Request request;
+    request.search = ++m_search;
+    request.inventory = m_inventory;
+    request.series = m_series;
+    request.minimumValue = m_minimumValue;
+    request.maximumValue = m_maximumValue;
+    request.customInventory = m_customInventory;
+    request.query.target = target;
+    request.query.tolerance = m_tolerance;
+    request.query.maxParts = m_maxParts;
+    request.query.maxResults = static_cast<size_t> (m_maxResults);
+
+    {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        m_request = request;
+        m_requestPending = true;
+    }
+
+    m_wake.notify_one();
+
+    if (!m_searching) {
+        m_searching = true;
+        emit searchingChanged();
+    }
+}
+
+/**
+ * Uses the given list of resistance @a values as inventory
+ */
+void CombinationCalculator::setInventory (const QVariantList& values) {
+    m_customInventory.clear();
+    for (int i = 0; i < values.count(); ++i)
+        m_customInventory.push_back (values.at (i).toDouble());
+
+    m_series = CUSTOM_INVENTORY;
+    ++m_inventory;
+    emit inventoryChanged();
+}
+
+/**
+ * Uses the given standard @a series as inventory
+ */
+void CombinationCalculator::setSeries (const int series) {
+    Q_ASSERT_X (series >= ResistorCore::SeriesE3 && series <= ResistorCore::SeriesE192,
+                __func__, "Invalid argument");
+
+    if (m_series != series) {
+        m_series = series;
+        ++m_inventory;
+        emit inventoryChanged();
+    }
+}
+
+/**
+ * Changes the lowest standard @a value of the inventory
+ */
+void CombinationCalculator::setMinimumValue (const qreal value) {
+    if (m_minimumValue != value) {
+        m_minimumValue = value;
+        ++m_inventory;
+        emit inventoryChanged();
+    }
+}
+
+/**
+ * Changes the highest standard @a value of the inventory
+ */
+void CombinationCalculator::setMaximumValue (const qreal value) {
+    if (m_maximumValue != value) {
+        m_maximumValue = value;
+        ++m_inventory;
+        emit inventoryChanged();
+    }
+}
+
+/**
+ * Changes the largest relative error accepted by the searches
+ */
+void CombinationCalculator::setTolerance (const qreal tolerance) {
+    Q_ASSERT_X (tolerance >= 0, __func__, "Invalid argument");
+
+    if (m_tolerance != tolerance) {
+        m_tolerance = tolerance;
+        emit toleranceChanged();
+    }
+}
+
+/**
+ * Changes the maximum number of resistors of each network
+ */
+void CombinationCalculator::setMaxParts (const int parts) {
+    Q_ASSERT_X (parts >= 1 && parts <= 4, __func__, "Invalid argument");
+
+    if (m_maxParts != parts) {
+        m_maxParts = parts;
+        emit maxPartsChanged();
+    }
+}
+
+/**
+ * Changes the maximum number of networks returned by each search
+ */
+void CombinationCalculator::setMaxResults (const int results) {
+    Q_ASSERT_X (results > 0, __func__, "Invalid argument");
+
+    if (m_maxResults != results) {
+        m_maxResults = results;
+        emit maxResultsChanged();
+    }
+}
+
+/**
+ * Shows the @a results of a search (called through a queued connection),
+ * results of searches that were replaced in the meantime are dropped
+ */
+void CombinationCalculator::onSearchFinished (const int search,
+                                              const QVariantList& results,
+                                              const qreal elapsed) {
+    if (search != m_search)
+        return;
+
+    m_results = results;
+    m_elapsed = elapsed;
+    emit resultsChanged();
+
+    if (m_searching) {
+        m_searching = false;
+        emit searchingChanged();
+    }
+}
+
+/**
+ * Runs the searches sent by @c solve() until the object is destroyed.
+ * Only the latest request is kept, so searches that were replaced
+ * before the worker picked them up are never started.
+ */
+void CombinationCalculator::workerLoop() {
+    ResistorCore::BatchExecutor executor;
+    ResistorCore::CombinationSolver solver (&executor);
+    int inventory = -1;
+
+    for (;;) {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock (m_mutex);
+            m_wake.wait (lock, [this]() { return m_requestPending || m_stopping; });
+            if (m_stopping)
+                return;
+
+            request = m_request;
+            m_requestPending = false;
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+
+        // Rebuild the inventory if it changed since the last search
+        if (request.inventory != inventory) {
+            inventory = request.inventory;
+            if (request.series == CUSTOM_INVENTORY)
+                solver.setInventory (request.customInventory.data(),
+                                     request.customInventory.size());
+            else
+                solver.setSeries (static_cast<ResistorCore::ESeries> (request.series),
+                                  request.minimumValue, request.maximumValue);
+        }
+
+        const std::vector<ResistorCore::Network> networks = solver.solve (request.query);
+
+        QVariantList results;
+        for (size_t i = 0; i < networks.size(); ++i) {
+            const ResistorCore::Network& network = networks [i];
+
+            QVariantMap map;
+            map.insert ("description", QString::fromStdString (
+                            ResistorCore::CombinationSolver::describe (network)));
+            map.insert ("resistance", network.resistance);
+            map.insert ("error", network.error);
+            map.insert ("parts", network.parts);
+            results.append (map);
+        }
+
+        emit searchFinished (request.search, results, timer.nsecsElapsed() / 1e6);
+    }
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef COMBINATION_CALCULATOR_H
+#define COMBINATION_CALCULATOR_H
+
+#include <QtQml>
+#include <QObject>
+#include <QVariantList>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+
+#include "CombinationSolver.h"
+
+/**
+ * QML front-end of the series/parallel combination solver.
+ *
+ * Searches run in a worker thread that is owned by the object, large
+ * inventories take up to a few million pairs per search. Only the latest
+ * search is kept, and the results of replaced searches are dropped.
+ *
+ * The inventory (a standard series between two values, or a custom list
+ * of values) is rebuilt by the worker on the next search after it
+ * changes, so changing several properties in a row only builds it once.
+ */
+class CombinationCalculator : public QObject
+{
+    Q_OBJECT
+
+#ifdef QT_QML_LIB
+    Q_PROPERTY (int series
+                READ series
+                WRITE setSeries
+                NOTIFY inventoryChanged)
+    Q_PROPERTY (qreal minimumValue
+                READ minimumValue
+                WRITE setMinimumValue
+                NOTIFY inventoryChanged)
+    Q_PROPERTY (qreal maximumValue
+                READ maximumValue
+                WRITE setMaximumValue
+                NOTIFY inventoryChanged)
+    Q_PROPERTY (qreal tolerance
+                READ tolerance
+                WRITE setTolerance
+                NOTIFY toleranceChanged)
+    Q_PROPERTY (int maxParts
+                READ maxParts
+                WRITE setMaxParts
+                NOTIFY maxPartsChanged)
+    Q_PROPERTY (int maxResults
+                READ maxResults
+                WRITE setMaxResults
+                NOTIFY maxResultsChanged)
+    Q_PROPERTY (QVariantList results
+                READ results
+                NOTIFY resultsChanged)
+    Q_PROPERTY (qreal elapsed
+                READ elapsed
+                NOTIFY resultsChanged)
+    Q_PROPERTY (bool searching
+                READ searching
+                NOTIFY searchingChanged)
+    Q_PROPERTY (QStringList seriesNames
+                READ seriesNames
+                CONSTANT)
+#endif
+
+signals:
+    void resultsChanged();
+    void inventoryChanged();
+    void toleranceChanged();
+    void maxPartsChanged();
+    void maxResultsChanged();
+    void searchingChanged();
+
+    void searchFinished (const int search, const QVariantList& results,
+                         const qreal elapsed);
+
+public:
+    CombinationCalculator (QObject* parent = 0);
+    ~CombinationCalculator();
+
+    static void DeclareQml()
+    {
+#ifdef QT_QML_LIB
+        qmlRegisterType<CombinationCalculator> ("ResistanceInfo", 1, 0, "CombinationSolver");
+#endif
+    }
+
+    int series() const;
+    qreal minimumValue() const;
+    qreal maximumValue() const;
+    qreal tolerance() const;
+    int maxParts() const;
+    int maxResults() const;
+    qreal elapsed() const;
+    bool searching() const;
+    QVariantList results() const;
+    QStringList seriesNames() const;
+
+public slots:
+    void solve (const qreal target);
+    void setInventory (const QVariantList& values);
+    void setSeries (const int series);
+    void setMinimumValue (const qreal value);
+    void setMaximumValue (const qreal value);
+    void setTolerance (const qreal tolerance);
+    void setMaxParts (const int parts);
+    void setMaxResults (const int results);
+
+private slots:
+    void onSearchFinished (const int search, const QVariantList& results,
+                           const qreal elapsed);
+
+private:
+    struct Request {
+        int search;
+        int inventory;
+        int series;
+        double minimumValue;
+        double maximumValue;
+        std::vector<double> customInventory;
+        ResistorCore::CombinationQuery query;
+    };
+
+    void workerLoop();
+
+private:
+    int m_series;
+    qreal m_minimumValue;
+    qreal m_maximumValue;
+    qreal m_tolerance;
+    int m_maxParts;
+    int m_maxResults;
+    qreal m_elapsed;
+    int m_inventory;
+
+    int m_search;
+    bool m_searching;
+    QVariantList m_results;
+    std::vector<double> m_customInventory;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    Request m_request;
+    bool m_requestPending;
+    bool m_stopping;
+};
+
+#endif
@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "BandBatch.h"
+
+#include <string.h>
+#include <assert.h>
+
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+    #define BATCH_X86_KERNELS
+    #define BATCH_TARGET(isa) __attribute__ ((target (isa)))
+    #include <immintrin.h>
+#elif defined (_MSC_VER) && (defined (_M_X64) || defined (_M_IX86))
+    #define BATCH_X86_KERNELS
+    #define BATCH_TARGET(isa)
+    #include <intrin.h>
+    #include <immintrin.h>
+#endif
+
+using namespace ResistorCore;
+
+/**
+ * Multiplier values indexed by the @c Multiplier enum. The table is padded
+ * to 16 entries so that masked indices can never read outside of it, the
+ * padding decodes to a 0 ohm resistance.
+ *
+ * Gold and silver divide by 10 and 100 (like @c decodeBands() does), so
+ * every resistance is the double that is nearest to the exact value.
+ */
+static const double MULTIPLIER_VALUES [16] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1, 1,
+    0, 0, 0, 0
+};
+static const double MULTIPLIER_DIVISORS [16] = {
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1e1, 1e2,
+    1, 1, 1, 1
+};
+
+/**
+ * Tolerance values indexed by the @c Tolerance enum, calculated with the
+ * same expressions as @c toleranceValue() to obtain identical results.
+ */
+static const double TOLERANCE_VALUES [8] = {
+    1 / 100.0, 2 / 100.0, 0.5 / 100.0, 0.25 / 100.0,
+    0.1 / 100.0, 0.05 / 100.0, 5 / 100.0, 10 / 100.0
+};
+
+/**
+ * Decodes the resistors in the [@a begin, @a end) range without using
+ * any vector instructions.
+ */
+static void decodeScalar (const ResistorType type,
+                          const BandArrays& bands,
+                          const size_t begin,
+                          const size_t end,
+                          double* resistance,
+                          double* minResistance,
+                          double* maxResistance) {
+    for (size_t i = begin; i < end; ++i) {
+        int base = bands.digitA [i] * 10 + bands.digitB [i];
+        if (type != FourStripResistor)
+            base = base * 10 + bands.digitC [i];
+
+        const double tolerance = TOLERANCE_VALUES [bands.tolerance [i] & 7];
+        const double value = base * MULTIPLIER_VALUES [bands.multiplier [i] & 15]
+                             / MULTIPLIER_DIVISORS [bands.multiplier [i] & 15];
+
+        resistance [i] = value;
+        minResistance [i] = (1 - tolerance) * value;
+        maxResistance [i] = (1 + tolerance) * value;
+    }
+}
+
+#ifdef BATCH_X86_KERNELS
+
+/**
+ * Reads four band indices starting at @a src into the 32-bit lanes of
+ * an SSE register.
+ */
+BATCH_TARGET ("sse4.1")
+static inline __m128i loadBands (const uint8_t* src) {
+    int32_t packed;
+    memcpy (&packed, src, sizeof (packed));
+    return _mm_cvtepu8_epi32 (_mm_cvtsi32_si128 (packed));
+}
+
+/**
+ * Calculates the integer base value (e.g. 47 or 470) of four resistors
+ * starting at the index @a i.
+ */
+BATCH_TARGET ("sse4.1")
+static inline __m128i loadBase (const ResistorType type,
+                                const BandArrays& bands,
+                                const size_t i) {
+    const __m128i ten = _mm_set1_epi32 (10);
+
+    __m128i base = _mm_add_epi32 (_mm_mullo_epi32 (loadBands (bands.digitA + i), ten),
+                                  loadBands (bands.digitB + i));
+    if (type != FourStripResistor)
+        base = _mm_add_epi32 (_mm_mullo_epi32 (base, ten),
+                              loadBands (bands.digitC + i));
+
+    return base;
+}
+
+/**
+ * SSE4.1 kernel, decodes four resistors per iteration using two
+ * double-precision lanes for the resistance calculations.
+ */
+BATCH_TARGET ("sse4.1")
+static void decodeSse41 (const ResistorType type,
+                         const BandArrays& bands,
+                         const size_t count,
+                         double* resistance,
+                         double* minResistance,
+                         double* maxResistance) {
+    const __m128d one = _mm_set1_pd (1);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i base = loadBase (type, bands, i);
+        const uint8_t* m = bands.multiplier + i;
+        const uint8_t* t = bands.tolerance + i;
+
+        const __m128d baseLo = _mm_cvtepi32_pd (base);
+        const __m128d baseHi = _mm_cvtepi32_pd (_mm_shuffle_epi32 (base, 0xEE));
+
+        const __m128d valueLo = _mm_div_pd (_mm_mul_pd (baseLo,
+                                                        _mm_set_pd (MULTIPLIER_VALUES [m [1] & 15],
+                                                                    MULTIPLIER_VALUES [m [0] & 15])),
+                                            _mm_set_pd (MULTIPLIER_DIVISORS [m [1] & 15],
+                                                        MULTIPLIER_DIVISORS [m [0] & 15]));
+        const __m128d valueHi = _mm_div_pd (_mm_mul_pd (baseHi,
+                                                        _mm_set_pd (MULTIPLIER_VALUES [m [3] & 15],
+                                                                    MULTIPLIER_VALUES [m [2] & 15])),
+                                            _mm_set_pd (MULTIPLIER_DIVISORS [m [3] & 15],
+                                                        MULTIPLIER_DIVISORS [m [2] & 15]));
+
+        const __m128d tolLo = _mm_set_pd (TOLERANCE_VALUES [t [1] & 7],
+                                          TOLERANCE_VALUES [t [0] & 7]);
+        const __m128d tolHi = _mm_set_pd (TOLERANCE_VALUES [t [3] & 7],
+                                          TOLERANCE_VALUES [t [2] & 7]);
+
+        _mm_storeu_pd (resistance + i, valueLo);
+        _mm_storeu_pd (resistance + i + 2, valueHi);
+        _mm_storeu_pd (minResistance + i, _mm_mul_pd (_mm_sub_pd (one, tolLo), valueLo));
+        _mm_storeu_pd (minResistance + i + 2, _mm_mul_pd (_mm_sub_pd (one, tolHi), valueHi));
+        _mm_storeu_pd (maxResistance + i, _mm_mul_pd (_mm_add_pd (one, tolLo), valueLo));
+        _mm_storeu_pd (maxResistance + i + 2, _mm_mul_pd (_mm_add_pd (one, tolHi), valueHi));
+    }
+
+    decodeScalar (type, bands, i, count, resistance, minResistance, maxResistance);
+}
+
+/**
+ * AVX2 kernel, decodes eight resistors per iteration using four
+ * double-precision lanes for the resistance calculations.
+ *
+ * Table values are loaded with scalar loads instead of gather instructions,
+ * which are slower than the equivalent scalar loads on most CPUs.
+ */
+BATCH_TARGET ("avx2")
+static inline void decodeAvx2Lanes (const __m128i base,
+                                    const uint8_t* m,
+                                    const uint8_t* t,
+                                    double* resistance,
+                                    double* minResistance,
+                                    double* maxResistance) {
+    const __m256d one = _mm256_set1_pd (1);
+    const __m256d multiplier = _mm256_set_pd (MULTIPLIER_VALUES [m [3] & 15],
+                                              MULTIPLIER_VALUES [m [2] & 15],
+                                              MULTIPLIER_VALUES [m [1] & 15],
+                                              MULTIPLIER_VALUES [m [0] & 15]);
+    const __m256d divisor = _mm256_set_pd (MULTIPLIER_DIVISORS [m [3] & 15],
+                                           MULTIPLIER_DIVISORS [m [2] & 15],
+                                           MULTIPLIER_DIVISORS [m [1] & 15],
+                                           MULTIPLIER_DIVISORS [m [0] & 15]);
+    const __m256d tolerance = _mm256_set_pd (TOLERANCE_VALUES [t [3] & 7],
+                                             TOLERANCE_VALUES [t [2] & 7],
+                                             TOLERANCE_VALUES [t [1] & 7],
+                                             TOLERANCE_VALUES [t [0] & 7]);
+
+    const __m256d value = _mm256_div_pd (_mm256_mul_pd (_mm256_cvtepi32_pd (base), multiplier),
+                                         divisor);
+    _mm256_storeu_pd (resistance, value);
+    _mm256_storeu_pd (minResistance, _mm256_mul_pd (_mm256_sub_pd (one, tolerance), value));
+    _mm256_storeu_pd (maxResistance, _mm256_mul_pd (_mm256_add_pd (one, tolerance), value));
+}
+
+BATCH_TARGET ("avx2")
+static void decodeAvx2 (const ResistorType type,
+                        const BandArrays& bands,
+                        const size_t count,
+                        double* resistance,
+                        double* minResistance,
+                        double* maxResistance) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        decodeAvx2Lanes (loadBase (type, bands, i),
+                         bands.multiplier + i, bands.tolerance + i,
+                         resistance + i, minResistance + i, maxResistance + i);
+        decodeAvx2Lanes (loadBase (type, bands, i + 4),
+                         bands.multiplier + i + 4, bands.tolerance + i + 4,
+                         resistance + i + 4, minResistance + i + 4, maxResistance + i + 4);
+    }
+
+    // Clear the upper halves of the AVX registers, otherwise the SSE code
+    // that runs afterwards (e.g. libm calls) is several times slower. GCC
+    // does not do this for functions with a target attribute.
+    _mm256_zeroupper();
+
+    decodeScalar (type, bands, i, count, resistance, minResistance, maxResistance);
+}
+
+#endif
+
+/**
+ * @returns @c true if the running CPU (and operating system) can execute
+ *          the given batch @a kernel
+ */
+bool ResistorCore::batchKernelSupported (const BatchKernel kernel) {
+    switch (kernel) {
+    case BatchAuto:
+    case BatchScalar:
+        return true;
+#if defined (BATCH_X86_KERNELS) && defined (__GNUC__)
+    case BatchSse41:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports ("sse4.1");
+    case BatchAvx2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports ("avx2");
+#elif defined (BATCH_X86_KERNELS)
+    case BatchSse41: {
+        int info [4];
+        __cpuid (info, 1);
+        return (info [2] & (1 << 19)) != 0;
+    }
+    case BatchAvx2: {
+        int info [4];
+        __cpuid (info, 1);
+        const bool osxsave = (info [2] & (1 << 27)) != 0;
+        if (!osxsave || (_xgetbv (0) & 6) != 6)
+            return false;
+
+        __cpuidex (info, 7, 0);
+        return (info [1] & (1 << 5)) != 0;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+/**
+ * @returns The fastest batch kernel that can run on this CPU
+ */
+BatchKernel ResistorCore::bestBatchKernel() {
+    static const BatchKernel kernel = batchKernelSupported (BatchAvx2) ? BatchAvx2 :
+                                      batchKernelSupported (BatchSse41) ? BatchSse41 :
+                                                                          BatchScalar;
+    return kernel;
+}
+
+/**
+ * @returns A human-readable name for the given batch @a kernel
+ */
+const char* ResistorCore::batchKernelName (const BatchKernel kernel) {
+    switch (kernel) {
+    case BatchAuto:
+        return batchKernelName (bestBatchKernel());
+    case BatchScalar:
+        return "scalar";
+    case BatchSse41:
+        return "sse4.1";
+    case BatchAvx2:
+        return "avx2";
+    default:
+        return "unknown";
+    }
+}
+
+/**
+ * Decodes @a count resistors of the given @a type at once.
+ *
+ * The nominal, minimum and maximum resistance of the i-th resistor are
+ * written to the i-th element of the @a resistance, @a minResistance and
+ * @a maxResistance arrays, which must be able to hold @a count values.
+ *
+ * Results are identical to calling @c decodeBands() for each resistor.
+ * Out-of-range multiplier indices decode to 0 ohms instead of reading
+ * outside of the lookup tables.
+ *
+ * The @a kernel parameter forces a specific instruction set, kernels that
+ * are not supported by the CPU fall back to the scalar implementation.
+ */
+void ResistorCore::decodeBandsBatch (const ResistorType type,
+                                     const BandArrays& bands,
+                                     const size_t count,
+                                     double* resistance,
+                                     double* minResistance,
+                                     double* maxResistance,
+                                     const BatchKernel kernel) {
+    assert (type == FourStripResistor || bands.digitC != NULL);
+
+    BatchKernel selected = kernel;
+    if (selected == BatchAuto)
+        selected = bestBatchKernel();
+    else if (!batchKernelSupported (selected))
+        selected = BatchScalar;
+
+    switch (selected) {
+#ifdef BATCH_X86_KERNELS
+    case BatchAvx2:
+        decodeAvx2 (type, bands, count, resistance, minResistance, maxResistance);
+        break;
+    case BatchSse41:
+        decodeSse41 (type, bands, count, resistance, minResistance, maxResistance);
+        break;
+#endif
+    default:
+        decodeScalar (type, bands, 0, count, resistance, minResistance, maxResistance);
+        break;
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_BAND_BATCH_H
+#define RESISTOR_BAND_BATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ResistorCore.h"
+
+namespace ResistorCore
+{
+
+/**
+ * Instruction sets that can be used by the batch band decoder.
+ * @c BatchAuto selects the fastest kernel supported by the running CPU.
+ */
+enum BatchKernel {
+    BatchAuto   = 0,
+    BatchScalar = 1,
+    BatchSse41  = 2,
+    BatchAvx2   = 3
+};
+
+/**
+ * Structure-of-arrays view over a list of color band readings.
+ *
+ * Each pointer references @c count contiguous band indices, with the same
+ * numbering as the @c Digit, @c Multiplier and @c Tolerance enums.
+ * The @c digitC array is only read for 5-strip and 6-strip resistors and
+ * may be NULL when decoding 4-strip resistors.
+ */
+struct BandArrays {
+    const uint8_t* digitA;
+    const uint8_t* digitB;
+    const uint8_t* digitC;
+    const uint8_t* multiplier;
+    const uint8_t* tolerance;
+};
+
+BatchKernel bestBatchKernel();
+bool batchKernelSupported (const BatchKernel kernel);
+const char* batchKernelName (const BatchKernel kernel);
+
+void decodeBandsBatch (const ResistorType type,
+                       const BandArrays& bands,
+                       const size_t count,
+                       double* resistance,
+                       double* minResistance,
+                       double* maxResistance,
+                       const BatchKernel kernel = BatchAuto);
+
+}
+
+#endif
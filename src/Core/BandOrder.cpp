@@ -0,0 +1,425 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "BandOrder.h"
+#include "ESeries.h"
+#include "BatchExecutor.h"
+
+#include <math.h>
+#include <assert.h>
+#include <algorithm>
+
+using namespace ResistorCore;
+
+/**
+ * Offsets and sizes of each band count in the packed code space. The
+ * digits, multiplier and tolerance of a 6-band code are laid out as a
+ * 5-band code, with the tempco as the least significant field.
+ */
+static const uint32_t FOUR_BAND_ROWS = 9 * 10 * 12 * 8;
+static const uint32_t FIVE_BAND_ROWS = 9 * 10 * 10 * 12 * 8;
+static const uint32_t SIX_BAND_ROWS = FIVE_BAND_ROWS * 6;
+static const uint32_t FIVE_BAND_OFFSET = FOUR_BAND_ROWS;
+static const uint32_t SIX_BAND_OFFSET = FIVE_BAND_OFFSET + FIVE_BAND_ROWS;
+static const uint32_t CODE_SPACE = SIX_BAND_OFFSET + SIX_BAND_ROWS;
+
+/**
+ * The tempco does not change the score of a code, so the score table only
+ * holds the 4 and 5-band rows, and 6-band codes use their 5-band row
+ */
+static const uint32_t SCORE_ROWS = SIX_BAND_OFFSET;
+
+/**
+ * Score added to the direction that agrees with each spacing hint (and
+ * taken from the other one), larger than any difference between static
+ * scores
+ */
+static const int SPACING_SCORES [3] = { 0, 50, -50 };
+
+/**
+ * Smallest number of readings given to each thread of a batch
+ */
+static const size_t RANKING_BLOCK = 4096;
+
+/**
+ * Maps every byte to the value that it takes in each band role, bytes
+ * that a role does not accept map to a value with the @c NO_BAND bit set,
+ * so a whole reading is validated by OR-ing its values
+ */
+static const uint16_t NO_BAND = 0x100;
+
+struct ColorRoles {
+    uint16_t leadingDigit [256];
+    uint16_t digit [256];
+    uint16_t multiplier [256];
+    uint16_t tolerance [256];
+    uint16_t tempco [256];
+};
+
+static constexpr ColorRoles makeColorRoles() {
+    ColorRoles roles {};
+    for (int c = 0; c < 256; ++c) {
+        roles.leadingDigit [c] = NO_BAND;
+        roles.digit [c] = NO_BAND;
+        roles.multiplier [c] = NO_BAND;
+        roles.tolerance [c] = NO_BAND;
+        roles.tempco [c] = NO_BAND;
+    }
+
+    for (int c = DigitBlack; c <= DigitWhite; ++c) {
+        roles.leadingDigit [c] = c == DigitBlack ? NO_BAND : static_cast<uint16_t> (c);
+        roles.digit [c] = static_cast<uint16_t> (c);
+    }
+
+    for (int c = MultiplierBlack; c <= MultiplierSilver; ++c)
+        roles.multiplier [c] = static_cast<uint16_t> (c);
+
+    roles.tolerance [MultiplierBrown] = ToleranceBrown;
+    roles.tolerance [MultiplierRed] = ToleranceRed;
+    roles.tolerance [MultiplierGreen] = ToleranceGreen;
+    roles.tolerance [MultiplierBlue] = ToleranceBlue;
+    roles.tolerance [MultiplierViolet] = ToleranceViolet;
+    roles.tolerance [MultiplierGray] = ToleranceGray;
+    roles.tolerance [MultiplierGold] = ToleranceGold;
+    roles.tolerance [MultiplierSilver] = ToleranceSilver;
+
+    roles.tempco [MultiplierBrown] = TempcoBrown;
+    roles.tempco [MultiplierRed] = TempcoRed;
+    roles.tempco [MultiplierOrange] = TempcoOrange;
+    roles.tempco [MultiplierYellow] = TempcoYellow;
+    roles.tempco [MultiplierBlue] = TempcoBlue;
+    roles.tempco [MultiplierViolet] = TempcoViolet;
+
+    return roles;
+}
+
+static constexpr ColorRoles COLOR_ROLES = makeColorRoles();
+
+/**
+ * Inverse of @c COLOR_ROLES, used to turn codes back into colors
+ */
+static const uint8_t TOLERANCE_COLORS [8] = {
+    MultiplierBrown, MultiplierRed, MultiplierGreen, MultiplierBlue,
+    MultiplierViolet, MultiplierGray, MultiplierGold, MultiplierSilver
+};
+static const uint8_t TEMPCO_COLORS [6] = {
+    MultiplierBrown, MultiplierRed, MultiplierOrange, MultiplierYellow,
+    MultiplierBlue, MultiplierViolet
+};
+
+/**
+ * Code read in one direction and its row in the score table, both are
+ * zero if the reading is not valid
+ */
+struct DirectedReading {
+    ResistorCode code;
+    uint32_t row;
+    bool valid;
+};
+
+/**
+ * Reads @a Count bands, where the i-th band is @a colors [i * step]. The
+ * reading is validated without branches, since both directions of most
+ * readings are equally likely to be valid.
+ */
+template <size_t Count>
+static inline DirectedReading readBands (const uint8_t* colors, const ptrdiff_t step) {
+    const size_t digits = Count == 4 ? 2 : 3;
+    const uint32_t a = COLOR_ROLES.leadingDigit [colors [0]];
+    const uint32_t b = COLOR_ROLES.digit [colors [step]];
+    const uint32_t c = Count == 4 ? 0 : COLOR_ROLES.digit [colors [2 * step]];
+    const uint32_t m = COLOR_ROLES.multiplier [colors [digits * step]];
+    const uint32_t t = COLOR_ROLES.tolerance [colors [(digits + 1) * step]];
+    const uint32_t tc = Count == 6 ? COLOR_ROLES.tempco [colors [5 * step]] : 0;
+
+    uint32_t row = Count == 4 ? (a - 1) * 10 + b : ((a - 1) * 10 + b) * 10 + c;
+    row = (row * 12 + m) * 8 + t;
+    if (Count != 4)
+        row += FIVE_BAND_OFFSET;
+
+    const ResistorType type = Count == 4 ? FourStripResistor :
+                              Count == 5 ? FiveStripResistor : SixStripResistor;
+    const ResistorCode code (type, static_cast<Digit> (a), static_cast<Digit> (b),
+                             static_cast<Digit> (c), static_cast<Multiplier> (m),
+                             static_cast<Tolerance> (t), static_cast<Tempco> (tc));
+
+    DirectedReading reading;
+    reading.valid = ((a | b | c | m | t | tc) & NO_BAND) == 0;
+    reading.code = reading.valid ? code : ResistorCode();
+    reading.row = reading.valid ? row : 0;
+    return reading;
+}
+
+/**
+ * Builds the score table and counts the ambiguous codes
+ */
+BandOrder::BandOrder() : m_ambiguous (0) {
+    m_scores.resize (SCORE_ROWS);
+    for (uint32_t i = 0; i < SCORE_ROWS; ++i)
+        m_scores [i] = static_cast<uint8_t> (staticScore (code (i)));
+
+    for (uint32_t i = 0; i < CODE_SPACE; ++i) {
+        const BandCode band = code (i).toBandCode();
+
+        // Colors of the code in reading order
+        uint8_t colors [MAX_READING_BANDS];
+        size_t count = 0;
+        for (int d = 0; d < (band.type == FourStripResistor ? 2 : 3); ++d)
+            colors [count++] = static_cast<uint8_t> (band.digits [d]);
+
+        colors [count++] = static_cast<uint8_t> (band.multiplier);
+        colors [count++] = TOLERANCE_COLORS [band.tolerance];
+        if (band.type == SixStripResistor)
+            colors [count++] = TEMPCO_COLORS [band.tempco];
+
+        BandReading reading;
+        std::copy (colors, colors + count, reading.colors);
+        reading.count = static_cast<uint8_t> (count);
+        reading.spacing = BandSpacingUnknown;
+        if (rank (reading).count == 2)
+            ++m_ambiguous;
+    }
+}
+
+/**
+ * Returns the only instance of the table, building it if required. This
+ * function is thread-safe.
+ */
+const BandOrder& BandOrder::instance() {
+    static const BandOrder order;
+    return order;
+}
+
+/**
+ * Returns the interpretations of the given @a reading, sorted by
+ * decreasing score. The forward direction wins ties. The ranking is
+ * empty if the colors cannot be read in any direction.
+ */
+BandRanking BandOrder::rank (const BandReading& reading) const {
+    BandRanking ranking;
+    switch (reading.count) {
+    case 4:
+        rankReading<4> (reading, ranking);
+        break;
+    case 5:
+        rankReading<5> (reading, ranking);
+        break;
+    case 6:
+        rankReading<6> (reading, ranking);
+        break;
+    default:
+        ranking.count = 0;
+        break;
+    }
+
+    return ranking;
+}
+
+/**
+ * Ranks a @a reading with @a Count bands. Both directions are always
+ * decoded and scored, and the candidates are placed without branching on
+ * their validity or their order.
+ */
+template <size_t Count>
+void BandOrder::rankReading (const BandReading& reading, BandRanking& ranking) const {
+    const DirectedReading forward = readBands<Count> (reading.colors, 1);
+    const DirectedReading reversed = readBands<Count> (reading.colors + Count - 1, -1);
+
+    const int hint = SPACING_SCORES [reading.spacing < 3 ? reading.spacing : 0];
+    const int forwardScore = m_scores [forward.row] + hint;
+    const int reversedScore = m_scores [reversed.row] - hint;
+    const bool reversedFirst = reversed.valid && (!forward.valid || reversedScore > forwardScore);
+
+    BandCandidate& first = ranking.candidates [reversedFirst ? 1 : 0];
+    first.code = forward.code;
+    first.score = static_cast<int16_t> (forwardScore);
+    first.direction = BandForward;
+
+    BandCandidate& second = ranking.candidates [reversedFirst ? 0 : 1];
+    second.code = reversed.code;
+    second.score = static_cast<int16_t> (reversedScore);
+    second.direction = BandReversed;
+
+    // A single valid direction is always placed first
+    ranking.count = static_cast<uint8_t> (forward.valid + reversed.valid);
+}
+
+/**
+ * Ranks @a count readings, the rankings are written to @a rankings. If an
+ * @a executor is given, large batches are split between its threads.
+ * Returns @c false if the job was cancelled.
+ */
+bool BandOrder::rankBatch (const BandReading* readings,
+                           const size_t count,
+                           BandRanking* rankings,
+                           BatchExecutor* executor) const {
+    assert (readings != NULL || count == 0);
+    assert (rankings != NULL || count == 0);
+
+    const BatchExecutor::Task task = [&] (const size_t begin, const size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            rankings [i] = rank (readings [i]);
+    };
+
+    if (!executor || count <= RANKING_BLOCK) {
+        task (0, count);
+        return true;
+    }
+
+    const size_t grain = std::max (RANKING_BLOCK, count / (executor->threadCount() * 8));
+    return executor->run (count, grain, task);
+}
+
+/**
+ * Returns the number of bytes used by the table
+ */
+size_t BandOrder::memoryUsage() const {
+    return sizeof (BandOrder) + m_scores.capacity() * sizeof (uint8_t);
+}
+
+/**
+ * Returns the number of codes that are also valid when their bands are
+ * read in the opposite direction
+ */
+size_t BandOrder::ambiguousCodes() const {
+    return m_ambiguous;
+}
+
+/**
+ * Returns the code at the given @a index of the packed code space
+ */
+ResistorCode BandOrder::code (const size_t index) {
+    assert (index < CODE_SPACE);
+
+    ResistorType type = FourStripResistor;
+    uint32_t row = static_cast<uint32_t> (index);
+    uint32_t tempco = TempcoBrown;
+    if (row >= SIX_BAND_OFFSET) {
+        type = SixStripResistor;
+        row -= SIX_BAND_OFFSET;
+        tempco = row % 6;
+        row /= 6;
+    }
+
+    else if (row >= FIVE_BAND_OFFSET) {
+        type = FiveStripResistor;
+        row -= FIVE_BAND_OFFSET;
+    }
+
+    const uint32_t tolerance = row % 8;
+    row /= 8;
+    const uint32_t multiplier = row % 12;
+    row /= 12;
+
+    uint32_t digitC = DigitBlack;
+    if (type != FourStripResistor) {
+        digitC = row % 10;
+        row /= 10;
+    }
+
+    const uint32_t digitB = row % 10;
+    const uint32_t digitA = row / 10 + 1;
+    if (type == FourStripResistor)
+        return ResistorCode (type, static_cast<Digit> (digitA), static_cast<Digit> (digitB),
+                             DigitBlack, static_cast<Multiplier> (multiplier),
+                             static_cast<Tolerance> (tolerance));
+
+    return ResistorCode (type, static_cast<Digit> (digitA), static_cast<Digit> (digitB),
+                         static_cast<Digit> (digitC), static_cast<Multiplier> (multiplier),
+                         static_cast<Tolerance> (tolerance), static_cast<Tempco> (tempco));
+}
+
+/**
+ * Returns the score of the given @a code that does not depend on how it
+ * was observed:
+ *
+ * - 40 points if the value belongs to the E-series of its tolerance,
+ *   or 20 points if it belongs to E24 or E192
+ * - 10 points if the tolerance is common for the number of bands
+ *   (gold, silver, red and brown for 4 bands, 1% or tighter otherwise,
+ *   i.e. brown, green, blue, violet and gray)
+ * - 10 points if the value is between 100 mOhm and 10 GOhm, the range of
+ *   common parts
+ */
+int BandOrder::staticScore (const ResistorCode& code) {
+    const double resistance = code.decode().resistance;
+    const double tolerance = toleranceValue (code.tolerance());
+
+    int score = 0;
+    if (isStandardValue (resistance, seriesForTolerance (tolerance)))
+        score += 40;
+    else if (isStandardValue (resistance, SeriesE24) || isStandardValue (resistance, SeriesE192))
+        score += 20;
+
+    if (code.type() == FourStripResistor) {
+        if (code.tolerance() == ToleranceGold || code.tolerance() == ToleranceSilver ||
+                code.tolerance() == ToleranceRed || code.tolerance() == ToleranceBrown)
+            score += 10;
+    }
+
+    else if (tolerance <= 0.01)
+        score += 10;
+
+    if (resistance >= 0.1 && resistance < 1e10)
+        score += 10;
+
+    return score;
+}
+
+/**
+ * Returns the side of the widest gap between @a count bands, given the
+ * centers of the bands in reading order in @a positions. The gap must be
+ * clearly wider than every other gap and must not be the middle one,
+ * otherwise the spacing is unknown.
+ */
+BandSpacing ResistorCore::bandSpacing (const double* positions, const size_t count) {
+    assert (positions != NULL || count == 0);
+
+    if (count < 3)
+        return BandSpacingUnknown;
+
+    size_t widest = 0;
+    double widestGap = 0;
+    double secondGap = 0;
+    for (size_t i = 0; i + 1 < count; ++i) {
+        const double gap = fabs (positions [i + 1] - positions [i]);
+        if (gap > widestGap) {
+            secondGap = widestGap;
+            widestGap = gap;
+            widest = i;
+        }
+
+        else if (gap > secondGap)
+            secondGap = gap;
+    }
+
+    if (widestGap < secondGap * 1.25)
+        return BandSpacingUnknown;
+
+    const size_t gaps = count - 1;
+    if (2 * widest + 1 > gaps)
+        return BandGapNearEnd;
+    if (2 * widest + 1 < gaps)
+        return BandGapNearStart;
+
+    return BandSpacingUnknown;
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_BAND_ORDER_H
+#define RESISTOR_BAND_ORDER_H
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ResistorCode.h"
+
+namespace ResistorCore
+{
+
+class BatchExecutor;
+
+/**
+ * Direction in which the bands of a reading are decoded
+ */
+enum BandDirection {
+    BandForward  = 0,
+    BandReversed = 1
+};
+
+/**
+ * Position of the widest gap between the bands of a reading. The
+ * tolerance band is separated from the others by a wider gap, so the
+ * gap tells which end of the body is the last band.
+ */
+enum BandSpacing {
+    BandSpacingUnknown = 0,
+    BandGapNearEnd     = 1,
+    BandGapNearStart   = 2
+};
+
+static const size_t MAX_READING_BANDS = 6;
+static const size_t MAX_BAND_CANDIDATES = 2;
+
+/**
+ * Band colors observed on a resistor, from one end of the body to the
+ * other. Colors are numbered as the @c Multiplier enum (black to white,
+ * gold and silver), @c spacing is a @c BandSpacing hint.
+ */
+struct BandReading {
+    uint8_t colors [MAX_READING_BANDS];
+    uint8_t count;
+    uint8_t spacing;
+};
+
+/**
+ * Interpretation of a reading, higher scores are more plausible
+ */
+struct BandCandidate {
+    ResistorCode code;
+    int16_t score;
+    uint8_t direction;
+};
+
+/**
+ * Candidates of a reading, sorted by decreasing score. A reading is
+ * ambiguous if it has more than one candidate.
+ */
+struct BandRanking {
+    BandCandidate candidates [MAX_BAND_CANDIDATES];
+    uint8_t count;
+};
+
+/**
+ * Decides which end of a resistor is the first band.
+ *
+ * Each reading is decoded in both directions, as every resistor type
+ * with that number of bands. Directions that put a color where the type
+ * does not accept it (e.g. gold as the first digit, or black as the
+ * leading digit) are discarded, the others are scored by E-series
+ * membership, by how common their tolerance band is and by the band
+ * spacing hint.
+ *
+ * Both directions are decoded without branches. The static part of the
+ * score of every code is precomputed in a table over the packed code
+ * space, 6-band codes share the rows of their 5-band counterparts (the
+ * tempco does not change the score), so the table takes one byte per
+ * 4 and 5-band code and stays in the L2 cache. Ranking a reading takes
+ * two table loads.
+ *
+ * The table is built the first time that @c instance() is called.
+ */
+class BandOrder
+{
+public:
+    static const BandOrder& instance();
+
+    BandRanking rank (const BandReading& reading) const;
+    bool rankBatch (const BandReading* readings,
+                    const size_t count,
+                    BandRanking* rankings,
+                    BatchExecutor* executor = NULL) const;
+
+    size_t memoryUsage() const;
+    size_t ambiguousCodes() const;
+
+private:
+    BandOrder();
+
+    template <size_t Count>
+    void rankReading (const BandReading& reading, BandRanking& ranking) const;
+
+    static ResistorCode code (const size_t index);
+    static int staticScore (const ResistorCode& code);
+
+private:
+    std::vector<uint8_t> m_scores;
+    size_t m_ambiguous;
+};
+
+BandSpacing bandSpacing (const double* positions, const size_t count);
+
+}
+
+#endif
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "BandTable.h"
+
+using namespace ResistorCore;
+
+/**
+ * Multiplier values, divisors and decimal exponents indexed by the
+ * @c Multiplier enum, tolerances use the same expressions as
+ * @c toleranceValue() so that the table matches @c decodeBands()
+ * bit-by-bit.
+ */
+static constexpr double TABLE_MULTIPLIERS [12] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1, 1
+};
+static constexpr double TABLE_DIVISORS [12] = {
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1e1, 1e2
+};
+static constexpr int TABLE_EXPONENTS [12] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, -1, -2
+};
+static constexpr double TABLE_TOLERANCES [8] = {
+    1 / 100.0, 2 / 100.0, 0.5 / 100.0, 0.25 / 100.0,
+    0.1 / 100.0, 0.05 / 100.0, 5 / 100.0, 10 / 100.0
+};
+
+/**
+ * Writes the decimal representation of @a value to @a out, starting at
+ * @a pos, and returns the position after the last written character.
+ */
+static constexpr int writeInteger (char* out, int pos, const int value) {
+    int divisor = 1;
+    while (value / divisor >= 10)
+        divisor *= 10;
+
+    for (; divisor > 0; divisor /= 10)
+        out [pos++] = static_cast<char> ('0' + (value / divisor) % 10);
+
+    return pos;
+}
+
+/**
+ * Writes the display label of the resistance @a s x 10^@a e to @a out,
+ * where @a s is a 3-digit significand. The label is generated with
+ * integer math and matches the output of @c formatResistance().
+ */
+static constexpr void writeLabel (char* out, const int s, const int e) {
+    // Get engineering exponent of the value (s has three digits)
+    const int decimal = e + 2;
+    const int power = decimal >= 0 ? (decimal / 3) * 3 : -((2 - decimal) / 3) * 3;
+
+    // Get base number in hundredths (e.g. 470 for 4.70 kOhm)
+    int cents = s;
+    for (int i = power - e; i < 2; ++i)
+        cents *= 10;
+
+    // Write integer part and decimals
+    int pos = writeInteger (out, 0, cents / 100);
+    if (cents % 100 != 0) {
+        out [pos++] = '.';
+        out [pos++] = static_cast<char> ('0' + (cents / 10) % 10);
+        out [pos++] = static_cast<char> ('0' + cents % 10);
+    }
+
+    // Write prefix and ohm sign (U+03A9 in UTF-8)
+    out [pos++] = ' ';
+    switch (power) {
+    case -3:
+        out [pos++] = 'm';
+        break;
+    case 3:
+        out [pos++] = 'k';
+        break;
+    case 6:
+        out [pos++] = 'M';
+        break;
+    case 9:
+        out [pos++] = 'G';
+        break;
+    default:
+        break;
+    }
+
+    out [pos++] = static_cast<char> (0xCE);
+    out [pos++] = static_cast<char> (0xA9);
+    out [pos] = '\0';
+}
+
+/**
+ * Returns the index of the label of the resistance @a s x 10^@a e
+ */
+static constexpr uint16_t labelIndex (const int s, const int e) {
+    return static_cast<uint16_t> ((s - 100) * BAND_LABEL_EXPONENTS + (e + 3));
+}
+
+/**
+ * Writes the decoding result of the band code with the given integer
+ * @a base, @a multiplier and @a tolerance to the given @a entry.
+ * @a s and @a e are the significand and exponent of the resistance.
+ */
+static constexpr void writeEntry (BandTableEntry& entry,
+                                  const int base,
+                                  const int multiplier,
+                                  const int tolerance,
+                                  const int s,
+                                  const int e) {
+    const double value = base * TABLE_MULTIPLIERS [multiplier] / TABLE_DIVISORS [multiplier];
+    entry.resistance = value;
+    entry.minResistance = (1 - TABLE_TOLERANCES [tolerance]) * value;
+    entry.maxResistance = (1 + TABLE_TOLERANCES [tolerance]) * value;
+    entry.label = labelIndex (s, e);
+}
+
+/**
+ * Generates the contents of the band table, this function is evaluated by
+ * the compiler when @c BAND_TABLE_STATIC is defined.
+ */
+static constexpr void fillBandTable (BandTableData& data) {
+    // Generate labels
+    for (int s = 100; s <= 999; ++s) {
+        for (int e = -3; e <= 9; ++e)
+            writeLabel (data.labels [labelIndex (s, e)], s, e);
+    }
+
+    // Generate 4-strip rows
+    size_t row = 0;
+    for (int a = 1; a <= 9; ++a) {
+        for (int b = 0; b <= 9; ++b) {
+            for (int m = 0; m < 12; ++m) {
+                for (int t = 0; t < 8; ++t) {
+                    const int base = 10 * a + b;
+                    writeEntry (data.entries [row++], base, m, t,
+                                base * 10, TABLE_EXPONENTS [m] - 1);
+                }
+            }
+        }
+    }
+
+    // Generate 5-strip rows
+    for (int a = 1; a <= 9; ++a) {
+        for (int b = 0; b <= 9; ++b) {
+            for (int c = 0; c <= 9; ++c) {
+                for (int m = 0; m < 12; ++m) {
+                    for (int t = 0; t < 8; ++t) {
+                        const int base = 100 * a + 10 * b + c;
+                        writeEntry (data.entries [row++], base, m, t,
+                                    base, TABLE_EXPONENTS [m]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+#ifdef BAND_TABLE_STATIC
+static constexpr BandTableData makeBandTable() {
+    BandTableData data {};
+    fillBandTable (data);
+    return data;
+}
+
+static constexpr BandTableData BAND_TABLE_DATA = makeBandTable();
+#else
+static BandTableData BAND_TABLE_DATA;
+#endif
+
+/**
+ * Builds the table (only when it is not generated at compile time)
+ */
+BandTable::BandTable() : m_data (&BAND_TABLE_DATA) {
+#ifndef BAND_TABLE_STATIC
+    fillBandTable (BAND_TABLE_DATA);
+#endif
+}
+
+/**
+ * Returns the only instance of the table, building it if required.
+ * This function is thread-safe.
+ */
+const BandTable& BandTable::instance() {
+    static const BandTable table;
+    return table;
+}
+
+/**
+ * Returns the table row of the given band @a code, or @c BAND_TABLE_SIZE
+ * if the code is not stored in the table (e.g. first digit is black).
+ */
+size_t BandTable::index (const BandCode& code) {
+    const unsigned a = static_cast<unsigned> (code.digits [0]) - 1;
+    const unsigned b = static_cast<unsigned> (code.digits [1]);
+    const unsigned m = static_cast<unsigned> (code.multiplier);
+    const unsigned t = static_cast<unsigned> (code.tolerance);
+
+    if (a > 8 || b > 9 || m > 11 || t > 7)
+        return BAND_TABLE_SIZE;
+
+    if (code.type == FourStripResistor)
+        return ((a * 10 + b) * 12 + m) * 8 + t;
+
+    const unsigned c = static_cast<unsigned> (code.digits [2]);
+    if (c > 9)
+        return BAND_TABLE_SIZE;
+
+    return BAND_TABLE_FOUR_STRIP_ROWS + (((a * 10 + b) * 10 + c) * 12 + m) * 8 + t;
+}
+
+/**
+ * Returns the table row of the given band @a code, or @c NULL if the code
+ * is not stored in the table.
+ */
+const BandTableEntry* BandTable::lookup (const BandCode& code) const {
+    const size_t row = index (code);
+    if (row >= BAND_TABLE_SIZE)
+        return NULL;
+
+    return &m_data->entries [row];
+}
+
+/**
+ * Returns @c true if the table was generated at compile time
+ */
+bool BandTable::isStatic() {
+#ifdef BAND_TABLE_STATIC
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Returns the number of bytes used by the table
+ */
+size_t BandTable::memoryUsage() {
+    return sizeof (BandTableData);
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_BAND_TABLE_H
+#define RESISTOR_BAND_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ResistorCore.h"
+
+namespace ResistorCore
+{
+
+/**
+ * Number of rows in the band table: 9x10x12x8 4-strip codes followed by
+ * 9x10x10x12x8 5-strip codes. 6-strip codes share the 5-strip rows, since
+ * the tempco strip does not change the resistance of the resistor.
+ */
+static const size_t BAND_TABLE_FOUR_STRIP_ROWS = 9 * 10 * 12 * 8;
+static const size_t BAND_TABLE_FIVE_STRIP_ROWS = 9 * 10 * 10 * 12 * 8;
+static const size_t BAND_TABLE_SIZE = BAND_TABLE_FOUR_STRIP_ROWS +
+                                      BAND_TABLE_FIVE_STRIP_ROWS;
+
+/**
+ * Display labels are interned by value, every decodable resistance can be
+ * written as a 3-digit significand (100-999) times 10^e, with e in [-3, 9].
+ */
+static const size_t BAND_LABEL_SIZE = 16;
+static const size_t BAND_LABEL_EXPONENTS = 13;
+static const size_t BAND_LABEL_COUNT = 900 * BAND_LABEL_EXPONENTS;
+
+/**
+ * Precomputed decoding result of a single band code, two rows share
+ * each cache line.
+ */
+struct alignas (32) BandTableEntry {
+    double resistance;
+    double minResistance;
+    double maxResistance;
+    uint16_t label;
+};
+
+/**
+ * Raw storage of the band table, the labels are NUL-terminated UTF-8
+ * strings formatted like @c formatResistance() does.
+ */
+struct alignas (64) BandTableData {
+    BandTableEntry entries [BAND_TABLE_SIZE];
+    char labels [BAND_LABEL_COUNT][BAND_LABEL_SIZE];
+};
+
+/**
+ * Dense lookup table with the decoding results of every valid band code
+ * (first digit other than black).
+ *
+ * By default the table is built the first time that @c instance() is
+ * called. When the library is built with @c BAND_TABLE_STATIC the table
+ * is generated by the compiler and stored in the read-only data of the
+ * binary instead.
+ */
+class BandTable
+{
+public:
+    static const BandTable& instance();
+    static size_t index (const BandCode& code);
+
+    const BandTableEntry* lookup (const BandCode& code) const;
+
+    inline const BandTableEntry& entry (const size_t index) const {
+        return m_data->entries [index];
+    }
+
+    inline const char* label (const BandTableEntry& entry) const {
+        return m_data->labels [entry.label];
+    }
+
+    static bool isStatic();
+    static size_t memoryUsage();
+
+private:
+    BandTable();
+
+private:
+    const BandTableData* m_data;
+};
+
+}
+
+#endif
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "BatchExecutor.h"
+#include "SmdDecoder.h"
+
+#include <algorithm>
+
+using namespace ResistorCore;
+
+/**
+ * Creates an executor that runs jobs on @a threadCount threads (including
+ * the thread that calls @c run()) and splits them into chunks of
+ * @a grainSize elements. A @a threadCount of 0 uses one thread per CPU core.
+ */
+BatchExecutor::BatchExecutor (const size_t threadCount, const size_t grainSize) :
+    m_grainSize (grainSize > 0 ? grainSize : 1),
+    m_generation (0),
+    m_activeWorkers (0),
+    m_stopping (false),
+    m_task (NULL),
+    m_progress (NULL),
+    m_count (0),
+    m_progressStep (1),
+    m_completed (0),
+    m_cancelled (false)
+{
+    const size_t threads = threadCount > 0 ? threadCount : defaultThreadCount();
+
+    for (size_t i = 0; i < threads; ++i)
+        m_queues.push_back (std::unique_ptr<Queue> (new Queue));
+
+    for (size_t i = 1; i < threads; ++i)
+        m_threads.push_back (std::thread (&BatchExecutor::workerLoop, this, i));
+}
+
+/**
+ * Stops and joins the worker threads
+ */
+BatchExecutor::~BatchExecutor() {
+    {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        m_stopping = true;
+    }
+
+    m_jobStarted.notify_all();
+    for (size_t i = 0; i < m_threads.size(); ++i)
+        m_threads [i].join();
+}
+
+/**
+ * @returns The number of hardware threads of the system (at least 1)
+ */
+size_t BatchExecutor::defaultThreadCount() {
+    const unsigned int threads = std::thread::hardware_concurrency();
+    return threads > 0 ? threads : 1;
+}
+
+/**
+ * @returns The number of threads that process each job
+ */
+size_t BatchExecutor::threadCount() const {
+    return m_queues.size();
+}
+
+/**
+ * @returns The number of elements in each chunk of a job
+ */
+size_t BatchExecutor::grainSize() const {
+    return m_grainSize;
+}
+
+/**
+ * Changes the number of elements in each chunk of the following jobs.
+ * Small grains balance better, large grains reduce the scheduling cost.
+ */
+void BatchExecutor::setGrainSize (const size_t grainSize) {
+    m_grainSize = grainSize > 0 ? grainSize : 1;
+}
+
+/**
+ * Calls @a task over the range [0, @a count) and waits until every chunk
+ * has been processed. The @a task is called concurrently from several
+ * threads with disjoint [begin, end) ranges.
+ *
+ * If given, @a progress is called (from any of the threads) each time
+ * that another percent of the range is completed, and when the job ends.
+ *
+ * Returns @c false if the job was cancelled with @c cancel(), in that
+ * case some of the chunks were not processed. Jobs cannot be nested and
+ * only one thread may call this function at a time.
+ */
+bool BatchExecutor::run (const size_t count,
+                         const Task& task,
+                         const ProgressCallback& progress) {
+    return run (count, m_grainSize, task, progress);
+}
+
+/**
+ * Same as @c run(), but splits this job into chunks of @a grainSize
+ * elements instead of using the executor's grain size, which lets
+ * callers size the chunks of each job without changing shared state.
+ */
+bool BatchExecutor::run (const size_t count,
+                         const size_t grainSize,
+                         const Task& task,
+                         const ProgressCallback& progress) {
+    m_cancelled = false;
+    if (count == 0)
+        return true;
+
+    // Give each thread a contiguous run of chunks
+    const size_t grain = grainSize > 0 ? grainSize : 1;
+    const size_t threads = m_queues.size();
+    const size_t chunks = (count + grain - 1) / grain;
+    for (size_t t = 0; t < threads; ++t) {
+        Queue& queue = *m_queues [t];
+        std::lock_guard<std::mutex> lock (queue.mutex);
+
+        const size_t first = t * chunks / threads;
+        const size_t last = (t + 1) * chunks / threads;
+        for (size_t c = first; c < last; ++c) {
+            const Chunk chunk = { c * grain, std::min (count, (c + 1) * grain) };
+            queue.chunks.push_back (chunk);
+        }
+    }
+
+    // Publish the job
+    m_task = &task;
+    m_progress = progress ? &progress : NULL;
+    m_count = count;
+    m_progressStep = count >= 100 ? count / 100 : 1;
+    m_completed = 0;
+
+    // Wake up the workers
+    if (!m_threads.empty()) {
+        {
+            std::lock_guard<std::mutex> lock (m_mutex);
+            m_activeWorkers = m_threads.size();
+            ++m_generation;
+        }
+
+        m_jobStarted.notify_all();
+    }
+
+    // Work on the job and wait for the other threads
+    processChunks (0);
+    {
+        std::unique_lock<std::mutex> lock (m_mutex);
+        m_jobFinished.wait (lock, [this]() { return m_activeWorkers == 0; });
+    }
+
+    m_task = NULL;
+    m_progress = NULL;
+    return !m_cancelled;
+}
+
+/**
+ * Cancels the current job, chunks that have not been started are
+ * skipped. This function can be called from any thread.
+ */
+void BatchExecutor::cancel() {
+    m_cancelled = true;
+}
+
+/**
+ * @returns @c true if the current (or last) job was cancelled
+ */
+bool BatchExecutor::isCancelled() const {
+    return m_cancelled;
+}
+
+/**
+ * Waits for jobs and processes them until the executor is destroyed
+ */
+void BatchExecutor::workerLoop (const size_t index) {
+    size_t generation = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock (m_mutex);
+            m_jobStarted.wait (lock, [&]() {
+                return m_stopping || m_generation != generation;
+            });
+
+            if (m_stopping)
+                return;
+
+            generation = m_generation;
+        }
+
+        processChunks (index);
+
+        std::lock_guard<std::mutex> lock (m_mutex);
+        if (--m_activeWorkers == 0)
+            m_jobFinished.notify_one();
+    }
+}
+
+/**
+ * Processes chunks from the queue of the thread with the given @a index,
+ * and from the other queues once it is empty, until no chunks are left
+ */
+void BatchExecutor::processChunks (const size_t index) {
+    Chunk chunk;
+    while (takeChunk (index, chunk) || stealChunk (index, chunk)) {
+        // Drain the queues without processing after a cancellation
+        if (m_cancelled.load (std::memory_order_relaxed))
+            continue;
+
+        (*m_task) (chunk.begin, chunk.end);
+
+        // Report progress once per percent
+        const size_t size = chunk.end - chunk.begin;
+        const size_t completed = m_completed.fetch_add (size) + size;
+        if (m_progress) {
+            const size_t before = completed - size;
+            if (before / m_progressStep != completed / m_progressStep || completed == m_count)
+                (*m_progress) (completed, m_count);
+        }
+    }
+}
+
+/**
+ * Takes the next chunk from the front of the thread's own queue
+ */
+bool BatchExecutor::takeChunk (const size_t index, Chunk& chunk) {
+    Queue& queue = *m_queues [index];
+    std::lock_guard<std::mutex> lock (queue.mutex);
+    if (queue.chunks.empty())
+        return false;
+
+    chunk = queue.chunks.front();
+    queue.chunks.pop_front();
+    return true;
+}
+
+/**
+ * Steals a chunk from the back of the queue of another thread
+ */
+bool BatchExecutor::stealChunk (const size_t index, Chunk& chunk) {
+    const size_t threads = m_queues.size();
+    for (size_t i = 1; i < threads; ++i) {
+        Queue& queue = *m_queues [(index + i) % threads];
+        std::lock_guard<std::mutex> lock (queue.mutex);
+        if (queue.chunks.empty())
+            continue;
+
+        chunk = queue.chunks.back();
+        queue.chunks.pop_back();
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * Parallel version of @c decodeBandsBatch(), each chunk of the job is
+ * decoded with the given @a kernel.
+ */
+void ResistorCore::decodeBandsParallel (BatchExecutor& executor,
+                                        const ResistorType type,
+                                        const BandArrays& bands,
+                                        const size_t count,
+                                        double* resistance,
+                                        double* minResistance,
+                                        double* maxResistance,
+                                        const BatchKernel kernel) {
+    executor.run (count, [&](const size_t begin, const size_t end) {
+        const BandArrays chunk = {
+            bands.digitA + begin,
+            bands.digitB + begin,
+            bands.digitC ? bands.digitC + begin : NULL,
+            bands.multiplier + begin,
+            bands.tolerance + begin
+        };
+
+        decodeBandsBatch (type, chunk, end - begin,
+                          resistance + begin,
+                          minResistance + begin,
+                          maxResistance + begin,
+                          kernel);
+    });
+}
+
+/**
+ * Parallel version of @c decodeSmdFixed()
+ */
+void ResistorCore::decodeSmdFixedParallel (BatchExecutor& executor,
+                                           const char* buffer,
+                                           const size_t count,
+                                           const size_t width,
+                                           SmdResult* results) {
+    executor.run (count, [&](const size_t begin, const size_t end) {
+        decodeSmdFixed (buffer + begin * width, end - begin, width, results + begin);
+    });
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_BATCH_EXECUTOR_H
+#define RESISTOR_BATCH_EXECUTOR_H
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+#include <stddef.h>
+
+#include "BandBatch.h"
+
+namespace ResistorCore
+{
+
+/**
+ * Runs data-parallel jobs over the index range [0, count) on a fixed pool
+ * of threads.
+ *
+ * The range is split into chunks of @c grainSize() elements. Each thread
+ * gets its own deque, which starts with a contiguous run of chunks. A
+ * thread takes chunks from the front of its own deque, so it walks its
+ * span of the input in order. When the deque is empty, the thread steals
+ * chunks from the back of the other deques, which is the part that their
+ * owners would process last.
+ *
+ * The thread that calls @c run() takes part in the job, so an executor
+ * with a single thread does not create any worker thread.
+ */
+class BatchExecutor
+{
+public:
+    typedef std::function<void (size_t begin, size_t end)> Task;
+    typedef std::function<void (size_t completed, size_t total)> ProgressCallback;
+
+    static const size_t DEFAULT_GRAIN_SIZE = 4096;
+
+    explicit BatchExecutor (const size_t threadCount = 0,
+                            const size_t grainSize = DEFAULT_GRAIN_SIZE);
+    ~BatchExecutor();
+
+    static size_t defaultThreadCount();
+
+    size_t threadCount() const;
+    size_t grainSize() const;
+    void setGrainSize (const size_t grainSize);
+
+    bool run (const size_t count,
+              const Task& task,
+              const ProgressCallback& progress = ProgressCallback());
+    bool run (const size_t count,
+              const size_t grainSize,
+              const Task& task,
+              const ProgressCallback& progress = ProgressCallback());
+
+    void cancel();
+    bool isCancelled() const;
+
+private:
+    struct Chunk {
+        size_t begin;
+        size_t end;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+    };
+
+    void workerLoop (const size_t index);
+    void processChunks (const size_t index);
+    bool takeChunk (const size_t index, Chunk& chunk);
+    bool stealChunk (const size_t index, Chunk& chunk);
+
+private:
+    size_t m_grainSize;
+    std::vector<std::thread> m_threads;
+    std::vector<std::unique_ptr<Queue>> m_queues;
+
+    std::mutex m_mutex;
+    std::condition_variable m_jobStarted;
+    std::condition_variable m_jobFinished;
+    size_t m_generation;
+    size_t m_activeWorkers;
+    bool m_stopping;
+
+    const Task* m_task;
+    const ProgressCallback* m_progress;
+    size_t m_count;
+    size_t m_progressStep;
+    std::atomic<size_t> m_completed;
+    std::atomic<bool> m_cancelled;
+};
+
+void decodeBandsParallel (BatchExecutor& executor,
+                          const ResistorType type,
+                          const BandArrays& bands,
+                          const size_t count,
+                          double* resistance,
+                          double* minResistance,
+                          double* maxResistance,
+                          const BatchKernel kernel = BatchAuto);
+
+void decodeSmdFixedParallel (BatchExecutor& executor,
+                             const char* buffer,
+                             const size_t count,
+                             const size_t width,
+                             SmdResult* results);
+
+}
+
+#endif
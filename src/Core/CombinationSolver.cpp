@@ -0,0 +1,608 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "CombinationSolver.h"
+#include "BatchExecutor.h"
+
+#include <math.h>
+#include <mutex>
+#include <string.h>
+#include <assert.h>
+#include <algorithm>
+
+using namespace ResistorCore;
+
+/**
+ * Number of low bits of the floating-point representation that are
+ * dropped to obtain the bucket of a 2-part network value, this leaves
+ * 10 bits of mantissa (about 1000 buckets per octave)
+ */
+static const int BUCKET_SHIFT = 42;
+
+/**
+ * Returns the bucket of the given positive @a value. Positive doubles
+ * have the same order as their bit patterns, so buckets are sorted.
+ */
+static inline uint64_t bucket (const double value) {
+    uint64_t bits;
+    memcpy (&bits, &value, sizeof (bits));
+    return bits >> BUCKET_SHIFT;
+}
+
+/**
+ * Returns the resistance of @a a and @a b connected in series or in
+ * @a parallel
+ */
+static inline double combine (const double a, const double b, const bool parallel) {
+    return parallel ? (a * b) / (a + b) : a + b;
+}
+
+/**
+ * Obtains the resistance that must be connected (in series or in
+ * @a parallel) to @a value to obtain @a target, returns @c false if there
+ * is no such resistance
+ */
+static inline bool partner (const double target,
+                            const double value,
+                            const bool parallel,
+                            double* required) {
+    if (parallel) {
+        if (value <= target)
+            return false;
+
+        *required = (value * target) / (value - target);
+        return true;
+    }
+
+    *required = target - value;
+    return *required > 0;
+}
+
+/**
+ * Calls @a visitor with the indices of the two values of the sorted
+ * @a values array that surround @a required
+ */
+template <typename Visitor>
+static inline void visitNeighbors (const std::vector<double>& values,
+                                   const double required,
+                                   Visitor visitor) {
+    const size_t index = static_cast<size_t> (
+                std::lower_bound (values.begin(), values.end(), required) - values.begin());
+
+    if (index > 0)
+        visitor (index - 1);
+    if (index < values.size())
+        visitor (index);
+}
+
+/**
+ * Keeps the best networks of each size found by a search (by absolute
+ * error), skipping networks that only differ in the order of their parts
+ */
+class CombinationSolver::Collector
+{
+public:
+    explicit Collector (const size_t capacity) : m_capacity (capacity) {}
+
+    /**
+     * Returns the largest error that a network with the given number of
+     * @a parts needs to have to be kept
+     */
+    inline double threshold (const int parts) const {
+        const std::vector<Network>& heap = m_heaps [parts - 1];
+        return heap.size() < m_capacity ? HUGE_VAL : fabs (heap.front().error);
+    }
+
+    void add (const Network& network) {
+        std::vector<Network>& heap = m_heaps [network.parts - 1];
+        if (fabs (network.error) > threshold (network.parts))
+            return;
+
+        for (size_t i = 0; i < heap.size(); ++i) {
+            if (equivalent (heap [i], network))
+                return;
+        }
+
+        if (heap.size() >= m_capacity) {
+            std::pop_heap (heap.begin(), heap.end(), compare);
+            heap.pop_back();
+        }
+
+        heap.push_back (network);
+        std::push_heap (heap.begin(), heap.end(), compare);
+    }
+
+    void merge (const Collector& other) {
+        for (int parts = 0; parts < 4; ++parts)
+            for (size_t i = 0; i < other.m_heaps [parts].size(); ++i)
+                add (other.m_heaps [parts][i]);
+    }
+
+    std::vector<Network> networks() const {
+        std::vector<Network> list;
+        for (int parts = 0; parts < 4; ++parts)
+            list.insert (list.end(), m_heaps [parts].begin(), m_heaps [parts].end());
+
+        return list;
+    }
+
+private:
+    static bool compare (const Network& a, const Network& b) {
+        return fabs (a.error) < fabs (b.error);
+    }
+
+    static bool equivalent (const Network& a, const Network& b) {
+        if (fabs (a.resistance - b.resistance) > 1e-12 * a.resistance)
+            return false;
+
+        double x [4];
+        double y [4];
+        sorted (a, x);
+        sorted (b, y);
+        return std::equal (x, x + a.parts, y);
+    }
+
+    static void sorted (const Network& network, double* values) {
+        for (int i = 0; i < network.parts; ++i) {
+            int j = i;
+            for (; j > 0 && values [j - 1] > network.values [i]; --j)
+                values [j] = values [j - 1];
+
+            values [j] = network.values [i];
+        }
+    }
+
+private:
+    size_t m_capacity;
+    std::vector<Network> m_heaps [4];
+};
+
+/**
+ * Creates a solver with an empty inventory, searches are split over the
+ * threads of the given @a executor (if any)
+ */
+CombinationSolver::CombinationSolver (BatchExecutor* executor) :
+    m_executor (executor),
+    m_firstBucket (0) {}
+
+/**
+ * Changes the stock values that can be used by the networks. Non-positive
+ * and repeated values are ignored, at most @c MAX_INVENTORY values are
+ * used (the lowest ones).
+ *
+ * This builds the sorted list of every 2-part network of the inventory,
+ * which takes O(n^2 log n) time.
+ */
+void CombinationSolver::setInventory (const double* values, const size_t count) {
+    assert (values != NULL || count == 0);
+
+    // Get sorted unique values
+    sortInventory (values, count, &m_values);
+    if (m_values.size() > MAX_INVENTORY)
+        m_values.resize (MAX_INVENTORY);
+
+    // Get every 2-part network
+    const size_t n = m_values.size();
+    m_pairs.clear();
+    m_pairs.reserve (n * (n + 1));
+    for (size_t a = 0; a < n; ++a) {
+        for (size_t b = a; b < n; ++b) {
+            for (int parallel = 0; parallel < 2; ++parallel) {
+                PairValue pair;
+                pair.value = combine (m_values [a], m_values [b], parallel);
+                pair.a = static_cast<uint16_t> (a);
+                pair.b = static_cast<uint16_t> (b);
+                pair.parallel = static_cast<uint8_t> (parallel);
+                m_pairs.push_back (pair);
+            }
+        }
+    }
+
+    std::sort (m_pairs.begin(), m_pairs.end(), [](const PairValue& x, const PairValue& y) {
+        return x.value < y.value;
+    });
+
+    // Keep a separate copy of the values to search them faster
+    m_pairValues.resize (m_pairs.size());
+    for (size_t i = 0; i < m_pairs.size(); ++i)
+        m_pairValues [i] = m_pairs [i].value;
+
+    // Store the index of the first value of each bucket
+    m_pairBuckets.clear();
+    m_firstBucket = 0;
+    if (!m_pairValues.empty()) {
+        m_firstBucket = bucket (m_pairValues.front());
+        const uint64_t buckets = bucket (m_pairValues.back()) - m_firstBucket + 1;
+
+        m_pairBuckets.assign (buckets + 1, 0);
+        size_t index = 0;
+        for (uint64_t b = 0; b <= buckets; ++b) {
+            while (index < m_pairValues.size() && bucket (m_pairValues [index]) - m_firstBucket < b)
+                ++index;
+
+            m_pairBuckets [b] = static_cast<uint32_t> (index);
+        }
+    }
+}
+
+/**
+ * Uses the values of the given standard @a series between @a minimum
+ * and @a maximum (inclusive) as the inventory
+ */
+void CombinationSolver::setSeries (const ESeries series,
+                                   const double minimum,
+                                   const double maximum) {
+    std::vector<double> inventory;
+    seriesInventory (series, minimum, maximum, &inventory);
+    setInventory (inventory.data(), inventory.size());
+}
+
+/**
+ * Returns the number of stock values used by the networks
+ */
+size_t CombinationSolver::inventorySize() const {
+    return m_values.size();
+}
+
+/**
+ * Returns the sorted stock values used by the networks
+ */
+const std::vector<double>& CombinationSolver::inventory() const {
+    return m_values;
+}
+
+/**
+ * Searches the networks with up to @c maxParts parts that approximate the
+ * target of the given @a query.
+ *
+ * Networks within the tolerance of the query are ranked by number of parts
+ * and then by absolute error. If no network is within the tolerance, the
+ * closest networks are returned instead (ranked by absolute error). At
+ * most @c maxResults networks are returned.
+ */
+std::vector<Network> CombinationSolver::solve (const CombinationQuery& query) const {
+    std::vector<Network> results;
+    if (!(query.target > 0) || m_values.empty() || query.maxResults == 0)
+        return results;
+
+    const size_t capacity = query.maxResults * 4;
+    Collector collector (capacity);
+    searchSmall (query, collector);
+
+    // Search 4-part networks, in parallel if possible
+    if (query.maxParts >= 4) {
+        std::mutex mutex;
+        auto chain = [&](const size_t begin, const size_t end) {
+            Collector local (capacity);
+            searchChain (query, begin, end, local);
+            std::lock_guard<std::mutex> lock (mutex);
+            collector.merge (local);
+        };
+        auto pair = [&](const size_t begin, const size_t end) {
+            Collector local (capacity);
+            searchPair (query, begin, end, local);
+            std::lock_guard<std::mutex> lock (mutex);
+            collector.merge (local);
+        };
+
+        if (m_executor) {
+            const size_t threads = m_executor->threadCount();
+            m_executor->run (m_values.size(), m_values.size() / (threads * 8), chain);
+            m_executor->run (m_pairs.size(), m_pairs.size() / (threads * 8), pair);
+        }
+
+        else {
+            chain (0, m_values.size());
+            pair (0, m_pairs.size());
+        }
+    }
+
+    // Keep networks within tolerance (if any)
+    const std::vector<Network> networks = collector.networks();
+    for (size_t i = 0; i < networks.size(); ++i) {
+        if (fabs (networks [i].error) <= query.tolerance)
+            results.push_back (networks [i]);
+    }
+
+    // Rank networks
+    if (!results.empty()) {
+        std::sort (results.begin(), results.end(), [](const Network& a, const Network& b) {
+            if (a.parts != b.parts)
+                return a.parts < b.parts;
+
+            return fabs (a.error) < fabs (b.error);
+        });
+    }
+
+    else {
+        results = networks;
+        std::sort (results.begin(), results.end(), [](const Network& a, const Network& b) {
+            if (fabs (a.error) != fabs (b.error))
+                return fabs (a.error) < fabs (b.error);
+
+            return a.parts < b.parts;
+        });
+    }
+
+    if (results.size() > query.maxResults)
+        results.resize (query.maxResults);
+
+    return results;
+}
+
+/**
+ * Calculates the resistance of the given @a network
+ */
+double CombinationSolver::evaluate (const Network& network) {
+    assert (network.parts >= 1 && network.parts <= 4);
+
+    const double* v = network.values;
+    const uint8_t ops = network.ops;
+
+    if (network.shape == Network::Pair)
+        return combine (combine (v [0], v [1], ops & 2),
+                        combine (v [2], v [3], ops & 4),
+                        ops & 1);
+
+    double value = v [network.parts - 1];
+    for (int i = network.parts - 2; i >= 0; --i)
+        value = combine (v [i], value, (ops >> i) & 1);
+
+    return value;
+}
+
+/**
+ * Returns a readable UTF-8 expression of the given @a network, where
+ * "+" connects parts in series and "||" connects them in parallel
+ * (e.g. "4.70 kΩ + (1.00 kΩ || 2.20 kΩ)")
+ */
+std::string CombinationSolver::describe (const Network& network) {
+    assert (network.parts >= 1 && network.parts <= 4);
+
+    // Sub-expressions know their top-level operation (-1 for single parts),
+    // so that parentheses are only added when the operation changes
+    struct Term {
+        std::string text;
+        int op;
+    };
+
+    auto join = [](const Term& left, const Term& right, const int op) {
+        const char* symbol = op ? " || " : " + ";
+        Term term;
+        term.op = op;
+        term.text = (left.op >= 0 && left.op != op) ? "(" + left.text + ")" : left.text;
+        term.text += symbol;
+        term.text += (right.op >= 0 && right.op != op) ? "(" + right.text + ")" : right.text;
+        return term;
+    };
+
+    Term parts [4];
+    for (int i = 0; i < network.parts; ++i) {
+        parts [i].text = formatResistance (network.values [i]);
+        parts [i].op = -1;
+    }
+
+    const uint8_t ops = network.ops;
+    if (network.shape == Network::Pair)
+        return join (join (parts [0], parts [1], (ops >> 1) & 1),
+                     join (parts [2], parts [3], (ops >> 2) & 1),
+                     ops & 1).text;
+
+    Term term = parts [network.parts - 1];
+    for (int i = network.parts - 2; i >= 0; --i)
+        term = join (parts [i], term, (ops >> i) & 1);
+
+    return term.text;
+}
+
+/**
+ * Calls @a visitor with the two 2-part networks whose value surrounds
+ * @a required, and with their index in the sorted list
+ */
+template <typename Visitor>
+void CombinationSolver::visitPairs (const double required, Visitor visitor) const {
+    const size_t index = lowerPair (required);
+
+    if (index > 0)
+        visitor (m_pairs [index - 1], index - 1);
+    if (index < m_pairs.size())
+        visitor (m_pairs [index], index);
+}
+
+/**
+ * Returns the index of the first 2-part network with a value that is not
+ * lower than @a value (like @c std::lower_bound), only bisecting the
+ * bucket of @a value
+ */
+size_t CombinationSolver::lowerPair (const double value) const {
+    if (m_pairValues.empty() || value <= m_pairValues.front())
+        return 0;
+    if (value > m_pairValues.back())
+        return m_pairValues.size();
+
+    const uint64_t b = bucket (value) - m_firstBucket;
+    const double* first = m_pairValues.data() + m_pairBuckets [b];
+    const double* last = m_pairValues.data() + m_pairBuckets [b + 1];
+    return static_cast<size_t> (std::lower_bound (first, last, value) - m_pairValues.data());
+}
+
+/**
+ * Searches the networks with 1, 2 and 3 parts
+ */
+void CombinationSolver::searchSmall (const CombinationQuery& query,
+                                     Collector& collector) const {
+    const double target = query.target;
+
+    Network network = Network();
+    network.shape = Network::Chain;
+
+    // Single parts
+    network.parts = 1;
+    network.ops = 0;
+    visitNeighbors (m_values, target, [&](const size_t index) {
+        network.values [0] = m_values [index];
+        network.resistance = m_values [index];
+        network.error = (network.resistance - target) / target;
+        collector.add (network);
+    });
+
+    // 2-part and 3-part networks
+    for (size_t i = 0; i < m_values.size(); ++i) {
+        const double value = m_values [i];
+
+        for (int op = 0; op < 2; ++op) {
+            double required;
+            if (!partner (target, value, op, &required))
+                continue;
+
+            network.values [0] = value;
+
+            if (query.maxParts >= 2) {
+                network.parts = 2;
+                visitNeighbors (m_values, required, [&](const size_t index) {
+                    network.values [1] = m_values [index];
+                    network.ops = static_cast<uint8_t> (op);
+                    network.resistance = combine (value, m_values [index], op);
+                    network.error = (network.resistance - target) / target;
+                    collector.add (network);
+                });
+            }
+
+            if (query.maxParts >= 3) {
+                network.parts = 3;
+                visitPairs (required, [&](const PairValue& pair, size_t) {
+                    network.values [1] = m_values [pair.a];
+                    network.values [2] = m_values [pair.b];
+                    network.ops = static_cast<uint8_t> (op | (pair.parallel << 1));
+                    network.resistance = combine (value, pair.value, op);
+                    network.error = (network.resistance - target) / target;
+                    collector.add (network);
+                });
+            }
+        }
+    }
+}
+
+/**
+ * Searches the 4-part networks with a chain layout, where the first part
+ * is the value with an index in [@a begin, @a end)
+ */
+void CombinationSolver::searchChain (const CombinationQuery& query,
+                                     const size_t begin,
+                                     const size_t end,
+                                     Collector& collector) const {
+    const double target = query.target;
+
+    Network network = Network();
+    network.shape = Network::Chain;
+    network.parts = 4;
+
+    for (size_t i = begin; i < end; ++i) {
+        const double first = m_values [i];
+
+        for (int outer = 0; outer < 2; ++outer) {
+            // Value that the other three parts must have
+            double rest;
+            if (!partner (target, first, outer, &rest))
+                continue;
+
+            // The second part must be lower than the rest for series
+            // connections, and higher for parallel connections
+            const size_t split = static_cast<size_t> (
+                        std::lower_bound (m_values.begin(), m_values.end(), rest) - m_values.begin());
+
+            for (int inner = 0; inner < 2; ++inner) {
+                const size_t from = inner ? split : 0;
+                const size_t to = inner ? m_values.size() : split;
+
+                for (size_t j = from; j < to; ++j) {
+                    const double second = m_values [j];
+
+                    double required;
+                    if (!partner (rest, second, inner, &required))
+                        continue;
+
+                    visitPairs (required, [&](const PairValue& pair, size_t) {
+                        const double value = combine (first, combine (second, pair.value, inner), outer);
+                        const double error = (value - target) / target;
+                        if (fabs (error) > collector.threshold (4))
+                            return;
+
+                        network.values [0] = first;
+                        network.values [1] = second;
+                        network.values [2] = m_values [pair.a];
+                        network.values [3] = m_values [pair.b];
+                        network.ops = static_cast<uint8_t> (outer | (inner << 1) | (pair.parallel << 2));
+                        network.resistance = value;
+                        network.error = error;
+                        collector.add (network);
+                    });
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Searches the 4-part networks made of two 2-part networks, where the
+ * first one has an index in [@a begin, @a end)
+ */
+void CombinationSolver::searchPair (const CombinationQuery& query,
+                                    const size_t begin,
+                                    const size_t end,
+                                    Collector& collector) const {
+    const double target = query.target;
+
+    Network network = Network();
+    network.shape = Network::Pair;
+    network.parts = 4;
+
+    for (size_t i = begin; i < end; ++i) {
+        const PairValue& left = m_pairs [i];
+
+        for (int op = 0; op < 2; ++op) {
+            double required;
+            if (!partner (target, left.value, op, &required))
+                continue;
+
+            visitPairs (required, [&](const PairValue& right, const size_t index) {
+                // Each pair of networks is visited twice, keep one
+                if (index < i)
+                    return;
+
+                const double value = combine (left.value, right.value, op);
+                const double error = (value - target) / target;
+                if (fabs (error) > collector.threshold (4))
+                    return;
+
+                network.values [0] = m_values [left.a];
+                network.values [1] = m_values [left.b];
+                network.values [2] = m_values [right.a];
+                network.values [3] = m_values [right.b];
+                network.ops = static_cast<uint8_t> (op | (left.parallel << 1) | (right.parallel << 2));
+                network.resistance = value;
+                network.error = error;
+                collector.add (network);
+            });
+        }
+    }
+}
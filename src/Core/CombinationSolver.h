@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_COMBINATION_SOLVER_H
+#define RESISTOR_COMBINATION_SOLVER_H
+
+#include <string>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ESeries.h"
+
+namespace ResistorCore
+{
+
+class BatchExecutor;
+
+/**
+ * Series/parallel network of up to four resistors.
+ *
+ * Bit k of @c ops is set if the k-th operation is a parallel connection
+ * (otherwise it is a series connection), networks are laid out as:
+ *
+ * - 1 part:  v0
+ * - Chain:   v0 op0 (v1 op1 (v2 op2 v3)), truncated to the number of parts
+ * - Pair:    (v0 op1 v1) op0 (v2 op2 v3), only used with 4 parts
+ */
+struct Network {
+    enum Shape {
+        Chain = 0,
+        Pair  = 1
+    };
+
+    double resistance;
+    double error;
+    double values [4];
+    uint8_t parts;
+    uint8_t shape;
+    uint8_t ops;
+};
+
+/**
+ * Parameters of a search, @c tolerance is the largest accepted relative
+ * error (e.g. 0.001 for 0.1%)
+ */
+struct CombinationQuery {
+    double target;
+    double tolerance;
+    int maxParts;
+    size_t maxResults;
+};
+
+/**
+ * Finds series, parallel and mixed networks of 1 to 4 stock resistors
+ * that approximate a target resistance.
+ *
+ * The solver keeps the sorted values of every 2-part network of the
+ * inventory, which is built once when the inventory changes. Each query
+ * fixes the outer parts of a network, derives the value that the rest of
+ * the network must have, and binary searches it among the stored values
+ * (meet in the middle), so a 4-part search over n values costs about
+ * n^2 log n instead of n^4. The stored values are bucketed by the top
+ * bits of their floating-point representation, so each search only
+ * bisects a handful of neighboring values. Outer loops are pruned to the values that can
+ * still reach the target, and are split over the threads of an optional
+ * @c BatchExecutor.
+ */
+class CombinationSolver
+{
+public:
+    static const size_t MAX_INVENTORY = 2048;
+
+    explicit CombinationSolver (BatchExecutor* executor = NULL);
+
+    void setInventory (const double* values, const size_t count);
+    void setSeries (const ESeries series, const double minimum, const double maximum);
+
+    size_t inventorySize() const;
+    const std::vector<double>& inventory() const;
+
+    std::vector<Network> solve (const CombinationQuery& query) const;
+
+    static double evaluate (const Network& network);
+    static std::string describe (const Network& network);
+
+private:
+    struct PairValue {
+        double value;
+        uint16_t a;
+        uint16_t b;
+        uint8_t parallel;
+    };
+
+    class Collector;
+
+    void searchSmall (const CombinationQuery& query, Collector& collector) const;
+    void searchChain (const CombinationQuery& query, const size_t begin,
+                      const size_t end, Collector& collector) const;
+    void searchPair (const CombinationQuery& query, const size_t begin,
+                     const size_t end, Collector& collector) const;
+
+    size_t lowerPair (const double value) const;
+
+    template <typename Visitor>
+    void visitPairs (const double required, Visitor visitor) const;
+
+private:
+    BatchExecutor* m_executor;
+    std::vector<double> m_values;
+    std::vector<PairValue> m_pairs;
+    std::vector<double> m_pairValues;
+    std::vector<uint32_t> m_pairBuckets;
+    uint64_t m_firstBucket;
+};
+
+}
+
+#endif
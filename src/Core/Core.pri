@@ -0,0 +1,104 @@
+#
+# Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+
+
+#-------------------------------------------------------------------------------
+# Qt-free decoding core (shared by the application and the ResistanceCore lib)
+#-------------------------------------------------------------------------------
+
+CONFIG += c++14
+CONFIG += thread
+INCLUDEPATH += $$PWD
+
+#-------------------------------------------------------------------------------
+# Optional band lookup table, use "qmake CONFIG+=band_table" to decode the
+# colors of ResistanceInfo through a table that is built on first use, or
+# "qmake CONFIG+=band_table_static" to generate the table at compile time
+#-------------------------------------------------------------------------------
+
+band_table_static {
+    CONFIG += band_table
+    DEFINES += BAND_TABLE_STATIC
+}
+
+band_table {
+    DEFINES += ENABLE_BAND_TABLE
+}
+
+#-------------------------------------------------------------------------------
+# Import source code
+#-------------------------------------------------------------------------------
+
+HEADERS += \
+    $$PWD/BandBatch.h \
+    $$PWD/BandOrder.h \
+    $$PWD/BatchExecutor.h \
+    $$PWD/BandTable.h \
+    $$PWD/CombinationSolver.h \
+    $$PWD/DividerSolver.h \
+    $$PWD/Dual.h \
+    $$PWD/ESeries.h \
+    $$PWD/ExactResistance.h \
+    $$PWD/Expression.h \
+    $$PWD/GainSolver.h \
+    $$PWD/Interval.h \
+    $$PWD/Marking.h \
+    $$PWD/MonteCarlo.h \
+    $$PWD/Netlist.h \
+    $$PWD/NetworkSolver.h \
+    $$PWD/ResistanceFormatter.h \
+    $$PWD/ResistanceParser.h \
+    $$PWD/ResistorCode.h \
+    $$PWD/ResistorCore.h \
+    $$PWD/ReverseLookup.h \
+    $$PWD/SmdDecoder.h \
+    $$PWD/SmdLookup.h \
+    $$PWD/SparseCholesky.h \
+    $$PWD/Thermal.h \
+    $$PWD/WorstCase.h
+
+SOURCES += \
+    $$PWD/BandBatch.cpp \
+    $$PWD/BandOrder.cpp \
+    $$PWD/BatchExecutor.cpp \
+    $$PWD/BandTable.cpp \
+    $$PWD/CombinationSolver.cpp \
+    $$PWD/DividerSolver.cpp \
+    $$PWD/ESeries.cpp \
+    $$PWD/ExactResistance.cpp \
+    $$PWD/Expression.cpp \
+    $$PWD/GainSolver.cpp \
+    $$PWD/Interval.cpp \
+    $$PWD/Marking.cpp \
+    $$PWD/MonteCarlo.cpp \
+    $$PWD/Netlist.cpp \
+    $$PWD/NetworkSolver.cpp \
+    $$PWD/ResistanceFormatter.cpp \
+    $$PWD/ResistanceParser.cpp \
+    $$PWD/ResistorCode.cpp \
+    $$PWD/ResistorCore.cpp \
+    $$PWD/ReverseLookup.cpp \
+    $$PWD/SmdDecoder.cpp \
+    $$PWD/SmdLookup.cpp \
+    $$PWD/SparseCholesky.cpp \
+    $$PWD/Thermal.cpp \
+    $$PWD/WorstCase.cpp
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "DividerSolver.h"
+
+#include <math.h>
+#include <assert.h>
+#include <algorithm>
+
+using namespace ResistorCore;
+
+/**
+ * Ranks dividers by nominal error, then by worst-case error and then by
+ * total resistance
+ */
+static bool better (const Divider& a, const Divider& b) {
+    if (fabs (a.error) != fabs (b.error))
+        return fabs (a.error) < fabs (b.error);
+    if (a.worstCaseError != b.worstCaseError)
+        return a.worstCaseError < b.worstCaseError;
+
+    return a.r1 + a.r2 < b.r1 + b.r2;
+}
+
+/**
+ * Changes the stock values that can be used by the dividers, non-positive
+ * and repeated values are ignored
+ */
+void DividerSolver::setInventory (const double* values, const size_t count) {
+    sortInventory (values, count, &m_values);
+}
+
+/**
+ * Uses the values of the given standard @a series between @a minimum
+ * and @a maximum (inclusive) as the inventory
+ */
+void DividerSolver::setSeries (const ESeries series,
+                               const double minimum,
+                               const double maximum) {
+    seriesInventory (series, minimum, maximum, &m_values);
+}
+
+/**
+ * Returns the number of stock values used by the dividers
+ */
+size_t DividerSolver::inventorySize() const {
+    return m_values.size();
+}
+
+/**
+ * Returns the best @c maxResults dividers for the given @a query, sorted
+ * from best to worst (see @c better())
+ */
+std::vector<Divider> DividerSolver::solve (const DividerQuery& query) const {
+    std::vector<Divider> heap;
+    if (!(query.ratio > 0 && query.ratio < 1) || query.maxResults == 0)
+        return heap;
+
+    const double scale = (1 - query.ratio) / query.ratio;
+    const size_t n = m_values.size();
+
+    size_t i = 0;
+    for (size_t j = 0; j < n; ++j) {
+        const double r2 = m_values [j];
+
+        // Move the r1 pointer to the first value above the ideal r1
+        const double ideal = r2 * scale;
+        while (i < n && m_values [i] < ideal)
+            ++i;
+
+        // Check both neighbors of the ideal value
+        for (size_t k = (i > 0 ? i - 1 : 0); k <= i && k < n; ++k) {
+            const double r1 = m_values [k];
+            const double total = r1 + r2;
+            if (total < query.minTotal || total > query.maxTotal)
+                continue;
+
+            const Divider divider = evaluate (r1, r2, query.ratio, query.tolerance);
+            if (heap.size() < query.maxResults) {
+                heap.push_back (divider);
+                std::push_heap (heap.begin(), heap.end(), better);
+            }
+
+            else if (better (divider, heap.front())) {
+                std::pop_heap (heap.begin(), heap.end(), better);
+                heap.back() = divider;
+                std::push_heap (heap.begin(), heap.end(), better);
+            }
+        }
+    }
+
+    std::sort_heap (heap.begin(), heap.end(), better);
+    return heap;
+}
+
+/**
+ * Returns the minimum total resistance of a divider across the given
+ * @a voltage that draws at most the given @a current
+ */
+double DividerSolver::totalForCurrent (const double voltage, const double current) {
+    assert (current > 0);
+    return fabs (voltage) / current;
+}
+
+/**
+ * Calculates the nominal and worst-case errors of the divider made of
+ * @a r1 and @a r2 for the given target @a ratio, when both parts have
+ * the given @a tolerance strip
+ */
+Divider DividerSolver::evaluate (const double r1,
+                                 const double r2,
+                                 const double ratio,
+                                 const Tolerance tolerance) {
+    const double t = toleranceValue (tolerance);
+
+    // The ratio is lowest with r2 at its minimum and r1 at its maximum
+    const double low = r2 * (1 - t) / (r2 * (1 - t) + r1 * (1 + t));
+    const double high = r2 * (1 + t) / (r2 * (1 + t) + r1 * (1 - t));
+
+    Divider divider;
+    divider.r1 = r1;
+    divider.r2 = r2;
+    divider.ratio = r2 / (r1 + r2);
+    divider.error = (divider.ratio - ratio) / ratio;
+    divider.worstCaseError = std::max (fabs (low - ratio), fabs (high - ratio)) / ratio;
+    return divider;
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_DIVIDER_SOLVER_H
+#define RESISTOR_DIVIDER_SOLVER_H
+
+#include <vector>
+#include <stddef.h>
+
+#include "ESeries.h"
+#include "ResistorCore.h"
+
+namespace ResistorCore
+{
+
+/**
+ * Voltage divider where Vout / Vin = r2 / (r1 + r2). @c error is the
+ * relative error of the nominal ratio, @c worstCaseError is the largest
+ * relative error when both parts are at the ends of their tolerance.
+ */
+struct Divider {
+    double r1;
+    double r2;
+    double ratio;
+    double error;
+    double worstCaseError;
+};
+
+/**
+ * Parameters of a search, the total resistance (r1 + r2) of each divider
+ * must be between @c minTotal and @c maxTotal. Use @c totalForCurrent()
+ * to turn a current budget into a minimum total resistance.
+ */
+struct DividerQuery {
+    double ratio;
+    double minTotal;
+    double maxTotal;
+    Tolerance tolerance;
+    size_t maxResults;
+};
+
+/**
+ * Finds the pairs of stock values that best approximate a divider ratio.
+ *
+ * For a given r2, the ideal r1 is r2 (1 - ratio) / ratio, which grows
+ * with r2. The solver walks the sorted inventory with two pointers, one
+ * over r2 and one over the ideal r1, so a query only checks the two
+ * neighbors of each ideal value and runs in linear time.
+ */
+class DividerSolver
+{
+public:
+    void setInventory (const double* values, const size_t count);
+    void setSeries (const ESeries series, const double minimum, const double maximum);
+
+    size_t inventorySize() const;
+
+    std::vector<Divider> solve (const DividerQuery& query) const;
+
+    static double totalForCurrent (const double voltage, const double current);
+    static Divider evaluate (const double r1, const double r2,
+                             const double ratio, const Tolerance tolerance);
+
+private:
+    std::vector<double> m_values;
+};
+
+}
+
+#endif
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_DUAL_H
+#define RESISTOR_DUAL_H
+
+#include <math.h>
+#include <stddef.h>
+
+namespace ResistorCore
+{
+
+/**
+ * Calls @a function for every index in [I, N), the recursion is resolved
+ * at compile time so the calls are emitted as straight-line code
+ */
+template <size_t I, size_t N>
+struct DualUnroll {
+    template <typename Function>
+    static inline void run (const Function& function) {
+        function (I);
+        DualUnroll<I + 1, N>::run (function);
+    }
+};
+
+template <size_t N>
+struct DualUnroll<N, N> {
+    template <typename Function>
+    static inline void run (const Function&) {}
+};
+
+/**
+ * Forward-mode automatic differentiation with @a N partial derivatives.
+ *
+ * A dual number carries a value and its derivatives with respect to N
+ * independent variables. Evaluating an expression over dual numbers
+ * gives its value and its full gradient in a single pass, instead of
+ * the N + 1 evaluations needed by finite differences, and without their
+ * truncation error. The size is fixed at compile time and every loop
+ * over the derivatives is unrolled by @c DualUnroll, so an expression
+ * compiles to straight-line code.
+ */
+template <size_t N>
+struct Dual {
+    double value;
+    double derivative [N];
+
+    Dual() : value (0) {
+        DualUnroll<0, N>::run ([&](const size_t i) {
+            derivative [i] = 0;
+        });
+    }
+
+    Dual (const double constant) : value (constant) {
+        DualUnroll<0, N>::run ([&](const size_t i) {
+            derivative [i] = 0;
+        });
+    }
+
+    /**
+     * Returns the independent variable @a index with the given @a value
+     */
+    static Dual variable (const double value, const size_t index) {
+        Dual dual (value);
+        dual.derivative [index] = 1;
+        return dual;
+    }
+};
+
+template <size_t N>
+inline Dual<N> operator+ (const Dual<N>& a, const Dual<N>& b) {
+    Dual<N> r (a.value + b.value);
+    DualUnroll<0, N>::run ([&](const size_t i) {
+        r.derivative [i] = a.derivative [i] + b.derivative [i];
+    });
+    return r;
+}
+
+template <size_t N>
+inline Dual<N> operator- (const Dual<N>& a, const Dual<N>& b) {
+    Dual<N> r (a.value - b.value);
+    DualUnroll<0, N>::run ([&](const size_t i) {
+        r.derivative [i] = a.derivative [i] - b.derivative [i];
+    });
+    return r;
+}
+
+template <size_t N>
+inline Dual<N> operator- (const Dual<N>& a) {
+    Dual<N> r (-a.value);
+    DualUnroll<0, N>::run ([&](const size_t i) {
+        r.derivative [i] = -a.derivative [i];
+    });
+    return r;
+}
+
+template <size_t N>
+inline Dual<N> operator* (const Dual<N>& a, const Dual<N>& b) {
+    Dual<N> r (a.value * b.value);
+    DualUnroll<0, N>::run ([&](const size_t i) {
+        r.derivative [i] = a.derivative [i] * b.value + a.value * b.derivative [i];
+    });
+    return r;
+}
+
+template <size_t N>
+inline Dual<N> operator/ (const Dual<N>& a, const Dual<N>& b) {
+    const double inverse = 1 / b.value;
+    Dual<N> r (a.value * inverse);
+    DualUnroll<0, N>::run ([&](const size_t i) {
+        r.derivative [i] = (a.derivative [i] - r.value * b.derivative [i]) * inverse;
+    });
+    return r;
+}
+
+/*
+ * Operations with constants, which skip the derivatives of the constant
+ */
+template <size_t N>
+inline Dual<N> operator+ (const Dual<N>& a, const double b) {
+    Dual<N> r (a);
+    r.value += b;
+    return r;
+}
+
+template <size_t N>
+inline Dual<N> operator+ (const double a, const Dual<N>& b) {
+    return b + a;
+}
+
+template <size_t N>
+inline Dual<N> operator- (const Dual<N>& a, const double b) {
+    Dual<N> r (a);
+    r.value -= b;
+    return r;
+}
+
+template <size_t N>
+inline Dual<N> operator- (const double a, const Dual<N>& b) {
+    return -b + a;
+}
+
+template <size_t N>
+inline Dual<N> operator* (const Dual<N>& a, const double b) {
+    Dual<N> r (a.value * b);
+    DualUnroll<0, N>::run ([&](const size_t i) {
+        r.derivative [i] = a.derivative [i] * b;
+    });
+    return r;
+}
+
+template <size_t N>
+inline Dual<N> operator* (const double a, const Dual<N>& b) {
+    return b * a;
+}
+
+template <size_t N>
+inline Dual<N> operator/ (const Dual<N>& a, const double b) {
+    return a * (1 / b);
+}
+
+template <size_t N>
+inline Dual<N> operator/ (const double a, const Dual<N>& b) {
+    const double inverse = 1 / b.value;
+    const double scale = -a * inverse * inverse;
+
+    Dual<N> r (a * inverse);
+    DualUnroll<0, N>::run ([&](const size_t i) {
+        r.derivative [i] = b.derivative [i] * scale;
+    });
+    return r;
+}
+
+template <size_t N>
+inline Dual<N>& operator+= (Dual<N>& a, const Dual<N>& b) { return a = a + b; }
+template <size_t N>
+inline Dual<N>& operator-= (Dual<N>& a, const Dual<N>& b) { return a = a - b; }
+template <size_t N>
+inline Dual<N>& operator*= (Dual<N>& a, const Dual<N>& b) { return a = a * b; }
+template <size_t N>
+inline Dual<N>& operator/= (Dual<N>& a, const Dual<N>& b) { return a = a / b; }
+
+/*
+ * Keep the standard math functions visible from the library namespace,
+ * otherwise the overloads below would hide them
+ */
+using ::sqrt;
+using ::log;
+using ::exp;
+
+template <size_t N>
+inline Dual<N> sqrt (const Dual<N>& a) {
+    Dual<N> r (::sqrt (a.value));
+    const double scale = 0.5 / r.value;
+    DualUnroll<0, N>::run ([&](const size_t i) {
+        r.derivative [i] = a.derivative [i] * scale;
+    });
+    return r;
+}
+
+template <size_t N>
+inline Dual<N> log (const Dual<N>& a) {
+    Dual<N> r (::log (a.value));
+    DualUnroll<0, N>::run ([&](const size_t i) {
+        r.derivative [i] = a.derivative [i] / a.value;
+    });
+    return r;
+}
+
+template <size_t N>
+inline Dual<N> exp (const Dual<N>& a) {
+    Dual<N> r (::exp (a.value));
+    DualUnroll<0, N>::run ([&](const size_t i) {
+        r.derivative [i] = a.derivative [i] * r.value;
+    });
+    return r;
+}
+
+}
+
+#endif
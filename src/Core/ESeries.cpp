@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ESeries.h"
+
+#include <math.h>
+#include <assert.h>
+#include <algorithm>
+
+using namespace ResistorCore;
+
+/**
+ * Significands of the E24 series, E3, E6 and E12 take every 8th, 4th and
+ * 2nd value of this list
+ */
+static constexpr int E24_VALUES [24] = {
+    10, 11, 12, 13, 15, 16, 18, 20, 22, 24, 27, 30,
+    33, 36, 39, 43, 47, 51, 56, 62, 68, 75, 82, 91
+};
+
+/**
+ * Significands of the E192 series, E48 and E96 take every 4th and 2nd
+ * value of this list
+ */
+static constexpr int E192_VALUES [192] = {
+    100, 101, 102, 104, 105, 106, 107, 109, 110, 111, 113, 114,
+    115, 117, 118, 120, 121, 123, 124, 126, 127, 129, 130, 132,
+    133, 135, 137, 138, 140, 142, 143, 145, 147, 149, 150, 152,
+    154, 156, 158, 160, 162, 164, 165, 167, 169, 172, 174, 176,
+    178, 180, 182, 184, 187, 189, 191, 193, 196, 198, 200, 203,
+    205, 208, 210, 213, 215, 218, 221, 223, 226, 229, 232, 234,
+    237, 240, 243, 246, 249, 252, 255, 258, 261, 264, 267, 271,
+    274, 277, 280, 284, 287, 291, 294, 298, 301, 305, 309, 312,
+    316, 320, 324, 328, 332, 336, 340, 344, 348, 352, 357, 361,
+    365, 370, 374, 379, 383, 388, 392, 397, 402, 407, 412, 417,
+    422, 427, 432, 437, 442, 448, 453, 459, 464, 470, 475, 481,
+    487, 493, 499, 505, 511, 517, 523, 530, 536, 542, 549, 556,
+    562, 569, 576, 583, 590, 597, 604, 612, 619, 626, 634, 642,
+    649, 657, 665, 673, 681, 690, 698, 706, 715, 723, 732, 741,
+    750, 759, 768, 777, 787, 796, 806, 816, 825, 835, 845, 856,
+    866, 876, 887, 898, 909, 920, 931, 942, 953, 965, 976, 988
+};
+
+/**
+ * Number of values per decade of each series
+ */
+static constexpr int SERIES_SIZES [SERIES_COUNT] = { 3, 6, 12, 24, 48, 96, 192 };
+
+/**
+ * Offsets of each series in the catalog
+ */
+static constexpr size_t SERIES_OFFSETS [SERIES_COUNT + 1] = {
+    0,
+    3 * SERIES_DECADES,
+    9 * SERIES_DECADES,
+    21 * SERIES_DECADES,
+    45 * SERIES_DECADES,
+    93 * SERIES_DECADES,
+    189 * SERIES_DECADES,
+    381 * SERIES_DECADES
+};
+
+/**
+ * Number of 64-bit words needed to flag every significand (100-999)
+ */
+static const int MEMBER_WORDS = (900 + 63) / 64;
+
+/**
+ * Every value of every series over all decades (sorted within each
+ * series), and a bitset with the significands of each series
+ */
+struct Catalog {
+    double values [SERIES_OFFSETS [SERIES_COUNT]];
+    uint64_t members [SERIES_COUNT][MEMBER_WORDS];
+};
+
+/**
+ * Returns the 3-digit significand (100-999) of the given @a index of
+ * the given @a series
+ */
+static constexpr int significand (const int series, const int index) {
+    return series <= SeriesE24 ?
+                E24_VALUES [index * (24 / SERIES_SIZES [series])] * 10 :
+                E192_VALUES [index * (192 / SERIES_SIZES [series])];
+}
+
+static constexpr Catalog makeCatalog() {
+    Catalog catalog {};
+    for (int series = 0; series < SERIES_COUNT; ++series) {
+        const int size = SERIES_SIZES [series];
+        size_t offset = SERIES_OFFSETS [series];
+
+        for (int decade = 0; decade < SERIES_DECADES; ++decade) {
+            // Get 10^|p|, where the value is significand * 10^p
+            const int power = SERIES_MIN_DECADE + decade - 2;
+            double scale = 1;
+            for (int i = 0; i < (power < 0 ? -power : power); ++i)
+                scale *= 10;
+
+            // Divide by an exact power of ten, so that the result is the
+            // closest double to the decimal value
+            for (int i = 0; i < size; ++i) {
+                const double value = significand (series, i);
+                catalog.values [offset++] = power < 0 ? value / scale : value * scale;
+            }
+        }
+
+        for (int i = 0; i < size; ++i) {
+            const int bit = significand (series, i) - 100;
+            catalog.members [series][bit / 64] |= uint64_t (1) << (bit % 64);
+        }
+    }
+
+    return catalog;
+}
+
+static constexpr Catalog CATALOG = makeCatalog();
+
+/**
+ * Returns the index of the last value of the sorted @a values array that
+ * is lower or equal than @a x (or 0 if every value is greater than @a x).
+ *
+ * The loop runs a fixed number of iterations for a given @a size and
+ * the comparison compiles to a conditional move, so the search has no
+ * unpredictable branches.
+ */
+static inline size_t floorIndex (const double* values, const size_t size, const double x) {
+    const double* base = values;
+    size_t n = size;
+    while (n > 1) {
+        const size_t half = n / 2;
+        base = (base [half] <= x) ? base + half : base;
+        n -= half;
+    }
+
+    return static_cast<size_t> (base - values);
+}
+
+/**
+ * Fills a match with the neighbors of @a x, where @a index is the result
+ * of @c floorIndex(). The nearest value is chosen in the log domain, i.e.
+ * the upper neighbor wins if @a x is above the geometric mean of both.
+ */
+static inline StandardMatch match (const double* values,
+                                   const size_t size,
+                                   const size_t index,
+                                   const double x) {
+    const size_t next = index + ((values [index] < x) & (index + 1 < size));
+
+    StandardMatch result;
+    result.lower = values [index];
+    result.upper = values [next];
+    result.nearest = (x * x > result.lower * result.upper) ? result.upper : result.lower;
+    result.error = (result.nearest - x) / x;
+    return result;
+}
+
+/**
+ * Returns the number of values per decade of the given @a series
+ */
+int ResistorCore::seriesSize (const ESeries series) {
+    assert (series >= SeriesE3 && series <= SeriesE192);
+    return SERIES_SIZES [series];
+}
+
+/**
+ * Returns the name of the given @a series (e.g. "E24")
+ */
+const char* ResistorCore::seriesName (const ESeries series) {
+    assert (series >= SeriesE3 && series <= SeriesE192);
+
+    static const char* names [SERIES_COUNT] = {
+        "E3", "E6", "E12", "E24", "E48", "E96", "E192"
+    };
+
+    return names [series];
+}
+
+/**
+ * Returns the series that is manufactured with the given @a tolerance
+ * (e.g. E24 for 5%, E96 for 1%)
+ */
+ESeries ResistorCore::seriesForTolerance (const double tolerance) {
+    if (tolerance > 0.2)
+        return SeriesE3;
+    if (tolerance >= 0.2)
+        return SeriesE6;
+    if (tolerance >= 0.1)
+        return SeriesE12;
+    if (tolerance >= 0.05)
+        return SeriesE24;
+    if (tolerance >= 0.02)
+        return SeriesE48;
+    if (tolerance >= 0.01)
+        return SeriesE96;
+
+    return SeriesE192;
+}
+
+/**
+ * Points @a values to the sorted list of every value of the given
+ * @a series over all decades, returns the number of values
+ */
+size_t ResistorCore::seriesValues (const ESeries series, const double** values) {
+    assert (series >= SeriesE3 && series <= SeriesE192);
+    assert (values != NULL);
+
+    *values = CATALOG.values + SERIES_OFFSETS [series];
+    return SERIES_OFFSETS [series + 1] - SERIES_OFFSETS [series];
+}
+
+/**
+ * Fills @a inventory with the given stock @a values sorted in ascending
+ * order, non-positive, infinite and repeated values are dropped
+ */
+void ResistorCore::sortInventory (const double* values,
+                                  const size_t count,
+                                  std::vector<double>* inventory) {
+    assert (values != NULL || count == 0);
+    assert (inventory != NULL);
+
+    inventory->clear();
+    for (size_t i = 0; i < count; ++i) {
+        if (values [i] > 0 && values [i] < HUGE_VAL)
+            inventory->push_back (values [i]);
+    }
+
+    std::sort (inventory->begin(), inventory->end());
+    inventory->erase (std::unique (inventory->begin(), inventory->end()), inventory->end());
+}
+
+/**
+ * Fills @a inventory with the values of the given @a series between
+ * @a minimum and @a maximum (inclusive), in ascending order
+ */
+void ResistorCore::seriesInventory (const ESeries series,
+                                    const double minimum,
+                                    const double maximum,
+                                    std::vector<double>* inventory) {
+    assert (inventory != NULL);
+
+    const double* values;
+    const size_t count = seriesValues (series, &values);
+
+    const double* first = std::lower_bound (values, values + count, minimum);
+    const double* last = std::upper_bound (values, values + count, maximum);
+    inventory->assign (first, std::max (first, last));
+}
+
+/**
+ * Returns @c true if the given @a resistance (rounded to the nearest
+ * milliohm) is a value of the given @a series
+ */
+bool ResistorCore::isStandardValue (const double resistance, const ESeries series) {
+    assert (series >= SeriesE3 && series <= SeriesE192);
+
+    int digits;
+    int exponent;
+    if (!splitMilliohms (toMilliohms (resistance), &digits, &exponent))
+        return false;
+
+    const int decade = exponent + 2;
+    if (decade < SERIES_MIN_DECADE || decade >= SERIES_MIN_DECADE + SERIES_DECADES)
+        return false;
+
+    const int bit = digits - 100;
+    return (CATALOG.members [series][bit / 64] >> (bit % 64)) & 1;
+}
+
+/**
+ * Returns the value of the given @a series that is closest to the given
+ * @a resistance (in the log domain)
+ */
+double ResistorCore::nearestStandardValue (const double resistance, const ESeries series) {
+    return matchStandardValue (resistance, series).nearest;
+}
+
+/**
+ * Returns the values of the given @a series that surround the given
+ * @a resistance, values outside of the catalog are clamped to its first
+ * or last value. Non-positive resistances are returned unchanged.
+ */
+StandardMatch ResistorCore::matchStandardValue (const double resistance, const ESeries series) {
+    if (!(resistance > 0)) {
+        const StandardMatch result = { resistance, resistance, resistance, 0 };
+        return result;
+    }
+
+    const double* values;
+    const size_t size = seriesValues (series, &values);
+    return match (values, size, floorIndex (values, size, resistance), resistance);
+}
+
+/**
+ * Snaps @a count @a resistances to the nearest value of the given
+ * @a series, the relative errors are written to @a errors (if not NULL).
+ *
+ * Values are searched in groups of 8, with the steps of each search
+ * interleaved so that the loads of the catalog overlap.
+ */
+void ResistorCore::nearestStandardValues (const ESeries series,
+                                          const double* resistances,
+                                          const size_t count,
+                                          double* nearest,
+                                          double* errors) {
+    assert (resistances != NULL || count == 0);
+    assert (nearest != NULL || count == 0);
+
+    const size_t LANES = 8;
+
+    const double* values;
+    const size_t size = seriesValues (series, &values);
+
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        const double* x = resistances + i;
+
+        // Run the searches in lockstep
+        const double* base [LANES];
+        for (size_t lane = 0; lane < LANES; ++lane)
+            base [lane] = values;
+
+        size_t n = size;
+        while (n > 1) {
+            const size_t half = n / 2;
+            for (size_t lane = 0; lane < LANES; ++lane)
+                base [lane] = (base [lane][half] <= x [lane]) ? base [lane] + half : base [lane];
+
+            n -= half;
+        }
+
+        // Pick the nearest neighbor of each value
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            StandardMatch result = { x [lane], x [lane], x [lane], 0 };
+            if (x [lane] > 0)
+                result = match (values, size, static_cast<size_t> (base [lane] - values), x [lane]);
+
+            nearest [i + lane] = result.nearest;
+            if (errors)
+                errors [i + lane] = result.error;
+        }
+    }
+
+    // Snap remaining values
+    for (; i < count; ++i) {
+        const StandardMatch result = matchStandardValue (resistances [i], series);
+        nearest [i] = result.nearest;
+        if (errors)
+            errors [i] = result.error;
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_E_SERIES_H
+#define RESISTOR_E_SERIES_H
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ResistorCore.h"
+
+namespace ResistorCore
+{
+
+/**
+ * IEC 60063 preferred number series
+ */
+enum ESeries {
+    SeriesE3   = 0,
+    SeriesE6   = 1,
+    SeriesE12  = 2,
+    SeriesE24  = 3,
+    SeriesE48  = 4,
+    SeriesE96  = 5,
+    SeriesE192 = 6
+};
+
+static const int SERIES_COUNT = 7;
+
+/**
+ * Decades covered by the catalog, from 10^-1 ohms (100 mOhm) up to
+ * 10^11 ohms (so the largest value is 988 GOhm in E192), which covers
+ * every band code (up to 999 GOhm with a white multiplier)
+ */
+static const int SERIES_MIN_DECADE = -1;
+static const int SERIES_DECADES = 13;
+
+/**
+ * Neighbors of a value in a series, @c error is the relative error of
+ * @c nearest, i.e. (nearest - value) / value
+ */
+struct StandardMatch {
+    double lower;
+    double upper;
+    double nearest;
+    double error;
+};
+
+int seriesSize (const ESeries series);
+const char* seriesName (const ESeries series);
+ESeries seriesForTolerance (const double tolerance);
+size_t seriesValues (const ESeries series, const double** values);
+
+void sortInventory (const double* values,
+                    const size_t count,
+                    std::vector<double>* inventory);
+void seriesInventory (const ESeries series,
+                      const double minimum,
+                      const double maximum,
+                      std::vector<double>* inventory);
+
+bool isStandardValue (const double resistance, const ESeries series);
+double nearestStandardValue (const double resistance, const ESeries series);
+StandardMatch matchStandardValue (const double resistance, const ESeries series);
+
+void nearestStandardValues (const ESeries series,
+                            const double* resistances,
+                            const size_t count,
+                            double* nearest,
+                            double* errors = NULL);
+
+}
+
+#endif
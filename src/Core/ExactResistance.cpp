@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ExactResistance.h"
+#include "ResistorCore.h"
+
+#include <math.h>
+#include <assert.h>
+
+using namespace ResistorCore;
+
+const int ExactResistance::EXPONENT;
+const uint64_t ExactResistance::INVALID_MICROOHMS;
+
+/**
+ * Powers of ten that fit in 64 bits
+ */
+static const uint64_t POWERS_OF_TEN [20] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull,
+    10000000ull, 100000000ull, 1000000000ull, 10000000000ull,
+    100000000000ull, 1000000000000ull, 10000000000000ull,
+    100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+    100000000000000000ull, 1000000000000000000ull,
+    10000000000000000000ull
+};
+
+/**
+ * Largest significand that can be scaled by each power of ten without
+ * reaching INVALID_MICROOHMS, so that no division is needed to detect
+ * overflows
+ */
+struct ScaleLimits {
+    uint64_t limits [20];
+};
+
+static constexpr ScaleLimits makeScaleLimits() {
+    ScaleLimits table {};
+    uint64_t power = 1;
+    for (int i = 0; i < 20; ++i) {
+        table.limits [i] = (UINT64_MAX - 1) / power;
+        power *= 10;
+    }
+
+    return table;
+}
+
+static constexpr ScaleLimits SCALE_LIMITS = makeScaleLimits();
+
+/**
+ * Values below 2^53 micro-ohms are converted to doubles without rounding
+ */
+static const uint64_t EXACT_DOUBLE_LIMIT = 1ull << 53;
+
+/**
+ * Returns the resistance @a significand x 10^@a exponent ohms, or an
+ * invalid value if it has more than six fractional digits or does not
+ * fit in 64 bits.
+ */
+ExactResistance ExactResistance::fromDecimal (uint64_t significand, int exponent) {
+    if (significand == 0)
+        return fromMicroohms (0);
+
+    exponent -= EXPONENT;
+
+    // Remove fractional digits, they must all be zeros
+    if (exponent < 0) {
+        if (exponent < -19 || significand % POWERS_OF_TEN [-exponent] != 0)
+            return ExactResistance();
+
+        return fromMicroohms (significand / POWERS_OF_TEN [-exponent]);
+    }
+
+    // Scale to micro-ohms, the largest value is reserved for INVALID
+    if (exponent > 19 || significand > SCALE_LIMITS.limits [exponent])
+        return ExactResistance();
+
+    return fromMicroohms (significand * POWERS_OF_TEN [exponent]);
+}
+
+/**
+ * Returns the given @a resistance rounded to the nearest micro-ohm.
+ * Negative values (e.g. @c UNKNOWN_RESISTANCE), NaNs and values that do
+ * not fit give an invalid value.
+ */
+ExactResistance ExactResistance::fromDouble (const double resistance) {
+    if (!(resistance >= 0) || resistance >= 1.8e13)
+        return ExactResistance();
+
+    // Round in floating point, llround() would overflow above ~9.2e12 ohms
+    return fromMicroohms (static_cast<uint64_t> (round (resistance * 1e6)));
+}
+
+/**
+ * Returns the value rounded to the nearest milliohm, which is the key
+ * used by the reverse lookup structures, or @c INVALID_MILLIOHMS
+ */
+uint64_t ExactResistance::milliohms() const {
+    if (!isValid())
+        return INVALID_MILLIOHMS;
+
+    return m_microohms / 1000 + (m_microohms % 1000 >= 500 ? 1 : 0);
+}
+
+/**
+ * Returns the double that is nearest to the exact value, or
+ * @c UNKNOWN_RESISTANCE if the value is invalid
+ */
+double ExactResistance::toDouble() const {
+    if (!isValid())
+        return UNKNOWN_RESISTANCE;
+
+    // Both operands are exact, so the quotient is correctly rounded
+    if (m_microohms < EXACT_DOUBLE_LIMIT)
+        return static_cast<double> (m_microohms) / 1e6;
+
+    // The integer part of large values is still exact
+    const uint64_t ohms = m_microohms / 1000000;
+    const uint64_t fraction = m_microohms % 1000000;
+    return static_cast<double> (ohms) + static_cast<double> (fraction) / 1e6;
+}
+
+/**
+ * Writes the value as the shortest @a significand x 10^@a exponent
+ * ohms, i.e. the significand has no trailing zeros (4.7 kOhm is 47 x
+ * 10^2). Zero is written as 0 x 10^0. Returns @c false if the value is
+ * invalid.
+ */
+bool ExactResistance::decimal (uint64_t* significand, int* exponent) const {
+    assert (significand != NULL && exponent != NULL);
+
+    if (!isValid())
+        return false;
+
+    uint64_t value = m_microohms;
+    int power = EXPONENT;
+    if (value == 0)
+        power = 0;
+
+    while (value != 0 && value % 10 == 0) {
+        value /= 10;
+        ++power;
+    }
+
+    *significand = value;
+    *exponent = power;
+    return true;
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_EXACT_RESISTANCE_H
+#define RESISTOR_EXACT_RESISTANCE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <type_traits>
+
+namespace ResistorCore
+{
+
+/**
+ * Exact resistance value, stored as an integer number of micro-ohms.
+ *
+ * Every value that can be written with color bands (0.01 ohm to 999 Gohm),
+ * SMD markings or RKM notation is a decimal with at most six fractional
+ * digits, so it is represented without rounding errors. Values can be
+ * compared, sorted and hashed with integer operations, which makes them
+ * suitable as keys for indices, caches and duplicate detection.
+ *
+ * Conversions from decimal significands and exponents are exact, the
+ * conversion to @c double is correctly rounded.
+ */
+class ExactResistance
+{
+public:
+    /**
+     * Decimal exponent of the stored integer (1 unit = 10^-6 ohms)
+     */
+    static const int EXPONENT = -6;
+
+    /**
+     * Stored value of unknown or unrepresentable resistances
+     */
+    static const uint64_t INVALID_MICROOHMS = UINT64_MAX;
+
+    constexpr ExactResistance() : m_microohms (INVALID_MICROOHMS) {}
+
+    static constexpr ExactResistance fromMicroohms (const uint64_t microohms) {
+        return ExactResistance (microohms, 0);
+    }
+
+    static ExactResistance fromDecimal (uint64_t significand, int exponent);
+    static ExactResistance fromDouble (const double resistance);
+
+    constexpr uint64_t microohms() const {
+        return m_microohms;
+    }
+
+    constexpr bool isValid() const {
+        return m_microohms != INVALID_MICROOHMS;
+    }
+
+    uint64_t milliohms() const;
+    double toDouble() const;
+    bool decimal (uint64_t* significand, int* exponent) const;
+
+    constexpr bool operator== (const ExactResistance& other) const {
+        return m_microohms == other.m_microohms;
+    }
+
+    constexpr bool operator!= (const ExactResistance& other) const {
+        return m_microohms != other.m_microohms;
+    }
+
+    constexpr bool operator< (const ExactResistance& other) const {
+        return m_microohms < other.m_microohms;
+    }
+
+    constexpr bool operator<= (const ExactResistance& other) const {
+        return m_microohms <= other.m_microohms;
+    }
+
+    constexpr bool operator> (const ExactResistance& other) const {
+        return m_microohms > other.m_microohms;
+    }
+
+    constexpr bool operator>= (const ExactResistance& other) const {
+        return m_microohms >= other.m_microohms;
+    }
+
+private:
+    constexpr ExactResistance (const uint64_t microohms, int) : m_microohms (microohms) {}
+
+private:
+    uint64_t m_microohms;
+};
+
+static_assert (sizeof (ExactResistance) == sizeof (uint64_t),
+               "ExactResistance must fit in 64 bits");
+static_assert (std::is_trivially_copyable<ExactResistance>::value,
+               "ExactResistance must be trivially copyable");
+
+}
+
+namespace std
+{
+
+template <>
+struct hash<ResistorCore::ExactResistance> {
+    size_t operator() (const ResistorCore::ExactResistance& value) const {
+        return hash<uint64_t>() (value.microohms());
+    }
+};
+
+}
+
+#endif
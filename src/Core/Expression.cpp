@@ -0,0 +1,962 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Expression.h"
+#include "SmdDecoder.h"
+#include "BatchExecutor.h"
+#include "ResistanceParser.h"
+
+#include <math.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <algorithm>
+
+using namespace ResistorCore;
+
+/**
+ * Number of bindings that are evaluated together by @c evaluateBatch(),
+ * each instruction runs over a whole block, so the loops vectorize
+ */
+static const size_t EVALUATION_BLOCK = 256;
+
+/**
+ * Stack size of @c Expression::evaluate() that does not allocate memory
+ */
+static const size_t LOCAL_STACK_DEPTH = 32;
+
+/**
+ * Limits that keep the recursive parser and the units within bounds
+ */
+static const int MAX_NESTING = 256;
+static const int MAX_UNIT_EXPONENT = 8;
+
+/**
+ * Number of cached literals allowed for each cached expression
+ */
+static const size_t LITERALS_PER_EXPRESSION = 8;
+
+static const UnitDimension DIMENSIONLESS = { 0, 0 };
+static const UnitDimension OHMS = { 1, -1 };
+static const UnitDimension VOLTS = { 1, 0 };
+static const UnitDimension AMPERES = { 0, 1 };
+static const UnitDimension WATTS = { 1, 1 };
+
+/**
+ * Equivalent of two resistances in parallel, NaN if a resistance is
+ * negative. The denominator is replaced by one when the sum is zero, which
+ * only happens with two shorts (and gives zero), and both cases are
+ * selected without a branch, which lets the block loop vectorize.
+ */
+static inline double parallel (const double a, const double b) {
+    const double sum = a + b;
+    const double value = a * b / (sum + static_cast<double> (sum == 0));
+    return (a >= 0 && b >= 0) ? value : NAN;
+}
+
+/**
+ * Applies the arithmetic instruction @a opcode to @a a and @a b
+ */
+static inline double apply (const uint32_t opcode, const double a, const double b) {
+    switch (opcode) {
+    case OpAdd:
+        return a + b;
+    case OpSubtract:
+        return a - b;
+    case OpMultiply:
+        return a * b;
+    case OpDivide:
+        return a / b;
+    case OpParallel:
+        return parallel (a, b);
+    default:
+        assert (false);
+        return 0;
+    }
+}
+
+/**
+ * Returns the UTF-8 character at @a at (all of its bytes), used to quote
+ * characters in error messages
+ */
+static std::string codePoint (const char* at, const char* end) {
+    const unsigned char lead = static_cast<unsigned char> (*at);
+    size_t length = 1;
+    if (lead >= 0xF0)
+        length = 4;
+    else if (lead >= 0xE0)
+        length = 3;
+    else if (lead >= 0xC0)
+        length = 2;
+
+    length = std::min (length, static_cast<size_t> (end - at));
+    for (size_t i = 1; i < length; ++i) {
+        if ((static_cast<unsigned char> (at [i]) & 0xC0) != 0x80)
+            return std::string (at, i);
+    }
+
+    return std::string (at, length);
+}
+
+/**
+ * Returns @c true if the @a length characters at @a text start with
+ * @a prefix, ignoring case
+ */
+static bool startsWith (const char* text, const size_t length, const char* prefix) {
+    const size_t prefixLength = strlen (prefix);
+    if (length < prefixLength)
+        return false;
+
+    for (size_t i = 0; i < prefixLength; ++i)
+        if (tolower (static_cast<unsigned char> (text [i])) != prefix [i])
+            return false;
+
+    return true;
+}
+
+/**
+ * Parses a number with an optional SI prefix and unit letter ("4k7",
+ * "12V", "2.5mA", "10kΩ", "100n", "1e-3")
+ */
+static bool decodeNumber (const char* text, const size_t length,
+                          ExpressionLiteral* literal) {
+    size_t n = length;
+    bool hasUnit = true;
+    literal->flexible = false;
+    switch (text [n - 1]) {
+    case 'V':
+        literal->dimension = VOLTS;
+        --n;
+        break;
+    case 'A':
+        literal->dimension = AMPERES;
+        --n;
+        break;
+    case 'W':
+        literal->dimension = WATTS;
+        --n;
+        break;
+    default:
+        literal->dimension = OHMS;
+        hasUnit = false;
+        break;
+    }
+
+    // Exact decimal parser of the resistance input
+    ParsedResistance parsed;
+    if (parseResistance (text, n, &parsed)) {
+        if (hasUnit && (parsed.flags & ParsedUnit))
+            return false;
+
+        literal->value = parsed.resistance.toDouble();
+        literal->flexible = !hasUnit && !(parsed.flags & (ParsedRkm | ParsedUnit | ParsedPrefix));
+        return true;
+    }
+
+    // Values below a micro-ohm or with an exponent ("100n", "1e-9"), the
+    // SPICE parser reads "M" as milli, so only accept small prefixes
+    bool prefix = false;
+    for (size_t i = 0; i < n; ++i) {
+        const char c = text [i];
+        if (c == 'f' || c == 'p' || c == 'n' || c == 'u' || c == '\xC2' || c == '\xB5')
+            prefix = true;
+
+        else if (!isdigit (static_cast<unsigned char> (c)) &&
+                 c != '.' && c != 'e' && c != 'E' && c != '+' && c != '-')
+            return false;
+    }
+
+    if (!parseSpiceValue (text, n, &literal->value))
+        return false;
+
+    literal->flexible = !hasUnit && !prefix;
+    return true;
+}
+
+/**
+ * Decodes a literal of an expression: a number, a color band code
+ * ("bands=yellow-violet-red-gold") or an SMD marking ("smd=4R7")
+ */
+static bool decodeLiteral (const char* text, const size_t length,
+                           ExpressionLiteral* literal) {
+    if (length == 0)
+        return false;
+
+    ExactResistance resistance;
+    if (startsWith (text, length, "bands=")) {
+        BandCode code;
+        if (!parseColorBands (text + 6, length - 6, &code))
+            return false;
+
+        resistance = decodeBandsExact (code);
+    }
+
+    else if (startsWith (text, length, "smd="))
+        resistance = decodeSmdExact (text + 4, length - 4);
+
+    else
+        return decodeNumber (text, length, literal);
+
+    if (!resistance.isValid())
+        return false;
+
+    literal->value = resistance.toDouble();
+    literal->dimension = OHMS;
+    literal->flexible = false;
+    return true;
+}
+
+bool ResistorCore::operator== (const UnitDimension& a, const UnitDimension& b) {
+    return a.volts == b.volts && a.amperes == b.amperes;
+}
+
+bool ResistorCore::operator!= (const UnitDimension& a, const UnitDimension& b) {
+    return !(a == b);
+}
+
+/**
+ * Returns the symbol of the given unit ("Ω", "V", "A", "W", "S"), powers
+ * of ohms and watts are written as "Ω^2" and other units as "V^2·A^-1"
+ */
+std::string ResistorCore::unitSymbol (const UnitDimension& dimension) {
+    if (dimension == DIMENSIONLESS)
+        return "";
+    if (dimension == OHMS)
+        return "\xCE\xA9";
+    if (dimension == VOLTS)
+        return "V";
+    if (dimension == AMPERES)
+        return "A";
+    if (dimension == WATTS)
+        return "W";
+    if (dimension.volts == -1 && dimension.amperes == 1)
+        return "S";
+    if (dimension.volts == -dimension.amperes)
+        return "\xCE\xA9^" + std::to_string (dimension.volts);
+    if (dimension.volts == dimension.amperes)
+        return "W^" + std::to_string (dimension.volts);
+
+    std::string symbol;
+    if (dimension.volts != 0)
+        symbol = "V^" + std::to_string (dimension.volts);
+    if (dimension.volts != 0 && dimension.amperes != 0)
+        symbol += "\xC2\xB7";
+    if (dimension.amperes != 0)
+        symbol += "A^" + std::to_string (dimension.amperes);
+
+    return symbol;
+}
+
+namespace ResistorCore
+{
+
+/**
+ * Recursive descent parser that writes the postfix code of an expression:
+ *
+ *     sum     = product (("+" | "-") product)*
+ *     product = unary (("*" | "/" | "||") unary)*
+ *     unary   = ("-" | "+") unary | primary
+ *     primary = literal | variable | "(" sum ")"
+ *
+ * The units of the operands are checked while parsing, and operations on
+ * constants are folded.
+ */
+class ExpressionCompiler
+{
+public:
+    ExpressionCompiler (const char* text,
+                        const size_t length,
+                        Expression* expression,
+                        std::unordered_map<std::string, ExpressionLiteral>* literals);
+
+    bool compile (std::string* error);
+
+private:
+    struct Operand {
+        size_t start;
+        UnitDimension dimension;
+        bool flexible;
+    };
+
+    bool parseSum (Operand* operand);
+    bool parseProduct (Operand* operand);
+    bool parseUnary (Operand* operand);
+    bool parsePrimary (Operand* operand);
+    bool parseLiteral (const char* start, Operand* operand);
+    bool parseName (Operand* operand);
+
+    bool combine (const uint32_t opcode, const char* at,
+                  Operand* left, const Operand& right);
+    bool isConstant (const Operand& operand, const size_t end) const;
+
+    void skipSpaces();
+    void emit (const uint32_t opcode, const uint32_t operand = 0);
+    bool fail (const char* at, const std::string& message);
+
+    const char* m_text;
+    const char* m_position;
+    const char* m_end;
+    int m_nesting;
+    std::string m_error;
+    Expression* m_expression;
+    std::unordered_map<std::string, ExpressionLiteral>* m_literals;
+};
+
+}
+
+ExpressionCompiler::ExpressionCompiler (const char* text,
+                                        const size_t length,
+                                        Expression* expression,
+                                        std::unordered_map<std::string, ExpressionLiteral>* literals) :
+    m_text (text),
+    m_position (text),
+    m_end (text + length),
+    m_nesting (0),
+    m_expression (expression),
+    m_literals (literals) {}
+
+/**
+ * Compiles the whole text, then removes the constants that were folded
+ * and computes the stack depth. On failure, the expression is cleared
+ * and the message (with the column of the error) is written to @a error
+ */
+bool ExpressionCompiler::compile (std::string* error) {
+    m_expression->clear();
+
+    Operand result;
+    bool valid = parseSum (&result);
+    if (valid) {
+        skipSpaces();
+        if (m_position != m_end)
+            valid = fail (m_position, "unexpected \"" + codePoint (m_position, m_end) + "\"");
+    }
+
+    if (!valid) {
+        m_expression->clear();
+        if (error)
+            *error = m_error;
+
+        return false;
+    }
+
+    // Keep only the constants that are still used
+    std::vector<double> constants;
+    size_t depth = 0;
+    size_t maxDepth = 0;
+    for (size_t i = 0; i < m_expression->m_code.size(); ++i) {
+        ExpressionInstruction& instruction = m_expression->m_code [i];
+        if (instruction.opcode == OpConstant) {
+            constants.push_back (m_expression->m_constants [instruction.operand]);
+            instruction.operand = static_cast<uint32_t> (constants.size() - 1);
+        }
+
+        if (instruction.opcode == OpConstant || instruction.opcode == OpVariable)
+            maxDepth = std::max (maxDepth, ++depth);
+        else if (instruction.opcode != OpNegate)
+            --depth;
+    }
+
+    assert (depth == 1);
+    m_expression->m_constants.swap (constants);
+    m_expression->m_stackDepth = maxDepth;
+    m_expression->m_dimension = result.flexible ? OHMS : result.dimension;
+
+    if (error)
+        error->clear();
+
+    return true;
+}
+
+bool ExpressionCompiler::parseSum (Operand* operand) {
+    if (!parseProduct (operand))
+        return false;
+
+    while (true) {
+        skipSpaces();
+        if (m_position == m_end || (*m_position != '+' && *m_position != '-'))
+            return true;
+
+        const char* at = m_position++;
+        const uint32_t opcode = *at == '+' ? OpAdd : OpSubtract;
+
+        Operand right;
+        if (!parseProduct (&right) || !combine (opcode, at, operand, right))
+            return false;
+    }
+}
+
+bool ExpressionCompiler::parseProduct (Operand* operand) {
+    if (!parseUnary (operand))
+        return false;
+
+    while (true) {
+        skipSpaces();
+        if (m_position == m_end)
+            return true;
+
+        uint32_t opcode;
+        const char* at = m_position;
+        if (*m_position == '*')
+            opcode = OpMultiply;
+        else if (*m_position == '/')
+            opcode = OpDivide;
+        else if (*m_position == '|' && m_position + 1 < m_end && m_position [1] == '|')
+            opcode = OpParallel;
+        else
+            return true;
+
+        m_position += opcode == OpParallel ? 2 : 1;
+
+        Operand right;
+        if (!parseUnary (&right) || !combine (opcode, at, operand, right))
+            return false;
+    }
+}
+
+bool ExpressionCompiler::parseUnary (Operand* operand) {
+    skipSpaces();
+    if (m_position == m_end || (*m_position != '-' && *m_position != '+'))
+        return parsePrimary (operand);
+
+    const bool negate = *m_position == '-';
+    ++m_position;
+
+    if (++m_nesting > MAX_NESTING)
+        return fail (m_position, "expression is nested too deeply");
+
+    const bool valid = parseUnary (operand);
+    --m_nesting;
+    if (!valid || !negate)
+        return valid;
+
+    std::vector<ExpressionInstruction>& code = m_expression->m_code;
+    if (isConstant (*operand, code.size()))
+        m_expression->m_constants [code.back().operand] *= -1;
+    else
+        emit (OpNegate);
+
+    return true;
+}
+
+bool ExpressionCompiler::parsePrimary (Operand* operand) {
+    if (m_position == m_end)
+        return fail (m_position, "expected a value");
+
+    const char c = *m_position;
+    if (c == '(') {
+        const char* open = m_position++;
+        if (++m_nesting > MAX_NESTING)
+            return fail (open, "expression is nested too deeply");
+
+        if (!parseSum (operand))
+            return false;
+
+        --m_nesting;
+        skipSpaces();
+        if (m_position == m_end || *m_position != ')')
+            return fail (open, "missing \")\"");
+
+        ++m_position;
+        return true;
+    }
+
+    if (isdigit (static_cast<unsigned char> (c)) || c == '.')
+        return parseLiteral (m_position, operand);
+
+    if (isalpha (static_cast<unsigned char> (c)) || c == '_')
+        return parseName (operand);
+
+    return fail (m_position, "expected a value");
+}
+
+/**
+ * Reads a number (with its prefix and unit), a band code or an SMD
+ * marking that starts at @a start, decoded literals are taken from the
+ * cache when possible
+ */
+bool ExpressionCompiler::parseLiteral (const char* start, Operand* operand) {
+    const bool bands = startsWith (start, static_cast<size_t> (m_end - start), "bands=");
+    const bool smd = !bands && startsWith (start, static_cast<size_t> (m_end - start), "smd=");
+
+    // Band codes are made of letters and dashes, the rest of literals
+    // are letters, digits, dots and UTF-8 symbols ("µ", "Ω")
+    const char* p = start + (bands ? 6 : (smd ? 4 : 0));
+    while (p < m_end) {
+        const unsigned char c = static_cast<unsigned char> (*p);
+        if (bands) {
+            if (!isalpha (c) && c != '-')
+                break;
+        }
+
+        else if ((c == '+' || c == '-') && !smd && p > start + 1 &&
+                 (p [-1] == 'e' || p [-1] == 'E') && isdigit (static_cast<unsigned char> (p [-2])) &&
+                 p + 1 < m_end && isdigit (static_cast<unsigned char> (p [1]))) {
+            // Exponent sign ("1e-3")
+        }
+
+        else if (!isalnum (c) && c != '.' && c < 0x80)
+            break;
+
+        ++p;
+    }
+
+    // Resistances that the input parser reads past the token ("10 kohm",
+    // "4.7 k"), so that operands follow the grammar of parseResistance()
+    if (!bands && !smd) {
+        ParsedResistance parsed;
+        const size_t scanned = scanResistance (start, static_cast<size_t> (m_end - start), &parsed);
+        if (start + scanned > p)
+            p = start + scanned;
+    }
+
+    const std::string token (start, p);
+    m_position = p;
+
+    ExpressionLiteral literal;
+    std::unordered_map<std::string, ExpressionLiteral>::const_iterator cached;
+    if (m_literals && (cached = m_literals->find (token)) != m_literals->end())
+        literal = cached->second;
+
+    else if (!decodeLiteral (token.data(), token.size(), &literal))
+        return fail (start, "invalid value \"" + token + "\"");
+
+    else if (m_literals)
+        m_literals->insert (std::make_pair (token, literal));
+
+    operand->start = m_expression->m_code.size();
+    operand->dimension = literal.dimension;
+    operand->flexible = literal.flexible;
+    m_expression->m_constants.push_back (literal.value);
+    emit (OpConstant, static_cast<uint32_t> (m_expression->m_constants.size() - 1));
+    return true;
+}
+
+/**
+ * Reads a variable name, or a "bands=" or "smd=" literal
+ */
+bool ExpressionCompiler::parseName (Operand* operand) {
+    const char* start = m_position;
+    const char* p = start;
+    while (p < m_end && (isalnum (static_cast<unsigned char> (*p)) || *p == '_'))
+        ++p;
+
+    if (p < m_end && *p == '=')
+        return parseLiteral (start, operand);
+
+    m_position = p;
+    const std::string name (start, p);
+
+    std::vector<std::string>& variables = m_expression->m_variables;
+    const size_t index = std::find (variables.begin(), variables.end(), name) - variables.begin();
+    if (index == variables.size())
+        variables.push_back (name);
+
+    operand->start = m_expression->m_code.size();
+    operand->dimension = DIMENSIONLESS;
+    operand->flexible = true;
+    emit (OpVariable, static_cast<uint32_t> (index));
+    return true;
+}
+
+/**
+ * Checks the units of an operation on @a left and @a right, whose code
+ * has already been written, and emits the instruction (or folds it if
+ * both operands are constants). The result is stored in @a left.
+ */
+bool ExpressionCompiler::combine (const uint32_t opcode, const char* at,
+                                  Operand* left, const Operand& right) {
+    // Sums and parallel combinations need operands of the same unit,
+    // plain numbers and variables take the unit of the other operand
+    if (opcode == OpAdd || opcode == OpSubtract || opcode == OpParallel) {
+        if (left->flexible)
+            left->dimension = right.dimension;
+
+        else if (!right.flexible && left->dimension != right.dimension) {
+            const std::string verb = opcode == OpAdd ? "add " : (opcode == OpSubtract ? "subtract " : "combine ");
+            return fail (at, "cannot " + verb + unitSymbol (right.dimension) +
+                         (opcode == OpAdd ? " to " : (opcode == OpSubtract ? " from " : " with ")) +
+                         unitSymbol (left->dimension));
+        }
+
+        left->flexible = left->flexible && right.flexible;
+        if (opcode == OpParallel && !left->flexible && left->dimension != OHMS)
+            return fail (at, "\"||\" needs resistances");
+    }
+
+    // Products and quotients combine the units
+    else {
+        const int sign = opcode == OpMultiply ? 1 : -1;
+        const UnitDimension l = left->flexible ? DIMENSIONLESS : left->dimension;
+        const UnitDimension r = right.flexible ? DIMENSIONLESS : right.dimension;
+        left->dimension.volts = l.volts + sign * r.volts;
+        left->dimension.amperes = l.amperes + sign * r.amperes;
+        left->flexible = left->flexible && right.flexible;
+
+        if (abs (left->dimension.volts) > MAX_UNIT_EXPONENT ||
+                abs (left->dimension.amperes) > MAX_UNIT_EXPONENT)
+            return fail (at, "unit is out of range");
+    }
+
+    // Fold constants, the code of the operands is one instruction each
+    std::vector<ExpressionInstruction>& code = m_expression->m_code;
+    if (isConstant (*left, right.start) && isConstant (right, code.size())) {
+        std::vector<double>& constants = m_expression->m_constants;
+        const double a = constants [code [left->start].operand];
+        const double b = constants [code [right.start].operand];
+        if (opcode == OpParallel && (a < 0 || b < 0))
+            return fail (at, "\"||\" needs non-negative resistances");
+
+        constants [code [left->start].operand] = apply (opcode, a, b);
+        code.pop_back();
+        return true;
+    }
+
+    emit (opcode);
+    return true;
+}
+
+/**
+ * Returns @c true if the code of @a operand, which ends before the
+ * instruction @a end, is a single constant
+ */
+bool ExpressionCompiler::isConstant (const Operand& operand, const size_t end) const {
+    return end == operand.start + 1 && m_expression->m_code [operand.start].opcode == OpConstant;
+}
+
+void ExpressionCompiler::skipSpaces() {
+    while (m_position < m_end && isspace (static_cast<unsigned char> (*m_position)))
+        ++m_position;
+}
+
+void ExpressionCompiler::emit (const uint32_t opcode, const uint32_t operand) {
+    const ExpressionInstruction instruction = { opcode, operand };
+    m_expression->m_code.push_back (instruction);
+}
+
+/**
+ * Builds the error message for the character at @a at
+ */
+bool ExpressionCompiler::fail (const char* at, const std::string& message) {
+    m_error = "column " + std::to_string (at - m_text + 1) + ": " + message;
+    return false;
+}
+
+/**
+ * Creates an empty (invalid) expression
+ */
+Expression::Expression() :
+    m_stackDepth (0),
+    m_dimension (DIMENSIONLESS) {}
+
+void Expression::clear() {
+    m_code.clear();
+    m_constants.clear();
+    m_variables.clear();
+    m_stackDepth = 0;
+    m_dimension = DIMENSIONLESS;
+}
+
+/**
+ * Returns @c true if the expression was compiled successfully
+ */
+bool Expression::isValid() const {
+    return !m_code.empty();
+}
+
+/**
+ * Returns @c true if the expression was folded to a single constant
+ */
+bool Expression::isConstant() const {
+    return m_code.size() == 1 && m_code [0].opcode == OpConstant;
+}
+
+/**
+ * Returns the number of values on the stack of the evaluation
+ */
+size_t Expression::stackDepth() const {
+    return m_stackDepth;
+}
+
+size_t Expression::instructionCount() const {
+    return m_code.size();
+}
+
+const ExpressionInstruction& Expression::instruction (const size_t index) const {
+    assert (index < m_code.size());
+    return m_code [index];
+}
+
+/**
+ * Returns the number of variables, their values are passed to
+ * @c evaluate() in the order of their first use in the text
+ */
+size_t Expression::variableCount() const {
+    return m_variables.size();
+}
+
+/**
+ * Returns the index of the variable with the given @a name, or
+ * @c INVALID_INDEX. Names are case-sensitive
+ */
+size_t Expression::variableIndex (const std::string& name) const {
+    for (size_t i = 0; i < m_variables.size(); ++i)
+        if (m_variables [i] == name)
+            return i;
+
+    return INVALID_INDEX;
+}
+
+const std::string& Expression::variableName (const size_t index) const {
+    assert (index < m_variables.size());
+    return m_variables [index];
+}
+
+/**
+ * Returns the unit of the result, expressions made only of plain
+ * numbers and variables are resistances
+ */
+UnitDimension Expression::dimension() const {
+    return m_dimension;
+}
+
+std::string Expression::unit() const {
+    return unitSymbol (m_dimension);
+}
+
+/**
+ * Evaluates the expression with the given @a variables (one value for
+ * each variable, in the order of @c variableName()). Returns NaN if the
+ * expression is not valid
+ */
+double Expression::evaluate (const double* variables) const {
+    assert (variables != NULL || m_variables.empty());
+
+    if (m_code.empty())
+        return NAN;
+
+    double local [LOCAL_STACK_DEPTH];
+    std::vector<double> heap;
+    double* stack = local;
+    if (m_stackDepth > LOCAL_STACK_DEPTH) {
+        heap.resize (m_stackDepth);
+        stack = heap.data();
+    }
+
+    size_t top = 0;
+    for (size_t i = 0; i < m_code.size(); ++i) {
+        const ExpressionInstruction& instruction = m_code [i];
+        switch (instruction.opcode) {
+        case OpConstant:
+            stack [top++] = m_constants [instruction.operand];
+            break;
+        case OpVariable:
+            stack [top++] = variables [instruction.operand];
+            break;
+        case OpNegate:
+            stack [top - 1] = -stack [top - 1];
+            break;
+        default:
+            --top;
+            stack [top - 1] = apply (instruction.opcode, stack [top - 1], stack [top]);
+            break;
+        }
+    }
+
+    return stack [0];
+}
+
+/**
+ * Evaluates the expression for @a count bindings, the values of variable
+ * v are read from <tt>variables[v][0 ... count - 1]</tt>. The bindings
+ * are processed in blocks, so every instruction is a loop over the
+ * values of the block.
+ *
+ * If an @a executor is given, the blocks are distributed among its
+ * threads. Returns @c false if the expression is not valid or if the
+ * executor was cancelled.
+ */
+bool Expression::evaluateBatch (const double* const* variables,
+                                const size_t count,
+                                double* results,
+                                BatchExecutor* executor) const {
+    assert (variables != NULL || m_variables.empty());
+    assert (results != NULL || count == 0);
+
+    if (m_code.empty())
+        return false;
+
+    const BatchExecutor::Task task = [&] (const size_t begin, const size_t end) {
+        std::vector<double> stack (m_stackDepth * EVALUATION_BLOCK);
+        for (size_t i = begin; i < end; i += EVALUATION_BLOCK)
+            evaluateBlock (variables, i, std::min (EVALUATION_BLOCK, end - i), stack.data(), results);
+    };
+
+    if (!executor || count <= EVALUATION_BLOCK) {
+        task (0, count);
+        return true;
+    }
+
+    const size_t grain = std::max (EVALUATION_BLOCK, count / (executor->threadCount() * 8));
+    return executor->run (count, grain, task);
+}
+
+/**
+ * Evaluates up to @c EVALUATION_BLOCK bindings starting at @a offset,
+ * each row of @a stack holds one value of every binding. The arithmetic
+ * loops always run over whole rows, a constant trip count that the
+ * compiler vectorizes, the values past @a count are ignored.
+ */
+void Expression::evaluateBlock (const double* const* variables,
+                                const size_t offset,
+                                const size_t count,
+                                double* stack,
+                                double* results) const {
+    size_t top = 0;
+    for (size_t i = 0; i < m_code.size(); ++i) {
+        const ExpressionInstruction& instruction = m_code [i];
+        const uint32_t opcode = instruction.opcode;
+
+        if (opcode == OpConstant) {
+            double* row = stack + top++ * EVALUATION_BLOCK;
+            std::fill (row, row + count, m_constants [instruction.operand]);
+            continue;
+        }
+
+        if (opcode == OpVariable) {
+            memcpy (stack + top++ * EVALUATION_BLOCK,
+                    variables [instruction.operand] + offset,
+                    count * sizeof (double));
+            continue;
+        }
+
+        if (opcode == OpNegate) {
+            double* a = stack + (top - 1) * EVALUATION_BLOCK;
+            for (size_t j = 0; j < EVALUATION_BLOCK; ++j)
+                a [j] = -a [j];
+
+            continue;
+        }
+
+        --top;
+        double* a = stack + (top - 1) * EVALUATION_BLOCK;
+        const double* b = a + EVALUATION_BLOCK;
+        switch (opcode) {
+        case OpAdd:
+            for (size_t j = 0; j < EVALUATION_BLOCK; ++j)
+                a [j] += b [j];
+            break;
+        case OpSubtract:
+            for (size_t j = 0; j < EVALUATION_BLOCK; ++j)
+                a [j] -= b [j];
+            break;
+        case OpMultiply:
+            for (size_t j = 0; j < EVALUATION_BLOCK; ++j)
+                a [j] *= b [j];
+            break;
+        case OpDivide:
+            for (size_t j = 0; j < EVALUATION_BLOCK; ++j)
+                a [j] /= b [j];
+            break;
+        case OpParallel:
+            for (size_t j = 0; j < EVALUATION_BLOCK; ++j)
+                a [j] = parallel (a [j], b [j]);
+            break;
+        }
+    }
+
+    memcpy (results + offset, stack, count * sizeof (double));
+}
+
+/**
+ * Creates a cache that keeps up to @a capacity expressions
+ */
+ExpressionCache::ExpressionCache (const size_t capacity) :
+    m_capacity (capacity > 0 ? capacity : 1) {}
+
+void ExpressionCache::clear() {
+    m_entries.clear();
+    m_literals.clear();
+}
+
+/**
+ * Returns the number of cached expressions
+ */
+size_t ExpressionCache::size() const {
+    return m_entries.size();
+}
+
+/**
+ * Returns the compiled version of @a text, which is only compiled if it
+ * is not in the cache. Returns @c NULL (and writes the message to
+ * @a error) if the expression is not valid
+ */
+const Expression* ExpressionCache::compile (const std::string& text, std::string* error) {
+    std::unordered_map<std::string, Entry>::iterator entry = m_entries.find (text);
+    if (entry == m_entries.end()) {
+        if (m_entries.size() >= m_capacity)
+            m_entries.clear();
+        if (m_literals.size() >= m_capacity * LITERALS_PER_EXPRESSION)
+            m_literals.clear();
+
+        entry = m_entries.insert (std::make_pair (text, Entry())).first;
+        ExpressionCompiler compiler (text.data(), text.size(), &entry->second.expression, &m_literals);
+        entry->second.valid = compiler.compile (&entry->second.error);
+    }
+
+    if (error)
+        *error = entry->second.error;
+
+    return entry->second.valid ? &entry->second.expression : NULL;
+}
+
+/**
+ * Compiles the expression of @a length bytes at @a text. Values can be
+ * written as:
+ *
+ * - Resistances, with the grammar of @c parseResistance(): "4k7", "2R2",
+ *   "1.5M", "10kΩ", "10 kohm", and small values such as "100n"
+ * - Voltages, currents and powers: "12V", "2.5mA", "250mW"
+ * - Color band codes: "bands=yellow-violet-red-gold"
+ * - SMD markings: "smd=103", "smd=01C"
+ * - Plain numbers ("2", "1e-3") and variables ("R1", "gain"), which
+ *   take the unit of the other operand in sums and parallels
+ *
+ * Operators are "+", "-", "*", "/" and "||" (resistances in parallel,
+ * same precedence as "*", negative resistances are rejected, or give NaN
+ * when they come from variables). Since names start with a letter, RKM values
+ * must start with a digit ("0R47" instead of "R47"), and band codes end
+ * at the first character that is not a letter or a dash.
+ *
+ * On failure, the message (with the column of the error) is written to
+ * @a error and @c false is returned.
+ */
+bool ResistorCore::compileExpression (const char* text,
+                                      const size_t length,
+                                      Expression* expression,
+                                      std::string* error) {
+    assert (text != NULL || length == 0);
+    assert (expression != NULL);
+
+    ExpressionCompiler compiler (text, length, expression, NULL);
+    return compiler.compile (error);
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_EXPRESSION_H
+#define RESISTOR_EXPRESSION_H
+
+#include <string>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+
+#include "Netlist.h"
+
+namespace ResistorCore
+{
+
+class BatchExecutor;
+
+enum ExpressionOpcode {
+    OpConstant = 0,
+    OpVariable = 1,
+    OpAdd      = 2,
+    OpSubtract = 3,
+    OpMultiply = 4,
+    OpDivide   = 5,
+    OpParallel = 6,
+    OpNegate   = 7
+};
+
+/**
+ * Instruction of the stack machine that evaluates expressions. The
+ * @c operand is the index of the constant or variable to push, it is not
+ * used by the arithmetic instructions
+ */
+struct ExpressionInstruction {
+    uint32_t opcode;
+    uint32_t operand;
+};
+
+/**
+ * Physical dimension of a value, as powers of volts and amperes. An ohm
+ * is V/A (volts 1, amperes -1) and a watt is V·A (volts 1, amperes 1)
+ */
+struct UnitDimension {
+    int volts;
+    int amperes;
+};
+
+bool operator== (const UnitDimension& a, const UnitDimension& b);
+bool operator!= (const UnitDimension& a, const UnitDimension& b);
+
+std::string unitSymbol (const UnitDimension& dimension);
+
+/**
+ * Decoded number, band code or SMD marking of an expression. Plain
+ * numbers are @c flexible, they take the dimension of the other operand
+ * in sums and parallel combinations
+ */
+struct ExpressionLiteral {
+    double value;
+    UnitDimension dimension;
+    bool flexible;
+};
+
+/**
+ * Arithmetic expression with resistances, voltages, currents and powers,
+ * compiled to postfix bytecode by @c compileExpression(). The expression
+ * can be evaluated many times, either with a single set of variable
+ * values or with whole columns of values at once.
+ */
+class Expression
+{
+public:
+    Expression();
+
+    void clear();
+    bool isValid() const;
+    bool isConstant() const;
+
+    size_t stackDepth() const;
+    size_t instructionCount() const;
+    const ExpressionInstruction& instruction (const size_t index) const;
+
+    size_t variableCount() const;
+    size_t variableIndex (const std::string& name) const;
+    const std::string& variableName (const size_t index) const;
+
+    UnitDimension dimension() const;
+    std::string unit() const;
+
+    double evaluate (const double* variables = NULL) const;
+    bool evaluateBatch (const double* const* variables,
+                        const size_t count,
+                        double* results,
+                        BatchExecutor* executor = NULL) const;
+
+private:
+    friend class ExpressionCompiler;
+
+    void evaluateBlock (const double* const* variables,
+                        const size_t offset,
+                        const size_t count,
+                        double* stack,
+                        double* results) const;
+
+    size_t m_stackDepth;
+    UnitDimension m_dimension;
+    std::vector<double> m_constants;
+    std::vector<std::string> m_variables;
+    std::vector<ExpressionInstruction> m_code;
+};
+
+bool compileExpression (const char* text,
+                        const size_t length,
+                        Expression* expression,
+                        std::string* error = NULL);
+
+/**
+ * Compiled expressions keyed by their text. The decoded literals are
+ * also kept, so editing one operand of a long expression does not decode
+ * the other band codes and markings again.
+ *
+ * Both tables are cleared when they reach their capacity, so a returned
+ * expression is only valid until the next call to @c compile().
+ */
+class ExpressionCache
+{
+public:
+    explicit ExpressionCache (const size_t capacity = 64);
+
+    void clear();
+    size_t size() const;
+
+    const Expression* compile (const std::string& text,
+                               std::string* error = NULL);
+
+private:
+    struct Entry {
+        Expression expression;
+        std::string error;
+        bool valid;
+    };
+
+    size_t m_capacity;
+    std::unordered_map<std::string, Entry> m_entries;
+    std::unordered_map<std::string, ExpressionLiteral> m_literals;
+};
+
+}
+
+#endif
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "GainSolver.h"
+
+#include <math.h>
+#include <assert.h>
+#include <algorithm>
+
+using namespace ResistorCore;
+
+/**
+ * Number of feedback resistors checked between two reads of the
+ * cancellation flag
+ */
+static const size_t CANCEL_CHECK_INTERVAL = 64;
+
+/**
+ * Returns @c true if stage @a a ranks before stage @a b. Stages are
+ * ranked by gain error and then by feedback resistance (smaller values
+ * load the op-amp output more, but add less noise and offset).
+ */
+bool GainSolver::better (const GainStage& a, const GainStage& b) {
+    if (fabs (a.error) != fabs (b.error))
+        return fabs (a.error) < fabs (b.error);
+
+    return a.rf < b.rf;
+}
+
+/**
+ * Changes the stock values that can be used by the amplifiers,
+ * non-positive and repeated values are ignored
+ */
+void GainSolver::setInventory (const double* values, const size_t count) {
+    sortInventory (values, count, &m_values);
+}
+
+/**
+ * Uses the values of the given standard @a series between @a minimum
+ * and @a maximum (inclusive) as the inventory
+ */
+void GainSolver::setSeries (const ESeries series,
+                            const double minimum,
+                            const double maximum) {
+    seriesInventory (series, minimum, maximum, &m_values);
+}
+
+/**
+ * Returns the number of stock values used by the amplifiers
+ */
+size_t GainSolver::inventorySize() const {
+    return m_values.size();
+}
+
+/**
+ * Returns the best @c maxResults stages for the given @a query, sorted
+ * from best to worst.
+ *
+ * Each stage that enters the running top results is passed to
+ * @a candidateFound (if set) while the search proceeds, so the reported
+ * stages get progressively better. If @a cancelled becomes @c true the
+ * search stops and returns the stages found so far.
+ */
+std::vector<GainStage> GainSolver::solve (const GainQuery& query,
+                                          const CandidateCallback& candidateFound,
+                                          const std::atomic<bool>* cancelled) const {
+    std::vector<GainStage> heap;
+    if (query.maxResults == 0 || !(query.gain > 0 && query.gain < HUGE_VAL))
+        return heap;
+
+    // Get the rf / rg ratio, non-inverting amplifiers need a gain above 1
+    double ratio = query.gain;
+    double minRg = query.minInputImpedance;
+    if (query.type == AmplifierNonInverting) {
+        ratio = query.gain - 1;
+        minRg = 0;
+    }
+
+    if (!(ratio > 0))
+        return heap;
+
+    const size_t n = m_values.size();
+    const double* values = m_values.data();
+
+    // Skip the feedback resistors below the allowed range
+    size_t f = static_cast<size_t> (std::lower_bound (values, values + n, query.minFeedback) - values);
+
+    size_t g = 0;
+    for (; f < n && values [f] <= query.maxFeedback; ++f) {
+        if (cancelled && f % CANCEL_CHECK_INTERVAL == 0 &&
+                cancelled->load (std::memory_order_relaxed))
+            break;
+
+        // Move the rg pointer to the first value above the ideal rg
+        const double rf = values [f];
+        const double ideal = rf / ratio;
+        while (g < n && values [g] < ideal)
+            ++g;
+
+        // Check both neighbors of the ideal value
+        for (size_t k = (g > 0 ? g - 1 : 0); k <= g && k < n; ++k) {
+            const double rg = values [k];
+            if (rg < minRg)
+                continue;
+
+            GainStage stage;
+            stage.rf = rf;
+            stage.rg = rg;
+            stage.gain = gain (query.type, rf, rg);
+            stage.error = (stage.gain - query.gain) / query.gain;
+            if (!(fabs (stage.error) <= query.maxError))
+                continue;
+
+            if (heap.size() < query.maxResults) {
+                heap.push_back (stage);
+                std::push_heap (heap.begin(), heap.end(), better);
+            }
+
+            else if (better (stage, heap.front())) {
+                std::pop_heap (heap.begin(), heap.end(), better);
+                heap.back() = stage;
+                std::push_heap (heap.begin(), heap.end(), better);
+            }
+
+            else
+                continue;
+
+            if (candidateFound)
+                candidateFound (stage);
+        }
+    }
+
+    std::sort_heap (heap.begin(), heap.end(), better);
+    return heap;
+}
+
+/**
+ * Returns the magnitude of the gain of an amplifier of the given @a type
+ * with the given feedback (@a rf) and gain (@a rg) resistors
+ */
+double GainSolver::gain (const AmplifierType type, const double rf, const double rg) {
+    assert (rg > 0);
+
+    if (type == AmplifierNonInverting)
+        return 1 + rf / rg;
+
+    return rf / rg;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_GAIN_SOLVER_H
+#define RESISTOR_GAIN_SOLVER_H
+
+#include <atomic>
+#include <vector>
+#include <functional>
+#include <stddef.h>
+
+#include "ESeries.h"
+
+namespace ResistorCore
+{
+
+/**
+ * Op-amp amplifier topologies, the gain of an inverting amplifier is
+ * -rf / rg and the gain of a non-inverting amplifier is 1 + rf / rg
+ */
+enum AmplifierType {
+    AmplifierInverting    = 0,
+    AmplifierNonInverting = 1
+};
+
+/**
+ * Feedback (@c rf) and gain (@c rg) resistors of an amplifier. @c gain
+ * is the magnitude of the nominal gain and @c error is its relative
+ * error against the requested gain.
+ */
+struct GainStage {
+    double rf;
+    double rg;
+    double gain;
+    double error;
+};
+
+/**
+ * Parameters of a search. @c gain is the magnitude of the requested
+ * gain (it must be above 1 for non-inverting amplifiers). The input
+ * impedance of an inverting amplifier is rg, so @c minInputImpedance
+ * bounds rg, it is ignored by non-inverting amplifiers. Stages whose
+ * relative gain error is above @c maxError are discarded.
+ */
+struct GainQuery {
+    AmplifierType type;
+    double gain;
+    double minInputImpedance;
+    double minFeedback;
+    double maxFeedback;
+    double maxError;
+    size_t maxResults;
+};
+
+/**
+ * Finds the feedback and gain resistors of an op-amp amplifier.
+ *
+ * The solver walks the feedback resistors in ascending order, the ideal
+ * rg grows with rf, so a second pointer tracks it and only its two
+ * neighbors are checked. Every stage that enters the running top results
+ * is reported to the caller as soon as it is found, and the search stops
+ * early when the optional cancellation flag is set.
+ */
+class GainSolver
+{
+public:
+    typedef std::function<void (const GainStage& stage)> CandidateCallback;
+
+    void setInventory (const double* values, const size_t count);
+    void setSeries (const ESeries series, const double minimum, const double maximum);
+
+    size_t inventorySize() const;
+
+    std::vector<GainStage> solve (const GainQuery& query,
+                                  const CandidateCallback& candidateFound = CandidateCallback(),
+                                  const std::atomic<bool>* cancelled = NULL) const;
+
+    static double gain (const AmplifierType type, const double rf, const double rg);
+    static bool better (const GainStage& a, const GainStage& b);
+
+private:
+    std::vector<double> m_values;
+};
+
+}
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Interval.h"
+
+#include <algorithm>
+
+using namespace ResistorCore;
+
+/**
+ * Returns the interval between the minimum and maximum resistance of
+ * a decoded resistor
+ */
+Interval Interval::fromBands (const BandResult& result) {
+    return Interval (result.minResistance, result.maxResistance);
+}
+
+/**
+ * Returns the interval @a value ± @a tolerance (relative, e.g. 0.05 for
+ * 5%), which is the same range as the one given by @c applyTolerance()
+ */
+Interval Interval::fromTolerance (const double value, const double tolerance) {
+    const double a = value * (1 - tolerance);
+    const double b = value * (1 + tolerance);
+    return Interval (std::min (a, b), std::max (a, b));
+}
+
+/**
+ * Returns the interval that contains every real number
+ */
+Interval Interval::entire() {
+    return Interval (-HUGE_VAL, HUGE_VAL);
+}
+
+/**
+ * Multiplies two intervals, the bounds of the product are the extreme
+ * products of the bounds of the operands
+ */
+Interval ResistorCore::operator* (const Interval& a, const Interval& b) {
+    // Fast path for the common case of positive intervals (resistances)
+    if (a.lower >= 0 && b.lower >= 0)
+        return roundOutwards (Interval (a.lower * b.lower, a.upper * b.upper));
+
+    const double p0 = a.lower * b.lower;
+    const double p1 = a.lower * b.upper;
+    const double p2 = a.upper * b.lower;
+    const double p3 = a.upper * b.upper;
+    return roundOutwards (Interval (std::min (std::min (p0, p1), std::min (p2, p3)),
+                                    std::max (std::max (p0, p1), std::max (p2, p3))));
+}
+
+/**
+ * Divides two intervals, returns the entire real line if @a b contains 0
+ */
+Interval ResistorCore::operator/ (const Interval& a, const Interval& b) {
+    return a * reciprocal (b);
+}
+
+/**
+ * Returns 1 / @a a, or the entire real line if @a a contains 0
+ */
+Interval ResistorCore::reciprocal (const Interval& a) {
+    if (a.containsZero())
+        return Interval::entire();
+
+    return roundOutwards (Interval (1 / a.upper, 1 / a.lower));
+}
+
+/**
+ * Returns the smallest interval that contains both @a a and @a b
+ */
+Interval ResistorCore::hull (const Interval& a, const Interval& b) {
+    return Interval (std::min (a.lower, b.lower), std::max (a.upper, b.upper));
+}
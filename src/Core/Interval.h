@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_INTERVAL_H
+#define RESISTOR_INTERVAL_H
+
+#include <math.h>
+
+#include "ResistorCore.h"
+
+namespace ResistorCore
+{
+
+/**
+ * Closed interval [lower, upper] of real numbers.
+ *
+ * Every operation rounds its bounds outwards by one unit in the last
+ * place, so the result always contains the exact value of the operation
+ * for any operands within the input intervals.
+ *
+ * Like any interval arithmetic, the bounds are only tight when each
+ * variable appears once in an expression: r2 / (r1 + r2) gives wider
+ * bounds than the equivalent 1 / (1 + r1 / r2), because the first form
+ * treats both occurrences of r2 as independent.
+ */
+struct Interval {
+    double lower;
+    double upper;
+
+    Interval() : lower (0), upper (0) {}
+    Interval (const double value) : lower (value), upper (value) {}
+    Interval (const double low, const double high) : lower (low), upper (high) {}
+
+    double width() const { return upper - lower; }
+    double midpoint() const { return lower + (upper - lower) / 2; }
+    bool contains (const double value) const { return value >= lower && value <= upper; }
+    bool containsZero() const { return lower <= 0 && upper >= 0; }
+
+    static Interval fromBands (const BandResult& result);
+    static Interval fromTolerance (const double value, const double tolerance);
+    static Interval entire();
+};
+
+/**
+ * Widens the bounds of @a value by one unit in the last place
+ */
+inline Interval roundOutwards (const Interval& value) {
+    return Interval (nextafter (value.lower, -HUGE_VAL), nextafter (value.upper, HUGE_VAL));
+}
+
+inline Interval operator+ (const Interval& a, const Interval& b) {
+    return roundOutwards (Interval (a.lower + b.lower, a.upper + b.upper));
+}
+
+inline Interval operator- (const Interval& a, const Interval& b) {
+    return roundOutwards (Interval (a.lower - b.upper, a.upper - b.lower));
+}
+
+inline Interval operator- (const Interval& a) {
+    return Interval (-a.upper, -a.lower);
+}
+
+Interval operator* (const Interval& a, const Interval& b);
+Interval operator/ (const Interval& a, const Interval& b);
+
+inline Interval& operator+= (Interval& a, const Interval& b) { return a = a + b; }
+inline Interval& operator-= (Interval& a, const Interval& b) { return a = a - b; }
+inline Interval& operator*= (Interval& a, const Interval& b) { return a = a * b; }
+inline Interval& operator/= (Interval& a, const Interval& b) { return a = a / b; }
+
+Interval reciprocal (const Interval& a);
+Interval hull (const Interval& a, const Interval& b);
+
+}
+
+#endif
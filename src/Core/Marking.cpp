@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Marking.h"
+
+#include <math.h>
+#include <assert.h>
+
+using namespace ResistorCore;
+
+/*
+ * Definitions of the compile-time tables, which are indexed at runtime
+ */
+constexpr double MarkingScale::MULTIPLIERS [28];
+constexpr double MarkingScale::DIVISORS [28];
+constexpr uint16_t MarkingLookup::EIA96 [100];
+
+constexpr MarkingAlphabet ResistorMarking::ALPHABET;
+constexpr MarkingRules ResistorMarking::RULES;
+constexpr MarkingRules ResistorMarking::FALLBACK;
+constexpr MarkingBands ResistorMarking::BANDS;
+
+constexpr MarkingAlphabet CapacitorMarking::ALPHABET;
+constexpr MarkingRules CapacitorMarking::RULES;
+constexpr MarkingRules CapacitorMarking::FALLBACK;
+constexpr MarkingBands CapacitorMarking::BANDS;
+
+constexpr MarkingAlphabet InductorMarking::ALPHABET;
+constexpr MarkingRules InductorMarking::RULES;
+constexpr MarkingRules InductorMarking::FALLBACK;
+constexpr MarkingBands InductorMarking::BANDS;
+
+/**
+ * Engineering prefixes from 10^-15 to 10^9
+ */
+static const char* const PREFIXES [] = {
+    "f", "p", "n", "\xC2\xB5", "m", "", "k", "M", "G"
+};
+
+/**
+ * Decodes @a count fixed-width records of @a width bytes, each code ends
+ * at the first NUL or space of its record
+ */
+template <typename Family>
+static void decodeRecords (const char* buffer, const size_t count,
+                           const size_t width, MarkingValue* results) {
+    for (size_t i = 0; i < count; ++i) {
+        const char* record = buffer + i * width;
+
+        size_t size = 0;
+        while (size < width && record [size] != '\0' && record [size] != ' ')
+            ++size;
+
+        results [i] = decodeCode<Family> (record, size);
+    }
+}
+
+/**
+ * Decodes newline-separated codes, carriage returns are ignored
+ */
+template <typename Family>
+static size_t decodeLines (const char* buffer, const size_t length,
+                           MarkingValue* results, const size_t capacity) {
+    size_t count = 0;
+    size_t start = 0;
+    while (start < length && count < capacity) {
+        size_t end = start;
+        while (end < length && buffer [end] != '\n')
+            ++end;
+
+        size_t size = end - start;
+        if (size > 0 && buffer [end - 1] == '\r')
+            --size;
+
+        results [count++] = decodeCode<Family> (buffer + start, size);
+        start = end + 1;
+    }
+
+    return count;
+}
+
+/**
+ * Decodes @a count color codes of @a bands colors each
+ */
+template <typename Family>
+static void decodeColorRecords (const uint8_t* colors, const size_t count,
+                                const size_t bands, MarkingValue* results) {
+    for (size_t i = 0; i < count; ++i)
+        results [i] = decodeColors<Family> (colors + i * bands, bands);
+}
+
+/**
+ * Decodes the printed @a code of a component, which must have @a length
+ * characters. Invalid codes give the @c MarkingInvalid scheme.
+ */
+MarkingValue ResistorCore::decodeMarking (const ComponentFamily family,
+                                          const char* code,
+                                          const size_t length) {
+    assert (code != NULL || length == 0);
+
+    switch (family) {
+    case FamilyCapacitor:
+        return decodeCode<CapacitorMarking> (code, length);
+    case FamilyInductor:
+        return decodeCode<InductorMarking> (code, length);
+    default:
+        return decodeCode<ResistorMarking> (code, length);
+    }
+}
+
+/**
+ * Decodes the @a count color bands of a component, colors are numbered
+ * as the @c Multiplier enum. Capacitors have no color codes.
+ */
+MarkingValue ResistorCore::decodeColorMarking (const ComponentFamily family,
+                                               const uint8_t* colors,
+                                               const size_t count) {
+    assert (colors != NULL || count == 0);
+
+    switch (family) {
+    case FamilyCapacitor:
+        return decodeColors<CapacitorMarking> (colors, count);
+    case FamilyInductor:
+        return decodeColors<InductorMarking> (colors, count);
+    default:
+        return decodeColors<ResistorMarking> (colors, count);
+    }
+}
+
+/**
+ * Decodes @a count codes stored in fixed-width records of @a width
+ * bytes. Each code ends at the first NUL or space character of its
+ * record, or at the end of the record.
+ */
+void ResistorCore::decodeMarkings (const ComponentFamily family,
+                                   const char* buffer,
+                                   const size_t count,
+                                   const size_t width,
+                                   MarkingValue* results) {
+    assert (buffer != NULL || count == 0);
+    assert (results != NULL || count == 0);
+
+    switch (family) {
+    case FamilyCapacitor:
+        decodeRecords<CapacitorMarking> (buffer, count, width, results);
+        break;
+    case FamilyInductor:
+        decodeRecords<InductorMarking> (buffer, count, width, results);
+        break;
+    default:
+        decodeRecords<ResistorMarking> (buffer, count, width, results);
+        break;
+    }
+}
+
+/**
+ * Decodes a buffer of newline-separated codes, which must have
+ * @a length bytes, and writes up to @a capacity results. Returns the
+ * number of decoded codes.
+ */
+size_t ResistorCore::decodeMarkingLines (const ComponentFamily family,
+                                         const char* buffer,
+                                         const size_t length,
+                                         MarkingValue* results,
+                                         const size_t capacity) {
+    assert (buffer != NULL || length == 0);
+    assert (results != NULL || capacity == 0);
+
+    switch (family) {
+    case FamilyCapacitor:
+        return decodeLines<CapacitorMarking> (buffer, length, results, capacity);
+    case FamilyInductor:
+        return decodeLines<InductorMarking> (buffer, length, results, capacity);
+    default:
+        return decodeLines<ResistorMarking> (buffer, length, results, capacity);
+    }
+}
+
+/**
+ * Decodes @a count color codes, stored one after the other with
+ * @a bands colors each
+ */
+void ResistorCore::decodeColorMarkings (const ComponentFamily family,
+                                        const uint8_t* colors,
+                                        const size_t count,
+                                        const size_t bands,
+                                        MarkingValue* results) {
+    assert (colors != NULL || count == 0);
+    assert (results != NULL || count == 0);
+
+    switch (family) {
+    case FamilyCapacitor:
+        decodeColorRecords<CapacitorMarking> (colors, count, bands, results);
+        break;
+    case FamilyInductor:
+        decodeColorRecords<InductorMarking> (colors, count, bands, results);
+        break;
+    default:
+        decodeColorRecords<ResistorMarking> (colors, count, bands, results);
+        break;
+    }
+}
+
+/**
+ * Returns the value of the given @a marking in ohms, farads or henries
+ * (the double nearest to the exact value), or NaN if it is not valid
+ */
+double ResistorCore::markingValue (const MarkingValue& marking) {
+    if (marking.scheme == MarkingInvalid)
+        return NAN;
+
+    const int index = marking.exponent + MarkingScale::OFFSET;
+    return marking.significand * MarkingScale::MULTIPLIERS [index] / MarkingScale::DIVISORS [index];
+}
+
+/**
+ * Converts @a count markings to their values, see @c markingValue()
+ */
+void ResistorCore::markingValues (const MarkingValue* markings,
+                                  const size_t count,
+                                  double* values) {
+    assert (markings != NULL || count == 0);
+    assert (values != NULL || count == 0);
+
+    for (size_t i = 0; i < count; ++i)
+        values [i] = markingValue (markings [i]);
+}
+
+/**
+ * Returns the UTF-8 symbol of the unit of the given @a family
+ */
+const char* ResistorCore::markingUnit (const ComponentFamily family) {
+    switch (family) {
+    case FamilyCapacitor:
+        return "F";
+    case FamilyInductor:
+        return "H";
+    default:
+        return "\xCE\xA9";
+    }
+}
+
+/**
+ * Returns the exact value of the given @a marking with an engineering
+ * prefix and the unit of its family (e.g. "4.7 nF" or "100 µH"), or an
+ * empty string if the marking is not valid
+ */
+std::string ResistorCore::formatMarking (const MarkingValue& marking) {
+    if (marking.scheme == MarkingInvalid)
+        return std::string();
+
+    const std::string unit = markingUnit (static_cast<ComponentFamily> (marking.family));
+    if (marking.significand == 0)
+        return "0 " + unit;
+
+    // Choose the prefix from the position of the leading digit
+    const std::string digits = std::to_string (marking.significand);
+    const int leading = marking.exponent + static_cast<int> (digits.size()) - 1;
+    int power = leading >= 0 ? leading / 3 * 3 : -((-leading + 2) / 3 * 3);
+    power = power < -15 ? -15 : (power > 9 ? 9 : power);
+
+    // Place the decimal point, then remove trailing zeros
+    std::string text;
+    const int shift = marking.exponent - power;
+    if (shift >= 0)
+        text = digits + std::string (static_cast<size_t> (shift), '0');
+
+    else {
+        const int integers = static_cast<int> (digits.size()) + shift;
+        if (integers > 0)
+            text = digits.substr (0, static_cast<size_t> (integers)) + "." +
+                   digits.substr (static_cast<size_t> (integers));
+        else
+            text = "0." + std::string (static_cast<size_t> (-integers), '0') + digits;
+
+        while (text [text.size() - 1] == '0')
+            text.erase (text.size() - 1);
+        if (text [text.size() - 1] == '.')
+            text.erase (text.size() - 1);
+    }
+
+    return text + " " + PREFIXES [(power + 15) / 3] + unit;
+}
@@ -0,0 +1,799 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_MARKING_H
+#define RESISTOR_MARKING_H
+
+#include <string>
+#include <utility>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ResistorCore.h"
+
+/*
+ * The decoders are templates that are instantiated once per family, they
+ * must be inlined into their callers so that the result is built in
+ * registers instead of being packed into memory and read back
+ */
+#if defined (__GNUC__)
+    #define MARKING_INLINE inline __attribute__ ((always_inline))
+#elif defined (_MSC_VER)
+    #define MARKING_INLINE __forceinline
+#else
+    #define MARKING_INLINE inline
+#endif
+
+namespace ResistorCore
+{
+
+enum ComponentFamily {
+    FamilyResistor  = 0,
+    FamilyCapacitor = 1,
+    FamilyInductor  = 2
+};
+
+/**
+ * Marking schemes, the first values match the @c SmdScheme enum
+ */
+enum MarkingScheme {
+    MarkingInvalid    = 0,
+    MarkingJumper     = 1,
+    MarkingThreeDigit = 2,
+    MarkingFourDigit  = 3,
+    MarkingRadix      = 4,
+    MarkingEia96      = 5,
+    MarkingEia198     = 6,
+    MarkingPlain      = 7,
+    MarkingColors     = 8
+};
+
+/**
+ * Decoded marking of a component. The value is @c significand x
+ * 10^@c exponent ohms, farads or henries (depending on the @c family),
+ * the tolerance is given in basis points (1% is 100) and is zero if the
+ * marking does not specify it.
+ */
+struct MarkingValue {
+    uint32_t significand;
+    int32_t exponent;
+    uint16_t tolerance;
+    uint8_t scheme;
+    uint8_t family;
+};
+
+MarkingValue decodeMarking (const ComponentFamily family,
+                            const char* code,
+                            const size_t length);
+MarkingValue decodeColorMarking (const ComponentFamily family,
+                                 const uint8_t* colors,
+                                 const size_t count);
+
+void decodeMarkings (const ComponentFamily family,
+                     const char* buffer,
+                     const size_t count,
+                     const size_t width,
+                     MarkingValue* results);
+size_t decodeMarkingLines (const ComponentFamily family,
+                           const char* buffer,
+                           const size_t length,
+                           MarkingValue* results,
+                           const size_t capacity);
+void decodeColorMarkings (const ComponentFamily family,
+                          const uint8_t* colors,
+                          const size_t count,
+                          const size_t bands,
+                          MarkingValue* results);
+
+double markingValue (const MarkingValue& marking);
+void markingValues (const MarkingValue* markings,
+                    const size_t count,
+                    double* values);
+
+const char* markingUnit (const ComponentFamily family);
+std::string formatMarking (const MarkingValue& marking);
+
+/*
+ * Table-driven decoding engine.
+ *
+ * A code of up to MAX_MARKING_LENGTH characters is reduced to a pattern
+ * of digits and letters, which selects a rule of the family. The rule
+ * tells which digits form the significand and which character gives the
+ * power of ten (a multiplier digit, a radix letter such as the "R" of
+ * "4R7" or an EIA letter) or the tolerance. Rules are written as role
+ * strings, for example "ddm" (two significant digits and a multiplier
+ * digit) or "drd" (digit, radix letter, digit).
+ *
+ * Every table is built at compile time and each family is a separate
+ * instantiation of the engine, so adding a family does not add any
+ * dispatch to the decoding loop. The rule of each pattern is also
+ * compiled into its own decoder, and the only runtime dispatch is the
+ * jump from the pattern to that decoder.
+ */
+
+static const size_t MAX_MARKING_LENGTH = 5;
+static const size_t MARKING_PATTERNS = 2 << MAX_MARKING_LENGTH;
+static const int8_t NO_EXPONENT = INT8_MIN;
+static const uint16_t NO_TOLERANCE = UINT16_MAX;
+static const uint16_t NO_SIGNIFICAND = UINT16_MAX;
+
+enum MarkingClass {
+    MarkingOther  = 0,
+    MarkingDigit  = 1,
+    MarkingLetter = 2
+};
+
+/**
+ * Tables that map a character to a power of ten, the first one gives
+ * zero for every character and is used by rules without a multiplier
+ */
+enum MarkingTable {
+    TableNone   = 0,
+    TableDigit  = 1,
+    TableEia198 = 2,
+    TableRadix  = 3,
+    TableCode   = 4,
+    TableCount  = 5
+};
+
+/**
+ * Per-character data of a family, indexed by the byte value
+ */
+struct MarkingAlphabet {
+    uint8_t classes [256];
+    int8_t exponents [TableCount][256];
+    uint8_t significands [256];
+    uint16_t tolerances [256];
+};
+
+/**
+ * Decoding rule of a pattern. The significand is made of the digits in
+ * the first @c digits characters (skipping the radix letter), or is the
+ * value of the EIA-198 @c letter. The exponent
+ * is @c exponent plus the value of the @c multiplier character in
+ * @c table.
+ */
+struct MarkingRule {
+    uint8_t scheme;
+    uint8_t digits;
+    int8_t exponent;
+    uint8_t table;
+    uint8_t multiplier;
+    int8_t letter;
+    int8_t tolerancePosition;
+    uint16_t tolerance;
+};
+
+/**
+ * Rules indexed by the pattern of a code, which is (1 << length) with
+ * bit i set if character i is a letter
+ */
+struct MarkingRules {
+    MarkingRule rules [MARKING_PATTERNS];
+};
+
+/**
+ * Source of a rule: role string, scheme, base exponent and tolerance
+ * (used when the code has no tolerance letter)
+ */
+struct MarkingLayout {
+    const char* roles;
+    MarkingScheme scheme;
+    int exponent;
+    uint16_t tolerance;
+};
+
+/**
+ * Color code of a family with the given number of bands: number of
+ * digits, position of the tolerance band (-1 if there is none) and
+ * tolerance used when there is no tolerance band
+ */
+struct MarkingBandRule {
+    bool valid;
+    uint8_t digits;
+    int8_t tolerancePosition;
+    uint16_t tolerance;
+};
+
+/**
+ * Color codes of a family, colors are numbered as the @c Multiplier
+ * enum (black to white, gold and silver)
+ */
+struct MarkingBands {
+    int8_t exponent;
+    MarkingBandRule rules [7];
+    uint16_t tolerances [12];
+};
+
+/**
+ * Powers of ten of the decoded exponents (10^-15 to 10^12), negative
+ * exponents divide by an exact power of ten, so that every value is the
+ * double nearest to the exact value without branching on the sign
+ */
+struct MarkingScale {
+    static constexpr int OFFSET = 15;
+    static constexpr double MULTIPLIERS [28] = {
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12
+    };
+    static constexpr double DIVISORS [28] = {
+        1e15, 1e14, 1e13, 1e12, 1e11, 1e10, 1e9, 1e8, 1e7, 1e6, 1e5, 1e4, 1e3, 1e2, 1e1,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1
+    };
+};
+
+/**
+ * EIA-96 significands, indexed by the two digits of the code. Index 0 is
+ * zero and indices past 96 are not valid.
+ */
+struct MarkingLookup {
+    static constexpr uint16_t EIA96 [100] = {
+        000, 100, 102, 105, 107, 110, 113, 115, 118, 121,
+        124, 127, 130, 133, 137, 140, 143, 147, 150, 154,
+        158, 162, 165, 169, 174, 178, 182, 187, 191, 196,
+        200, 205, 210, 215, 221, 226, 232, 237, 243, 249,
+        255, 261, 267, 274, 280, 287, 294, 301, 309, 316,
+        324, 332, 340, 348, 357, 365, 374, 383, 392, 402,
+        412, 422, 432, 442, 453, 464, 475, 487, 499, 511,
+        523, 536, 549, 562, 576, 590, 604, 619, 634, 649,
+        665, 681, 698, 715, 732, 750, 768, 787, 806, 825,
+        845, 866, 887, 909, 931, 953, 976, NO_SIGNIFICAND,
+        NO_SIGNIFICAND, NO_SIGNIFICAND
+    };
+};
+
+/**
+ * Returns an alphabet where only digits are valid characters, with
+ * every table empty
+ */
+constexpr MarkingAlphabet makeAlphabet() {
+    MarkingAlphabet alphabet {};
+    for (int c = 0; c < 256; ++c) {
+        alphabet.tolerances [c] = NO_TOLERANCE;
+        for (int table = TableDigit; table < TableCount; ++table)
+            alphabet.exponents [table][c] = NO_EXPONENT;
+    }
+
+    for (int c = '0'; c <= '9'; ++c)
+        alphabet.classes [c] = MarkingDigit;
+
+    return alphabet;
+}
+
+/**
+ * Assigns the given @a exponent to the letters of @a letters in @a table
+ */
+constexpr void setLetters (MarkingAlphabet& alphabet, const char* letters,
+                           const MarkingTable table, const int exponent) {
+    for (; *letters != '\0'; ++letters) {
+        const uint8_t c = static_cast<uint8_t> (*letters);
+        alphabet.classes [c] = MarkingLetter;
+        alphabet.exponents [table][c] = static_cast<int8_t> (exponent);
+    }
+}
+
+/**
+ * Assigns the exponents of the ten digits in the given @a table
+ */
+constexpr void setDigits (MarkingAlphabet& alphabet, const MarkingTable table,
+                          const int (&exponents) [10]) {
+    for (int d = 0; d < 10; ++d)
+        alphabet.exponents [table]['0' + d] = static_cast<int8_t> (exponents [d]);
+}
+
+/**
+ * Assigns a tolerance (in basis points) to each letter of @a letters
+ */
+constexpr void setTolerance (MarkingAlphabet& alphabet, const char* letters,
+                             const uint16_t tolerance) {
+    for (; *letters != '\0'; ++letters) {
+        const uint8_t c = static_cast<uint8_t> (*letters);
+        alphabet.classes [c] = MarkingLetter;
+        alphabet.tolerances [c] = tolerance;
+    }
+}
+
+/**
+ * Called by @c makeRules() when two layouts have the same pattern. It is
+ * not constexpr, so the collision stops the compilation of the table.
+ */
+inline void markingPatternCollision() {}
+
+/**
+ * Builds the rules of the given layouts. Roles are: "d" significant
+ * digit, "m" multiplier digit, "x" EIA-198 multiplier digit, "r" radix
+ * letter, "c" EIA-96 multiplier letter, "e" EIA-198 letter and "t"
+ * tolerance letter. Layouts with the same pattern (e.g. "dr" and "dt")
+ * cannot share a table, one of them must go to the fallback rules.
+ */
+constexpr MarkingRules makeRules (const MarkingLayout* layouts, const size_t count) {
+    MarkingRules table {};
+    for (size_t l = 0; l < count; ++l) {
+        const char* roles = layouts [l].roles;
+
+        size_t length = 0;
+        while (roles [length] != '\0')
+            ++length;
+
+        MarkingRule rule {};
+        rule.scheme = static_cast<uint8_t> (layouts [l].scheme);
+        rule.exponent = static_cast<int8_t> (layouts [l].exponent);
+        rule.tolerance = layouts [l].tolerance;
+        rule.letter = -1;
+        rule.tolerancePosition = -1;
+
+        size_t pattern = size_t (1) << length;
+        for (size_t i = 0; i < length; ++i) {
+            switch (roles [i]) {
+            case 'd':
+                rule.digits = static_cast<uint8_t> (i + 1);
+                break;
+            case 'm':
+            case 'x':
+                rule.table = roles [i] == 'm' ? TableDigit : TableEia198;
+                rule.multiplier = static_cast<uint8_t> (i);
+                break;
+            case 'r':
+            case 'c':
+                rule.table = roles [i] == 'r' ? TableRadix : TableCode;
+                rule.multiplier = static_cast<uint8_t> (i);
+                pattern |= size_t (1) << i;
+                break;
+            case 'e':
+                rule.letter = static_cast<int8_t> (i);
+                pattern |= size_t (1) << i;
+                break;
+            case 't':
+                rule.tolerancePosition = static_cast<int8_t> (i);
+                pattern |= size_t (1) << i;
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (table.rules [pattern].scheme != MarkingInvalid)
+            markingPatternCollision();
+
+        table.rules [pattern] = rule;
+    }
+
+    return table;
+}
+
+/**
+ * Returns a band rule with the given values
+ */
+constexpr MarkingBandRule bandRule (const uint8_t digits,
+                                    const int8_t tolerancePosition,
+                                    const uint16_t tolerance) {
+    return MarkingBandRule { true, digits, tolerancePosition, tolerance };
+}
+
+/**
+ * Returns color codes without any valid band count
+ */
+constexpr MarkingBands makeBands (const int exponent) {
+    MarkingBands bands {};
+    bands.exponent = static_cast<int8_t> (exponent);
+    for (int i = 0; i < 12; ++i)
+        bands.tolerances [i] = NO_TOLERANCE;
+
+    return bands;
+}
+
+/**
+ * Resistors: SMD codes ("103", "4702", "4R7", "01C") and 3 to 6 bands
+ */
+constexpr MarkingAlphabet makeResistorAlphabet() {
+    MarkingAlphabet alphabet = makeAlphabet();
+    setDigits (alphabet, TableDigit, { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+    setLetters (alphabet, "Rr", TableRadix, 0);
+    setLetters (alphabet, "Zz", TableCode, -3);
+    setLetters (alphabet, "YyRr", TableCode, -2);
+    setLetters (alphabet, "XxSs", TableCode, -1);
+    setLetters (alphabet, "Aa", TableCode, 0);
+    setLetters (alphabet, "BbHh", TableCode, 1);
+    setLetters (alphabet, "Cc", TableCode, 2);
+    setLetters (alphabet, "Dd", TableCode, 3);
+    setLetters (alphabet, "Ee", TableCode, 4);
+    setLetters (alphabet, "Ff", TableCode, 5);
+    return alphabet;
+}
+
+constexpr MarkingRules makeResistorRules() {
+    const MarkingLayout layouts [] = {
+        { "ddm",  MarkingThreeDigit,  0, 500 },
+        { "dddm", MarkingFourDigit,   0, 100 },
+        { "drd",  MarkingRadix,      -1, 500 },
+        { "drdd", MarkingRadix,      -2, 100 },
+        { "ddrd", MarkingRadix,      -1, 100 },
+        { "ddc",  MarkingEia96,       0, 100 }
+    };
+
+    return makeRules (layouts, sizeof (layouts) / sizeof (layouts [0]));
+}
+
+constexpr MarkingBands makeResistorBands() {
+    MarkingBands bands = makeBands (0);
+    bands.rules [3] = bandRule (2, -1, 2000);
+    bands.rules [4] = bandRule (2, 3, 0);
+    bands.rules [5] = bandRule (3, 4, 0);
+    bands.rules [6] = bandRule (3, 4, 0);
+    bands.tolerances [MultiplierBrown] = 100;
+    bands.tolerances [MultiplierRed] = 200;
+    bands.tolerances [MultiplierGreen] = 50;
+    bands.tolerances [MultiplierBlue] = 25;
+    bands.tolerances [MultiplierViolet] = 10;
+    bands.tolerances [MultiplierGray] = 5;
+    bands.tolerances [MultiplierGold] = 500;
+    bands.tolerances [MultiplierSilver] = 1000;
+    return bands;
+}
+
+/**
+ * Ceramic capacitors: picofarad codes ("104", "104K", "47"), radix
+ * codes ("4n7", "2u2", "10n", "n47", "100nJ") and EIA-198 codes ("A2"). Tolerance
+ * letters B, C and D are absolute (in picofarads) and give no tolerance.
+ */
+constexpr MarkingAlphabet makeCapacitorAlphabet() {
+    MarkingAlphabet alphabet = makeAlphabet();
+    setDigits (alphabet, TableDigit, { 0, 1, 2, 3, 4, 5, 6, NO_EXPONENT, -2, -1 });
+    setDigits (alphabet, TableEia198, { 0, 1, 2, 3, 4, 5, 6, 7, 8, -1 });
+    setLetters (alphabet, "pPRr", TableRadix, -12);
+    setLetters (alphabet, "nN", TableRadix, -9);
+    setLetters (alphabet, "uU", TableRadix, -6);
+
+    const char letters [] = "ABCDEFGHJKaLMNbPQdReSfTUmVWnXtYyZ";
+    const uint8_t significands [] = {
+        10, 11, 12, 13, 15, 16, 18, 20, 22, 24, 25, 27, 30, 33, 35, 36, 39,
+        40, 43, 45, 47, 50, 51, 56, 60, 62, 68, 70, 75, 80, 82, 90, 91
+    };
+    for (int i = 0; letters [i] != '\0'; ++i) {
+        const uint8_t c = static_cast<uint8_t> (letters [i]);
+        alphabet.classes [c] = MarkingLetter;
+        alphabet.significands [c] = significands [i];
+    }
+
+    setTolerance (alphabet, "BCD", 0);
+    setTolerance (alphabet, "F", 100);
+    setTolerance (alphabet, "G", 200);
+    setTolerance (alphabet, "J", 500);
+    setTolerance (alphabet, "K", 1000);
+    setTolerance (alphabet, "M", 2000);
+    setTolerance (alphabet, "Z", 8000);
+    return alphabet;
+}
+
+constexpr MarkingRules makeCapacitorRules() {
+    const MarkingLayout layouts [] = {
+        { "d",     MarkingPlain,      -12, 0 },
+        { "dd",    MarkingPlain,      -12, 0 },
+        { "ddm",   MarkingThreeDigit, -12, 0 },
+        { "dr",    MarkingRadix,        0, 0 },
+        { "ddr",   MarkingRadix,        0, 0 },
+        { "dddr",  MarkingRadix,        0, 0 },
+        { "drd",   MarkingRadix,       -1, 0 },
+        { "drdd",  MarkingRadix,       -2, 0 },
+        { "ddrd",  MarkingRadix,       -1, 0 },
+        { "rdd",   MarkingRadix,       -2, 0 },
+        { "drt",   MarkingRadix,        0, 0 },
+        { "ddrt",  MarkingRadix,        0, 0 },
+        { "dddrt", MarkingRadix,        0, 0 },
+        { "drdt",  MarkingRadix,       -1, 0 },
+        { "drddt", MarkingRadix,       -2, 0 },
+        { "ddrdt", MarkingRadix,       -1, 0 },
+        { "rddt",  MarkingRadix,       -2, 0 },
+        { "ex",    MarkingEia198,     -13, 0 }
+    };
+
+    return makeRules (layouts, sizeof (layouts) / sizeof (layouts [0]));
+}
+
+/**
+ * Rules used when the primary rule of a pattern does not accept the
+ * code, "104K" has the same pattern as "100n" and "22K" as "10n"
+ */
+constexpr MarkingRules makeCapacitorFallback() {
+    const MarkingLayout layouts [] = {
+        { "dt",   MarkingPlain,      -12, 0 },
+        { "ddt",  MarkingPlain,      -12, 0 },
+        { "ddmt", MarkingThreeDigit, -12, 0 }
+    };
+
+    return makeRules (layouts, sizeof (layouts) / sizeof (layouts [0]));
+}
+
+/**
+ * Inductors: microhenry codes ("101", "101K"), radix codes ("4R7" in
+ * microhenries, "4N7" in nanohenries, "R47") and 3 or 4 bands
+ */
+constexpr MarkingAlphabet makeInductorAlphabet() {
+    MarkingAlphabet alphabet = makeAlphabet();
+    setDigits (alphabet, TableDigit, { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+    setLetters (alphabet, "Rr", TableRadix, -6);
+    setLetters (alphabet, "Nn", TableRadix, -9);
+    setTolerance (alphabet, "F", 100);
+    setTolerance (alphabet, "G", 200);
+    setTolerance (alphabet, "J", 500);
+    setTolerance (alphabet, "K", 1000);
+    setTolerance (alphabet, "M", 2000);
+    return alphabet;
+}
+
+constexpr MarkingRules makeInductorRules() {
+    const MarkingLayout layouts [] = {
+        { "ddm",   MarkingThreeDigit, -6, 0 },
+        { "ddmt",  MarkingThreeDigit, -6, 0 },
+        { "ddr",   MarkingRadix,       0, 0 },
+        { "drd",   MarkingRadix,      -1, 0 },
+        { "ddrd",  MarkingRadix,      -1, 0 },
+        { "rd",    MarkingRadix,      -1, 0 },
+        { "rdd",   MarkingRadix,      -2, 0 },
+        { "ddrt",  MarkingRadix,       0, 0 },
+        { "drdt",  MarkingRadix,      -1, 0 },
+        { "rddt",  MarkingRadix,      -2, 0 }
+    };
+
+    return makeRules (layouts, sizeof (layouts) / sizeof (layouts [0]));
+}
+
+constexpr MarkingBands makeInductorBands() {
+    MarkingBands bands = makeBands (-6);
+    bands.rules [3] = bandRule (2, -1, 2000);
+    bands.rules [4] = bandRule (2, 3, 0);
+    bands.tolerances [MultiplierBlack] = 2000;
+    bands.tolerances [MultiplierBrown] = 100;
+    bands.tolerances [MultiplierRed] = 200;
+    bands.tolerances [MultiplierOrange] = 300;
+    bands.tolerances [MultiplierYellow] = 400;
+    bands.tolerances [MultiplierGold] = 500;
+    bands.tolerances [MultiplierSilver] = 1000;
+    return bands;
+}
+
+/**
+ * Families, each one is a set of compile-time tables
+ */
+struct ResistorMarking {
+    static constexpr ComponentFamily FAMILY = FamilyResistor;
+    static constexpr size_t MAX_LENGTH = 4;
+    static constexpr bool JUMPERS = true;
+    static constexpr MarkingAlphabet ALPHABET = makeResistorAlphabet();
+    static constexpr MarkingRules RULES = makeResistorRules();
+    static constexpr MarkingRules FALLBACK = makeRules (NULL, 0);
+    static constexpr MarkingBands BANDS = makeResistorBands();
+};
+
+struct CapacitorMarking {
+    static constexpr ComponentFamily FAMILY = FamilyCapacitor;
+    static constexpr size_t MAX_LENGTH = 5;
+    static constexpr bool JUMPERS = false;
+    static constexpr MarkingAlphabet ALPHABET = makeCapacitorAlphabet();
+    static constexpr MarkingRules RULES = makeCapacitorRules();
+    static constexpr MarkingRules FALLBACK = makeCapacitorFallback();
+    static constexpr MarkingBands BANDS = makeBands (-12);
+};
+
+struct InductorMarking {
+    static constexpr ComponentFamily FAMILY = FamilyInductor;
+    static constexpr size_t MAX_LENGTH = 4;
+    static constexpr bool JUMPERS = false;
+    static constexpr MarkingAlphabet ALPHABET = makeInductorAlphabet();
+    static constexpr MarkingRules RULES = makeInductorRules();
+    static constexpr MarkingRules FALLBACK = makeRules (NULL, 0);
+    static constexpr MarkingBands BANDS = makeInductorBands();
+};
+
+/**
+ * Appends the digit at @a position of the @a code to the @a significand
+ * if it is one of the significant digits of the @a rule
+ */
+MARKING_INLINE uint32_t appendDigit (const uint32_t significand,
+                                     const MarkingRule& rule,
+                                     const size_t pattern,
+                                     const char* code,
+                                     const size_t position) {
+    if (position >= rule.digits || ((pattern >> position) & 1) != 0)
+        return significand;
+
+    return significand * 10 + static_cast<uint32_t> (code [position] - '0');
+}
+
+/**
+ * Applies the given @a rule to a @a code whose pattern is @a pattern,
+ * returns false if a character is not accepted by the rule
+ */
+template <typename Family>
+MARKING_INLINE bool applyRule (const MarkingRule& rule,
+                               const size_t pattern,
+                               const char* code,
+                               MarkingValue& result) {
+    const MarkingAlphabet& alphabet = Family::ALPHABET;
+    if (rule.scheme == MarkingInvalid)
+        return false;
+
+    const int exponent = alphabet.exponents [rule.table][static_cast<uint8_t> (code [rule.multiplier])];
+    if (exponent == NO_EXPONENT)
+        return false;
+
+    // Significand, made of the digits that precede the multiplier (the
+    // loop is unrolled by hand because compilers keep it at -O2)
+    uint32_t significand = 0;
+    significand = appendDigit (significand, rule, pattern, code, 0);
+    significand = appendDigit (significand, rule, pattern, code, 1);
+    significand = appendDigit (significand, rule, pattern, code, 2);
+    significand = appendDigit (significand, rule, pattern, code, 3);
+    significand = appendDigit (significand, rule, pattern, code, 4);
+
+    if (rule.scheme == MarkingEia96)
+        significand = MarkingLookup::EIA96 [significand];
+    if (rule.letter >= 0) {
+        significand = alphabet.significands [static_cast<uint8_t> (code [rule.letter])];
+        if (significand == 0)
+            return false;
+    }
+
+    if (significand == NO_SIGNIFICAND)
+        return false;
+
+    // Tolerance
+    uint16_t tolerance = rule.tolerance;
+    if (rule.tolerancePosition >= 0) {
+        tolerance = alphabet.tolerances [static_cast<uint8_t> (code [rule.tolerancePosition])];
+        if (tolerance == NO_TOLERANCE)
+            return false;
+    }
+
+    result.significand = significand;
+    result.exponent = rule.exponent + exponent;
+    result.tolerance = tolerance;
+    result.scheme = rule.scheme;
+    return true;
+}
+
+/**
+ * Decodes a @a code whose pattern is @a Pattern. The rules are constant
+ * here, so their positions and tables become immediates and the decoded
+ * value does not wait for loads from the rule tables. The fallback rule
+ * is tried if the primary rule does not accept the code.
+ */
+template <typename Family, size_t Pattern>
+void decodePattern (const char* code, MarkingValue& result) {
+    constexpr MarkingRule primary = Family::RULES.rules [Pattern];
+    constexpr MarkingRule fallback = Family::FALLBACK.rules [Pattern];
+    if (!applyRule<Family> (primary, Pattern, code, result))
+        applyRule<Family> (fallback, Pattern, code, result);
+}
+
+/**
+ * Decoder of the patterns that no rule accepts
+ */
+inline void rejectPattern (const char* code, MarkingValue& result) {
+    (void) code;
+    (void) result;
+}
+
+/**
+ * Decoder of each pattern of a family, built at compile time. Patterns
+ * without rules share the same decoder.
+ */
+template <typename Family>
+struct MarkingDecoders
+{
+    typedef void (*Decoder) (const char* code, MarkingValue& result);
+
+    struct Table
+    {
+        Decoder decoders [MARKING_PATTERNS];
+    };
+
+    template <size_t... Patterns>
+    static constexpr Table makeTable (std::index_sequence<Patterns...>) {
+        return Table { { (Family::RULES.rules [Patterns].scheme != MarkingInvalid ||
+                          Family::FALLBACK.rules [Patterns].scheme != MarkingInvalid) ?
+                         &decodePattern<Family, Patterns> : &rejectPattern... } };
+    }
+
+    static constexpr Table TABLE = makeTable (std::make_index_sequence<MARKING_PATTERNS>());
+};
+
+template <typename Family>
+constexpr typename MarkingDecoders<Family>::Table MarkingDecoders<Family>::TABLE;
+
+/**
+ * Decodes the printed @a code of a component of the given family, which
+ * must have @a length characters (it does not need to be NUL-terminated)
+ */
+template <typename Family>
+MARKING_INLINE MarkingValue decodeCode (const char* code, const size_t length) {
+    MarkingValue result = { 0, 0, 0, MarkingInvalid, static_cast<uint8_t> (Family::FAMILY) };
+    if (length == 0 || length > Family::MAX_LENGTH)
+        return result;
+
+    // Classify the characters and build the pattern
+    const MarkingAlphabet& alphabet = Family::ALPHABET;
+    size_t pattern = size_t (1) << length;
+    uint8_t nonZero = 0;
+    for (size_t i = 0; i < length; ++i) {
+        const uint8_t c = static_cast<uint8_t> (code [i]);
+        const uint8_t type = alphabet.classes [c];
+        if (type == MarkingOther)
+            return result;
+
+        pattern |= static_cast<size_t> (type >> 1) << i;
+        nonZero |= c ^ '0';
+    }
+
+    // Zero-ohm resistors ("0", "00", "000" or "0000")
+    if (Family::JUMPERS && nonZero == 0) {
+        result.scheme = MarkingJumper;
+        return result;
+    }
+
+    MarkingDecoders<Family>::TABLE.decoders [pattern] (code, result);
+    return result;
+}
+
+/**
+ * Decodes the @a count color bands of a component of the given family,
+ * colors are numbered as the @c Multiplier enum
+ */
+template <typename Family>
+MARKING_INLINE MarkingValue decodeColors (const uint8_t* colors, const size_t count) {
+    MarkingValue result = { 0, 0, 0, MarkingInvalid, static_cast<uint8_t> (Family::FAMILY) };
+    const MarkingBands& bands = Family::BANDS;
+    if (count >= 7 || !bands.rules [count].valid)
+        return result;
+
+    const MarkingBandRule& rule = bands.rules [count];
+    uint32_t significand = 0;
+    for (size_t i = 0; i < rule.digits; ++i) {
+        if (colors [i] > MultiplierWhite)
+            return result;
+
+        significand = significand * 10 + colors [i];
+    }
+
+    // Gold and silver divide by 10 and 100
+    const uint8_t multiplier = colors [rule.digits];
+    if (multiplier > MultiplierSilver)
+        return result;
+
+    uint16_t tolerance = rule.tolerance;
+    if (rule.tolerancePosition >= 0) {
+        const uint8_t color = colors [rule.tolerancePosition];
+        tolerance = color <= MultiplierSilver ? bands.tolerances [color] : NO_TOLERANCE;
+        if (tolerance == NO_TOLERANCE)
+            return result;
+    }
+
+    result.significand = significand;
+    result.exponent = bands.exponent + (multiplier <= MultiplierWhite ? multiplier : MultiplierWhite - multiplier);
+    result.tolerance = tolerance;
+    result.scheme = MarkingColors;
+    return result;
+}
+
+}
+
+#endif
@@ -0,0 +1,435 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "MonteCarlo.h"
+#include "WorstCase.h"
+
+#include <math.h>
+#include <mutex>
+#include <assert.h>
+#include <algorithm>
+
+using namespace ResistorCore;
+
+const double MonteCarloEngine::REFERENCE_TEMPERATURE = 25;
+
+/**
+ * Number of samples of each chunk, chunks are the unit of work of the
+ * threads and the unit of the (ordered) statistics merge
+ */
+static const size_t CHUNK_SAMPLES = 16384;
+
+/**
+ * Number of samples that are generated and reduced together
+ */
+static const size_t BLOCK_SAMPLES = 256;
+
+/**
+ * Standard deviations covered by the tolerance of normal distributions
+ */
+static const double SIGMAS_PER_TOLERANCE = 3;
+
+/**
+ * Philox-4x32 multipliers and Weyl key increments
+ */
+static const uint32_t PHILOX_M0 = 0xD2511F53;
+static const uint32_t PHILOX_M1 = 0xCD9E8D57;
+static const uint32_t PHILOX_W0 = 0x9E3779B9;
+static const uint32_t PHILOX_W1 = 0xBB67AE85;
+
+/**
+ * Running statistics of a chunk, deviations are measured from the
+ * nominal output to keep the sums accurate
+ */
+struct ChunkStats {
+    double sum;
+    double sumSquares;
+    double min;
+    double max;
+    uint64_t inSpec;
+};
+
+/**
+ * Converts a random integer to a double in the open interval (0, 1)
+ */
+static inline double unitInterval (const uint32_t value) {
+    return (value + 0.5) * (1.0 / 4294967296.0);
+}
+
+/**
+ * Generates the four random integers of the given @a sample and
+ * @a stream (part index), @a attempt is used to redraw rejected samples
+ */
+static inline void randomWords (const uint64_t sample,
+                                const uint32_t stream,
+                                const uint32_t attempt,
+                                const uint64_t seed,
+                                uint32_t output [4]) {
+    const uint32_t counter [4] = {
+        static_cast<uint32_t> (sample),
+        static_cast<uint32_t> (sample >> 32),
+        stream,
+        attempt
+    };
+
+    MonteCarloEngine::philox (counter, seed, output);
+}
+
+/**
+ * Returns the relative deviation of a part from its nominal value for
+ * the given random words (@a attempt is only used by truncated normal
+ * distributions to redraw the samples that are out of tolerance)
+ */
+static inline double deviation (const MonteCarloPart& part,
+                                const uint32_t words [4],
+                                const uint64_t sample,
+                                const uint32_t stream,
+                                const uint64_t seed) {
+    if (part.distribution == DistributionUniform)
+        return part.tolerance * (2 * unitInterval (words [0]) - 1);
+
+    // Box-Muller transform
+    double z = sqrt (-2 * log (unitInterval (words [0]))) *
+               cos (2 * M_PI * unitInterval (words [1]));
+
+    // Redraw the samples outside of the tolerance
+    if (part.distribution == DistributionTruncatedNormal) {
+        uint32_t attempt = 0;
+        uint32_t redraw [4];
+        while (fabs (z) > SIGMAS_PER_TOLERANCE) {
+            randomWords (sample, stream, ++attempt, seed, redraw);
+            z = sqrt (-2 * log (unitInterval (redraw [0]))) *
+                cos (2 * M_PI * unitInterval (redraw [1]));
+        }
+    }
+
+    return part.tolerance * z / SIGMAS_PER_TOLERANCE;
+}
+
+/**
+ * Calculates the outputs of the network for @a count samples, @a values
+ * holds the values of each part with a stride of @c BLOCK_SAMPLES
+ */
+static void evaluateBlock (const NetworkModel model,
+                           const double* values,
+                           const size_t parts,
+                           const size_t count,
+                           double* output) {
+    const double* p0 = values;
+    const double* p1 = values + BLOCK_SAMPLES;
+
+    switch (model) {
+    case ModelSeries:
+        std::copy (p0, p0 + count, output);
+        for (size_t p = 1; p < parts; ++p)
+            for (size_t i = 0; i < count; ++i)
+                output [i] += values [p * BLOCK_SAMPLES + i];
+        break;
+    case ModelParallel:
+        for (size_t i = 0; i < count; ++i)
+            output [i] = 1 / p0 [i];
+        for (size_t p = 1; p < parts; ++p)
+            for (size_t i = 0; i < count; ++i)
+                output [i] += 1 / values [p * BLOCK_SAMPLES + i];
+        for (size_t i = 0; i < count; ++i)
+            output [i] = 1 / output [i];
+        break;
+    case ModelDivider:
+        for (size_t i = 0; i < count; ++i)
+            output [i] = p1 [i] / (p0 [i] + p1 [i]);
+        break;
+    case ModelInvertingGain:
+        for (size_t i = 0; i < count; ++i)
+            output [i] = p0 [i] / p1 [i];
+        break;
+    case ModelNonInvertingGain:
+        for (size_t i = 0; i < count; ++i)
+            output [i] = 1 + p0 [i] / p1 [i];
+        break;
+    }
+}
+
+MonteCarloEngine::MonteCarloEngine (BatchExecutor* executor) :
+    m_executor (executor) {}
+
+/**
+ * Runs the analysis described by @a setup and writes its summary to
+ * @a result.
+ *
+ * The @a progress callback (if set) receives the number of processed
+ * chunks. Returns @c false if the setup is invalid (no samples, no bins,
+ * or a wrong number of parts for the model) or if the executor was
+ * cancelled, in which case @a result is not changed.
+ */
+bool MonteCarloEngine::run (const MonteCarloSetup& setup,
+                            MonteCarloResult* result,
+                            const BatchExecutor::ProgressCallback& progress) const {
+    assert (result != NULL);
+    assert (setup.parts != NULL || setup.partCount == 0);
+
+    // Validate setup
+    const size_t parts = setup.partCount;
+    const bool twoParts = setup.model == ModelDivider ||
+                          setup.model == ModelInvertingGain ||
+                          setup.model == ModelNonInvertingGain;
+    if (setup.samples == 0 || setup.bins == 0 || parts == 0 || parts > MAX_PARTS)
+        return false;
+    if (twoParts && parts != 2)
+        return false;
+
+    // Get nominal output
+    double nominal [MAX_PARTS];
+    for (size_t p = 0; p < parts; ++p)
+        nominal [p] = setup.parts [p].nominal;
+
+    const double nominalOutput = evaluate (setup.model, nominal, parts);
+
+    // Get the worst-case outputs of bounded distributions, which are at
+    // the corners of the (monotonic) network functions
+    const double deltaT = std::max (fabs (setup.minTemperature - REFERENCE_TEMPERATURE),
+                                    fabs (setup.maxTemperature - REFERENCE_TEMPERATURE));
+
+    double low [MAX_PARTS];
+    double high [MAX_PARTS];
+    for (size_t p = 0; p < parts; ++p) {
+        const MonteCarloPart& part = setup.parts [p];
+        const double drift = fabs (part.tempco) * 1e-6 * deltaT;
+        low [p] = part.nominal * (1 - part.tolerance) * (1 - drift);
+        high [p] = part.nominal * (1 + part.tolerance) * (1 + drift);
+    }
+
+    double histogramMin = nominalOutput;
+    double histogramMax = nominalOutput;
+    for (size_t corner = 0; corner < (size_t (1) << parts); ++corner) {
+        double values [MAX_PARTS];
+        for (size_t p = 0; p < parts; ++p)
+            values [p] = (corner >> p) & 1 ? high [p] : low [p];
+
+        const double output = evaluate (setup.model, values, parts);
+        histogramMin = std::min (histogramMin, output);
+        histogramMax = std::max (histogramMax, output);
+    }
+
+    if (!(histogramMax > histogramMin)) {
+        const double width = std::max (fabs (nominalOutput) * 1e-9, 1e-300);
+        histogramMin = nominalOutput - width;
+        histogramMax = nominalOutput + width;
+    }
+
+    // Process the samples chunk by chunk
+    const size_t bins = setup.bins;
+    const double binScale = bins / (histogramMax - histogramMin);
+    const size_t chunks = static_cast<size_t> ((setup.samples + CHUNK_SAMPLES - 1) / CHUNK_SAMPLES);
+
+    std::mutex mutex;
+    std::vector<ChunkStats> stats (chunks);
+    std::vector<uint64_t> histogram (bins + 2, 0);
+
+    const BatchExecutor::Task task = [&](const size_t begin, const size_t end) {
+        std::vector<uint64_t> counts (bins + 2, 0);
+        std::vector<double> values (parts * BLOCK_SAMPLES);
+        double temperature [BLOCK_SAMPLES];
+        double output [BLOCK_SAMPLES];
+        uint32_t words [4];
+
+        for (size_t c = begin; c < end; ++c) {
+            const uint64_t first = static_cast<uint64_t> (c) * CHUNK_SAMPLES;
+            const uint64_t last = std::min<uint64_t> (first + CHUNK_SAMPLES, setup.samples);
+
+            ChunkStats chunk = { 0, 0, HUGE_VAL, -HUGE_VAL, 0 };
+            for (uint64_t block = first; block < last; block += BLOCK_SAMPLES) {
+                const size_t count = static_cast<size_t> (std::min<uint64_t> (BLOCK_SAMPLES, last - block));
+
+                // Draw the ambient temperature of each sample
+                for (size_t i = 0; i < count; ++i) {
+                    randomWords (block + i, MAX_PARTS, 0, setup.seed, words);
+                    temperature [i] = setup.minTemperature + unitInterval (words [0]) *
+                                      (setup.maxTemperature - setup.minTemperature) -
+                                      REFERENCE_TEMPERATURE;
+                }
+
+                // Draw the value of each part
+                for (size_t p = 0; p < parts; ++p) {
+                    const MonteCarloPart& part = setup.parts [p];
+                    const uint32_t stream = static_cast<uint32_t> (p);
+                    double* partValues = values.data() + p * BLOCK_SAMPLES;
+
+                    for (size_t i = 0; i < count; ++i) {
+                        randomWords (block + i, stream, 0, setup.seed, words);
+                        const double tempco = part.tempco * 1e-6 * (2 * unitInterval (words [2]) - 1);
+                        partValues [i] = part.nominal *
+                                         (1 + deviation (part, words, block + i, stream, setup.seed)) *
+                                         (1 + tempco * temperature [i]);
+                    }
+                }
+
+                // Calculate the outputs and reduce them
+                evaluateBlock (setup.model, values.data(), parts, count, output);
+                for (size_t i = 0; i < count; ++i) {
+                    const double x = output [i];
+                    const double d = x - nominalOutput;
+                    chunk.sum += d;
+                    chunk.sumSquares += d * d;
+                    chunk.min = std::min (chunk.min, x);
+                    chunk.max = std::max (chunk.max, x);
+                    chunk.inSpec += (x >= setup.specMin && x <= setup.specMax);
+
+                    // Bin 0 is the underflow and bin (bins + 1) the overflow
+                    size_t bin;
+                    if (x < histogramMin)
+                        bin = 0;
+                    else if (x > histogramMax)
+                        bin = bins + 1;
+                    else
+                        bin = std::min (static_cast<size_t> ((x - histogramMin) * binScale), bins - 1) + 1;
+
+                    ++counts [bin];
+                }
+            }
+
+            stats [c] = chunk;
+        }
+
+        // Counts are integers, so the merge order does not matter
+        std::lock_guard<std::mutex> lock (mutex);
+        for (size_t i = 0; i < counts.size(); ++i)
+            histogram [i] += counts [i];
+    };
+
+    if (m_executor) {
+        const size_t threads = m_executor->threadCount();
+        if (!m_executor->run (chunks, chunks / (threads * 8), task, progress))
+            return false;
+    }
+
+    else {
+        for (size_t c = 0; c < chunks; ++c) {
+            task (c, c + 1);
+            if (progress)
+                progress (c + 1, chunks);
+        }
+    }
+
+    // Merge the chunk statistics in order, so that the floating-point
+    // sums do not depend on the number of threads
+    double sum = 0;
+    double sumSquares = 0;
+    uint64_t inSpec = 0;
+    result->min = HUGE_VAL;
+    result->max = -HUGE_VAL;
+    for (size_t c = 0; c < chunks; ++c) {
+        sum += stats [c].sum;
+        sumSquares += stats [c].sumSquares;
+        inSpec += stats [c].inSpec;
+        result->min = std::min (result->min, stats [c].min);
+        result->max = std::max (result->max, stats [c].max);
+    }
+
+    const double n = static_cast<double> (setup.samples);
+    const double variance = setup.samples > 1 ? (sumSquares - sum * sum / n) / (n - 1) : 0;
+
+    result->nominal = nominalOutput;
+    result->samples = setup.samples;
+    result->mean = nominalOutput + sum / n;
+    result->stddev = sqrt (std::max (variance, 0.0));
+    result->yield = inSpec / n;
+    result->histogramMin = histogramMin;
+    result->histogramMax = histogramMax;
+    result->underflow = histogram [0];
+    result->overflow = histogram [bins + 1];
+    result->histogram.assign (histogram.begin() + 1, histogram.begin() + 1 + bins);
+    return true;
+}
+
+/**
+ * Returns the output of a network of the given @a model for the given
+ * part @a values
+ */
+double MonteCarloEngine::evaluate (const NetworkModel model,
+                                   const double* values,
+                                   const size_t count) {
+    assert (values != NULL && count > 0);
+    return networkOutput (model, values, count);
+}
+
+/**
+ * Returns the value below which the given fraction @a p of the samples
+ * of @a result fall, interpolated linearly within the histogram bins
+ */
+double MonteCarloEngine::quantile (const MonteCarloResult& result, const double p) {
+    const size_t bins = result.histogram.size();
+    if (result.samples == 0 || bins == 0)
+        return 0;
+
+    const double target = std::min (std::max (p, 0.0), 1.0) * result.samples;
+    double cumulative = static_cast<double> (result.underflow);
+    if (target <= cumulative)
+        return result.underflow > 0 ? result.min : result.histogramMin;
+
+    const double width = (result.histogramMax - result.histogramMin) / bins;
+    for (size_t i = 0; i < bins; ++i) {
+        const double count = static_cast<double> (result.histogram [i]);
+        if (count > 0 && cumulative + count >= target)
+            return result.histogramMin + width * (i + (target - cumulative) / count);
+
+        cumulative += count;
+    }
+
+    return result.overflow > 0 ? result.max : result.histogramMax;
+}
+
+/**
+ * Philox-4x32-10 counter-based generator (Salmon et al., "Parallel
+ * random numbers: as easy as 1, 2, 3"), writes the four random words of
+ * the given @a counter and @a key to @a output
+ */
+void MonteCarloEngine::philox (const uint32_t counter [4],
+                               const uint64_t key,
+                               uint32_t output [4]) {
+    uint32_t c0 = counter [0];
+    uint32_t c1 = counter [1];
+    uint32_t c2 = counter [2];
+    uint32_t c3 = counter [3];
+    uint32_t k0 = static_cast<uint32_t> (key);
+    uint32_t k1 = static_cast<uint32_t> (key >> 32);
+
+    for (int round = 0; round < 10; ++round) {
+        if (round > 0) {
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+
+        const uint64_t product0 = static_cast<uint64_t> (PHILOX_M0) * c0;
+        const uint64_t product1 = static_cast<uint64_t> (PHILOX_M1) * c2;
+        const uint32_t n0 = static_cast<uint32_t> (product1 >> 32) ^ c1 ^ k0;
+        const uint32_t n2 = static_cast<uint32_t> (product0 >> 32) ^ c3 ^ k1;
+        c1 = static_cast<uint32_t> (product1);
+        c3 = static_cast<uint32_t> (product0);
+        c0 = n0;
+        c2 = n2;
+    }
+
+    output [0] = c0;
+    output [1] = c1;
+    output [2] = c2;
+    output [3] = c3;
+}
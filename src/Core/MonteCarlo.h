@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_MONTE_CARLO_H
+#define RESISTOR_MONTE_CARLO_H
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "BatchExecutor.h"
+
+namespace ResistorCore
+{
+
+/**
+ * Distribution of the value of a part within its tolerance:
+ *
+ * - Uniform: flat over nominal ± tolerance
+ * - Normal: the tolerance is three standard deviations, so 0.27% of the
+ *   parts are outside of it
+ * - Truncated normal: like @c DistributionNormal, but parts outside of
+ *   the tolerance are discarded (as if they were rejected by the vendor)
+ */
+enum Distribution {
+    DistributionUniform         = 0,
+    DistributionNormal          = 1,
+    DistributionTruncatedNormal = 2
+};
+
+/**
+ * Output of a network as a function of its parts:
+ *
+ * - Series and parallel: resistance of every part in series/parallel
+ * - Divider: ratio p1 / (p0 + p1)
+ * - Inverting gain: magnitude of the gain p0 / p1 (p0 is the feedback
+ *   resistor and p1 the gain resistor)
+ * - Non-inverting gain: 1 + p0 / p1
+ */
+enum NetworkModel {
+    ModelSeries           = 0,
+    ModelParallel         = 1,
+    ModelDivider          = 2,
+    ModelInvertingGain    = 3,
+    ModelNonInvertingGain = 4
+};
+
+/**
+ * Part of a network, @c tolerance is relative (e.g. 0.05 for 5%) and
+ * @c tempco is the largest temperature coefficient in ppm/K. The actual
+ * coefficient of each sample is uniform over ± @c tempco.
+ */
+struct MonteCarloPart {
+    double nominal;
+    double tolerance;
+    double tempco;
+    Distribution distribution;
+};
+
+/**
+ * Parameters of an analysis. The ambient temperature of each sample is
+ * uniform over [@c minTemperature, @c maxTemperature] (in °C, the
+ * nominal values are given at 25 °C). The yield is the fraction of the
+ * samples within [@c specMin, @c specMax]. Samples are generated from
+ * @c seed and their index only, so the same setup always gives the
+ * same result.
+ */
+struct MonteCarloSetup {
+    NetworkModel model;
+    const MonteCarloPart* parts;
+    size_t partCount;
+    double minTemperature;
+    double maxTemperature;
+    uint64_t samples;
+    uint64_t seed;
+    size_t bins;
+    double specMin;
+    double specMax;
+};
+
+/**
+ * Summary of an analysis. The histogram has equal bins between
+ * @c histogramMin and @c histogramMax (the worst-case outputs of
+ * bounded distributions), samples outside of that range are counted
+ * in @c underflow and @c overflow.
+ */
+struct MonteCarloResult {
+    double nominal;
+    uint64_t samples;
+    double mean;
+    double stddev;
+    double min;
+    double max;
+    double yield;
+    double histogramMin;
+    double histogramMax;
+    uint64_t underflow;
+    uint64_t overflow;
+    std::vector<uint64_t> histogram;
+};
+
+/**
+ * Monte Carlo tolerance analysis of resistor networks.
+ *
+ * Random numbers come from a counter-based generator (Philox-4x32-10)
+ * keyed by the seed and indexed by the sample and part numbers, so any
+ * sample can be generated independently of the others. Samples are
+ * split in fixed chunks that are processed by the threads of an
+ * optional @c BatchExecutor, and the statistics of the chunks are
+ * merged in chunk order, so results do not depend on the number of
+ * threads.
+ *
+ * Samples are generated in structure-of-arrays blocks and reduced into
+ * a histogram and a few running sums as they are produced, so memory
+ * use does not depend on the number of samples. Quantiles are read
+ * from the histogram.
+ */
+class MonteCarloEngine
+{
+public:
+    static const size_t MAX_PARTS = 8;
+    static const size_t DEFAULT_BINS = 1024;
+    static const double REFERENCE_TEMPERATURE;
+
+    explicit MonteCarloEngine (BatchExecutor* executor = NULL);
+
+    bool run (const MonteCarloSetup& setup,
+              MonteCarloResult* result,
+              const BatchExecutor::ProgressCallback& progress =
+                  BatchExecutor::ProgressCallback()) const;
+
+    static double evaluate (const NetworkModel model,
+                            const double* values,
+                            const size_t count);
+    static double quantile (const MonteCarloResult& result, const double p);
+    static void philox (const uint32_t counter [4], const uint64_t key, uint32_t output [4]);
+
+private:
+    BatchExecutor* m_executor;
+};
+
+}
+
+#endif
@@ -0,0 +1,591 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Netlist.h"
+#include "SmdDecoder.h"
+
+#include <math.h>
+#include <ctype.h>
+#include <string.h>
+
+using namespace ResistorCore;
+
+/**
+ * Color names accepted by @c parseColorBands(), in the order of the
+ * @c Multiplier enum (digits 0-9, then gold and silver)
+ */
+static const char* const COLOR_NAMES [] = {
+    "black", "brown", "red", "orange", "yellow", "green",
+    "blue", "violet", "gray", "white", "gold", "silver"
+};
+
+static const int COLOR_COUNT = sizeof (COLOR_NAMES) / sizeof (COLOR_NAMES [0]);
+static const int GRAY_INDEX = 8;
+
+/**
+ * Tolerance and tempco bands for each color, -1 if the color cannot be
+ * used in that position
+ */
+static const int COLOR_TOLERANCES [COLOR_COUNT] = {
+    -1, ToleranceBrown, ToleranceRed, -1, -1, ToleranceGreen,
+    ToleranceBlue, ToleranceViolet, ToleranceGray, -1, ToleranceGold,
+    ToleranceSilver
+};
+
+static const int COLOR_TEMPCOS [COLOR_COUNT] = {
+    -1, TempcoBrown, TempcoRed, TempcoOrange, TempcoYellow, -1,
+    TempcoBlue, TempcoViolet, -1, -1, -1, -1
+};
+
+/**
+ * Powers of ten that are exactly representable as doubles
+ */
+static const double EXACT_POWERS [] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/**
+ * Returns @c true if the @a length characters at @a text match
+ * @a keyword, ignoring case
+ */
+static bool matches (const char* text, const size_t length,
+                     const char* keyword) {
+    const size_t keywordLength = strlen (keyword);
+    if (length != keywordLength)
+        return false;
+
+    for (size_t i = 0; i < length; ++i)
+        if (tolower (static_cast<unsigned char> (text [i])) !=
+                static_cast<unsigned char> (keyword [i]))
+            return false;
+
+    return true;
+}
+
+/**
+ * Returns @c true if @a text starts with @a prefix, ignoring case
+ */
+static bool startsWith (const char* text, const size_t length,
+                        const char* prefix) {
+    const size_t prefixLength = strlen (prefix);
+    return length >= prefixLength && matches (text, prefixLength, prefix);
+}
+
+/**
+ * Returns the lower-case version of @a name, used as the lookup key of
+ * nodes and elements
+ */
+static std::string lookupKey (const std::string& name) {
+    std::string key (name);
+    for (size_t i = 0; i < key.size(); ++i)
+        key [i] = static_cast<char> (tolower (static_cast<unsigned char> (key [i])));
+
+    return key;
+}
+
+/**
+ * Returns the index of the color named by the given text, or -1
+ */
+static int colorIndex (const char* text, const size_t length) {
+    if (matches (text, length, "grey"))
+        return GRAY_INDEX;
+
+    for (int i = 0; i < COLOR_COUNT; ++i)
+        if (matches (text, length, COLOR_NAMES [i]))
+            return i;
+
+    return -1;
+}
+
+/**
+ * Builds the error message for the given line
+ */
+static bool fail (std::string* error, const size_t line,
+                  const std::string& message) {
+    if (error)
+        *error = "line " + std::to_string (line) + ": " + message;
+
+    return false;
+}
+
+/**
+ * Parses the value of a resistor, which can be a SPICE number, a color
+ * band code ("bands=yellow-violet-red-gold") or an SMD marking
+ * ("smd=4R7")
+ */
+static bool parseResistance (const std::string& token, double* value) {
+    const char* text = token.c_str();
+    const size_t length = token.size();
+
+    if (startsWith (text, length, "bands=")) {
+        BandCode code;
+        if (!parseColorBands (text + 6, length - 6, &code))
+            return false;
+
+        *value = decodeBands (code).resistance;
+    }
+
+    else if (startsWith (text, length, "smd=")) {
+        const SmdResult result = decodeSmd (text + 4, length - 4);
+        if (result.scheme == SmdInvalid)
+            return false;
+
+        *value = result.resistance;
+    }
+
+    else if (!parseSpiceValue (text, length, value))
+        return false;
+
+    return true;
+}
+
+/**
+ * Creates an empty netlist that only contains the ground node
+ */
+Netlist::Netlist() {
+    clear();
+}
+
+/**
+ * Removes every element and node, except for the ground node
+ */
+void Netlist::clear() {
+    m_nodes.clear();
+    m_elements.clear();
+    m_nodeNames.clear();
+    m_elementNames.clear();
+
+    m_nodeNames.push_back ("0");
+    m_nodes ["0"] = GROUND_NODE;
+    m_nodes ["gnd"] = GROUND_NODE;
+}
+
+/**
+ * Returns the index of the node with the given @a name, registering it
+ * if it does not exist yet
+ */
+size_t Netlist::addNode (const std::string& name) {
+    const std::string key = lookupKey (name);
+    const std::unordered_map<std::string, size_t>::const_iterator it = m_nodes.find (key);
+    if (it != m_nodes.end())
+        return it->second;
+
+    const size_t index = m_nodeNames.size();
+    m_nodeNames.push_back (name);
+    m_nodes [key] = index;
+    return index;
+}
+
+/**
+ * Appends an @a element to the netlist. Returns @c false (and does
+ * nothing) if another element has the same name or if one of its nodes
+ * does not exist
+ */
+bool Netlist::addElement (const NetlistElement& element) {
+    if (element.nodes [0] >= nodeCount() || element.nodes [1] >= nodeCount())
+        return false;
+
+    const std::string key = lookupKey (element.name);
+    if (m_elementNames.count (key))
+        return false;
+
+    m_elementNames [key] = m_elements.size();
+    m_elements.push_back (element);
+    return true;
+}
+
+/**
+ * Returns the index of the node with the given @a name, or
+ * @c INVALID_INDEX if there is no such node
+ */
+size_t Netlist::nodeIndex (const std::string& name) const {
+    const std::unordered_map<std::string, size_t>::const_iterator it = m_nodes.find (lookupKey (name));
+    return it == m_nodes.end() ? INVALID_INDEX : it->second;
+}
+
+/**
+ * Returns the index of the element with the given @a name, or
+ * @c INVALID_INDEX if there is no such element
+ */
+size_t Netlist::elementIndex (const std::string& name) const {
+    const std::unordered_map<std::string, size_t>::const_iterator it = m_elementNames.find (lookupKey (name));
+    return it == m_elementNames.end() ? INVALID_INDEX : it->second;
+}
+
+/**
+ * Returns the number of nodes, including the ground node
+ */
+size_t Netlist::nodeCount() const {
+    return m_nodeNames.size();
+}
+
+/**
+ * Returns the number of elements
+ */
+size_t Netlist::elementCount() const {
+    return m_elements.size();
+}
+
+/**
+ * Returns the name of the given @a node, as first written in the netlist
+ */
+const std::string& Netlist::nodeName (const size_t node) const {
+    return m_nodeNames [node];
+}
+
+/**
+ * Returns the element at the given @a index
+ */
+const NetlistElement& Netlist::element (const size_t index) const {
+    return m_elements [index];
+}
+
+/**
+ * Returns the element at the given @a index
+ */
+NetlistElement& Netlist::element (const size_t index) {
+    return m_elements [index];
+}
+
+/**
+ * Parses a SPICE-like netlist. Supported syntax:
+ *
+ * - The first line is the title of the circuit and is ignored, like in
+ *   SPICE, even when it looks like an element
+ * - <tt>Rname n+ n- value</tt>: resistor, the value can be a number
+ *   ("4.7k"), a color band code ("bands=yellow-violet-red-gold") or an
+ *   SMD marking ("smd=4R7")
+ * - <tt>Vname n+ n- [DC] value</tt>: independent voltage source
+ * - <tt>Iname n+ n- [DC] value</tt>: independent current source, the
+ *   current flows from n+ through the source to n-
+ * - Lines starting with '*' and text after ';' are comments
+ * - Dot commands are ignored, parsing stops at ".end"
+ *
+ * Node "0" (or "gnd") is the ground node. On failure, the error message
+ * (with the offending line number) is written to @a error.
+ */
+bool ResistorCore::parseNetlist (const char* text,
+                                 const size_t length,
+                                 Netlist* netlist,
+                                 std::string* error) {
+    if (!netlist || (!text && length > 0))
+        return fail (error, 0, "invalid arguments");
+
+    netlist->clear();
+
+    size_t line = 0;
+    size_t position = 0;
+    std::vector<std::string> tokens;
+    while (position < length) {
+        ++line;
+
+        /* Find the end of the line and strip inline comments */
+        size_t end = position;
+        while (end < length && text [end] != '\n')
+            ++end;
+
+        size_t contentEnd = position;
+        while (contentEnd < end && text [contentEnd] != ';')
+            ++contentEnd;
+
+        /* Split the line in whitespace-separated tokens */
+        tokens.clear();
+        for (size_t i = position; i < contentEnd;) {
+            while (i < contentEnd && isspace (static_cast<unsigned char> (text [i])))
+                ++i;
+
+            const size_t start = i;
+            while (i < contentEnd && !isspace (static_cast<unsigned char> (text [i])))
+                ++i;
+
+            if (i > start)
+                tokens.push_back (std::string (text + start, i - start));
+        }
+
+        position = end + 1;
+
+        /* Skip the title line, empty lines, comments and dot commands */
+        if (line == 1)
+            continue;
+
+        if (tokens.empty() || tokens [0][0] == '*')
+            continue;
+
+        if (tokens [0][0] == '.') {
+            if (matches (tokens [0].c_str(), tokens [0].size(), ".end"))
+                break;
+
+            continue;
+        }
+
+        /* Identify the element type */
+        NetlistElement element;
+        element.name = tokens [0];
+        switch (tolower (static_cast<unsigned char> (tokens [0][0]))) {
+        case 'r':
+            element.type = ElementResistor;
+            break;
+        case 'v':
+            element.type = ElementVoltageSource;
+            break;
+        case 'i':
+            element.type = ElementCurrentSource;
+            break;
+        default:
+            return fail (error, line, "unsupported element '" + tokens [0] + "'");
+        }
+
+        /* Sources may have a "DC" keyword before the value */
+        size_t valueToken = 3;
+        if (element.type != ElementResistor && tokens.size() > 4 &&
+                matches (tokens [3].c_str(), tokens [3].size(), "dc"))
+            valueToken = 4;
+
+        if (tokens.size() <= valueToken)
+            return fail (error, line, "missing nodes or value for '" + element.name + "'");
+
+        if (tokens.size() > valueToken + 1)
+            return fail (error, line, "unexpected '" + tokens [valueToken + 1] + "'");
+
+        /* Parse the value */
+        const std::string& value = tokens [valueToken];
+        if (element.type == ElementResistor) {
+            if (!parseResistance (value, &element.value))
+                return fail (error, line, "invalid resistance '" + value + "'");
+
+            if (!(element.value > 0) || !isfinite (element.value))
+                return fail (error, line, "resistance of '" + element.name + "' must be positive");
+        }
+
+        else if (!parseSpiceValue (value.c_str(), value.size(), &element.value))
+            return fail (error, line, "invalid value '" + value + "'");
+
+        /* Register nodes and the element */
+        element.nodes [0] = netlist->addNode (tokens [1]);
+        element.nodes [1] = netlist->addNode (tokens [2]);
+        if (!netlist->addElement (element))
+            return fail (error, line, "duplicate element '" + element.name + "'");
+    }
+
+    return true;
+}
+
+/**
+ * Parses a SPICE number: a decimal value with optional exponent ("1.5e3")
+ * followed by an optional scale factor (f, p, n, u or µ, m, k, meg, g, t
+ * or mil). Any letters after the number or the scale factor are ignored,
+ * so units can be written ("10kohm", "5V").
+ */
+bool ResistorCore::parseSpiceValue (const char* text, const size_t length,
+                                    double* value) {
+    if (!text || !value || length == 0)
+        return false;
+
+    size_t i = 0;
+    bool negative = false;
+    if (text [i] == '+' || text [i] == '-') {
+        negative = text [i] == '-';
+        ++i;
+    }
+
+    /* Mantissa, as an integer with a decimal exponent */
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    int digits = 0;
+    bool point = false;
+    for (; i < length; ++i) {
+        const char c = text [i];
+        if (c == '.' && !point)
+            point = true;
+
+        else if (c >= '0' && c <= '9') {
+            ++digits;
+            if (mantissa < UINT64_C (100000000000000000)) {
+                mantissa = mantissa * 10 + static_cast<uint64_t> (c - '0');
+                if (point)
+                    --exponent;
+            }
+
+            else if (!point)
+                ++exponent;
+        }
+
+        else
+            break;
+    }
+
+    if (digits == 0)
+        return false;
+
+    /* Exponent, only if followed by digits ("1e3", not "1meg") */
+    if (i + 1 < length && (text [i] == 'e' || text [i] == 'E')) {
+        size_t j = i + 1;
+        bool negativeExponent = false;
+        if (text [j] == '+' || text [j] == '-') {
+            negativeExponent = text [j] == '-';
+            ++j;
+        }
+
+        if (j < length && text [j] >= '0' && text [j] <= '9') {
+            int explicitExponent = 0;
+            for (; j < length && text [j] >= '0' && text [j] <= '9'; ++j)
+                if (explicitExponent < 1000)
+                    explicitExponent = explicitExponent * 10 + (text [j] - '0');
+
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
+            i = j;
+        }
+    }
+
+    /* Scale factor */
+    double scale = 1;
+    const char* suffix = text + i;
+    const size_t suffixLength = length - i;
+    if (startsWith (suffix, suffixLength, "meg")) {
+        exponent += 6;
+        i += 3;
+    }
+
+    else if (startsWith (suffix, suffixLength, "mil")) {
+        scale = 25.4e-6;
+        i += 3;
+    }
+
+    else if (startsWith (suffix, suffixLength, "\xC2\xB5")) {
+        exponent -= 6;
+        i += 2;
+    }
+
+    else if (suffixLength > 0) {
+        switch (tolower (static_cast<unsigned char> (suffix [0]))) {
+        case 'f':
+            exponent -= 15;
+            ++i;
+            break;
+        case 'p':
+            exponent -= 12;
+            ++i;
+            break;
+        case 'n':
+            exponent -= 9;
+            ++i;
+            break;
+        case 'u':
+            exponent -= 6;
+            ++i;
+            break;
+        case 'm':
+            exponent -= 3;
+            ++i;
+            break;
+        case 'k':
+            exponent += 3;
+            ++i;
+            break;
+        case 'g':
+            exponent += 9;
+            ++i;
+            break;
+        case 't':
+            exponent += 12;
+            ++i;
+            break;
+        default:
+            break;
+        }
+    }
+
+    /* Only unit letters may follow */
+    for (; i < length; ++i) {
+        const unsigned char c = static_cast<unsigned char> (text [i]);
+        if (!isalpha (c) && c < 0x80)
+            return false;
+    }
+
+    /* Scale by exact powers of ten where possible, so "4.7k" is exact */
+    double result = static_cast<double> (mantissa);
+    if (exponent >= 0 && exponent <= 22)
+        result *= EXACT_POWERS [exponent];
+    else if (exponent < 0 && exponent >= -22)
+        result /= EXACT_POWERS [-exponent];
+    else
+        result *= pow (10.0, exponent);
+
+    result *= scale;
+    *value = negative ? -result : result;
+    return true;
+}
+
+/**
+ * Parses a color band code written as color names separated by dashes,
+ * e.g. "yellow-violet-red-gold". Four bands are digit, digit, multiplier
+ * and tolerance, five bands add a third digit and six bands add the
+ * tempco at the end.
+ */
+bool ResistorCore::parseColorBands (const char* text, const size_t length,
+                                    BandCode* code) {
+    if (!text || !code)
+        return false;
+
+    int colors [6];
+    size_t count = 0;
+    size_t start = 0;
+    for (size_t i = 0; i <= length; ++i) {
+        if (i == length || text [i] == '-') {
+            if (count == 6)
+                return false;
+
+            colors [count] = colorIndex (text + start, i - start);
+            if (colors [count] < 0)
+                return false;
+
+            ++count;
+            start = i + 1;
+        }
+    }
+
+    if (count < 4)
+        return false;
+
+    const size_t digits = count == 4 ? 2 : 3;
+    code->type = count == 4 ? FourStripResistor :
+                 count == 5 ? FiveStripResistor : SixStripResistor;
+
+    code->digits [2] = DigitBlack;
+    for (size_t i = 0; i < digits; ++i) {
+        if (colors [i] > DigitWhite)
+            return false;
+
+        code->digits [i] = static_cast<Digit> (colors [i]);
+    }
+
+    const int tolerance = COLOR_TOLERANCES [colors [digits + 1]];
+    const int tempco = count == 6 ? COLOR_TEMPCOS [colors [5]] : TempcoBrown;
+    if (tolerance < 0 || tempco < 0)
+        return false;
+
+    code->multiplier = static_cast<Multiplier> (colors [digits]);
+    code->tolerance = static_cast<Tolerance> (tolerance);
+    code->tempco = static_cast<Tempco> (tempco);
+    return true;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_NETLIST_H
+#define RESISTOR_NETLIST_H
+
+#include <string>
+#include <vector>
+#include <stddef.h>
+#include <unordered_map>
+
+#include "ResistorCore.h"
+
+namespace ResistorCore
+{
+
+/**
+ * Index of the reference node ("0" or "gnd"), present in every netlist
+ */
+static const size_t GROUND_NODE = 0;
+
+/**
+ * Returned by the lookup functions when a name does not exist
+ */
+static const size_t INVALID_INDEX = static_cast<size_t> (-1);
+
+enum ElementType {
+    ElementResistor      = 0,
+    ElementVoltageSource = 1,
+    ElementCurrentSource = 2
+};
+
+/**
+ * Two-terminal element of a netlist. Currents are positive when they flow
+ * from @c nodes[0] (the positive terminal) through the element to
+ * @c nodes[1], as in SPICE
+ */
+struct NetlistElement {
+    ElementType type;
+    std::string name;
+    size_t nodes [2];
+    double value;
+};
+
+/**
+ * Parsed circuit: node names (index 0 is always the ground node) and the
+ * list of elements. Names are case-insensitive, as in SPICE
+ */
+class Netlist
+{
+public:
+    Netlist();
+
+    void clear();
+    size_t addNode (const std::string& name);
+    bool addElement (const NetlistElement& element);
+
+    size_t nodeIndex (const std::string& name) const;
+    size_t elementIndex (const std::string& name) const;
+
+    size_t nodeCount() const;
+    size_t elementCount() const;
+    const std::string& nodeName (const size_t node) const;
+    const NetlistElement& element (const size_t index) const;
+    NetlistElement& element (const size_t index);
+
+private:
+    std::vector<std::string> m_nodeNames;
+    std::vector<NetlistElement> m_elements;
+    std::unordered_map<std::string, size_t> m_nodes;
+    std::unordered_map<std::string, size_t> m_elementNames;
+};
+
+bool parseNetlist (const char* text,
+                   const size_t length,
+                   Netlist* netlist,
+                   std::string* error = NULL);
+
+bool parseSpiceValue (const char* text, const size_t length, double* value);
+bool parseColorBands (const char* text, const size_t length, BandCode* code);
+
+}
+
+#endif
@@ -0,0 +1,427 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "NetworkSolver.h"
+
+#include <math.h>
+#include <algorithm>
+
+using namespace ResistorCore;
+
+namespace
+{
+/**
+ * Disjoint-set forest used to check the topology of the netlist
+ */
+class DisjointSets
+{
+public:
+    explicit DisjointSets (const size_t size) : m_parent (size) {
+        for (size_t i = 0; i < size; ++i)
+            m_parent [i] = i;
+    }
+
+    size_t find (size_t i) {
+        while (m_parent [i] != i) {
+            m_parent [i] = m_parent [m_parent [i]];
+            i = m_parent [i];
+        }
+
+        return i;
+    }
+
+    bool join (const size_t a, const size_t b) {
+        const size_t rootA = find (a);
+        const size_t rootB = find (b);
+        if (rootA == rootB)
+            return false;
+
+        m_parent [rootB] = rootA;
+        return true;
+    }
+
+private:
+    std::vector<size_t> m_parent;
+};
+}
+
+/**
+ * Writes the given error @a message (if requested) and returns @c false
+ */
+static bool fail (std::string* error, const std::string& message) {
+    if (error)
+        *error = message;
+
+    return false;
+}
+
+/**
+ * Creates a solver without a circuit, call @c load() before using it
+ */
+NetworkSolver::NetworkSolver() :
+    m_loaded (false),
+    m_dirty (true) {}
+
+/**
+ * Loads the given @a netlist and performs the symbolic analysis of its
+ * conductance matrix. Fails (writing the reason to @a error) if a node has
+ * no DC path to ground or if voltage sources form a loop.
+ */
+bool NetworkSolver::load (const Netlist& netlist, std::string* error) {
+    m_loaded = false;
+    m_dirty = true;
+    m_netlist = netlist;
+
+    const size_t nodes = netlist.nodeCount();
+    const size_t elements = netlist.elementCount();
+
+    /* Check voltage source loops and build the adjacency of the forest */
+    DisjointSets sources (nodes);
+    DisjointSets connected (nodes);
+    std::vector<size_t> pointers (nodes + 1, 0);
+    for (size_t e = 0; e < elements; ++e) {
+        const NetlistElement& element = netlist.element (e);
+        if (element.type == ElementCurrentSource)
+            continue;
+
+        connected.join (element.nodes [0], element.nodes [1]);
+        if (element.type != ElementVoltageSource)
+            continue;
+
+        if (!sources.join (element.nodes [0], element.nodes [1]))
+            return fail (error, "voltage sources form a loop at '" + element.name + "'");
+
+        ++pointers [element.nodes [0] + 1];
+        ++pointers [element.nodes [1] + 1];
+    }
+
+    for (size_t node = 0; node < nodes; ++node)
+        if (connected.find (node) != connected.find (GROUND_NODE))
+            return fail (error, "node '" + netlist.nodeName (node) + "' has no DC path to ground");
+
+    for (size_t node = 0; node < nodes; ++node)
+        pointers [node + 1] += pointers [node];
+
+    std::vector<size_t> adjacent (pointers [nodes]);
+    std::vector<size_t> next (pointers.begin(), pointers.end() - 1);
+    for (size_t e = 0; e < elements; ++e) {
+        const NetlistElement& element = netlist.element (e);
+        if (element.type == ElementVoltageSource) {
+            adjacent [next [element.nodes [0]]++] = e;
+            adjacent [next [element.nodes [1]]++] = e;
+        }
+    }
+
+    /* Each tree of voltage sources becomes a single unknown, the tree that
+     * contains the ground node has a known voltage */
+    size_t unknowns = 0;
+    m_treeOrder.clear();
+    m_treeOrder.reserve (nodes);
+    m_unknowns.assign (nodes, INVALID_INDEX);
+    m_treeParent.assign (nodes, INVALID_INDEX);
+    m_treeSource.assign (nodes, INVALID_INDEX);
+
+    std::vector<bool> visited (nodes, false);
+    for (size_t root = 0; root < nodes; ++root) {
+        if (visited [root])
+            continue;
+
+        const size_t unknown = root == GROUND_NODE ? INVALID_INDEX : unknowns++;
+        size_t head = m_treeOrder.size();
+        m_treeOrder.push_back (root);
+        visited [root] = true;
+
+        for (; head < m_treeOrder.size(); ++head) {
+            const size_t node = m_treeOrder [head];
+            m_unknowns [node] = unknown;
+
+            for (size_t p = pointers [node]; p < pointers [node + 1]; ++p) {
+                const NetlistElement& source = netlist.element (adjacent [p]);
+                const size_t other = source.nodes [0] == node ? source.nodes [1] :
+                                                                source.nodes [0];
+                if (!visited [other]) {
+                    visited [other] = true;
+                    m_treeParent [other] = node;
+                    m_treeSource [other] = adjacent [p];
+                    m_treeOrder.push_back (other);
+                }
+            }
+        }
+    }
+
+    /* Nonzero pattern of the conductance matrix (upper triangle) */
+    std::vector<std::pair<size_t, size_t> > entries;
+    for (size_t e = 0; e < elements; ++e) {
+        const NetlistElement& element = netlist.element (e);
+        if (element.type != ElementResistor)
+            continue;
+
+        const size_t a = m_unknowns [element.nodes [0]];
+        const size_t b = m_unknowns [element.nodes [1]];
+        if (a != INVALID_INDEX && b != INVALID_INDEX && a != b)
+            entries.push_back (std::make_pair (std::max (a, b), std::min (a, b)));
+    }
+
+    std::sort (entries.begin(), entries.end());
+    entries.erase (std::unique (entries.begin(), entries.end()), entries.end());
+
+    std::vector<size_t> columns (unknowns + 1, 0);
+    std::vector<size_t> rows (entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        ++columns [entries [i].first + 1];
+        rows [i] = entries [i].second;
+    }
+
+    for (size_t j = 0; j < unknowns; ++j)
+        columns [j + 1] += columns [j];
+
+    if (!m_cholesky.analyze (unknowns, columns, rows))
+        return fail (error, "invalid conductance matrix");
+
+    /* Positions of the conductance of each resistor in the matrix */
+    m_slots.assign (3 * elements, SparseCholesky::INVALID_SLOT);
+    for (size_t e = 0; e < elements; ++e) {
+        const NetlistElement& element = netlist.element (e);
+        const size_t a = m_unknowns [element.nodes [0]];
+        const size_t b = m_unknowns [element.nodes [1]];
+        if (element.type != ElementResistor || a == b)
+            continue;
+
+        m_slots [3 * e + 0] = m_cholesky.slot (a, a);
+        m_slots [3 * e + 1] = m_cholesky.slot (b, b);
+        m_slots [3 * e + 2] = m_cholesky.slot (a, b);
+    }
+
+    m_rhs.assign (unknowns, 0);
+    m_offsets.assign (nodes, 0);
+    m_values.assign (m_cholesky.valueCount(), 0);
+    m_loaded = true;
+    return true;
+}
+
+/**
+ * Changes the value of the given @a element. Changing a resistance only
+ * invalidates the numeric factorization, changing a source does not
+ * invalidate anything. Returns @c false for invalid elements or
+ * non-positive resistances
+ */
+bool NetworkSolver::setValue (const size_t element, const double value) {
+    if (!m_loaded || element >= m_netlist.elementCount() || !isfinite (value))
+        return false;
+
+    NetlistElement& target = m_netlist.element (element);
+    if (target.type == ElementResistor) {
+        if (!(value > 0))
+            return false;
+
+        m_dirty = true;
+    }
+
+    target.value = value;
+    return true;
+}
+
+/**
+ * Computes the node voltages and element currents of the loaded circuit
+ */
+bool NetworkSolver::solve (NetworkSolution* solution) {
+    if (!m_loaded || !solution || !refactorize())
+        return false;
+
+    computeOffsets();
+
+    /* Injected currents: current sources and the currents forced through
+     * resistors by the voltage sources */
+    const size_t elements = m_netlist.elementCount();
+    std::fill (m_rhs.begin(), m_rhs.end(), 0);
+    for (size_t e = 0; e < elements; ++e) {
+        const NetlistElement& element = m_netlist.element (e);
+        const size_t a = m_unknowns [element.nodes [0]];
+        const size_t b = m_unknowns [element.nodes [1]];
+        if (a == b)
+            continue;
+
+        double current;
+        if (element.type == ElementResistor)
+            current = (m_offsets [element.nodes [0]] - m_offsets [element.nodes [1]]) / element.value;
+        else if (element.type == ElementCurrentSource)
+            current = element.value;
+        else
+            continue;
+
+        if (a != INVALID_INDEX)
+            m_rhs [a] -= current;
+        if (b != INVALID_INDEX)
+            m_rhs [b] += current;
+    }
+
+    m_cholesky.solve (m_rhs.data());
+
+    /* Node voltages */
+    const size_t nodes = m_netlist.nodeCount();
+    solution->voltages.resize (nodes);
+    for (size_t node = 0; node < nodes; ++node) {
+        const size_t unknown = m_unknowns [node];
+        solution->voltages [node] = m_offsets [node];
+        if (unknown != INVALID_INDEX)
+            solution->voltages [node] += m_rhs [unknown];
+    }
+
+    /* Resistor and current source currents, and the net current that
+     * leaves each node through them */
+    std::vector<double> leaving (nodes, 0);
+    solution->power.assign (elements, 0);
+    solution->currents.assign (elements, 0);
+    for (size_t e = 0; e < elements; ++e) {
+        const NetlistElement& element = m_netlist.element (e);
+        if (element.type == ElementVoltageSource)
+            continue;
+
+        const double voltage = solution->voltages [element.nodes [0]] -
+                               solution->voltages [element.nodes [1]];
+        const double current = element.type == ElementResistor ?
+                               voltage / element.value : element.value;
+
+        solution->currents [e] = current;
+        solution->power [e] = voltage * current;
+        leaving [element.nodes [0]] += current;
+        leaving [element.nodes [1]] -= current;
+    }
+
+    /* Voltage source currents from KCL, walking each tree from its leaves */
+    for (size_t i = m_treeOrder.size(); i-- > 0;) {
+        const size_t node = m_treeOrder [i];
+        const size_t source = m_treeSource [node];
+        if (source == INVALID_INDEX)
+            continue;
+
+        const NetlistElement& element = m_netlist.element (source);
+        const double current = element.nodes [0] == node ? -leaving [node] :
+                                                           leaving [node];
+
+        solution->currents [source] = current;
+        solution->power [source] = element.value * current;
+        leaving [m_treeParent [node]] += leaving [node];
+    }
+
+    return true;
+}
+
+/**
+ * Returns the resistance seen between @a nodeA and @a nodeB with every
+ * source turned off (voltage sources shorted, current sources open), or
+ * @c UNKNOWN_RESISTANCE if the nodes are invalid
+ */
+double NetworkSolver::equivalentResistance (const size_t nodeA,
+                                            const size_t nodeB) {
+    if (!m_loaded || nodeA >= m_netlist.nodeCount() ||
+            nodeB >= m_netlist.nodeCount() || !refactorize())
+        return UNKNOWN_RESISTANCE;
+
+    const size_t a = m_unknowns [nodeA];
+    const size_t b = m_unknowns [nodeB];
+    if (a == b)
+        return 0;
+
+    /* Inject 1 A at node A and extract it at node B */
+    std::fill (m_rhs.begin(), m_rhs.end(), 0);
+    if (a != INVALID_INDEX)
+        m_rhs [a] = 1;
+    if (b != INVALID_INDEX)
+        m_rhs [b] = -1;
+
+    m_cholesky.solve (m_rhs.data());
+
+    const double voltageA = a == INVALID_INDEX ? 0 : m_rhs [a];
+    const double voltageB = b == INVALID_INDEX ? 0 : m_rhs [b];
+    return voltageA - voltageB;
+}
+
+/**
+ * Returns the loaded netlist, with the values given by @c setValue()
+ */
+const Netlist& NetworkSolver::netlist() const {
+    return m_netlist;
+}
+
+/**
+ * Returns the number of unknowns of the nodal system, which is the number
+ * of nodes that are not joined to another node by a voltage source
+ */
+size_t NetworkSolver::unknownCount() const {
+    return m_rhs.size();
+}
+
+/**
+ * Returns the number of nonzeros of the Cholesky factor
+ */
+size_t NetworkSolver::factorNonZeros() const {
+    return m_cholesky.factorNonZeros();
+}
+
+/**
+ * Assembles the conductance matrix and factorizes it if a resistance
+ * changed since the last factorization
+ */
+bool NetworkSolver::refactorize() {
+    if (!m_dirty)
+        return m_cholesky.factorized();
+
+    std::fill (m_values.begin(), m_values.end(), 0);
+    for (size_t e = 0; e < m_netlist.elementCount(); ++e) {
+        const NetlistElement& element = m_netlist.element (e);
+        if (element.type != ElementResistor)
+            continue;
+
+        const double conductance = 1 / element.value;
+        const size_t* slots = &m_slots [3 * e];
+        if (slots [0] != SparseCholesky::INVALID_SLOT)
+            m_values [slots [0]] += conductance;
+        if (slots [1] != SparseCholesky::INVALID_SLOT)
+            m_values [slots [1]] += conductance;
+        if (slots [2] != SparseCholesky::INVALID_SLOT)
+            m_values [slots [2]] -= conductance;
+    }
+
+    m_dirty = false;
+    return m_cholesky.factorize (m_values.data());
+}
+
+/**
+ * Computes the voltage of each node relative to the root of its voltage
+ * source tree
+ */
+void NetworkSolver::computeOffsets() {
+    for (size_t i = 0; i < m_treeOrder.size(); ++i) {
+        const size_t node = m_treeOrder [i];
+        const size_t source = m_treeSource [node];
+        if (source == INVALID_INDEX) {
+            m_offsets [node] = 0;
+            continue;
+        }
+
+        const NetlistElement& element = m_netlist.element (source);
+        const double voltage = element.nodes [0] == node ? element.value :
+                                                           -element.value;
+        m_offsets [node] = m_offsets [m_treeParent [node]] + voltage;
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_NETWORK_SOLVER_H
+#define RESISTOR_NETWORK_SOLVER_H
+
+#include <string>
+#include <vector>
+#include <stddef.h>
+
+#include "Netlist.h"
+#include "SparseCholesky.h"
+
+namespace ResistorCore
+{
+
+/**
+ * DC operating point of a netlist. Voltages are given per node (relative
+ * to ground), currents and absorbed power per element, using the
+ * current direction of @c NetlistElement
+ */
+struct NetworkSolution {
+    std::vector<double> voltages;
+    std::vector<double> currents;
+    std::vector<double> power;
+};
+
+/**
+ * DC solver for resistor networks based on nodal analysis.
+ *
+ * Voltage sources are not added as extra unknowns (which would make the
+ * system indefinite). Instead, the nodes joined by voltage sources are
+ * merged in a single unknown and their voltages are kept as fixed offsets
+ * from the first node of the group, so the conductance matrix stays
+ * symmetric positive definite and is factorized with a sparse Cholesky
+ * decomposition. The currents of the voltage sources are recovered from
+ * Kirchhoff's current law afterwards.
+ *
+ * The symbolic analysis is done once in @c load(). Changing the value of
+ * a resistor only repeats the numeric factorization, and changing the
+ * value of a source does not refactorize at all, so sweeps over element
+ * values are cheap.
+ */
+class NetworkSolver
+{
+public:
+    NetworkSolver();
+
+    bool load (const Netlist& netlist, std::string* error = NULL);
+    bool setValue (const size_t element, const double value);
+    bool solve (NetworkSolution* solution);
+    double equivalentResistance (const size_t nodeA, const size_t nodeB);
+
+    const Netlist& netlist() const;
+    size_t unknownCount() const;
+    size_t factorNonZeros() const;
+
+private:
+    bool refactorize();
+    void computeOffsets();
+
+private:
+    bool m_loaded;
+    bool m_dirty;
+    Netlist m_netlist;
+
+    std::vector<size_t> m_unknowns;
+    std::vector<size_t> m_treeOrder;
+    std::vector<size_t> m_treeParent;
+    std::vector<size_t> m_treeSource;
+    std::vector<double> m_offsets;
+
+    std::vector<size_t> m_slots;
+    std::vector<double> m_values;
+    std::vector<double> m_rhs;
+    SparseCholesky m_cholesky;
+};
+
+}
+
+#endif
@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ResistanceFormatter.h"
+#include "ResistorCore.h"
+
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+
+using namespace ResistorCore;
+
+/**
+ * Engineering powers of ten, from 10^9 down to 10^-24
+ */
+static const int POWER_COUNT = 12;
+static const double POWERS [POWER_COUNT] = {
+    1e9, 1e6, 1e3, 1e0, 1e-3, 1e-6, 1e-9, 1e-12, 1e-15, 1e-18, 1e-21, 1e-24
+};
+
+/**
+ * Appends the ASCII @a text to @a out, returns the number of code units
+ */
+template <typename Char>
+static inline size_t writeAscii (Char* out, const char* text) {
+    size_t i = 0;
+    for (; text [i] != '\0'; ++i)
+        out [i] = static_cast<Char> (text [i]);
+
+    return i;
+}
+
+/**
+ * Appends the decimal representation of @a value to @a out
+ */
+template <typename Char>
+static inline size_t writeInteger (Char* out, uint64_t value) {
+    char digits [20];
+    size_t count = 0;
+    do {
+        digits [count++] = static_cast<char> ('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    for (size_t i = 0; i < count; ++i)
+        out [i] = static_cast<Char> (digits [count - 1 - i]);
+
+    return count;
+}
+
+/**
+ * Appends the ohm sign (U+03A9) to @a out
+ */
+static inline size_t writeOhm (char* out) {
+    out [0] = static_cast<char> (0xCE);
+    out [1] = static_cast<char> (0xA9);
+    return 2;
+}
+
+static inline size_t writeOhm (char16_t* out) {
+    out [0] = u'\u03A9';
+    return 1;
+}
+
+/**
+ * Appends the micro sign (U+00B5) to @a out
+ */
+static inline size_t writeMicro (char* out) {
+    out [0] = static_cast<char> (0xC2);
+    out [1] = static_cast<char> (0xB5);
+    return 2;
+}
+
+static inline size_t writeMicro (char16_t* out) {
+    out [0] = u'\u00B5';
+    return 1;
+}
+
+/**
+ * Appends a space, the SI prefix of the given engineering @a power and
+ * the ohm sign to @a out
+ */
+template <typename Char>
+static inline size_t writeUnit (Char* out, const int power) {
+    size_t length = 0;
+    out [length++] = static_cast<Char> (' ');
+    switch (power) {
+    case 9:
+        out [length++] = static_cast<Char> ('G');
+        break;
+    case 6:
+        out [length++] = static_cast<Char> ('M');
+        break;
+    case 3:
+        out [length++] = static_cast<Char> ('k');
+        break;
+    case 0:
+        break;
+    case -3:
+        out [length++] = static_cast<Char> ('m');
+        break;
+    case -6:
+        length += writeMicro (out + length);
+        break;
+    case -9:
+        out [length++] = static_cast<Char> ('n');
+        break;
+    default:
+        out [length++] = static_cast<Char> ('E');
+        out [length++] = static_cast<Char> ('-');
+        length += writeInteger (out + length, static_cast<uint64_t> (-power));
+        break;
+    }
+
+    length += writeOhm (out + length);
+    return length;
+}
+
+/**
+ * Writes the text of the given @a resistance to @a out and returns the
+ * number of code units that were written. The @a out buffer must have room
+ * for at least @c RESISTANCE_STR_CAPACITY code units.
+ */
+template <typename Char>
+static size_t writeResistance (const double resistance, Char* out) {
+    assert (resistance >= UNKNOWN_RESISTANCE);
+
+    // Resistance is unknown
+    if (resistance < 0)
+        return writeAscii (out, "Unknown");
+
+    // Resistance is 0 ohms
+    if (resistance == 0.0) {
+        size_t length = writeAscii (out, "0 ");
+        length += writeOhm (out + length);
+        length += writeAscii (out + length, " (jumper)");
+        return length;
+    }
+
+    // Get engineering exponent without calling pow()
+    int index = 0;
+    while (index < POWER_COUNT - 1 && resistance < POWERS [index])
+        ++index;
+
+    const int power = 9 - 3 * index;
+
+    // Get base number in hundredths (e.g. 470 for 4.70 kOhm)
+    const double scaled = resistance / POWERS [index] * 100;
+    const uint64_t cents = scaled < 1.8e19 ? static_cast<uint64_t> (llround (scaled))
+                                           : UINT64_MAX;
+
+    // Write integer part and decimals
+    size_t length = writeInteger (out, cents / 100);
+    if (cents % 100 != 0) {
+        out [length++] = static_cast<Char> ('.');
+        out [length++] = static_cast<Char> ('0' + (cents / 10) % 10);
+        out [length++] = static_cast<Char> ('0' + cents % 10);
+    }
+
+    // Write prefix and unit
+    length += writeUnit (out + length, power);
+    return length;
+}
+
+/**
+ * Engineering units in micro-ohms, from 1 Gohm down to 1 micro-ohm
+ */
+static const int UNIT_COUNT = 6;
+static const uint64_t MICROOHM_UNITS [UNIT_COUNT] = {
+    1000000000000000ull, 1000000000000ull, 1000000000ull, 1000000ull, 1000ull, 1ull
+};
+
+/**
+ * Writes the text of the given exact @a resistance to @a out without
+ * rounding it, every significant digit is written (e.g. "4.753 kOhm").
+ * Values with one or two decimals are written with two decimals, like
+ * the floating-point version does (e.g. "4.70 kOhm").
+ */
+template <typename Char>
+static size_t writeResistance (const ExactResistance resistance, Char* out) {
+    // Resistance is unknown
+    if (!resistance.isValid())
+        return writeAscii (out, "Unknown");
+
+    // Resistance is 0 ohms
+    const uint64_t microohms = resistance.microohms();
+    if (microohms == 0) {
+        size_t length = writeAscii (out, "0 ");
+        length += writeOhm (out + length);
+        length += writeAscii (out + length, " (jumper)");
+        return length;
+    }
+
+    // Get engineering unit
+    int index = 0;
+    while (index < UNIT_COUNT - 1 && microohms < MICROOHM_UNITS [index])
+        ++index;
+
+    // Write integer part
+    const uint64_t unit = MICROOHM_UNITS [index];
+    size_t length = writeInteger (out, microohms / unit);
+
+    // Write fractional digits without trailing zeros (keep at least two)
+    uint64_t fraction = microohms % unit;
+    if (fraction != 0) {
+        int digits = 3 * (UNIT_COUNT - 1 - index);
+        while (digits > 2 && fraction % 10 == 0) {
+            fraction /= 10;
+            --digits;
+        }
+
+        out [length++] = static_cast<Char> ('.');
+        for (int i = digits - 1; i >= 0; --i) {
+            out [length + i] = static_cast<Char> ('0' + fraction % 10);
+            fraction /= 10;
+        }
+
+        length += digits;
+    }
+
+    // Write prefix and unit
+    length += writeUnit (out + length, 9 - 3 * index);
+    return length;
+}
+
+/**
+ * Writes the text of @a value to @a buffer followed by a NUL terminator.
+ * Returns the number of code units written (without the terminator), or
+ * 0 if the text and its terminator do not fit in @a capacity units.
+ */
+template <typename Value, typename Char>
+static inline size_t writeTerminated (const Value& value, Char* buffer, const size_t capacity) {
+    // Write directly to the output buffer if it is large enough
+    if (capacity >= RESISTANCE_STR_CAPACITY) {
+        const size_t length = writeResistance (value, buffer);
+        buffer [length] = static_cast<Char> ('\0');
+        return length;
+    }
+
+    // Use a temporary buffer and check if the text fits
+    Char text [RESISTANCE_STR_CAPACITY];
+    const size_t length = writeResistance (value, text);
+    if (length + 1 > capacity)
+        return 0;
+
+    memcpy (buffer, text, length * sizeof (Char));
+    buffer [length] = static_cast<Char> ('\0');
+    return length;
+}
+
+/**
+ * Formats the given @a resistance like @c formatResistance() does, but
+ * writes the UTF-8 text to the given @a buffer instead of allocating a
+ * string. Powers of ten are obtained from a table and the digits are
+ * generated with integer math.
+ *
+ * Returns the number of bytes written (without the NUL terminator), or
+ * 0 if the text and its terminator do not fit in @a capacity bytes.
+ */
+size_t ResistorCore::formatResistanceUtf8 (const double resistance,
+                                           char* buffer,
+                                           const size_t capacity) {
+    return writeTerminated (resistance, buffer, capacity);
+}
+
+/**
+ * UTF-16 version of @c formatResistanceUtf8(), the returned value is the
+ * number of UTF-16 code units that were written to @a buffer.
+ */
+size_t ResistorCore::formatResistanceUtf16 (const double resistance,
+                                            char16_t* buffer,
+                                            const size_t capacity) {
+    return writeTerminated (resistance, buffer, capacity);
+}
+
+/**
+ * Formats the given exact @a resistance without rounding it, the UTF-8
+ * text is written to @a buffer. Every value has at most six decimals, so
+ * @c RESISTANCE_STR_CAPACITY bytes are always enough.
+ *
+ * Returns the number of bytes written (without the NUL terminator), or
+ * 0 if the text and its terminator do not fit in @a capacity bytes.
+ */
+size_t ResistorCore::formatResistanceUtf8 (const ExactResistance resistance,
+                                           char* buffer,
+                                           const size_t capacity) {
+    return writeTerminated (resistance, buffer, capacity);
+}
+
+/**
+ * UTF-16 version of the exact @c formatResistanceUtf8(), the returned
+ * value is the number of UTF-16 code units that were written to @a buffer.
+ */
+size_t ResistorCore::formatResistanceUtf16 (const ExactResistance resistance,
+                                            char16_t* buffer,
+                                            const size_t capacity) {
+    return writeTerminated (resistance, buffer, capacity);
+}
+
+/**
+ * Formats @a count values from the @a resistances array into a single
+ * UTF-8 @a buffer, each value is followed by the given @a separator
+ * (e.g. a newline for exporting one value per row).
+ *
+ * Returns the number of values that fit in the buffer, the number of
+ * bytes that were used is written to @a bytesWritten (if not NULL). The
+ * output is not NUL-terminated.
+ */
+size_t ResistorCore::formatResistances (const double* resistances,
+                                        const size_t count,
+                                        char* buffer,
+                                        const size_t capacity,
+                                        const char separator,
+                                        size_t* bytesWritten) {
+    size_t used = 0;
+    size_t formatted = 0;
+    for (; formatted < count; ++formatted) {
+        // Write directly to the output buffer while it has enough room
+        if (capacity - used >= RESISTANCE_STR_CAPACITY) {
+            used += writeResistance (resistances [formatted], buffer + used);
+            buffer [used++] = separator;
+            continue;
+        }
+
+        // Use a temporary buffer near the end of the output buffer
+        char text [RESISTANCE_STR_CAPACITY];
+        const size_t length = writeResistance (resistances [formatted], text);
+        if (used + length + 1 > capacity)
+            break;
+
+        memcpy (buffer + used, text, length);
+        used += length;
+        buffer [used++] = separator;
+    }
+
+    if (bytesWritten)
+        *bytesWritten = used;
+
+    return formatted;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTANCE_FORMATTER_H
+#define RESISTANCE_FORMATTER_H
+
+#include <stddef.h>
+
+#include "ExactResistance.h"
+
+namespace ResistorCore
+{
+
+/**
+ * Number of code units (including the NUL terminator) that are always
+ * enough to hold a formatted resistance value.
+ */
+static const size_t RESISTANCE_STR_CAPACITY = 40;
+
+size_t formatResistanceUtf8 (const double resistance,
+                             char* buffer,
+                             const size_t capacity);
+
+size_t formatResistanceUtf16 (const double resistance,
+                              char16_t* buffer,
+                              const size_t capacity);
+
+size_t formatResistanceUtf8 (const ExactResistance resistance,
+                             char* buffer,
+                             const size_t capacity);
+
+size_t formatResistanceUtf16 (const ExactResistance resistance,
+                              char16_t* buffer,
+                              const size_t capacity);
+
+size_t formatResistances (const double* resistances,
+                          const size_t count,
+                          char* buffer,
+                          const size_t capacity,
+                          const char separator,
+                          size_t* bytesWritten);
+
+}
+
+#endif
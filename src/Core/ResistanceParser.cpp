@@ -0,0 +1,504 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ResistanceParser.h"
+
+#include <math.h>
+#include <string.h>
+#include <assert.h>
+
+using namespace ResistorCore;
+
+/**
+ * Powers of ten used to rescale annotation values
+ */
+static const uint64_t PARSER_POWERS [10] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull,
+    10000000ull, 100000000ull, 1000000000ull
+};
+
+/**
+ * Returns @c true if @a c is an ASCII digit
+ */
+static inline bool isDigit (const char c) {
+    return static_cast<unsigned char> (c - '0') < 10;
+}
+
+/**
+ * Returns @c true if @a c is a space or tab
+ */
+static inline bool isSpace (const char c) {
+    return c == ' ' || c == '\t';
+}
+
+/**
+ * Returns @c true if @a c separates annotations ("10k, 1%; 100ppm")
+ */
+static inline bool isSeparator (const char c) {
+    return isSpace (c) || c == ',' || c == ';';
+}
+
+/**
+ * Moves @a p past spaces and tabs
+ */
+static inline void skipSpaces (const char*& p, const char* end) {
+    while (p < end && isSpace (*p))
+        ++p;
+}
+
+/**
+ * Returns @c true if the bytes at @a p are the given UTF-8 @a sequence
+ * and moves @a p past them
+ */
+static inline bool matchBytes (const char*& p, const char* end, const char* sequence) {
+    const char* q = p;
+    for (; *sequence != '\0'; ++sequence, ++q) {
+        if (q == end || *q != *sequence)
+            return false;
+    }
+
+    p = q;
+    return true;
+}
+
+/**
+ * Returns @c true if the text at @a p is the given lowercase ASCII
+ * @a word (case insensitive) and moves @a p past it
+ */
+static inline bool matchWord (const char*& p, const char* end, const char* word) {
+    const char* q = p;
+    for (; *word != '\0'; ++word, ++q) {
+        if (q == end || (*q | 0x20) != *word)
+            return false;
+    }
+
+    p = q;
+    return true;
+}
+
+/**
+ * Appends the digits at @a p to @a value and adds their number to
+ * @a count. Returns @c false if the value does not fit in 64 bits.
+ */
+static inline bool parseDigits (const char*& p, const char* end, uint64_t* value, int* count) {
+    uint64_t result = *value;
+    int digits = 0;
+    for (; p < end && isDigit (*p); ++p, ++digits) {
+        if (result > (UINT64_MAX - 9) / 10)
+            return false;
+
+        result = result * 10 + static_cast<uint64_t> (*p - '0');
+    }
+
+    *value = result;
+    *count += digits;
+    return true;
+}
+
+/**
+ * Reads a multiplier letter (RKM notation or SI prefix) at @a p and
+ * writes its decimal exponent. Unlike SPICE, "M" is mega and "m" is
+ * milli, "meg" (any case) is also accepted as mega.
+ */
+static inline bool parsePrefix (const char*& p, const char* end, int* exponent) {
+    if (p == end)
+        return false;
+
+    switch (*p) {
+    case 'R':
+    case 'r':
+        *exponent = 0;
+        break;
+    case 'k':
+    case 'K':
+        *exponent = 3;
+        break;
+    case 'M':
+    case 'm': {
+        const char* q = p;
+        if (matchWord (q, end, "meg")) {
+            *exponent = 6;
+            p = q;
+            return true;
+        }
+
+        *exponent = *p == 'M' ? 6 : -3;
+        break;
+    }
+    case 'G':
+    case 'g':
+        *exponent = 9;
+        break;
+    case 'T':
+        *exponent = 12;
+        break;
+    case 'u':
+        *exponent = -6;
+        break;
+    default:
+        // Micro sign (U+00B5) or Greek small letter mu (U+03BC)
+        if (matchBytes (p, end, "\xC2\xB5") || matchBytes (p, end, "\xCE\xBC")) {
+            *exponent = -6;
+            return true;
+        }
+
+        return false;
+    }
+
+    ++p;
+    return true;
+}
+
+/**
+ * Reads an ohm unit at @a p: the ohm sign (U+2126), the Greek capital
+ * omega (U+03A9), "ohm" or "ohms" (any case)
+ */
+static inline bool parseUnit (const char*& p, const char* end) {
+    if (matchBytes (p, end, "\xCE\xA9") || matchBytes (p, end, "\xE2\x84\xA6"))
+        return true;
+
+    if (matchWord (p, end, "ohm")) {
+        if (p < end && (*p | 0x20) == 's')
+            ++p;
+
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * Returns @c true if the text at @a p starts with a plus-minus sign
+ * ("±", "+/-" or "+-"), which marks an annotation that does not need a
+ * separator ("10k±5%")
+ */
+static inline bool isPlusMinus (const char* p, const char* end) {
+    const char* q = p;
+    return matchBytes (q, end, "\xC2\xB1") || matchBytes (q, end, "+/-") || matchBytes (q, end, "+-");
+}
+
+/**
+ * Writes @a value x 10^(@a digits - @a fraction) to @a result, which must
+ * be an integer that fits in 16 bits
+ */
+static inline bool rescale (const uint64_t value,
+                            const int fraction,
+                            const int digits,
+                            uint16_t* result) {
+    uint64_t scaled;
+    if (fraction > digits) {
+        const int shift = fraction - digits;
+        if (shift > 9 || value % PARSER_POWERS [shift] != 0)
+            return false;
+
+        scaled = value / PARSER_POWERS [shift];
+    }
+
+    else {
+        if (value > UINT16_MAX)
+            return false;
+
+        scaled = value * PARSER_POWERS [digits - fraction];
+    }
+
+    if (scaled > UINT16_MAX)
+        return false;
+
+    *result = static_cast<uint16_t> (scaled);
+    return true;
+}
+
+/**
+ * Reads a tolerance ("±1%", "+/-0.5 %", "5%") or tempco ("100ppm",
+ * "±50 ppm/K", "25ppm/°C") annotation at @a p
+ */
+static inline bool parseAnnotation (const char*& p, const char* end, ParsedResistance* result) {
+    // Optional plus-minus sign
+    if (!matchBytes (p, end, "\xC2\xB1") && !matchBytes (p, end, "+/-"))
+        matchBytes (p, end, "+-");
+
+    skipSpaces (p, end);
+
+    // Read the number
+    uint64_t value = 0;
+    int digits = 0;
+    int fraction = 0;
+    if (!parseDigits (p, end, &value, &digits))
+        return false;
+
+    if (p < end && *p == '.') {
+        ++p;
+        if (!parseDigits (p, end, &value, &fraction))
+            return false;
+    }
+
+    if (digits + fraction == 0)
+        return false;
+
+    skipSpaces (p, end);
+
+    // Tolerance in percent, stored in basis points
+    if (p < end && *p == '%') {
+        ++p;
+        if ((result->flags & ParsedTolerance) || !rescale (value, fraction, 2, &result->tolerance))
+            return false;
+
+        result->flags |= ParsedTolerance;
+        return true;
+    }
+
+    // Tempco in ppm, with an optional "/K" or "/°C"
+    if (matchWord (p, end, "ppm")) {
+        const char* q = p;
+        if (matchBytes (q, end, "/")) {
+            if (matchBytes (q, end, "\xC2\xB0") || matchBytes (q, end, "\xC2\xBA"))
+                p = q + (q < end && (*q | 0x20) == 'c' ? 1 : 0);
+            else if (q < end && ((*q | 0x20) == 'k' || (*q | 0x20) == 'c'))
+                p = q + 1;
+        }
+
+        if ((result->flags & ParsedTempco) || !rescale (value, fraction, 0, &result->tempco))
+            return false;
+
+        result->flags |= ParsedTempco;
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * Reads the value of a resistance at @a p: the number with its optional
+ * RKM letter or SI prefix, then the optional unit. The resistance is
+ * written to @a result and @a p is moved past the value.
+ */
+static inline bool parseValue (const char*& p, const char* end, ParsedResistance* result) {
+    skipSpaces (p, end);
+
+    // Integer part
+    uint64_t significand = 0;
+    int digits = 0;
+    int fraction = 0;
+    int exponent = 0;
+    if (!parseDigits (p, end, &significand, &digits))
+        return false;
+
+    // Decimal point (or comma) followed by the fractional digits
+    if (p < end && (*p == '.' || (*p == ',' && p + 1 < end && isDigit (p [1])))) {
+        ++p;
+        if (!parseDigits (p, end, &significand, &fraction))
+            return false;
+
+        const char* q = p;
+        skipSpaces (q, end);
+        if (parsePrefix (q, end, &exponent)) {
+            p = q;
+            result->flags |= ParsedPrefix;
+        }
+    }
+
+    // RKM letter in place of the decimal point ("4k7", "R47", "100R")
+    else if (parsePrefix (p, end, &exponent)) {
+        const bool ohms = p [-1] == 'R' || p [-1] == 'r';
+        if (!parseDigits (p, end, &significand, &fraction))
+            return false;
+
+        result->flags |= ParsedPrefix;
+        if (fraction > 0 || ohms)
+            result->flags |= ParsedRkm;
+    }
+
+    // SI prefix after a space ("4 k")
+    else if (digits > 0) {
+        const char* q = p;
+        skipSpaces (q, end);
+        if (parsePrefix (q, end, &exponent)) {
+            p = q;
+            result->flags |= ParsedPrefix;
+        }
+    }
+
+    if (digits + fraction == 0)
+        return false;
+
+    // Unit
+    const char* q = p;
+    skipSpaces (q, end);
+    if (parseUnit (q, end)) {
+        p = q;
+        result->flags |= ParsedUnit;
+    }
+
+    result->resistance = ExactResistance::fromDecimal (significand, exponent - fraction);
+    return result->resistance.isValid();
+}
+
+/**
+ * Clears the given @a result and returns @c false
+ */
+static inline bool reject (ParsedResistance* result) {
+    result->resistance = ExactResistance();
+    result->tolerance = 0;
+    result->tempco = 0;
+    result->flags = 0;
+    return false;
+}
+
+/**
+ * Parses a human-written resistance of @a length bytes (UTF-8, does not
+ * need to be NUL-terminated) without allocating memory:
+ *
+ * - RKM notation: "4k7", "2R2", "0R1", "R47", "100R", "1M5"
+ * - Decimal numbers with an optional SI prefix: "1.5M", "4.7 k", "220"
+ * - An optional unit: "Ω", "ohm" or "ohms"
+ * - Optional tolerance and tempco annotations, separated by spaces,
+ *   commas or semicolons: "10kΩ ±1%", "4k7 5% 100ppm/K". Annotations
+ *   that start with a plus-minus sign can follow the value or unit
+ *   directly: "10k±5%", "10kΩ±5%"
+ *
+ * The value is parsed as a decimal, so the resistance is exact. Returns
+ * @c false (and an invalid resistance) if the text is not valid.
+ */
+bool ResistorCore::parseResistance (const char* text,
+                                    const size_t length,
+                                    ParsedResistance* result) {
+    assert (text != NULL || length == 0);
+    assert (result != NULL);
+
+    reject (result);
+
+    const char* p = text;
+    const char* end = text + length;
+    if (!parseValue (p, end, result))
+        return reject (result);
+
+    // Annotations
+    while (true) {
+        const char* start = p;
+        while (p < end && (isSeparator (*p) || *p == '\r' || *p == '\n'))
+            ++p;
+
+        if (p == end)
+            break;
+
+        if ((p == start && !isPlusMinus (p, end)) || !parseAnnotation (p, end, result))
+            return reject (result);
+    }
+
+    return true;
+}
+
+/**
+ * Reads the longest resistance value (number, RKM letter or SI prefix and
+ * unit, with the grammar of @c parseResistance()) at the start of the
+ * @a length bytes at @a text, annotations are not read. Returns the
+ * number of bytes of the value, or 0 if the text does not start with one.
+ */
+size_t ResistorCore::scanResistance (const char* text,
+                                     const size_t length,
+                                     ParsedResistance* result) {
+    assert (text != NULL || length == 0);
+    assert (result != NULL);
+
+    reject (result);
+
+    const char* p = text;
+    if (!parseValue (p, text + length, result)) {
+        reject (result);
+        return 0;
+    }
+
+    return static_cast<size_t> (p - text);
+}
+
+/**
+ * Parses a buffer of newline-separated resistance strings, which must
+ * have @a length bytes, and writes up to @a capacity results. Invalid
+ * lines give an invalid resistance.
+ *
+ * Returns the number of parsed lines, the number of bytes that were
+ * consumed is written to @a bytesRead (if not NULL), so that large
+ * buffers can be parsed in chunks.
+ */
+size_t ResistorCore::parseResistanceLines (const char* buffer,
+                                           const size_t length,
+                                           ParsedResistance* results,
+                                           const size_t capacity,
+                                           size_t* bytesRead) {
+    assert (buffer != NULL || length == 0);
+    assert (results != NULL || capacity == 0);
+
+    size_t count = 0;
+    size_t start = 0;
+    while (start < length && count < capacity) {
+        // Find end of the line
+        const void* newline = memchr (buffer + start, '\n', length - start);
+        const size_t end = newline ? static_cast<size_t> (static_cast<const char*> (newline) - buffer)
+                                   : length;
+
+        // Carriage returns are skipped by the parser
+        parseResistance (buffer + start, end - start, &results [count++]);
+        start = end + 1;
+    }
+
+    if (bytesRead)
+        *bytesRead = start < length ? start : length;
+
+    return count;
+}
+
+/**
+ * Finds the tolerance strip color for the given tolerance in
+ * @a basisPoints (e.g. 100 for brown). Returns @c false if no strip color
+ * has this tolerance.
+ */
+bool ResistorCore::toleranceBand (const uint16_t basisPoints, Tolerance* tolerance) {
+    assert (tolerance != NULL);
+
+    for (int i = ToleranceBrown; i <= ToleranceSilver; ++i) {
+        const Tolerance band = static_cast<Tolerance> (i);
+        if (llround (toleranceValue (band) * 10000) == basisPoints) {
+            *tolerance = band;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Finds the tempco strip color for the given temperature coefficient in
+ * @a ppm per kelvin. Returns @c false if no strip color has this tempco.
+ */
+bool ResistorCore::tempcoBand (const uint16_t ppm, Tempco* tempco) {
+    assert (tempco != NULL);
+
+    for (int i = TempcoBrown; i <= TempcoViolet; ++i) {
+        const Tempco band = static_cast<Tempco> (i);
+        if (tempcoValue (band) == ppm) {
+            *tempco = band;
+            return true;
+        }
+    }
+
+    return false;
+}
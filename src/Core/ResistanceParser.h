@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_RESISTANCE_PARSER_H
+#define RESISTOR_RESISTANCE_PARSER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ResistorCore.h"
+#include "ExactResistance.h"
+
+namespace ResistorCore
+{
+
+/**
+ * Parts of the text that were present in a parsed resistance string
+ */
+enum ParsedFlags {
+    ParsedRkm       = 1,
+    ParsedUnit      = 2,
+    ParsedTolerance = 4,
+    ParsedTempco    = 8,
+    ParsedPrefix    = 16
+};
+
+/**
+ * Result of parsing a human-written resistance string. The tolerance is
+ * given in basis points (1/100 %, so 1% is 100 and 0.05% is 5) and the
+ * tempco in ppm/K, both are zero if the text does not specify them.
+ */
+struct ParsedResistance {
+    ExactResistance resistance;
+    uint16_t tolerance;
+    uint16_t tempco;
+    uint32_t flags;
+};
+
+bool parseResistance (const char* text,
+                      const size_t length,
+                      ParsedResistance* result);
+size_t scanResistance (const char* text,
+                       const size_t length,
+                       ParsedResistance* result);
+
+size_t parseResistanceLines (const char* buffer,
+                             const size_t length,
+                             ParsedResistance* results,
+                             const size_t capacity,
+                             size_t* bytesRead = NULL);
+
+bool toleranceBand (const uint16_t basisPoints, Tolerance* tolerance);
+bool tempcoBand (const uint16_t ppm, Tempco* tempco);
+
+}
+
+#endif
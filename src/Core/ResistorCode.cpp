@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ResistorCode.h"
+
+#include <assert.h>
+
+using namespace ResistorCore;
+
+/**
+ * Returns the code with the given @a ordinal, which must be lower than
+ * @c ORDINAL_COUNT.
+ */
+ResistorCode ResistorCode::fromOrdinal (uint32_t ordinal) {
+    assert (ordinal < ORDINAL_COUNT);
+
+    const Tempco tempco = static_cast<Tempco> (ordinal % 6);
+    ordinal /= 6;
+    const Tolerance tolerance = static_cast<Tolerance> (ordinal % 8);
+    ordinal /= 8;
+    const Multiplier multiplier = static_cast<Multiplier> (ordinal % 12);
+    ordinal /= 12;
+    const Digit digitC = static_cast<Digit> (ordinal % 10);
+    ordinal /= 10;
+    const Digit digitB = static_cast<Digit> (ordinal % 10);
+    ordinal /= 10;
+    const Digit digitA = static_cast<Digit> (ordinal % 10);
+    ordinal /= 10;
+    const ResistorType type = static_cast<ResistorType> (ordinal);
+
+    return ResistorCode (type, digitA, digitB, digitC,
+                         multiplier, tolerance, tempco);
+}
+
+/**
+ * Returns @c true if every field of the code is within the range of
+ * its corresponding enum
+ */
+bool ResistorCode::isValid() const {
+    return type() <= SixStripResistor &&
+            digitA() <= DigitWhite &&
+            digitB() <= DigitWhite &&
+            digitC() <= DigitWhite &&
+            multiplier() <= MultiplierSilver &&
+            tolerance() <= ToleranceSilver &&
+            tempco() <= TempcoViolet;
+}
+
+/**
+ * Returns a dense number in the [0, @c ORDINAL_COUNT) range that uniquely
+ * identifies this code (minimal perfect hash). The code must be valid.
+ *
+ * Ordinals follow the same order as the comparison operators.
+ */
+uint32_t ResistorCode::ordinal() const {
+    assert (isValid());
+
+    uint32_t ordinal = type();
+    ordinal = ordinal * 10 + digitA();
+    ordinal = ordinal * 10 + digitB();
+    ordinal = ordinal * 10 + digitC();
+    ordinal = ordinal * 12 + multiplier();
+    ordinal = ordinal * 8 + tolerance();
+    ordinal = ordinal * 6 + tempco();
+    return ordinal;
+}
+
+/**
+ * Returns a copy of the code where the strips that are not used by the
+ * resistor type are reset (third digit for 4-strip resistors, tempco for
+ * 4-strip and 5-strip resistors). Two normalized codes are equal if and
+ * only if they describe the same physical resistor.
+ */
+ResistorCode ResistorCode::normalized() const {
+    ResistorCode code = *this;
+
+    if (type() == FourStripResistor)
+        code.setDigit (2, DigitBlack);
+
+    if (type() != SixStripResistor)
+        code.setTempco (TempcoBrown);
+
+    return code;
+}
+
+/**
+ * Converts the code to the unpacked structure used by the decoder
+ */
+BandCode ResistorCode::toBandCode() const {
+    BandCode code;
+    code.type = type();
+    code.digits [0] = digitA();
+    code.digits [1] = digitB();
+    code.digits [2] = digitC();
+    code.multiplier = multiplier();
+    code.tolerance = tolerance();
+    code.tempco = tempco();
+    return code;
+}
+
+/**
+ * Calculates the nominal, minimum and maximum resistance of the code
+ */
+BandResult ResistorCode::decode() const {
+    return decodeBands (toBandCode());
+}
+
+/**
+ * Returns the exact nominal resistance of the code
+ */
+ExactResistance ResistorCode::decodeExact() const {
+    return decodeBandsExact (toBandCode());
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_CODE_H
+#define RESISTOR_CODE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <type_traits>
+
+#include "ResistorCore.h"
+
+namespace ResistorCore
+{
+
+/**
+ * Compact, trivially copyable representation of a color band code.
+ *
+ * All band fields are packed in the low 24 bits of a 32-bit integer, with
+ * the resistor type in the most significant position and the tempco in the
+ * least significant one:
+ *
+ *     | 23-22 | 21-18 | 17-14 | 13-10 |    9-6     |    5-3    |  2-0   |
+ *     | type  | digA  | digB  | digC  | multiplier | tolerance | tempco |
+ *
+ * Comparing the raw bits of two valid codes is equivalent to comparing
+ * their ordinals, so codes can be sorted and hashed with integer
+ * operations.
+ */
+class ResistorCode
+{
+public:
+    /**
+     * Number of distinct ordinals, i.e. size of a perfect hash table
+     * that can hold every valid code.
+     */
+    static const uint32_t ORDINAL_COUNT = 3 * 10 * 10 * 10 * 12 * 8 * 6;
+
+    constexpr ResistorCode() : m_bits (0) {}
+
+    constexpr ResistorCode (const ResistorType type,
+                            const Digit digitA,
+                            const Digit digitB,
+                            const Digit digitC,
+                            const Multiplier multiplier,
+                            const Tolerance tolerance,
+                            const Tempco tempco = TempcoBrown) :
+        m_bits ((static_cast<uint32_t> (type) << TYPE_SHIFT) |
+                (static_cast<uint32_t> (digitA) << DIGIT_A_SHIFT) |
+                (static_cast<uint32_t> (digitB) << DIGIT_B_SHIFT) |
+                (static_cast<uint32_t> (digitC) << DIGIT_C_SHIFT) |
+                (static_cast<uint32_t> (multiplier) << MULTIPLIER_SHIFT) |
+                (static_cast<uint32_t> (tolerance) << TOLERANCE_SHIFT) |
+                (static_cast<uint32_t> (tempco) << TEMPCO_SHIFT)) {}
+
+    explicit constexpr ResistorCode (const BandCode& code) :
+        ResistorCode (code.type, code.digits [0], code.digits [1],
+                      code.digits [2], code.multiplier, code.tolerance,
+                      code.tempco) {}
+
+    static constexpr ResistorCode fromBits (const uint32_t bits) {
+        return ResistorCode (bits & BITS_MASK, 0);
+    }
+
+    static ResistorCode fromOrdinal (uint32_t ordinal);
+
+    constexpr uint32_t bits() const {
+        return m_bits;
+    }
+
+    constexpr ResistorType type() const {
+        return static_cast<ResistorType> (field (TYPE_SHIFT, 2));
+    }
+
+    constexpr Digit digitA() const {
+        return static_cast<Digit> (field (DIGIT_A_SHIFT, 4));
+    }
+
+    constexpr Digit digitB() const {
+        return static_cast<Digit> (field (DIGIT_B_SHIFT, 4));
+    }
+
+    constexpr Digit digitC() const {
+        return static_cast<Digit> (field (DIGIT_C_SHIFT, 4));
+    }
+
+    constexpr Multiplier multiplier() const {
+        return static_cast<Multiplier> (field (MULTIPLIER_SHIFT, 4));
+    }
+
+    constexpr Tolerance tolerance() const {
+        return static_cast<Tolerance> (field (TOLERANCE_SHIFT, 3));
+    }
+
+    constexpr Tempco tempco() const {
+        return static_cast<Tempco> (field (TEMPCO_SHIFT, 3));
+    }
+
+    constexpr Digit digit (const int number) const {
+        return number == 0 ? digitA() : number == 1 ? digitB() : digitC();
+    }
+
+    inline void setType (const ResistorType type) {
+        setField (TYPE_SHIFT, 2, type);
+    }
+
+    inline void setDigit (const int number, const Digit digit) {
+        setField (number == 0 ? DIGIT_A_SHIFT :
+                  number == 1 ? DIGIT_B_SHIFT : DIGIT_C_SHIFT, 4, digit);
+    }
+
+    inline void setMultiplier (const Multiplier multiplier) {
+        setField (MULTIPLIER_SHIFT, 4, multiplier);
+    }
+
+    inline void setTolerance (const Tolerance tolerance) {
+        setField (TOLERANCE_SHIFT, 3, tolerance);
+    }
+
+    inline void setTempco (const Tempco tempco) {
+        setField (TEMPCO_SHIFT, 3, tempco);
+    }
+
+    bool isValid() const;
+    uint32_t ordinal() const;
+    ResistorCode normalized() const;
+
+    BandCode toBandCode() const;
+    BandResult decode() const;
+    ExactResistance decodeExact() const;
+
+    constexpr bool operator== (const ResistorCode& other) const {
+        return m_bits == other.m_bits;
+    }
+
+    constexpr bool operator!= (const ResistorCode& other) const {
+        return m_bits != other.m_bits;
+    }
+
+    constexpr bool operator< (const ResistorCode& other) const {
+        return m_bits < other.m_bits;
+    }
+
+    constexpr bool operator<= (const ResistorCode& other) const {
+        return m_bits <= other.m_bits;
+    }
+
+    constexpr bool operator> (const ResistorCode& other) const {
+        return m_bits > other.m_bits;
+    }
+
+    constexpr bool operator>= (const ResistorCode& other) const {
+        return m_bits >= other.m_bits;
+    }
+
+private:
+    constexpr ResistorCode (const uint32_t bits, int) : m_bits (bits) {}
+
+    constexpr uint32_t field (const int shift, const int width) const {
+        return (m_bits >> shift) & ((1u << width) - 1);
+    }
+
+    inline void setField (const int shift, const int width, const uint32_t value) {
+        const uint32_t mask = ((1u << width) - 1) << shift;
+        m_bits = (m_bits & ~mask) | ((value << shift) & mask);
+    }
+
+private:
+    enum {
+        TEMPCO_SHIFT     = 0,
+        TOLERANCE_SHIFT  = 3,
+        MULTIPLIER_SHIFT = 6,
+        DIGIT_C_SHIFT    = 10,
+        DIGIT_B_SHIFT    = 14,
+        DIGIT_A_SHIFT    = 18,
+        TYPE_SHIFT       = 22
+    };
+
+    static const uint32_t BITS_MASK = 0xFFFFFF;
+
+    uint32_t m_bits;
+};
+
+static_assert (sizeof (ResistorCode) == sizeof (uint32_t),
+               "ResistorCode must fit in 32 bits");
+static_assert (std::is_trivially_copyable<ResistorCode>::value,
+               "ResistorCode must be trivially copyable");
+
+}
+
+namespace std
+{
+
+template <>
+struct hash<ResistorCore::ResistorCode> {
+    size_t operator() (const ResistorCore::ResistorCode& code) const {
+        return code.bits();
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ResistorCore.h"
+#include "ResistanceFormatter.h"
+
+#include <math.h>
+#include <assert.h>
+
+/**
+ * @returns The numerical value of the given @a digit color
+ */
+int ResistorCore::digitValue (const Digit digit) {
+    assert (digit >= DigitBlack && digit <= DigitWhite);
+    return static_cast<int> (digit);
+}
+
+/**
+ * @returns The numerical value for the given @a tempco strip color
+ */
+int ResistorCore::tempcoValue (const Tempco tempco) {
+    assert (tempco >= TempcoBrown && tempco <= TempcoViolet);
+
+    int value;
+
+    switch (tempco) {
+    case TempcoBrown:
+        value = 100;
+        break;
+    case TempcoRed:
+        value = 50;
+        break;
+    case TempcoOrange:
+        value = 15;
+        break;
+    case TempcoYellow:
+        value = 25;
+        break;
+    case TempcoBlue:
+        value = 10;
+        break;
+    case TempcoViolet:
+        value = 5;
+        break;
+    default:
+        value = 0;
+        break;
+    }
+
+    return value;
+}
+
+/**
+ * @returns The numerical value for the given @a tolerance strip color
+ */
+double ResistorCore::toleranceValue (const Tolerance tolerance) {
+    assert (tolerance >= ToleranceBrown && tolerance <= ToleranceSilver);
+
+    double value;
+
+    switch (tolerance) {
+    case ToleranceBrown:
+        value = 1;
+        break;
+    case ToleranceRed:
+        value = 2;
+        break;
+    case ToleranceGreen:
+        value = 0.5;
+        break;
+    case ToleranceBlue:
+        value = 0.25;
+        break;
+    case ToleranceViolet:
+        value = 0.1;
+        break;
+    case ToleranceGray:
+        value = 0.05;
+        break;
+    case ToleranceGold:
+        value = 5;
+        break;
+    case ToleranceSilver:
+        value = 10;
+        break;
+    default:
+        value = 0;
+        break;
+    }
+
+    return value / 100;
+}
+
+/**
+ * @returns The numerical value for the given @a multiplier strip color
+ */
+double ResistorCore::multiplierValue (const Multiplier multiplier) {
+    assert (multiplier >= MultiplierBlack && multiplier <= MultiplierSilver);
+
+    double value;
+    switch (multiplier) {
+    case MultiplierBlack:
+        value = pow (10, 0);
+        break;
+    case MultiplierBrown:
+        value = pow (10, 1);
+        break;
+    case MultiplierRed:
+        value = pow (10, 2);
+        break;
+    case MultiplierOrange:
+        value = pow (10, 3);
+        break;
+    case MultiplierYellow:
+        value = pow (10, 4);
+        break;
+    case MultiplierGreen:
+        value = pow (10, 5);
+        break;
+    case MultiplierBlue:
+        value = pow (10, 6);
+        break;
+    case MultiplierViolet:
+        value = pow (10, 7);
+        break;
+    case MultiplierGray:
+        value = pow (10, 8);
+        break;
+    case MultiplierWhite:
+        value = pow (10, 9);
+        break;
+    case MultiplierGold:
+        value = pow (10, -1);
+        break;
+    case MultiplierSilver:
+        value = pow (10, -2);
+        break;
+    default:
+        value = 0;
+        break;
+    }
+
+    return value;
+}
+
+/**
+ * @returns The decimal exponent of the given @a multiplier strip color
+ *          (e.g. 3 for orange and -1 for gold)
+ */
+int ResistorCore::multiplierExponent (const Multiplier multiplier) {
+    assert (multiplier >= MultiplierBlack && multiplier <= MultiplierSilver);
+
+    if (multiplier == MultiplierGold)
+        return -1;
+
+    if (multiplier == MultiplierSilver)
+        return -2;
+
+    return static_cast<int> (multiplier);
+}
+
+/**
+ * @returns The integer formed by the digit strips of the given band
+ *          @a code (e.g. 47 or 470)
+ */
+static inline int bandDigits (const ResistorCore::BandCode& code) {
+    using namespace ResistorCore;
+
+    int base = 10 * digitValue (code.digits [0]) + digitValue (code.digits [1]);
+    if (code.type != FourStripResistor)
+        base = 10 * base + digitValue (code.digits [2]);
+
+    return base;
+}
+
+/**
+ * Calculates the nominal, minimum and maximum resistance values of the
+ * resistor described by the given band @a code.
+ *
+ * Gold and silver multipliers divide by 10 and 100 instead of multiplying
+ * by 0.1 and 0.01 (which are not exact), so the nominal resistance is
+ * always the double that is nearest to the exact value.
+ */
+ResistorCore::BandResult ResistorCore::decodeBands (const BandCode& code) {
+    static const double POWERS [10] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+    };
+
+    const double base = bandDigits (code);
+    const int exponent = multiplierExponent (code.multiplier);
+    const double resistance = exponent >= 0 ? base * POWERS [exponent]
+                                            : base / POWERS [-exponent];
+
+    return applyTolerance (resistance, code.tolerance);
+}
+
+/**
+ * Returns the exact nominal resistance of the resistor described by the
+ * given band @a code, which can be hashed and compared without rounding
+ * errors.
+ */
+ResistorCore::ExactResistance ResistorCore::decodeBandsExact (const BandCode& code) {
+    return ExactResistance::fromDecimal (static_cast<uint64_t> (bandDigits (code)),
+                                         multiplierExponent (code.multiplier));
+}
+
+/**
+ * Calculates the minimum and maximum values of the given nominal
+ * @a resistance for the given @a tolerance strip color.
+ */
+ResistorCore::BandResult ResistorCore::applyTolerance (const double resistance,
+                                                       const Tolerance tolerance) {
+    assert (resistance >= UNKNOWN_RESISTANCE);
+
+    BandResult result;
+    result.resistance = resistance;
+    result.minResistance = (1 - toleranceValue (tolerance)) * resistance;
+    result.maxResistance = (1 + toleranceValue (tolerance)) * resistance;
+    return result;
+}
+
+/**
+ * Returns a nicely formatted UTF-8 string with the given @a resistance
+ * value (e.g. "4.70 kΩ").
+ *
+ * The decimal separator is always a dot, regardless of the C locale
+ * that is set by the application.
+ */
+std::string ResistorCore::formatResistance (const double resistance) {
+    char buffer [RESISTANCE_STR_CAPACITY];
+    const size_t length = formatResistanceUtf8 (resistance, buffer, sizeof (buffer));
+    return std::string (buffer, length);
+}
+
+/**
+ * Returns the UTF-8 text of the given exact @a resistance, with every
+ * significant digit (e.g. "4.753 kΩ")
+ */
+std::string ResistorCore::formatResistance (const ExactResistance resistance) {
+    char buffer [RESISTANCE_STR_CAPACITY];
+    const size_t length = formatResistanceUtf8 (resistance, buffer, sizeof (buffer));
+    return std::string (buffer, length);
+}
+
+/**
+ * Converts the given @a resistance to an integer number of milliohms,
+ * rounding to the nearest milliohm. Returns @c INVALID_MILLIOHMS for
+ * negative values (e.g. @c UNKNOWN_RESISTANCE) or values that do not fit.
+ */
+uint64_t ResistorCore::toMilliohms (const double resistance) {
+    if (!(resistance >= 0) || resistance > 1e15)
+        return INVALID_MILLIOHMS;
+
+    return static_cast<uint64_t> (llround (resistance * 1000));
+}
+
+/**
+ * Writes the given @a milliohms as a 3-digit @a significand (100-999)
+ * times 10^@a exponent ohms.
+ *
+ * Returns @c false if the value is zero, invalid or needs more than three
+ * significant digits (e.g. 4.701 ohms).
+ */
+bool ResistorCore::splitMilliohms (uint64_t milliohms,
+                                   int* significand,
+                                   int* exponent) {
+    assert (significand != NULL && exponent != NULL);
+
+    if (milliohms == 0 || milliohms == INVALID_MILLIOHMS)
+        return false;
+
+    int power = -3;
+    while (milliohms >= 1000) {
+        if (milliohms % 10 != 0)
+            return false;
+
+        milliohms /= 10;
+        ++power;
+    }
+
+    while (milliohms < 100) {
+        milliohms *= 10;
+        --power;
+    }
+
+    *significand = static_cast<int> (milliohms);
+    *exponent = power;
+    return true;
+}
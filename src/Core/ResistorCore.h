@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_CORE_H
+#define RESISTOR_CORE_H
+
+#include <string>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ExactResistance.h"
+
+/*
+ * Qt-free decoding engine used by the ResistanceInfo class.
+ *
+ * Every function in this namespace is pure (no global mutable state), so
+ * it can be called concurrently from any number of threads and linked
+ * into tools that do not depend on QtGui or QtQml.
+ */
+namespace ResistorCore
+{
+
+enum ResistorType {
+    FourStripResistor = 0,
+    FiveStripResistor = 1,
+    SixStripResistor  = 2
+};
+
+enum Digit {
+    DigitBlack  = 0,
+    DigitBrown  = 1,
+    DigitRed    = 2,
+    DigitOrange = 3,
+    DigitYellow = 4,
+    DigitGreen  = 5,
+    DigitBlue   = 6,
+    DigitViolet = 7,
+    DigitGray   = 8,
+    DigitWhite  = 9
+};
+
+enum Tempco {
+    TempcoBrown  = 0,
+    TempcoRed    = 1,
+    TempcoOrange = 2,
+    TempcoYellow = 3,
+    TempcoBlue   = 4,
+    TempcoViolet = 5
+};
+
+enum Multiplier {
+    MultiplierBlack  = 0,
+    MultiplierBrown  = 1,
+    MultiplierRed    = 2,
+    MultiplierOrange = 3,
+    MultiplierYellow = 4,
+    MultiplierGreen  = 5,
+    MultiplierBlue   = 6,
+    MultiplierViolet = 7,
+    MultiplierGray   = 8,
+    MultiplierWhite  = 9,
+    MultiplierGold   = 10,
+    MultiplierSilver = 11
+};
+
+enum Tolerance {
+    ToleranceBrown  = 0,
+    ToleranceRed    = 1,
+    ToleranceGreen  = 2,
+    ToleranceBlue   = 3,
+    ToleranceViolet = 4,
+    ToleranceGray   = 5,
+    ToleranceGold   = 6,
+    ToleranceSilver = 7
+};
+
+/**
+ * Used when the user inputs an invalid SMD code.
+ * This helps us to return "Unknown" resistance to the user instead
+ * of showing 'NaN' or another cryptic message to the user
+ */
+static const double UNKNOWN_RESISTANCE = -1.0;
+
+struct BandCode {
+    ResistorType type;
+    Digit digits [3];
+    Multiplier multiplier;
+    Tolerance tolerance;
+    Tempco tempco;
+};
+
+struct BandResult {
+    double resistance;
+    double minResistance;
+    double maxResistance;
+};
+
+enum SmdScheme {
+    SmdInvalid    = 0,
+    SmdJumper     = 1,
+    SmdThreeDigit = 2,
+    SmdFourDigit  = 3,
+    SmdRadix      = 4,
+    SmdEia96      = 5
+};
+
+struct SmdResult {
+    double resistance;
+    int tolerance;
+    SmdScheme scheme;
+};
+
+int digitValue (const Digit digit);
+int tempcoValue (const Tempco tempco);
+double toleranceValue (const Tolerance tolerance);
+double multiplierValue (const Multiplier multiplier);
+int multiplierExponent (const Multiplier multiplier);
+
+BandResult decodeBands (const BandCode& code);
+ExactResistance decodeBandsExact (const BandCode& code);
+BandResult applyTolerance (const double resistance, const Tolerance tolerance);
+
+std::string formatResistance (const double resistance);
+std::string formatResistance (const ExactResistance resistance);
+
+/**
+ * Exact integer representation of a resistance, used as the key of the
+ * lookup structures that go from a value back to its markings
+ */
+static const uint64_t INVALID_MILLIOHMS = UINT64_MAX;
+
+uint64_t toMilliohms (const double resistance);
+bool splitMilliohms (uint64_t milliohms, int* significand, int* exponent);
+
+}
+
+#endif
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ReverseLookup.h"
+#include "SmdDecoder.h"
+
+#include <math.h>
+#include <assert.h>
+#include <string.h>
+
+using namespace ResistorCore;
+
+/**
+ * Lowest power of ten (in ohms) of the values stored in the table
+ */
+static const int MIN_EXPONENT = -4;
+
+/**
+ * Builds the lookup structure
+ */
+ReverseLookup::ReverseLookup() {
+    m_entries.assign (REVERSE_TABLE_SIZE, ReverseEntry());
+    addBandCodes();
+    addSmdMarkings();
+}
+
+/**
+ * Returns the only instance of the lookup structure, building it if
+ * required. This function is thread-safe.
+ */
+const ReverseLookup& ReverseLookup::instance() {
+    static const ReverseLookup lookup;
+    return lookup;
+}
+
+/**
+ * Returns every encoding of the given @a resistance, or @c NULL if the
+ * value cannot be written with any color band code or SMD marking
+ */
+const ReverseEntry* ReverseLookup::lookup (const double resistance) const {
+    return lookupMilliohms (toMilliohms (resistance));
+}
+
+/**
+ * Returns every encoding of the resistance with the given number of
+ * @a milliohms, or @c NULL if the value cannot be written with any color
+ * band code or SMD marking
+ */
+const ReverseEntry* ReverseLookup::lookupMilliohms (const uint64_t milliohms) const {
+    size_t index;
+    if (!slot (milliohms, &index) || m_entries [index].flags == 0)
+        return NULL;
+
+    return &m_entries [index];
+}
+
+/**
+ * Writes the band code of the given @a type that has the given
+ * @a resistance, @a tolerance and @a tempco to @a code.
+ *
+ * Returns @c false (and leaves @a code untouched) if the resistance
+ * cannot be written with the digits of the given resistor type.
+ */
+bool ReverseLookup::bandCode (const double resistance,
+                              const ResistorType type,
+                              const Tolerance tolerance,
+                              const Tempco tempco,
+                              ResistorCode* code) const {
+    assert (code != NULL);
+
+    const ReverseEntry* entry = lookup (resistance);
+    if (!entry)
+        return false;
+
+    const bool fourStrip = (type == FourStripResistor);
+    if (!(entry->flags & (fourStrip ? HasFourStrip : HasFiveStrip)))
+        return false;
+
+    ResistorCode result = ResistorCode::fromBits (fourStrip ? entry->fourStrip :
+                                                              entry->fiveStrip);
+    result.setType (type);
+    result.setTolerance (tolerance);
+    result.setTempco (tempco);
+    *code = result;
+    return true;
+}
+
+/**
+ * Writes every band code of the given @a type with the given
+ * @a resistance to @a codes (one per tolerance strip, and per tempco
+ * strip for 6-strip resistors).
+ *
+ * At most @a capacity codes are written, the function returns the number
+ * of codes that describe the resistance (0 if there are none).
+ */
+size_t ReverseLookup::bandEncodings (const double resistance,
+                                     const ResistorType type,
+                                     ResistorCode* codes,
+                                     const size_t capacity) const {
+    assert (codes != NULL || capacity == 0);
+
+    ResistorCode code;
+    if (!bandCode (resistance, type, ToleranceBrown, TempcoBrown, &code))
+        return 0;
+
+    const int tempcos = (type == SixStripResistor) ? TempcoViolet + 1 : 1;
+
+    size_t count = 0;
+    for (int tolerance = ToleranceBrown; tolerance <= ToleranceSilver; ++tolerance) {
+        for (int tempco = 0; tempco < tempcos; ++tempco) {
+            if (count < capacity) {
+                code.setTolerance (static_cast<Tolerance> (tolerance));
+                code.setTempco (static_cast<Tempco> (tempco));
+                codes [count] = code;
+            }
+
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Returns the number of bytes used by the lookup structure
+ */
+size_t ReverseLookup::memoryUsage() const {
+    return sizeof (ReverseLookup) + m_entries.capacity() * sizeof (ReverseEntry);
+}
+
+/**
+ * Registers every 4-strip and 5-strip band code (with a non-black first
+ * digit), each value has at most one code of each type
+ */
+void ReverseLookup::addBandCodes() {
+    for (int type = FourStripResistor; type <= FiveStripResistor; ++type) {
+        const int lastDigitC = (type == FourStripResistor) ? DigitBlack : DigitWhite;
+        for (int a = DigitBrown; a <= DigitWhite; ++a) {
+            for (int b = DigitBlack; b <= DigitWhite; ++b) {
+                for (int c = DigitBlack; c <= lastDigitC; ++c) {
+                    for (int m = MultiplierBlack; m <= MultiplierSilver; ++m) {
+                        const ResistorCode code (static_cast<ResistorType> (type),
+                                                 static_cast<Digit> (a),
+                                                 static_cast<Digit> (b),
+                                                 static_cast<Digit> (c),
+                                                 static_cast<Multiplier> (m),
+                                                 ToleranceBrown);
+
+                        size_t index;
+                        if (!slot (toMilliohms (code.decode().resistance), &index))
+                            continue;
+
+                        ReverseEntry& entry = m_entries [index];
+                        if (type == FourStripResistor) {
+                            entry.fourStrip = code.bits();
+                            entry.flags |= HasFourStrip;
+                        }
+
+                        else {
+                            entry.fiveStrip = code.bits();
+                            entry.flags |= HasFiveStrip;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Registers the 3-character, 4-character and EIA-96 markings.
+ *
+ * Several markings can decode to the same value (e.g. "5R0" and "050", or
+ * "4R70" and "04R7"), the first one that is registered wins. The patterns
+ * are visited so that markings without a leading zero are preferred.
+ */
+void ReverseLookup::addSmdMarkings() {
+    const char* patterns [] = {
+        "NDD", "DRD", "0DD",
+        "NDDD", "DRDD", "NDRD", "0DDD", "0DRD"
+    };
+
+    for (size_t p = 0; p < sizeof (patterns) / sizeof (patterns [0]); ++p) {
+        const char* pattern = patterns [p];
+        const size_t length = strlen (pattern);
+
+        // Get number of combinations of the pattern
+        int combinations = 1;
+        for (size_t i = 0; i < length; ++i) {
+            if (pattern [i] == 'D')
+                combinations *= 10;
+            else if (pattern [i] == 'N')
+                combinations *= 9;
+        }
+
+        // Register every marking of the pattern
+        for (int n = 0; n < combinations; ++n) {
+            char code [4];
+            int value = n;
+            for (size_t i = length; i > 0; --i) {
+                const char symbol = pattern [i - 1];
+                if (symbol == 'D') {
+                    code [i - 1] = static_cast<char> ('0' + value % 10);
+                    value /= 10;
+                }
+
+                else if (symbol == 'N') {
+                    code [i - 1] = static_cast<char> ('1' + value % 9);
+                    value /= 9;
+                }
+
+                else
+                    code [i - 1] = symbol;
+            }
+
+            addMarking (code, length);
+        }
+    }
+
+    // Add EIA-96 markings
+    for (size_t index = 0; index < REVERSE_TABLE_SIZE; ++index) {
+        const int significand = static_cast<int> (index % 900) + 100;
+        const int exponent = static_cast<int> (index / 900) + MIN_EXPONENT;
+
+        ReverseEntry& entry = m_entries [index];
+        if (encodeEia96 (significand * pow (10, exponent),
+                         entry.eia96Marking,
+                         sizeof (entry.eia96Marking)) > 0)
+            entry.flags |= HasMarking;
+    }
+}
+
+/**
+ * Registers the given SMD marking (with @a length characters) if its
+ * value has no marking of the same length yet
+ */
+void ReverseLookup::addMarking (const char* code, const size_t length) {
+    assert (length == 3 || length == 4);
+
+    const SmdResult result = decodeSmd (code, length);
+    if (result.scheme == SmdInvalid || result.scheme == SmdJumper)
+        return;
+
+    size_t index;
+    if (!slot (toMilliohms (result.resistance), &index))
+        return;
+
+    ReverseEntry& entry = m_entries [index];
+    char* marking = (length == 3) ? entry.threeCharMarking : entry.fourCharMarking;
+    if (marking [0] == '\0') {
+        memcpy (marking, code, length);
+        marking [length] = '\0';
+        entry.flags |= HasMarking;
+    }
+}
+
+/**
+ * Obtains the table @a index of the value with the given number of
+ * @a milliohms, returns @c false if the value is not in the table
+ */
+bool ReverseLookup::slot (const uint64_t milliohms, size_t* index) {
+    int significand;
+    int exponent;
+    if (!splitMilliohms (milliohms, &significand, &exponent))
+        return false;
+
+    if (exponent < MIN_EXPONENT || exponent >= MIN_EXPONENT + static_cast<int> (REVERSE_EXPONENTS))
+        return false;
+
+    *index = static_cast<size_t> (exponent - MIN_EXPONENT) * 900 +
+             static_cast<size_t> (significand - 100);
+    return true;
+}
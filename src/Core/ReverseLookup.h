@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_REVERSE_LOOKUP_H
+#define RESISTOR_REVERSE_LOOKUP_H
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ResistorCode.h"
+#include "ResistorCore.h"
+
+namespace ResistorCore
+{
+
+/**
+ * Number of slots of the reverse lookup table, one for each 3-digit
+ * significand (100-999) times 10^e ohms, with e in [-4, 9]
+ */
+static const size_t REVERSE_EXPONENTS = 14;
+static const size_t REVERSE_TABLE_SIZE = 900 * REVERSE_EXPONENTS;
+
+/**
+ * Every encoding of a single resistance value. Band codes are stored with
+ * brown tolerance and tempco strips, markings are NUL-terminated and
+ * empty when the value cannot be written with the given scheme.
+ */
+struct ReverseEntry {
+    uint32_t fourStrip;
+    uint32_t fiveStrip;
+    char threeCharMarking [4];
+    char fourCharMarking [5];
+    char eia96Marking [4];
+    uint8_t flags;
+};
+
+/**
+ * Resolves a resistance value to its color bands and SMD markings with a
+ * single table probe.
+ *
+ * Values are keyed by their exact number of milliohms, so a value is only
+ * found if it can be written with three significant digits. The table is
+ * built the first time that @c instance() is called by running every
+ * code through @c decodeBands() and @c decodeSmd(), so both directions
+ * always agree.
+ */
+class ReverseLookup
+{
+public:
+    enum Flags {
+        HasFourStrip = 0x01,
+        HasFiveStrip = 0x02,
+        HasMarking   = 0x04
+    };
+
+    static const ReverseLookup& instance();
+
+    const ReverseEntry* lookup (const double resistance) const;
+    const ReverseEntry* lookupMilliohms (const uint64_t milliohms) const;
+
+    bool bandCode (const double resistance,
+                   const ResistorType type,
+                   const Tolerance tolerance,
+                   const Tempco tempco,
+                   ResistorCode* code) const;
+
+    size_t bandEncodings (const double resistance,
+                          const ResistorType type,
+                          ResistorCode* codes,
+                          const size_t capacity) const;
+
+    size_t memoryUsage() const;
+
+private:
+    ReverseLookup();
+    void addBandCodes();
+    void addSmdMarkings();
+    void addMarking (const char* code, const size_t length);
+
+    static bool slot (const uint64_t milliohms, size_t* index);
+
+private:
+    std::vector<ReverseEntry> m_entries;
+};
+
+}
+
+#endif
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "SmdDecoder.h"
+#include "Marking.h"
+
+#include <stdint.h>
+#include <assert.h>
+
+using namespace ResistorCore;
+
+/**
+ * Preferred EIA-96 multiplier letters, from 10^-3 to 10^5
+ */
+static const char SMD_EIA96_LETTERS [] = "ZYXABCDEF";
+
+/**
+ * Maps every 3-digit significand (100-999) to its EIA-96 code, or to 0
+ * if the significand is not an E96 value
+ */
+struct Eia96Index {
+    uint8_t code [900];
+};
+
+static constexpr Eia96Index makeEia96Index() {
+    Eia96Index table {};
+    for (int i = 1; i < 97; ++i)
+        table.code [MarkingLookup::EIA96 [i] - 100] = static_cast<uint8_t> (i);
+
+    return table;
+}
+
+static constexpr Eia96Index EIA96_INDEX = makeEia96Index();
+
+/**
+ * Calculates the resistance and tolerance of the given SMD resistor
+ * @a code, which must have @a length characters.
+ *
+ * The code is decoded in a single pass by the table-driven marking
+ * engine, with the rules of the resistor family, without allocating
+ * memory or modifying the input. The code does not need to be
+ * NUL-terminated, invalid codes return an @c UNKNOWN_RESISTANCE with 0%
+ * tolerance.
+ *
+ * Fractional values are divided by an exact power of ten, so the
+ * resistance is the double that is nearest to the exact value (e.g. "0R47"
+ * gives exactly the same double as the literal 0.47).
+ */
+SmdResult ResistorCore::decodeSmd (const char* code, const size_t length) {
+    assert (code != NULL || length == 0);
+
+    const MarkingValue marking = decodeCode<ResistorMarking> (code, length);
+
+    SmdResult result;
+    result.scheme = static_cast<SmdScheme> (marking.scheme);
+    result.tolerance = marking.tolerance / 100;
+
+    const int index = marking.exponent + MarkingScale::OFFSET;
+    const double value = marking.significand * MarkingScale::MULTIPLIERS [index] / MarkingScale::DIVISORS [index];
+    result.resistance = marking.scheme == MarkingInvalid ? UNKNOWN_RESISTANCE : value;
+    return result;
+}
+
+/**
+ * Returns the exact resistance of the given SMD resistor @a code, or an
+ * invalid value if the code cannot be decoded. The tolerance (in percent,
+ * as in @c SmdResult) is written to @a tolerance if it is not NULL.
+ */
+ExactResistance ResistorCore::decodeSmdExact (const char* code,
+                                              const size_t length,
+                                              int* tolerance) {
+    assert (code != NULL || length == 0);
+
+    const MarkingValue marking = decodeCode<ResistorMarking> (code, length);
+    if (tolerance)
+        *tolerance = marking.tolerance / 100;
+
+    if (marking.scheme == MarkingInvalid)
+        return ExactResistance();
+
+    return ExactResistance::fromDecimal (marking.significand, marking.exponent);
+}
+
+/**
+ * Decodes a buffer of newline-separated SMD codes, which must have
+ * @a length bytes. Carriage returns before each newline are ignored.
+ *
+ * At most @a capacity results are written to @a results, the function
+ * returns the number of codes that were decoded.
+ */
+size_t ResistorCore::decodeSmdLines (const char* buffer,
+                                     const size_t length,
+                                     SmdResult* results,
+                                     const size_t capacity) {
+    size_t count = 0;
+    size_t start = 0;
+    while (start < length && count < capacity) {
+        // Find end of the line
+        size_t end = start;
+        while (end < length && buffer [end] != '\n')
+            ++end;
+
+        // Decode the line without the carriage return (if any)
+        size_t size = end - start;
+        if (size > 0 && buffer [end - 1] == '\r')
+            --size;
+
+        results [count++] = decodeSmd (buffer + start, size);
+        start = end + 1;
+    }
+
+    return count;
+}
+
+/**
+ * Decodes @a count SMD codes stored in fixed-width records of @a width
+ * bytes. Each code ends at the first NUL or space character of its record,
+ * or at the end of the record.
+ */
+void ResistorCore::decodeSmdFixed (const char* buffer,
+                                   const size_t count,
+                                   const size_t width,
+                                   SmdResult* results) {
+    for (size_t i = 0; i < count; ++i) {
+        const char* record = buffer + i * width;
+
+        size_t size = 0;
+        while (size < width && record [size] != '\0' && record [size] != ' ')
+            ++size;
+
+        results [i] = decodeSmd (record, size);
+    }
+}
+
+/**
+ * Writes the EIA-96 marking of the given @a resistance (e.g. "01C" for
+ * 10 kOhm) to @a marking, which must hold at least @a capacity bytes.
+ *
+ * Returns the length of the marking (without the NUL terminator), or 0 if
+ * the resistance is not an E96 value between 100 mOhm and 97.6 MOhm or if
+ * the buffer is too small.
+ */
+size_t ResistorCore::encodeEia96 (const double resistance,
+                                  char* marking,
+                                  const size_t capacity) {
+    assert (marking != NULL || capacity == 0);
+
+    int significand;
+    int exponent;
+    if (capacity < 4 || !splitMilliohms (toMilliohms (resistance), &significand, &exponent))
+        return 0;
+
+    const int index = EIA96_INDEX.code [significand - 100];
+    if (index == 0 || exponent < -3 || exponent > 5)
+        return 0;
+
+    marking [0] = static_cast<char> ('0' + index / 10);
+    marking [1] = static_cast<char> ('0' + index % 10);
+    marking [2] = SMD_EIA96_LETTERS [exponent + 3];
+    marking [3] = '\0';
+    return 3;
+}
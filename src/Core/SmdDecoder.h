@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_SMD_DECODER_H
+#define RESISTOR_SMD_DECODER_H
+
+#include <stddef.h>
+
+#include "ResistorCore.h"
+
+namespace ResistorCore
+{
+
+SmdResult decodeSmd (const char* code, const size_t length);
+ExactResistance decodeSmdExact (const char* code,
+                                const size_t length,
+                                int* tolerance = NULL);
+
+size_t decodeSmdLines (const char* buffer,
+                       const size_t length,
+                       SmdResult* results,
+                       const size_t capacity);
+
+void decodeSmdFixed (const char* buffer,
+                     const size_t count,
+                     const size_t width,
+                     SmdResult* results);
+
+size_t encodeEia96 (const double resistance,
+                    char* marking,
+                    const size_t capacity);
+
+}
+
+#endif
@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "SmdLookup.h"
+#include "SmdDecoder.h"
+
+#include <assert.h>
+#include <algorithm>
+
+using namespace ResistorCore;
+
+/**
+ * Number of symbols in the SMD alphabet ([0-9A-Z])
+ */
+static const uint32_t SYMBOLS = 36;
+
+/**
+ * Offsets of the 1, 2 and 3-character markings in the dense table
+ */
+static const uint32_t DENSE_OFFSETS [4] = {
+    0, 0, SYMBOLS, SYMBOLS + SYMBOLS * SYMBOLS
+};
+static const uint32_t DENSE_SIZE = DENSE_OFFSETS [3] + SYMBOLS * SYMBOLS * SYMBOLS;
+
+/**
+ * Average number of keys per bucket of the perfect hash function
+ */
+static const uint32_t KEYS_PER_BUCKET = 4;
+
+/**
+ * Maps every byte to its index in the SMD alphabet (letters are
+ * case-insensitive), other bytes map to @c SYMBOLS
+ */
+struct SymbolTable {
+    uint8_t index [256];
+    char upper [256];
+};
+
+static constexpr SymbolTable makeSymbolTable() {
+    SymbolTable table {};
+    for (int c = 0; c < 256; ++c) {
+        table.index [c] = SYMBOLS;
+        table.upper [c] = '\0';
+    }
+
+    for (int c = '0'; c <= '9'; ++c) {
+        table.index [c] = static_cast<uint8_t> (c - '0');
+        table.upper [c] = static_cast<char> (c);
+    }
+
+    for (int c = 'A'; c <= 'Z'; ++c) {
+        table.index [c] = static_cast<uint8_t> (c - 'A' + 10);
+        table.index [c - 'A' + 'a'] = static_cast<uint8_t> (c - 'A' + 10);
+        table.upper [c] = static_cast<char> (c);
+        table.upper [c - 'A' + 'a'] = static_cast<char> (c);
+    }
+
+    return table;
+}
+
+static constexpr SymbolTable SYMBOL_TABLE = makeSymbolTable();
+
+/**
+ * Integer hash function used by the perfect hash (lowbias32)
+ */
+static inline uint32_t mix (uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352d;
+    x ^= x >> 15;
+    x *= 0x846ca68b;
+    x ^= x >> 16;
+    return x;
+}
+
+/**
+ * Returns the slot of the given @a key when its bucket uses the
+ * given @a displacement
+ */
+static inline uint32_t slot (const uint32_t key,
+                             const uint32_t displacement,
+                             const uint32_t size) {
+    return mix (key + 0x9e3779b9u * (displacement + 1)) % size;
+}
+
+/**
+ * Packs the 4-character @a code into an integer with its letters in
+ * uppercase, returns 0 if the code has characters outside of the alphabet
+ */
+static inline uint32_t packKey (const char* code) {
+    uint32_t key = 0;
+    for (int i = 0; i < 4; ++i) {
+        const char c = SYMBOL_TABLE.upper [static_cast<uint8_t> (code [i])];
+        if (c == '\0')
+            return 0;
+
+        key = (key << 8) | static_cast<uint8_t> (c);
+    }
+
+    return key;
+}
+
+/**
+ * Builds the lookup structure
+ */
+SmdLookup::SmdLookup() {
+    buildDenseTable();
+    buildPerfectHash();
+}
+
+/**
+ * Returns the only instance of the lookup structure, building it if
+ * required. This function is thread-safe.
+ */
+const SmdLookup& SmdLookup::instance() {
+    static const SmdLookup lookup;
+    return lookup;
+}
+
+/**
+ * Returns the resistance, tolerance and scheme of the given SMD @a code,
+ * which must have @a length characters. The result is identical to the
+ * one returned by @c decodeSmd().
+ */
+SmdResult SmdLookup::lookup (const char* code, const size_t length) const {
+    assert (code != NULL || length == 0);
+
+    // Probe the dense table
+    if (length >= 1 && length <= 3) {
+        uint32_t index = 0;
+        for (size_t i = 0; i < length; ++i) {
+            const uint32_t symbol = SYMBOL_TABLE.index [static_cast<uint8_t> (code [i])];
+            if (symbol == SYMBOLS)
+                return decodeSmd (NULL, 0);
+
+            index = index * SYMBOLS + symbol;
+        }
+
+        return result (m_dense [DENSE_OFFSETS [length] + index]);
+    }
+
+    // Probe the perfect hash
+    if (length == 4) {
+        const uint32_t key = packKey (code);
+        if (key != 0) {
+            const uint32_t size = static_cast<uint32_t> (m_hashed.size());
+            const uint32_t buckets = static_cast<uint32_t> (m_displacements.size());
+            const uint32_t bucket = mix (key) % buckets;
+            const SmdEntry& entry = m_hashed [slot (key, m_displacements [bucket], size)];
+            if (entry.key == key)
+                return result (entry);
+        }
+    }
+
+    return decodeSmd (NULL, 0);
+}
+
+/**
+ * Resolves @a count SMD markings, where @a codes [i] points to a marking
+ * with @a lengths [i] characters, the results are written to @a results.
+ */
+void SmdLookup::lookupBatch (const char* const* codes,
+                             const size_t* lengths,
+                             const size_t count,
+                             SmdResult* results) const {
+    for (size_t i = 0; i < count; ++i)
+        results [i] = lookup (codes [i], lengths [i]);
+}
+
+/**
+ * Returns the number of bytes used by the lookup structure
+ */
+size_t SmdLookup::memoryUsage() const {
+    return sizeof (SmdLookup) +
+            m_dense.capacity() * sizeof (SmdEntry) +
+            m_hashed.capacity() * sizeof (SmdEntry) +
+            m_displacements.capacity() * sizeof (uint16_t);
+}
+
+/**
+ * Returns the number of markings stored in the dense table
+ */
+size_t SmdLookup::denseEntries() const {
+    return m_dense.size();
+}
+
+/**
+ * Returns the number of markings stored in the perfect hash table
+ */
+size_t SmdLookup::hashedEntries() const {
+    return m_hashed.size();
+}
+
+/**
+ * Decodes every marking with 1 to 3 characters
+ */
+void SmdLookup::buildDenseTable() {
+    const char* alphabet = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    m_dense.resize (DENSE_SIZE);
+    for (size_t length = 1; length <= 3; ++length) {
+        uint32_t combinations = 1;
+        for (size_t i = 0; i < length; ++i)
+            combinations *= SYMBOLS;
+
+        for (uint32_t index = 0; index < combinations; ++index) {
+            char code [3];
+            uint32_t value = index;
+            for (size_t i = length; i > 0; --i) {
+                code [i - 1] = alphabet [value % SYMBOLS];
+                value /= SYMBOLS;
+            }
+
+            const SmdResult decoded = decodeSmd (code, length);
+            SmdEntry& entry = m_dense [DENSE_OFFSETS [length] + index];
+            entry.key = index;
+            entry.resistance = decoded.resistance;
+            entry.tolerance = static_cast<uint8_t> (decoded.tolerance);
+            entry.scheme = static_cast<uint8_t> (decoded.scheme);
+        }
+    }
+}
+
+/**
+ * Builds a minimal perfect hash over the valid 4-character markings
+ * (4-digit codes and R-notation codes) using the hash and displace
+ * algorithm: keys are grouped in buckets, and each bucket searches for
+ * a displacement value that sends all of its keys to free slots.
+ */
+void SmdLookup::buildPerfectHash() {
+    // Get every valid 4-character marking
+    std::vector<uint32_t> keys;
+    const char* patterns [] = { "DDDD", "DRDD", "DDRD" };
+    for (size_t p = 0; p < sizeof (patterns) / sizeof (patterns [0]); ++p) {
+        for (int n = 0; n < 1000 * (p == 0 ? 10 : 1); ++n) {
+            char code [4];
+            int value = n;
+            for (int i = 3; i >= 0; --i) {
+                if (patterns [p][i] == 'R')
+                    code [i] = 'R';
+                else {
+                    code [i] = static_cast<char> ('0' + value % 10);
+                    value /= 10;
+                }
+            }
+
+            if (decodeSmd (code, 4).scheme != SmdInvalid)
+                keys.push_back (packKey (code));
+        }
+    }
+
+    // Distribute keys into buckets
+    const uint32_t size = static_cast<uint32_t> (keys.size());
+    const uint32_t bucketCount = (size + KEYS_PER_BUCKET - 1) / KEYS_PER_BUCKET;
+    std::vector<std::vector<uint32_t>> buckets (bucketCount);
+    for (size_t i = 0; i < keys.size(); ++i)
+        buckets [mix (keys [i]) % bucketCount].push_back (keys [i]);
+
+    // Place the largest buckets first
+    std::vector<uint32_t> order (bucketCount);
+    for (uint32_t i = 0; i < bucketCount; ++i)
+        order [i] = i;
+
+    std::stable_sort (order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return buckets [a].size() > buckets [b].size();
+    });
+
+    // Find a displacement for each bucket
+    std::vector<bool> used (size, false);
+    std::vector<uint32_t> slots;
+    m_hashed.assign (size, SmdEntry());
+    m_displacements.assign (bucketCount, 0);
+    for (uint32_t b = 0; b < bucketCount; ++b) {
+        const std::vector<uint32_t>& bucket = buckets [order [b]];
+        if (bucket.empty())
+            continue;
+
+        for (uint32_t displacement = 0; displacement <= UINT16_MAX; ++displacement) {
+            slots.clear();
+            bool fits = true;
+            for (size_t k = 0; k < bucket.size() && fits; ++k) {
+                const uint32_t s = slot (bucket [k], displacement, size);
+                fits = !used [s] && std::find (slots.begin(), slots.end(), s) == slots.end();
+                slots.push_back (s);
+            }
+
+            if (fits) {
+                for (size_t k = 0; k < bucket.size(); ++k) {
+                    char code [4];
+                    for (int i = 0; i < 4; ++i)
+                        code [i] = static_cast<char> (bucket [k] >> (24 - 8 * i));
+
+                    const SmdResult decoded = decodeSmd (code, 4);
+                    SmdEntry& entry = m_hashed [slots [k]];
+                    entry.key = bucket [k];
+                    entry.resistance = decoded.resistance;
+                    entry.tolerance = static_cast<uint8_t> (decoded.tolerance);
+                    entry.scheme = static_cast<uint8_t> (decoded.scheme);
+                    used [slots [k]] = true;
+                }
+
+                m_displacements [order [b]] = static_cast<uint16_t> (displacement);
+                break;
+            }
+
+            assert (displacement < UINT16_MAX);
+        }
+    }
+}
+
+/**
+ * Converts a table @a entry to a decoding result
+ */
+SmdResult SmdLookup::result (const SmdEntry& entry) {
+    SmdResult result;
+    result.resistance = entry.resistance;
+    result.tolerance = entry.tolerance;
+    result.scheme = static_cast<SmdScheme> (entry.scheme);
+    return result;
+}
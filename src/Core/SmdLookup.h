@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_SMD_LOOKUP_H
+#define RESISTOR_SMD_LOOKUP_H
+
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ResistorCore.h"
+
+namespace ResistorCore
+{
+
+/**
+ * Precomputed decoding result of a single SMD marking
+ */
+struct SmdEntry {
+    double resistance;
+    uint32_t key;
+    uint8_t tolerance;
+    uint8_t scheme;
+};
+
+/**
+ * Resolves any SMD marking with a single table probe.
+ *
+ * Markings with 1 to 3 characters over [0-9A-Z] (case-insensitive) are
+ * stored in a dense table. The 4-character space is too large for a dense
+ * table, so only its valid subset (4-digit and R-notation codes) is stored,
+ * addressed through a minimal perfect hash (hash and displace).
+ *
+ * The structure is built the first time that @c instance() is called,
+ * every entry is obtained from @c decodeSmd(), so both always agree.
+ */
+class SmdLookup
+{
+public:
+    static const SmdLookup& instance();
+
+    SmdResult lookup (const char* code, const size_t length) const;
+    void lookupBatch (const char* const* codes,
+                      const size_t* lengths,
+                      const size_t count,
+                      SmdResult* results) const;
+
+    size_t memoryUsage() const;
+    size_t denseEntries() const;
+    size_t hashedEntries() const;
+
+private:
+    SmdLookup();
+    void buildDenseTable();
+    void buildPerfectHash();
+
+    static SmdResult result (const SmdEntry& entry);
+
+private:
+    std::vector<SmdEntry> m_dense;
+    std::vector<SmdEntry> m_hashed;
+    std::vector<uint16_t> m_displacements;
+};
+
+}
+
+#endif
@@ -0,0 +1,778 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "SparseCholesky.h"
+
+#include <math.h>
+#include <algorithm>
+
+using namespace ResistorCore;
+
+/**
+ * Subgraphs with fewer vertices than this are not dissected any further,
+ * their vertices are simply ordered before the separator of their parent
+ */
+static const size_t LEAF_SIZE = 64;
+
+/**
+ * Number of columns of a supernode that are factorized together
+ */
+static const size_t PANEL_BLOCK = 16;
+
+/**
+ * Marker for vertices that have not been visited by the current BFS
+ */
+static const size_t UNVISITED = static_cast<size_t> (-1);
+
+namespace
+{
+/**
+ * Adjacency (without self loops) of the matrix graph and the scratch
+ * buffers used while computing the nested dissection ordering
+ */
+struct Graph
+{
+    const std::vector<size_t>* pointers;
+    const std::vector<size_t>* indices;
+
+    std::vector<size_t> part;
+    std::vector<size_t> level;
+    std::vector<size_t> queue;
+    std::vector<size_t>* order;
+};
+
+/**
+ * Breadth-first search from @a root restricted to the vertices of
+ * @a part, the visited vertices are stored in @c graph.queue in BFS
+ * order. Returns the number of levels of the rooted level structure
+ */
+size_t bfs (Graph& graph, const size_t root, const size_t part) {
+    const std::vector<size_t>& ptr = *graph.pointers;
+    const std::vector<size_t>& idx = *graph.indices;
+
+    graph.queue.clear();
+    graph.queue.push_back (root);
+    graph.level [root] = 0;
+
+    size_t levels = 1;
+    for (size_t head = 0; head < graph.queue.size(); ++head) {
+        const size_t v = graph.queue [head];
+        for (size_t p = ptr [v]; p < ptr [v + 1]; ++p) {
+            const size_t w = idx [p];
+            if (graph.part [w] == part && graph.level [w] == UNVISITED) {
+                graph.level [w] = graph.level [v] + 1;
+                levels = std::max (levels, graph.level [w] + 1);
+                graph.queue.push_back (w);
+            }
+        }
+    }
+
+    return levels;
+}
+
+/**
+ * Clears the BFS levels of the vertices visited by the last search
+ */
+void resetLevels (Graph& graph) {
+    for (size_t i = 0; i < graph.queue.size(); ++i)
+        graph.level [graph.queue [i]] = UNVISITED;
+}
+
+/**
+ * Orders the connected subgraph reachable from @a seed inside @a part.
+ * Separators are taken from the middle level of the level structure of a
+ * pseudo-peripheral vertex, both halves are ordered first (recursively)
+ * and the separator last, so that eliminating it produces little fill
+ */
+void dissect (Graph& graph, const size_t seed, const size_t part,
+              size_t& nextPart) {
+    /* Find a pseudo-peripheral vertex (a few sweeps are enough) */
+    size_t root = seed;
+    size_t levels = bfs (graph, root, part);
+    for (int sweep = 0; sweep < 4; ++sweep) {
+        const size_t far = graph.queue.back();
+        resetLevels (graph);
+        const size_t farLevels = bfs (graph, far, part);
+        if (farLevels <= levels) {
+            resetLevels (graph);
+            levels = bfs (graph, root, part);
+            break;
+        }
+
+        root = far;
+        levels = farLevels;
+    }
+
+    std::vector<size_t> vertices (graph.queue);
+    const size_t count = vertices.size();
+
+    /* Small subgraph or no usable separator, order in BFS order */
+    if (count <= LEAF_SIZE || levels < 3) {
+        resetLevels (graph);
+        for (size_t i = 0; i < count; ++i) {
+            graph.part [vertices [i]] = UNVISITED;
+            graph.order->push_back (vertices [i]);
+        }
+
+        return;
+    }
+
+    /* Pick the level that splits the vertices in two halves */
+    size_t separator = graph.level [vertices [count / 2]];
+    separator = std::max<size_t> (1, std::min (separator, levels - 2));
+
+    /* Split the subgraph in two parts and the separator */
+    const size_t lowPart = nextPart++;
+    const size_t highPart = nextPart++;
+    std::vector<size_t> separatorVertices;
+    for (size_t i = 0; i < count; ++i) {
+        const size_t v = vertices [i];
+        const size_t l = graph.level [v];
+        if (l < separator)
+            graph.part [v] = lowPart;
+        else if (l > separator)
+            graph.part [v] = highPart;
+        else {
+            graph.part [v] = UNVISITED;
+            separatorVertices.push_back (v);
+        }
+    }
+
+    resetLevels (graph);
+
+    /* Each part may contain several components, dissect them all */
+    for (size_t i = 0; i < count; ++i) {
+        const size_t v = vertices [i];
+        const size_t p = graph.part [v];
+        if (p == lowPart || p == highPart)
+            dissect (graph, v, p, nextPart);
+    }
+
+    graph.order->insert (graph.order->end(),
+                         separatorVertices.begin(),
+                         separatorVertices.end());
+}
+}
+
+const size_t SparseCholesky::INVALID_SLOT;
+
+/**
+ * Computes the lower trapezoid of B * B(0:width, :)^T, where B is the
+ * @a height x @a columns block at @a block (column-major, with the given
+ * @a stride), and stores it column-major in @a product.
+ *
+ * The product is computed in 4x4 tiles accumulated in registers, so each
+ * entry of B that is loaded feeds four multiply-adds.
+ */
+static void multiplyLower (const double* block, const size_t stride,
+                           const size_t columns, const size_t width,
+                           const size_t height, double* product) {
+    for (size_t j = 0; j < width; j += 4) {
+        const size_t tileWidth = std::min<size_t> (4, width - j);
+
+        for (size_t i = j; i < height; i += 4) {
+            const size_t tileHeight = std::min<size_t> (4, height - i);
+
+            double tile [4][4] = {};
+            if (tileWidth == 4 && tileHeight == 4) {
+                for (size_t k = 0; k < columns; ++k) {
+                    const double* b = block + k * stride;
+                    for (size_t c = 0; c < 4; ++c)
+                        for (size_t r = 0; r < 4; ++r)
+                            tile [c][r] += b [i + r] * b [j + c];
+                }
+            }
+
+            else {
+                for (size_t k = 0; k < columns; ++k) {
+                    const double* b = block + k * stride;
+                    for (size_t c = 0; c < tileWidth; ++c)
+                        for (size_t r = 0; r < tileHeight; ++r)
+                            tile [c][r] += b [i + r] * b [j + c];
+                }
+            }
+
+            for (size_t c = 0; c < tileWidth; ++c) {
+                double* target = product + (j + c) * height;
+                for (size_t r = 0; r < tileHeight; ++r)
+                    if (i + r >= j + c)
+                        target [i + r] = tile [c][r];
+            }
+        }
+    }
+}
+
+/**
+ * Creates an empty factorization, call @c analyze() before using it
+ */
+SparseCholesky::SparseCholesky() :
+    m_size (0),
+    m_factorized (false),
+    m_updateSize (0),
+    m_factorNonZeros (0) {}
+
+/**
+ * Performs the symbolic analysis of a symmetric matrix with @a size rows,
+ * given in compressed column format by @a pointers and @a indices. The
+ * pattern may contain one or both triangles and the diagonal is always
+ * assumed to be present.
+ *
+ * Returns @c false if the pattern is malformed.
+ */
+bool SparseCholesky::analyze (const size_t size,
+                              const std::vector<size_t>& pointers,
+                              const std::vector<size_t>& indices) {
+    m_size = size;
+    m_factorized = false;
+    m_pointers.clear();
+
+    if (pointers.size() != size + 1 || pointers [size] > indices.size())
+        return false;
+
+    for (size_t i = 0; i < pointers [size]; ++i)
+        if (indices [i] >= size)
+            return false;
+
+    /* Build the full symmetric adjacency without the diagonal */
+    std::vector<size_t> degree (size + 1, 0);
+    for (size_t j = 0; j < size; ++j) {
+        for (size_t p = pointers [j]; p < pointers [j + 1]; ++p) {
+            if (indices [p] != j) {
+                ++degree [j];
+                ++degree [indices [p]];
+            }
+        }
+    }
+
+    std::vector<size_t> adjPointers (size + 1, 0);
+    for (size_t j = 0; j < size; ++j)
+        adjPointers [j + 1] = adjPointers [j] + degree [j];
+
+    std::vector<size_t> adjIndices (adjPointers [size]);
+    std::vector<size_t> next (adjPointers.begin(), adjPointers.end() - 1);
+    for (size_t j = 0; j < size; ++j) {
+        for (size_t p = pointers [j]; p < pointers [j + 1]; ++p) {
+            const size_t i = indices [p];
+            if (i != j) {
+                adjIndices [next [j]++] = i;
+                adjIndices [next [i]++] = j;
+            }
+        }
+    }
+
+    order (adjPointers, adjIndices);
+
+    /* Upper triangle of the permuted matrix, with explicit diagonal */
+    std::fill (degree.begin(), degree.end(), 1);
+    for (size_t j = 0; j < size; ++j) {
+        for (size_t p = adjPointers [j]; p < adjPointers [j + 1]; ++p) {
+            const size_t i = adjIndices [p];
+            if (i < j)
+                ++degree [std::max (m_inverse [i], m_inverse [j])];
+        }
+    }
+
+    std::vector<size_t> upperPointers (size + 1, 0);
+    for (size_t j = 0; j < size; ++j)
+        upperPointers [j + 1] = upperPointers [j] + degree [j];
+
+    std::vector<size_t> upperIndices (upperPointers [size]);
+    next.assign (upperPointers.begin(), upperPointers.end() - 1);
+    for (size_t j = 0; j < size; ++j) {
+        const size_t pj = m_inverse [j];
+        upperIndices [next [pj]++] = pj;
+        for (size_t p = adjPointers [j]; p < adjPointers [j + 1]; ++p) {
+            const size_t i = adjIndices [p];
+            if (i < j) {
+                const size_t pi = m_inverse [i];
+                const size_t column = std::max (pi, pj);
+                upperIndices [next [column]++] = std::min (pi, pj);
+            }
+        }
+    }
+
+    for (size_t j = 0; j < size; ++j)
+        std::sort (upperIndices.begin() + upperPointers [j],
+                   upperIndices.begin() + upperPointers [j + 1]);
+
+    /* Elimination tree (with path compression through ancestors) */
+    std::vector<size_t> parent (size, UNVISITED);
+    std::vector<size_t> ancestor (size, UNVISITED);
+    for (size_t k = 0; k < size; ++k) {
+        for (size_t p = upperPointers [k]; p < upperPointers [k + 1]; ++p) {
+            size_t i = upperIndices [p];
+            while (i != UNVISITED && i < k) {
+                const size_t inext = ancestor [i];
+                ancestor [i] = k;
+                if (inext == UNVISITED)
+                    parent [i] = k;
+
+                i = inext;
+            }
+        }
+    }
+
+    /* Column counts of L from the row subtrees: the pattern of row k of L
+     * is the set of etree paths from the entries of column k up to k */
+    std::vector<size_t> counts (size, 1);
+    std::vector<size_t>& marks = ancestor;
+    std::fill (marks.begin(), marks.end(), UNVISITED);
+    for (size_t k = 0; k < size; ++k) {
+        marks [k] = k;
+        for (size_t p = upperPointers [k]; p < upperPointers [k + 1]; ++p) {
+            for (size_t i = upperIndices [p]; marks [i] != k; i = parent [i]) {
+                ++counts [i];
+                marks [i] = k;
+            }
+        }
+    }
+
+    /* Lower triangle of the permuted matrix (the transpose of the upper
+     * one), pointing back to the value slots of the upper triangle */
+    std::fill (degree.begin(), degree.end(), 0);
+    for (size_t p = 0; p < upperPointers [size]; ++p)
+        ++degree [upperIndices [p]];
+
+    m_lowerPointers.assign (size + 1, 0);
+    for (size_t j = 0; j < size; ++j)
+        m_lowerPointers [j + 1] = m_lowerPointers [j] + degree [j];
+
+    m_lowerIndices.resize (m_lowerPointers [size]);
+    m_lowerSlots.resize (m_lowerPointers [size]);
+    next.assign (m_lowerPointers.begin(), m_lowerPointers.end() - 1);
+    for (size_t j = 0; j < size; ++j) {
+        for (size_t p = upperPointers [j]; p < upperPointers [j + 1]; ++p) {
+            const size_t q = next [upperIndices [p]]++;
+            m_lowerIndices [q] = j;
+            m_lowerSlots [q] = p;
+        }
+    }
+
+    /* Fundamental supernodes: chains of columns with nested patterns */
+    std::vector<size_t> fundamental (1, 0);
+    for (size_t j = 1; j <= size; ++j)
+        if (j == size || parent [j - 1] != j || counts [j - 1] != counts [j] + 1)
+            fundamental.push_back (j);
+
+    /* Relaxed supernodes: merge small supernodes into their parent when it
+     * comes right after them and few explicit zeros are added, so that the
+     * numeric phase works on larger dense blocks */
+    m_superColumns.assign (1, 0);
+    size_t groupColumns = 0;
+    size_t groupNonZeros = 0;
+    for (size_t f = 0; f + 1 < fundamental.size(); ++f) {
+        const size_t first = fundamental [f];
+        const size_t columns = fundamental [f + 1] - first;
+        const size_t rows = counts [first];
+
+        size_t nonZeros = 0;
+        for (size_t j = first; j < first + columns; ++j)
+            nonZeros += counts [j];
+
+        if (groupColumns > 0) {
+            const size_t mergedColumns = groupColumns + columns;
+            const size_t mergedRows = groupColumns + rows;
+            const size_t mergedNonZeros = groupNonZeros + nonZeros;
+            const double dense = static_cast<double> (mergedRows * mergedColumns -
+                                                      mergedColumns * (mergedColumns - 1) / 2);
+            const double zeros = (dense - static_cast<double> (mergedNonZeros)) / dense;
+
+            const bool isParent = parent [first - 1] >= first &&
+                                  parent [first - 1] < first + columns;
+            const bool relax = mergedColumns <= 4 ||
+                               (mergedColumns <= 16 && zeros < 0.8) ||
+                               (mergedColumns <= 48 && zeros < 0.1) ||
+                               zeros < 0.05;
+
+            if (isParent && relax) {
+                groupColumns = mergedColumns;
+                groupNonZeros = mergedNonZeros;
+                continue;
+            }
+
+            m_superColumns.push_back (first);
+        }
+
+        groupColumns = columns;
+        groupNonZeros = nonZeros;
+    }
+
+    if (size > 0)
+        m_superColumns.push_back (size);
+
+    const size_t supernodes = m_superColumns.size() - 1;
+    m_columnSupernodes.assign (size, 0);
+    for (size_t s = 0; s < supernodes; ++s)
+        for (size_t j = m_superColumns [s]; j < m_superColumns [s + 1]; ++j)
+            m_columnSupernodes [j] = s;
+
+    /* Children of each supernode in the supernodal elimination tree */
+    std::vector<size_t> childPointers (supernodes + 1, 0);
+    std::vector<size_t> superParent (supernodes, UNVISITED);
+    for (size_t s = 0; s < supernodes; ++s) {
+        const size_t p = parent [m_superColumns [s + 1] - 1];
+        if (p != UNVISITED) {
+            superParent [s] = m_columnSupernodes [p];
+            ++childPointers [superParent [s] + 1];
+        }
+    }
+
+    for (size_t s = 0; s < supernodes; ++s)
+        childPointers [s + 1] += childPointers [s];
+
+    std::vector<size_t> children (childPointers [supernodes]);
+    next.assign (childPointers.begin(), childPointers.end() - 1);
+    for (size_t s = 0; s < supernodes; ++s)
+        if (superParent [s] != UNVISITED)
+            children [next [superParent [s]]++] = s;
+
+    /* Row patterns of the supernodes: their own columns, the entries of
+     * the matrix below them and the patterns of their children */
+    m_updateSize = 0;
+    m_factorNonZeros = 0;
+    m_rows.clear();
+    m_rowPointers.assign (supernodes + 1, 0);
+    m_valuePointers.assign (supernodes + 1, 0);
+    std::fill (marks.begin(), marks.end(), UNVISITED);
+    for (size_t s = 0; s < supernodes; ++s) {
+        const size_t first = m_superColumns [s];
+        const size_t last = m_superColumns [s + 1];
+        const size_t begin = m_rows.size();
+
+        for (size_t j = first; j < last; ++j) {
+            m_rows.push_back (j);
+            marks [j] = s;
+        }
+
+        for (size_t j = first; j < last; ++j) {
+            for (size_t p = m_lowerPointers [j]; p < m_lowerPointers [j + 1]; ++p) {
+                const size_t i = m_lowerIndices [p];
+                if (i >= last && marks [i] != s) {
+                    m_rows.push_back (i);
+                    marks [i] = s;
+                }
+            }
+        }
+
+        for (size_t c = childPointers [s]; c < childPointers [s + 1]; ++c) {
+            const size_t child = children [c];
+            for (size_t p = m_rowPointers [child]; p < m_rowPointers [child + 1]; ++p) {
+                const size_t i = m_rows [p];
+                if (i >= last && marks [i] != s) {
+                    m_rows.push_back (i);
+                    marks [i] = s;
+                }
+            }
+        }
+
+        std::sort (m_rows.begin() + static_cast<std::ptrdiff_t> (begin + last - first),
+                   m_rows.end());
+
+        const size_t columns = last - first;
+        const size_t rows = m_rows.size() - begin;
+        const size_t below = rows - columns;
+        m_rowPointers [s + 1] = m_rows.size();
+        m_valuePointers [s + 1] = m_valuePointers [s] + rows * columns;
+        m_updateSize = std::max (m_updateSize, below * below);
+        m_updateSize = std::max (m_updateSize, rows * PANEL_BLOCK);
+    }
+
+    for (size_t j = 0; j < size; ++j)
+        m_factorNonZeros += counts [j];
+
+    m_pointers.swap (upperPointers);
+    m_indices.swap (upperIndices);
+    m_factorValues.assign (m_valuePointers [supernodes], 0);
+    return true;
+}
+
+/**
+ * Computes the numeric factorization from @a values, which must hold
+ * @c valueCount() entries laid out as given by @c slot().
+ *
+ * Supernodes are processed in order (left-looking): each one gathers the
+ * updates of the supernodes below it as dense products, then its dense
+ * panel is factorized in place.
+ *
+ * Returns @c false if the matrix is not positive definite.
+ */
+bool SparseCholesky::factorize (const double* values) {
+    m_factorized = false;
+    if (!analyzed() || (!values && m_size > 0))
+        return false;
+
+    const size_t supernodes = m_superColumns.size() - 1;
+
+    std::vector<size_t> map (m_size);
+    std::vector<size_t> head (supernodes, UNVISITED);
+    std::vector<size_t> link (supernodes, UNVISITED);
+    std::vector<size_t> progress (supernodes, 0);
+    std::vector<double> update (m_updateSize);
+
+    for (size_t s = 0; s < supernodes; ++s) {
+        const size_t first = m_superColumns [s];
+        const size_t last = m_superColumns [s + 1];
+        const size_t columns = last - first;
+        const size_t rowCount = m_rowPointers [s + 1] - m_rowPointers [s];
+        const size_t* rows = &m_rows [m_rowPointers [s]];
+        double* panel = &m_factorValues [m_valuePointers [s]];
+
+        /* Scatter the columns of the matrix into the panel */
+        std::fill (panel, panel + rowCount * columns, 0.0);
+        for (size_t i = 0; i < rowCount; ++i)
+            map [rows [i]] = i;
+
+        for (size_t j = first; j < last; ++j) {
+            double* column = panel + (j - first) * rowCount;
+            for (size_t p = m_lowerPointers [j]; p < m_lowerPointers [j + 1]; ++p)
+                column [map [m_lowerIndices [p]]] = values [m_lowerSlots [p]];
+        }
+
+        /* Apply the updates of every descendant with rows in [first, last) */
+        size_t d = head [s];
+        while (d != UNVISITED) {
+            const size_t nextD = link [d];
+            const size_t dColumns = m_superColumns [d + 1] - m_superColumns [d];
+            const size_t dRowCount = m_rowPointers [d + 1] - m_rowPointers [d];
+            const size_t* dRows = &m_rows [m_rowPointers [d]];
+            const double* dPanel = &m_factorValues [m_valuePointers [d]];
+
+            const size_t start = progress [d];
+            size_t end = start;
+            while (end < dRowCount && dRows [end] < last)
+                ++end;
+
+            const size_t width = end - start;
+            const size_t height = dRowCount - start;
+
+            /* Lower part of L(start:, :) * L(start:end, :)^T */
+            multiplyLower (dPanel + start, dRowCount, dColumns, width, height,
+                           update.data());
+
+            for (size_t j = 0; j < width; ++j) {
+                double* column = panel + (dRows [start + j] - first) * rowCount;
+                const double* source = &update [j * height];
+                for (size_t i = j; i < height; ++i)
+                    column [map [dRows [start + i]]] -= source [i];
+            }
+
+            /* Move the descendant to the supernode of its next row */
+            progress [d] = end;
+            if (end < dRowCount) {
+                const size_t target = m_columnSupernodes [dRows [end]];
+                link [d] = head [target];
+                head [target] = d;
+            }
+
+            d = nextD;
+        }
+
+        /* Dense Cholesky factorization of the panel, by blocks of columns:
+         * each block is updated by the columns on its left with a single
+         * product, then factorized column by column */
+        for (size_t j = 0; j < columns; j += PANEL_BLOCK) {
+            const size_t width = std::min (PANEL_BLOCK, columns - j);
+            const size_t height = rowCount - j;
+            if (j > 0) {
+                multiplyLower (panel + j, rowCount, j, width, height, update.data());
+                for (size_t c = 0; c < width; ++c) {
+                    double* column = panel + (j + c) * rowCount + j;
+                    const double* source = &update [c * height];
+                    for (size_t i = c; i < height; ++i)
+                        column [i] -= source [i];
+                }
+            }
+
+            for (size_t c = j; c < j + width; ++c) {
+                double* column = panel + c * rowCount;
+                for (size_t k = j; k < c; ++k) {
+                    const double* previous = panel + k * rowCount;
+                    const double factor = previous [c];
+                    for (size_t i = c; i < rowCount; ++i)
+                        column [i] -= previous [i] * factor;
+                }
+
+                const double pivot = column [c];
+                if (!(pivot > 0))
+                    return false;
+
+                column [c] = sqrt (pivot);
+                const double scale = 1 / column [c];
+                for (size_t i = c + 1; i < rowCount; ++i)
+                    column [i] *= scale;
+            }
+        }
+
+        progress [s] = columns;
+        if (columns < rowCount) {
+            const size_t target = m_columnSupernodes [rows [columns]];
+            link [s] = head [target];
+            head [target] = s;
+        }
+    }
+
+    m_factorized = true;
+    return true;
+}
+
+/**
+ * Solves A x = b in place (@a x holds b on input), in the original
+ * ordering of the matrix. Does nothing if the matrix is not factorized
+ */
+void SparseCholesky::solve (double* x) const {
+    if (!m_factorized || !x)
+        return;
+
+    std::vector<double> y (m_size);
+    for (size_t i = 0; i < m_size; ++i)
+        y [m_inverse [i]] = x [i];
+
+    const size_t supernodes = m_superColumns.size() - 1;
+
+    /* L y = b */
+    for (size_t s = 0; s < supernodes; ++s) {
+        const size_t first = m_superColumns [s];
+        const size_t columns = m_superColumns [s + 1] - first;
+        const size_t rowCount = m_rowPointers [s + 1] - m_rowPointers [s];
+        const size_t* rows = &m_rows [m_rowPointers [s]];
+        const double* panel = &m_factorValues [m_valuePointers [s]];
+
+        for (size_t j = 0; j < columns; ++j) {
+            const double* column = panel + j * rowCount;
+            const double value = y [first + j] / column [j];
+            y [first + j] = value;
+            for (size_t i = j + 1; i < rowCount; ++i)
+                y [rows [i]] -= column [i] * value;
+        }
+    }
+
+    /* L^T x = y */
+    for (size_t s = supernodes; s-- > 0;) {
+        const size_t first = m_superColumns [s];
+        const size_t columns = m_superColumns [s + 1] - first;
+        const size_t rowCount = m_rowPointers [s + 1] - m_rowPointers [s];
+        const size_t* rows = &m_rows [m_rowPointers [s]];
+        const double* panel = &m_factorValues [m_valuePointers [s]];
+
+        for (size_t j = columns; j-- > 0;) {
+            const double* column = panel + j * rowCount;
+            double sum = y [first + j];
+            for (size_t i = j + 1; i < rowCount; ++i)
+                sum -= column [i] * y [rows [i]];
+
+            y [first + j] = sum / column [j];
+        }
+    }
+
+    for (size_t i = 0; i < m_size; ++i)
+        x [i] = y [m_inverse [i]];
+}
+
+/**
+ * Returns the number of rows (and columns) of the analyzed matrix
+ */
+size_t SparseCholesky::size() const {
+    return m_size;
+}
+
+/**
+ * Returns the number of values expected by @c factorize()
+ */
+size_t SparseCholesky::valueCount() const {
+    return m_pointers.empty() ? 0 : m_pointers [m_size];
+}
+
+/**
+ * Returns the number of nonzeros of L, including the diagonal
+ */
+size_t SparseCholesky::factorNonZeros() const {
+    return m_factorNonZeros;
+}
+
+/**
+ * Returns the number of supernodes (dense column blocks) of L
+ */
+size_t SparseCholesky::supernodeCount() const {
+    return m_superColumns.empty() ? 0 : m_superColumns.size() - 1;
+}
+
+/**
+ * Returns the position in the value array of entry (@a row, @a column)
+ * of the original matrix, or @c INVALID_SLOT if the entry is not part of
+ * the analyzed pattern
+ */
+size_t SparseCholesky::slot (const size_t row, const size_t column) const {
+    if (!analyzed() || row >= m_size || column >= m_size)
+        return INVALID_SLOT;
+
+    const size_t pi = m_inverse [row];
+    const size_t pj = m_inverse [column];
+    const size_t i = std::min (pi, pj);
+    const size_t j = std::max (pi, pj);
+
+    const std::vector<size_t>::const_iterator begin = m_indices.begin() + m_pointers [j];
+    const std::vector<size_t>::const_iterator end = m_indices.begin() + m_pointers [j + 1];
+    const std::vector<size_t>::const_iterator it = std::lower_bound (begin, end, i);
+    if (it == end || *it != i)
+        return INVALID_SLOT;
+
+    return static_cast<size_t> (it - m_indices.begin());
+}
+
+/**
+ * Returns @c true if @c analyze() succeeded
+ */
+bool SparseCholesky::analyzed() const {
+    return !m_pointers.empty();
+}
+
+/**
+ * Returns @c true if the last call to @c factorize() succeeded
+ */
+bool SparseCholesky::factorized() const {
+    return m_factorized;
+}
+
+/**
+ * Computes the nested dissection permutation of the adjacency graph
+ */
+void SparseCholesky::order (const std::vector<size_t>& pointers,
+                            const std::vector<size_t>& indices) {
+    Graph graph;
+    graph.pointers = &pointers;
+    graph.indices = &indices;
+    graph.part.assign (m_size, 0);
+    graph.level.assign (m_size, UNVISITED);
+    graph.order = &m_permutation;
+
+    m_permutation.clear();
+    m_permutation.reserve (m_size);
+
+    size_t nextPart = 1;
+    for (size_t v = 0; v < m_size; ++v)
+        if (graph.part [v] == 0)
+            dissect (graph, v, 0, nextPart);
+
+    m_inverse.assign (m_size, 0);
+    for (size_t i = 0; i < m_size; ++i)
+        m_inverse [m_permutation [i]] = i;
+}
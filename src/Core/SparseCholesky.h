@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_SPARSE_CHOLESKY_H
+#define RESISTOR_SPARSE_CHOLESKY_H
+
+#include <vector>
+#include <stddef.h>
+
+namespace ResistorCore
+{
+
+/**
+ * Sparse Cholesky factorization (A = L L^T) of symmetric positive
+ * definite matrices.
+ *
+ * The work is split in two phases:
+ *
+ * - @c analyze() only looks at the nonzero pattern of the matrix. It
+ *   computes a fill-reducing nested dissection ordering (separators of
+ *   breadth-first level structures), the elimination tree, the pattern of
+ *   L and its supernodes (groups of columns with the same pattern).
+ * - @c factorize() computes the values of L with a left-looking
+ *   supernodal algorithm, which works on dense blocks, and can be called
+ *   again with new values as long as the pattern does not change, so
+ *   parameter sweeps only pay for the numeric phase.
+ *
+ * Values are given for the upper triangle of the permuted matrix, use
+ * @c slot() to find where each entry of the original matrix goes.
+ */
+class SparseCholesky
+{
+public:
+    static const size_t INVALID_SLOT = static_cast<size_t> (-1);
+
+    SparseCholesky();
+
+    bool analyze (const size_t size,
+                  const std::vector<size_t>& pointers,
+                  const std::vector<size_t>& indices);
+    bool factorize (const double* values);
+    void solve (double* x) const;
+
+    size_t size() const;
+    size_t valueCount() const;
+    size_t factorNonZeros() const;
+    size_t supernodeCount() const;
+    size_t slot (const size_t row, const size_t column) const;
+
+    bool analyzed() const;
+    bool factorized() const;
+
+private:
+    void order (const std::vector<size_t>& pointers,
+                const std::vector<size_t>& indices);
+
+private:
+    size_t m_size;
+    bool m_factorized;
+    size_t m_updateSize;
+    size_t m_factorNonZeros;
+
+    std::vector<size_t> m_permutation;
+    std::vector<size_t> m_inverse;
+
+    std::vector<size_t> m_pointers;
+    std::vector<size_t> m_indices;
+    std::vector<size_t> m_lowerPointers;
+    std::vector<size_t> m_lowerIndices;
+    std::vector<size_t> m_lowerSlots;
+
+    std::vector<size_t> m_superColumns;
+    std::vector<size_t> m_columnSupernodes;
+    std::vector<size_t> m_rowPointers;
+    std::vector<size_t> m_rows;
+    std::vector<size_t> m_valuePointers;
+    std::vector<double> m_factorValues;
+};
+
+}
+
+#endif
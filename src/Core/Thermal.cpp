@@ -0,0 +1,610 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Thermal.h"
+#include "BatchExecutor.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <assert.h>
+#include <algorithm>
+
+using namespace ResistorCore;
+
+const double ThermalModel::KELVIN_OFFSET = 273.15;
+const double ThermalModel::REFERENCE_TEMPERATURE = 25;
+
+/**
+ * Largest number of unknowns of the least squares fits
+ */
+static const size_t MAX_UNKNOWNS = 3;
+
+/**
+ * Columns whose norm drops below this fraction of their original norm
+ * after orthogonalization are considered linearly dependent
+ */
+static const double RANK_TOLERANCE = 1e-12;
+
+/**
+ * Steinhart-Hart cubic coefficients at or below this fraction of the linear
+ * one are treated as a small correction to the C = 0 solution rather than
+ * solved with Cardano's formula
+ */
+static const double CUBIC_TOLERANCE = 1e-9;
+
+/**
+ * Newton steps refining the inverse Steinhart-Hart solution; the start is
+ * close enough for quadratic convergence to reach double precision
+ */
+static const int NEWTON_STEPS = 4;
+
+/**
+ * Returns the absolute temperature of the given @a celsius value
+ */
+static inline double kelvin (const double celsius) {
+    return celsius + ThermalModel::KELVIN_OFFSET;
+}
+
+/**
+ * Returns @c true if the points can be used to fit a model, i.e. they are
+ * finite, above absolute zero and have positive resistances
+ */
+static bool validPoints (const ThermalPoint* points, const size_t count) {
+    if (!points)
+        return false;
+
+    for (size_t i = 0; i < count; ++i) {
+        if (!isfinite (points [i].temperature) || !isfinite (points [i].resistance))
+            return false;
+        if (kelvin (points [i].temperature) <= 0 || points [i].resistance <= 0)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Solves the least squares problem min |A x - y| for the @a rows x
+ * @a unknowns matrix A given column by column in @a columns, with a QR
+ * decomposition by modified Gram-Schmidt (the columns are overwritten).
+ * Returns @c false if the columns are linearly dependent
+ */
+static bool leastSquares (double* columns, const double* y, const size_t rows,
+                          const size_t unknowns, double* x) {
+    assert (unknowns <= MAX_UNKNOWNS);
+
+    double r [MAX_UNKNOWNS][MAX_UNKNOWNS] = {};
+    double qty [MAX_UNKNOWNS];
+    std::vector<double> residual (y, y + rows);
+
+    for (size_t j = 0; j < unknowns; ++j) {
+        double* column = columns + j * rows;
+
+        double original = 0;
+        for (size_t i = 0; i < rows; ++i)
+            original += column [i] * column [i];
+
+        for (size_t k = 0; k < j; ++k) {
+            const double* q = columns + k * rows;
+            double dot = 0;
+            for (size_t i = 0; i < rows; ++i)
+                dot += q [i] * column [i];
+
+            r [k][j] = dot;
+            for (size_t i = 0; i < rows; ++i)
+                column [i] -= dot * q [i];
+        }
+
+        double norm = 0;
+        for (size_t i = 0; i < rows; ++i)
+            norm += column [i] * column [i];
+
+        norm = sqrt (norm);
+        if (!(norm > RANK_TOLERANCE * sqrt (original)))
+            return false;
+
+        r [j][j] = norm;
+        for (size_t i = 0; i < rows; ++i)
+            column [i] /= norm;
+
+        double dot = 0;
+        for (size_t i = 0; i < rows; ++i)
+            dot += column [i] * residual [i];
+
+        qty [j] = dot;
+        for (size_t i = 0; i < rows; ++i)
+            residual [i] -= dot * column [i];
+    }
+
+    for (size_t j = unknowns; j-- > 0;) {
+        double sum = qty [j];
+        for (size_t k = j + 1; k < unknowns; ++k)
+            sum -= r [j][k] * x [k];
+
+        x [j] = sum / r [j][j];
+    }
+
+    return true;
+}
+
+/**
+ * Creates a linear model of a 1 ohm resistor without temperature drift
+ */
+ThermalModel::ThermalModel() :
+    m_type (ThermalLinear),
+    m_nominal (1),
+    m_reference (REFERENCE_TEMPERATURE),
+    m_alpha (0),
+    m_beta (0) {
+    m_coefficients [0] = 0;
+    m_coefficients [1] = 0;
+    m_coefficients [2] = 0;
+}
+
+/**
+ * Returns a linear model with the given @a nominal resistance at the
+ * @a reference temperature and a temperature coefficient of @a ppm
+ * parts per million per kelvin
+ */
+ThermalModel ThermalModel::linear (const double nominal,
+                                   const double ppm,
+                                   const double reference) {
+    ThermalModel model;
+    model.m_type = ThermalLinear;
+    model.m_nominal = nominal;
+    model.m_reference = reference;
+    model.m_alpha = ppm * 1e-6;
+    return model;
+}
+
+/**
+ * Returns a beta model with the given @a nominal resistance at the
+ * @a reference temperature (R25 and 25 °C in most datasheets)
+ */
+ThermalModel ThermalModel::beta (const double nominal,
+                                 const double beta,
+                                 const double reference) {
+    ThermalModel model;
+    model.m_type = ThermalBeta;
+    model.m_nominal = nominal;
+    model.m_reference = reference;
+    model.m_beta = beta;
+    return model;
+}
+
+/**
+ * Returns a Steinhart-Hart model with the given coefficients, for
+ * resistances in ohms and absolute temperatures
+ */
+ThermalModel ThermalModel::steinhartHart (const double a,
+                                          const double b,
+                                          const double c) {
+    ThermalModel model;
+    model.m_type = ThermalSteinhartHart;
+    model.m_coefficients [0] = a;
+    model.m_coefficients [1] = b;
+    model.m_coefficients [2] = c;
+    model.m_nominal = model.resistance (REFERENCE_TEMPERATURE);
+    return model;
+}
+
+/**
+ * Returns the linear model of a resistor from its bands. Only six-band
+ * resistors have a tempco band, other resistors are modeled without
+ * temperature drift
+ */
+ThermalModel ThermalModel::fromBands (const BandCode& code) {
+    const double ppm = code.type == SixStripResistor ? tempcoValue (code.tempco) : 0;
+    return linear (decodeBands (code).resistance, ppm);
+}
+
+/**
+ * Fits a linear model to the given measured @a points by least squares.
+ * At least two points at different temperatures are needed
+ */
+bool ThermalModel::fitLinear (const ThermalPoint* points,
+                              const size_t count,
+                              ThermalModel* model,
+                              const double reference) {
+    if (!model || count < 2 || !validPoints (points, count))
+        return false;
+
+    // R = R0 + R0 alpha (T - T0)
+    std::vector<double> columns (2 * count);
+    std::vector<double> y (count);
+    for (size_t i = 0; i < count; ++i) {
+        columns [i] = 1;
+        columns [count + i] = points [i].temperature - reference;
+        y [i] = points [i].resistance;
+    }
+
+    double x [2];
+    if (!leastSquares (columns.data(), y.data(), count, 2, x) || !(x [0] > 0))
+        return false;
+
+    *model = linear (x [0], x [1] / x [0] * 1e6, reference);
+    return true;
+}
+
+/**
+ * Fits a beta model to the given measured @a points by least squares on
+ * the logarithm of the resistance. At least two points at different
+ * temperatures are needed
+ */
+bool ThermalModel::fitBeta (const ThermalPoint* points,
+                            const size_t count,
+                            ThermalModel* model,
+                            const double reference) {
+    if (!model || count < 2 || !validPoints (points, count) || kelvin (reference) <= 0)
+        return false;
+
+    // ln R = ln R0 + beta (1/T - 1/T0)
+    std::vector<double> columns (2 * count);
+    std::vector<double> y (count);
+    for (size_t i = 0; i < count; ++i) {
+        columns [i] = 1;
+        columns [count + i] = 1 / kelvin (points [i].temperature) - 1 / kelvin (reference);
+        y [i] = log (points [i].resistance);
+    }
+
+    double x [2];
+    if (!leastSquares (columns.data(), y.data(), count, 2, x))
+        return false;
+
+    *model = beta (exp (x [0]), x [1], reference);
+    return true;
+}
+
+/**
+ * Fits the Steinhart-Hart coefficients to the given measured @a points by
+ * least squares on the inverse of the absolute temperature. At least
+ * three points with different resistances are needed, three points give
+ * the exact coefficients
+ */
+bool ThermalModel::fitSteinhartHart (const ThermalPoint* points,
+                                     const size_t count,
+                                     ThermalModel* model) {
+    if (!model || count < 3 || !validPoints (points, count))
+        return false;
+
+    // 1/T = A + B ln R + C (ln R)^3
+    std::vector<double> columns (3 * count);
+    std::vector<double> y (count);
+    for (size_t i = 0; i < count; ++i) {
+        const double l = log (points [i].resistance);
+        columns [i] = 1;
+        columns [count + i] = l;
+        columns [2 * count + i] = l * l * l;
+        y [i] = 1 / kelvin (points [i].temperature);
+    }
+
+    double x [3];
+    if (!leastSquares (columns.data(), y.data(), count, 3, x))
+        return false;
+
+    *model = steinhartHart (x [0], x [1], x [2]);
+    return true;
+}
+
+/**
+ * Returns the type of the model
+ */
+ThermalModelType ThermalModel::type() const {
+    return m_type;
+}
+
+/**
+ * Returns the resistance at the reference temperature
+ */
+double ThermalModel::nominal() const {
+    return m_nominal;
+}
+
+/**
+ * Returns the reference temperature of the linear and beta models
+ */
+double ThermalModel::reference() const {
+    return m_reference;
+}
+
+/**
+ * Returns the temperature coefficient of the linear model, in ppm/K
+ */
+double ThermalModel::ppm() const {
+    return m_alpha * 1e6;
+}
+
+/**
+ * Returns the beta value of the beta model, in kelvin
+ */
+double ThermalModel::betaValue() const {
+    return m_beta;
+}
+
+/**
+ * Returns the Steinhart-Hart coefficient A (0), B (1) or C (2)
+ */
+double ThermalModel::coefficient (const int index) const {
+    assert (index >= 0 && index < 3);
+    return m_coefficients [index];
+}
+
+/**
+ * Returns the resistance at the given @a temperature
+ */
+double ThermalModel::resistance (const double temperature) const {
+    double value;
+    sweep (&temperature, &value, 1);
+    return value;
+}
+
+/**
+ * Returns the temperature at which the model has the given
+ * @a resistance, or NaN if there is no such temperature
+ */
+double ThermalModel::temperature (const double resistance) const {
+    if (!(resistance > 0))
+        return NAN;
+
+    switch (m_type) {
+    case ThermalLinear:
+        return m_alpha != 0 ? m_reference + (resistance / m_nominal - 1) / m_alpha : NAN;
+    case ThermalBeta:
+        return m_beta != 0 ? 1 / (1 / kelvin (m_reference) + log (resistance / m_nominal) / m_beta) -
+               KELVIN_OFFSET : NAN;
+    case ThermalSteinhartHart: {
+        const double l = log (resistance);
+        return 1 / (m_coefficients [0] + m_coefficients [1] * l + m_coefficients [2] * l * l * l) -
+               KELVIN_OFFSET;
+    }
+    }
+
+    return NAN;
+}
+
+/**
+ * Evaluates the model at @a count temperatures. The model type is
+ * resolved once, so each loop only contains the arithmetic of its model
+ * and can be vectorized by the compiler
+ */
+void ThermalModel::sweep (const double* temperatures,
+                          double* resistances,
+                          const size_t count) const {
+    assert (temperatures != NULL || count == 0);
+    assert (resistances != NULL || count == 0);
+
+    switch (m_type) {
+    case ThermalLinear: {
+        const double slope = m_nominal * m_alpha;
+        const double offset = m_nominal - slope * m_reference;
+        for (size_t i = 0; i < count; ++i)
+            resistances [i] = offset + slope * temperatures [i];
+        break;
+    }
+    case ThermalBeta: {
+        const double inverseReference = 1 / kelvin (m_reference);
+        for (size_t i = 0; i < count; ++i)
+            resistances [i] = m_nominal * exp (m_beta * (1 / kelvin (temperatures [i]) -
+                                                         inverseReference));
+        break;
+    }
+    case ThermalSteinhartHart: {
+        // Solve C x^3 + B x + (A - 1/T) = 0 for x = ln R. Cardano's formula
+        // needs C > 0 and cancels badly as C vanishes, so a negligible or
+        // negative cubic term starts from the C = 0 solution instead; both
+        // starts are then polished by Newton steps on the cubic
+        const double a = m_coefficients [0];
+        const double b = m_coefficients [1];
+        const double c = m_coefficients [2];
+        if (c == 0) {
+            for (size_t i = 0; i < count; ++i)
+                resistances [i] = exp ((1 / kelvin (temperatures [i]) - a) / b);
+        }
+
+        else if (c > CUBIC_TOLERANCE * fabs (b)) {
+            const double p = b / (3 * c);
+            const double p3 = p * p * p;
+            for (size_t i = 0; i < count; ++i) {
+                const double inverse = 1 / kelvin (temperatures [i]);
+                const double y = (a - inverse) / c;
+                const double x = sqrt (p3 + y * y / 4);
+                double l = cbrt (x - y / 2) - cbrt (x + y / 2);
+                for (int step = 0; step < NEWTON_STEPS; ++step)
+                    l -= ((c * l * l + b) * l + a - inverse) / (3 * c * l * l + b);
+                resistances [i] = exp (l);
+            }
+        }
+
+        else {
+            for (size_t i = 0; i < count; ++i) {
+                const double inverse = 1 / kelvin (temperatures [i]);
+                double l = (inverse - a) / b;
+                for (int step = 0; step < NEWTON_STEPS; ++step)
+                    l -= ((c * l * l + b) * l + a - inverse) / (3 * c * l * l + b);
+                resistances [i] = exp (l);
+            }
+        }
+        break;
+    }
+    }
+}
+
+/**
+ * Returns the smallest interval that contains the resistance of every
+ * part of this model with the given relative @a tolerance over the
+ * given temperature range.
+ *
+ * The tempco band only gives the largest coefficient of a resistor, not
+ * its sign, so linear models drift by up to ± alpha. Beta and
+ * Steinhart-Hart models are monotonic and use their actual curve.
+ */
+Interval ThermalModel::bounds (const double minTemperature,
+                               const double maxTemperature,
+                               const double tolerance) const {
+    const double low = std::min (minTemperature, maxTemperature);
+    const double high = std::max (minTemperature, maxTemperature);
+    const Interval spread (1 - fabs (tolerance), 1 + fabs (tolerance));
+
+    if (m_type == ThermalLinear) {
+        const double deltaT = std::max (fabs (low - m_reference), fabs (high - m_reference));
+        const double drift = fabs (m_alpha) * deltaT;
+        return Interval (m_nominal) * spread * Interval (1 - drift, 1 + drift);
+    }
+
+    const double a = resistance (low);
+    const double b = resistance (high);
+    return Interval (std::min (a, b), std::max (a, b)) * spread;
+}
+
+/**
+ * Writes @a count evenly spaced temperatures from @a minTemperature to
+ * @a maxTemperature (both included) to @a temperatures
+ */
+void ResistorCore::temperatureSteps (const double minTemperature,
+                                     const double maxTemperature,
+                                     const size_t count,
+                                     double* temperatures) {
+    assert (temperatures != NULL || count == 0);
+
+    const double step = count > 1 ? (maxTemperature - minTemperature) / static_cast<double> (count - 1) : 0;
+    for (size_t i = 0; i < count; ++i)
+        temperatures [i] = minTemperature + step * static_cast<double> (i);
+
+    if (count > 1)
+        temperatures [count - 1] = maxTemperature;
+}
+
+/**
+ * Evaluates @a modelCount models at the same @a count temperatures. The
+ * curve of model m is written to <tt>resistances[m * count ...]</tt>.
+ *
+ * If an @a executor is given, the models are distributed among its
+ * threads. Returns @c false if the executor was cancelled.
+ */
+bool ResistorCore::sweepBatch (const ThermalModel* models,
+                               const size_t modelCount,
+                               const double* temperatures,
+                               const size_t count,
+                               double* resistances,
+                               BatchExecutor* executor) {
+    assert (models != NULL || modelCount == 0);
+
+    const BatchExecutor::Task task = [&] (const size_t begin, const size_t end) {
+        for (size_t m = begin; m < end; ++m)
+            models [m].sweep (temperatures, resistances + m * count, count);
+    };
+
+    if (!executor || modelCount < 2) {
+        task (0, modelCount);
+        return true;
+    }
+
+    return executor->run (modelCount, modelCount / (executor->threadCount() * 8), task);
+}
+
+/**
+ * Builds a fixed-point R(T) table with @a entries values from
+ * @a minTemperature to @a maxTemperature.
+ *
+ * A negative number of @a fractionalBits selects the largest number of
+ * fractional bits for which every value fits in 32 bits. Returns
+ * @c false if a value is negative, not finite or does not fit.
+ */
+bool ResistorCore::buildLookupTable (const ThermalModel& model,
+                                     const double minTemperature,
+                                     const double maxTemperature,
+                                     const size_t entries,
+                                     const int fractionalBits,
+                                     FixedPointTable* table) {
+    assert (table != NULL);
+
+    if (entries == 0 || fractionalBits > 31)
+        return false;
+
+    std::vector<double> temperatures (entries);
+    std::vector<double> resistances (entries);
+    temperatureSteps (minTemperature, maxTemperature, entries, temperatures.data());
+    model.sweep (temperatures.data(), resistances.data(), entries);
+
+    double largest = 0;
+    for (size_t i = 0; i < entries; ++i) {
+        if (!isfinite (resistances [i]) || resistances [i] < 0)
+            return false;
+
+        largest = std::max (largest, resistances [i]);
+    }
+
+    int bits = fractionalBits;
+    if (bits < 0) {
+        bits = 31;
+        while (bits > 0 && ldexp (largest, bits) + 0.5 > UINT32_MAX)
+            --bits;
+    }
+
+    std::vector<uint32_t> values (entries);
+    for (size_t i = 0; i < entries; ++i) {
+        const double scaled = floor (ldexp (resistances [i], bits) + 0.5);
+        if (scaled > UINT32_MAX)
+            return false;
+
+        values [i] = static_cast<uint32_t> (scaled);
+    }
+
+    table->minTemperature = minTemperature;
+    table->step = entries > 1 ? (maxTemperature - minTemperature) / static_cast<double> (entries - 1) : 0;
+    table->fractionalBits = bits;
+    table->values.swap (values);
+    return true;
+}
+
+/**
+ * Returns the C source code of a @c uint32_t array with the given
+ * @a name that holds the values of the @a table
+ */
+std::string ResistorCore::lookupTableSource (const FixedPointTable& table,
+                                             const std::string& name) {
+    const size_t count = table.values.size();
+    const double maxTemperature = table.minTemperature + table.step * static_cast<double> (count > 0 ? count - 1 : 0);
+
+    char buffer [256];
+    snprintf (buffer, sizeof (buffer),
+              "/*\n"
+              " * R(T) lookup table, %zu entries from %g degC to %g degC in steps of %g degC.\n"
+              " * Values are resistances in ohms with %d fractional bits (divide by %.0f).\n"
+              " */\n"
+              "static const uint32_t %s [%zu] = {",
+              count, table.minTemperature, maxTemperature, table.step,
+              table.fractionalBits, ldexp (1, table.fractionalBits),
+              name.c_str(), count);
+
+    std::string source (buffer);
+    for (size_t i = 0; i < count; ++i) {
+        snprintf (buffer, sizeof (buffer), "%s%u%s",
+                  i % 8 == 0 ? "\n    " : " ",
+                  static_cast<unsigned> (table.values [i]),
+                  i + 1 < count ? "," : "\n");
+        source += buffer;
+    }
+
+    source += "};\n";
+    return source;
+}
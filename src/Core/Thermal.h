@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_THERMAL_H
+#define RESISTOR_THERMAL_H
+
+#include <string>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Interval.h"
+#include "ResistorCore.h"
+
+namespace ResistorCore
+{
+
+class BatchExecutor;
+
+enum ThermalModelType {
+    ThermalLinear        = 0,
+    ThermalBeta          = 1,
+    ThermalSteinhartHart = 2
+};
+
+/**
+ * Measured resistance (ohms) at a given temperature (°C)
+ */
+struct ThermalPoint {
+    double temperature;
+    double resistance;
+};
+
+/**
+ * Resistance as a function of temperature. Temperatures are given in
+ * degrees Celsius.
+ *
+ * - Linear: R(T) = R0 (1 + alpha (T - T0)), used for regular resistors,
+ *   alpha comes from the tempco band in ppm/K.
+ * - Beta: R(T) = R0 exp (beta (1/T - 1/T0)) with absolute temperatures,
+ *   used for NTC thermistors (positive beta) and PTCs (negative beta).
+ * - Steinhart-Hart: 1/T = A + B ln R + C (ln R)^3, for thermistors over
+ *   wide temperature ranges.
+ *
+ * The models can be fitted from measured points by least squares.
+ */
+class ThermalModel
+{
+public:
+    static const double KELVIN_OFFSET;
+    static const double REFERENCE_TEMPERATURE;
+
+    ThermalModel();
+
+    static ThermalModel linear (const double nominal,
+                                const double ppm,
+                                const double reference = REFERENCE_TEMPERATURE);
+    static ThermalModel beta (const double nominal,
+                              const double beta,
+                              const double reference = REFERENCE_TEMPERATURE);
+    static ThermalModel steinhartHart (const double a,
+                                       const double b,
+                                       const double c);
+    static ThermalModel fromBands (const BandCode& code);
+
+    static bool fitLinear (const ThermalPoint* points,
+                           const size_t count,
+                           ThermalModel* model,
+                           const double reference = REFERENCE_TEMPERATURE);
+    static bool fitBeta (const ThermalPoint* points,
+                         const size_t count,
+                         ThermalModel* model,
+                         const double reference = REFERENCE_TEMPERATURE);
+    static bool fitSteinhartHart (const ThermalPoint* points,
+                                  const size_t count,
+                                  ThermalModel* model);
+
+    ThermalModelType type() const;
+    double nominal() const;
+    double reference() const;
+    double ppm() const;
+    double betaValue() const;
+    double coefficient (const int index) const;
+
+    double resistance (const double temperature) const;
+    double temperature (const double resistance) const;
+    void sweep (const double* temperatures,
+                double* resistances,
+                const size_t count) const;
+
+    Interval bounds (const double minTemperature,
+                     const double maxTemperature,
+                     const double tolerance = 0) const;
+
+private:
+    ThermalModelType m_type;
+    double m_nominal;
+    double m_reference;
+    double m_alpha;
+    double m_beta;
+    double m_coefficients [3];
+};
+
+/**
+ * R(T) table in unsigned fixed point, for firmware. Entry i is the
+ * resistance at @c minTemperature + i * @c step, multiplied by
+ * 2^@c fractionalBits and rounded to the nearest integer
+ */
+struct FixedPointTable {
+    double minTemperature;
+    double step;
+    int fractionalBits;
+    std::vector<uint32_t> values;
+};
+
+void temperatureSteps (const double minTemperature,
+                       const double maxTemperature,
+                       const size_t count,
+                       double* temperatures);
+
+bool sweepBatch (const ThermalModel* models,
+                 const size_t modelCount,
+                 const double* temperatures,
+                 const size_t count,
+                 double* resistances,
+                 BatchExecutor* executor = NULL);
+
+bool buildLookupTable (const ThermalModel& model,
+                       const double minTemperature,
+                       const double maxTemperature,
+                       const size_t entries,
+                       const int fractionalBits,
+                       FixedPointTable* table);
+
+std::string lookupTableSource (const FixedPointTable& table,
+                               const std::string& name);
+
+}
+
+#endif
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "WorstCase.h"
+
+#include <math.h>
+#include <assert.h>
+#include <algorithm>
+
+using namespace ResistorCore;
+
+/**
+ * Returns the range of values of a @a part between @a minTemperature
+ * and @a maxTemperature. The tolerance of normal distributions is their
+ * 3-sigma range, so the few parts beyond it are not covered.
+ */
+Interval ResistorCore::partInterval (const MonteCarloPart& part,
+                                     const double minTemperature,
+                                     const double maxTemperature) {
+    const double deltaT = std::max (fabs (minTemperature - MonteCarloEngine::REFERENCE_TEMPERATURE),
+                                    fabs (maxTemperature - MonteCarloEngine::REFERENCE_TEMPERATURE));
+    const double drift = fabs (part.tempco) * 1e-6 * deltaT;
+
+    return Interval::fromTolerance (part.nominal, part.tolerance) * Interval (1 - drift, 1 + drift);
+}
+
+/**
+ * Calculates the worst-case bounds of the output of a network with
+ * interval arithmetic, and the sensitivity of the output to each part
+ * with dual numbers (a single evaluation gives every derivative).
+ *
+ * Returns @c false if the number of parts is not valid for the model.
+ */
+bool ResistorCore::analyzeWorstCase (const NetworkModel model,
+                                     const MonteCarloPart* parts,
+                                     const size_t count,
+                                     const double minTemperature,
+                                     const double maxTemperature,
+                                     WorstCaseReport* report) {
+    assert (report != NULL);
+    assert (parts != NULL || count == 0);
+
+    const size_t maxParts = MonteCarloEngine::MAX_PARTS;
+    const bool twoParts = model == ModelDivider ||
+                          model == ModelInvertingGain ||
+                          model == ModelNonInvertingGain;
+    if (count == 0 || count > maxParts || (twoParts && count != 2))
+        return false;
+
+    // Get the bounds of the output
+    Interval intervals [maxParts];
+    for (size_t p = 0; p < count; ++p)
+        intervals [p] = partInterval (parts [p], minTemperature, maxTemperature);
+
+    report->bounds = networkOutput (model, intervals, count);
+
+    // Get the nominal output and its gradient
+    Dual<maxParts> duals [maxParts];
+    for (size_t p = 0; p < count; ++p)
+        duals [p] = Dual<maxParts>::variable (parts [p].nominal, p);
+
+    const Dual<maxParts> output = networkOutput (model, duals, count);
+    report->nominal = output.value;
+    report->partCount = count;
+
+    // Get the first-order contribution of each part
+    double total = 0;
+    for (size_t p = 0; p < count; ++p) {
+        const double derivative = output.derivative [p];
+        const double spread = intervals [p].width() / 2;
+
+        PartSensitivity& sensitivity = report->parts [p];
+        sensitivity.derivative = derivative;
+        sensitivity.sensitivity = derivative * parts [p].nominal / output.value;
+        sensitivity.contribution = fabs (derivative) * spread;
+        total += sensitivity.contribution;
+    }
+
+    report->linearDeviation = total;
+    report->dominantPart = 0;
+    for (size_t p = 0; p < count; ++p) {
+        report->parts [p].share = total > 0 ? report->parts [p].contribution / total : 0;
+        if (report->parts [p].contribution > report->parts [report->dominantPart].contribution)
+            report->dominantPart = p;
+    }
+
+    return true;
+}
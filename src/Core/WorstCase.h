@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef RESISTOR_WORST_CASE_H
+#define RESISTOR_WORST_CASE_H
+
+#include <stddef.h>
+
+#include "Dual.h"
+#include "Interval.h"
+#include "MonteCarlo.h"
+
+namespace ResistorCore
+{
+
+/**
+ * Output of a network (see @c NetworkModel) over any number type that
+ * supports the arithmetic operators, e.g. @c double, @c Interval or
+ * @c Dual.
+ *
+ * Each part appears once in every expression, so interval bounds are
+ * exact (up to rounding) for these models.
+ */
+template <typename T>
+inline T networkOutput (const NetworkModel model, const T* values, const size_t count) {
+    T output (0.0);
+    switch (model) {
+    case ModelSeries:
+        output = values [0];
+        for (size_t p = 1; p < count; ++p)
+            output += values [p];
+        break;
+    case ModelParallel:
+        output = 1.0 / values [0];
+        for (size_t p = 1; p < count; ++p)
+            output += 1.0 / values [p];
+        output = 1.0 / output;
+        break;
+    case ModelDivider:
+        output = 1.0 / (1.0 + values [0] / values [1]);
+        break;
+    case ModelInvertingGain:
+        output = values [0] / values [1];
+        break;
+    case ModelNonInvertingGain:
+        output = 1.0 + values [0] / values [1];
+        break;
+    }
+
+    return output;
+}
+
+/**
+ * Sensitivity of the output of a network to one of its parts:
+ *
+ * - @c derivative: partial derivative of the output with respect to
+ *   the part value
+ * - @c sensitivity: relative sensitivity, the relative change of the
+ *   output for a relative change of the part
+ * - @c contribution: first-order deviation of the output when the part
+ *   is at the edge of its tolerance and temperature drift
+ * - @c share: fraction of the sum of every contribution
+ */
+struct PartSensitivity {
+    double derivative;
+    double sensitivity;
+    double contribution;
+    double share;
+};
+
+/**
+ * Deterministic worst-case analysis of a network. @c bounds contains
+ * every possible output, @c linearDeviation is the first-order estimate
+ * of the largest deviation from the nominal output, and
+ * @c dominantPart is the part with the largest contribution to it.
+ */
+struct WorstCaseReport {
+    double nominal;
+    Interval bounds;
+    double linearDeviation;
+    size_t partCount;
+    size_t dominantPart;
+    PartSensitivity parts [MonteCarloEngine::MAX_PARTS];
+};
+
+Interval partInterval (const MonteCarloPart& part,
+                       const double minTemperature,
+                       const double maxTemperature);
+
+bool analyzeWorstCase (const NetworkModel model,
+                       const MonteCarloPart* parts,
+                       const size_t count,
+                       const double minTemperature,
+                       const double maxTemperature,
+                       WorstCaseReport* report);
+
+}
+
+#endif
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "DividerCalculator.h"
+
+#include <math.h>
+
+/**
+ * Standard values that can be used by the dividers
+ */
+static const double MINIMUM_VALUE = 1;
+static const double MAXIMUM_VALUE = 10e6;
+
+DividerCalculator::DividerCalculator (QObject* parent) : QObject (parent),
+    m_ratio (0.5),
+    m_minimumTotal (0),
+    m_maximumTotal (HUGE_VAL),
+    m_series (ResistorCore::SeriesE24),
+    m_tolerance (ResistorCore::ToleranceGold),
+    m_maxResults (10),
+    m_solvePending (false)
+{
+    m_solver.setSeries (ResistorCore::SeriesE24, MINIMUM_VALUE, MAXIMUM_VALUE);
+    scheduleSolve();
+}
+
+/**
+ * @returns The target output/input voltage ratio
+ */
+qreal DividerCalculator::ratio() const {
+    return m_ratio;
+}
+
+/**
+ * @returns The minimum total resistance (R1 + R2) of the dividers
+ */
+qreal DividerCalculator::minimumTotal() const {
+    return m_minimumTotal;
+}
+
+/**
+ * @returns The maximum total resistance (R1 + R2) of the dividers
+ */
+qreal DividerCalculator::maximumTotal() const {
+    return m_maximumTotal;
+}
+
+/**
+ * @returns The standard series used by the dividers
+ */
+int DividerCalculator::series() const {
+    return m_series;
+}
+
+/**
+ * @returns The tolerance strip of the parts, used to calculate the
+ *          worst-case error of each divider
+ */
+int DividerCalculator::tolerance() const {
+    return m_tolerance;
+}
+
+/**
+ * @returns The maximum number of dividers returned by each search
+ */
+int DividerCalculator::maxResults() const {
+    return m_maxResults;
+}
+
+/**
+ * @returns The dividers found by the last search (best first), each
+ *          divider is a map with its "r1", "r2", "ratio", "error" and
+ *          "worstCaseError"
+ */
+QVariantList DividerCalculator::results() const {
+    return m_results;
+}
+
+/**
+ * Limits the current drawn by the dividers across the given @a voltage
+ * to the given @a current, by changing the minimum total resistance
+ */
+void DividerCalculator::setCurrentBudget (const qreal voltage, const qreal current) {
+    if (current > 0)
+        setMinimumTotal (ResistorCore::DividerSolver::totalForCurrent (voltage, current));
+}
+
+/**
+ * Searches the dividers for the current parameters
+ */
+void DividerCalculator::solve() {
+    m_solvePending = false;
+
+    ResistorCore::DividerQuery query;
+    query.ratio = m_ratio;
+    query.minTotal = m_minimumTotal;
+    query.maxTotal = m_maximumTotal;
+    query.tolerance = static_cast<ResistorCore::Tolerance> (m_tolerance);
+    query.maxResults = static_cast<size_t> (m_maxResults);
+
+    const std::vector<ResistorCore::Divider> dividers = m_solver.solve (query);
+
+    m_results.clear();
+    for (size_t i = 0; i < dividers.size(); ++i) {
+        QVariantMap map;
+        map.insert ("r1", dividers [i].r1);
+        map.insert ("r2", dividers [i].r2);
+        map.insert ("ratio", dividers [i].ratio);
+        map.insert ("error", dividers [i].error);
+        map.insert ("worstCaseError", dividers [i].worstCaseError);
+        map.insert ("r1Str", QString::fromStdString (ResistorCore::formatResistance (dividers [i].r1)));
+        map.insert ("r2Str", QString::fromStdString (ResistorCore::formatResistance (dividers [i].r2)));
+
+        m_results.append (map);
+        emit resultFound (map);
+    }
+
+    emit resultsChanged();
+}
+
+/**
+ * Changes the target output/input voltage @a ratio
+ */
+void DividerCalculator::setRatio (const qreal ratio) {
+    if (m_ratio != ratio) {
+        m_ratio = ratio;
+        scheduleSolve();
+    }
+}
+
+/**
+ * Changes the minimum total resistance of the dividers
+ */
+void DividerCalculator::setMinimumTotal (const qreal total) {
+    if (m_minimumTotal != total) {
+        m_minimumTotal = total;
+        scheduleSolve();
+    }
+}
+
+/**
+ * Changes the maximum total resistance of the dividers
+ */
+void DividerCalculator::setMaximumTotal (const qreal total) {
+    if (m_maximumTotal != total) {
+        m_maximumTotal = total;
+        scheduleSolve();
+    }
+}
+
+/**
+ * Changes the standard @a series used by the dividers
+ */
+void DividerCalculator::setSeries (const int series) {
+    Q_ASSERT_X (series >= ResistorCore::SeriesE3 && series <= ResistorCore::SeriesE192,
+                __func__, "Invalid argument");
+
+    if (m_series != series) {
+        m_series = series;
+        m_solver.setSeries (static_cast<ResistorCore::ESeries> (series),
+                            MINIMUM_VALUE, MAXIMUM_VALUE);
+        scheduleSolve();
+    }
+}
+
+/**
+ * Changes the @a tolerance strip of the parts
+ */
+void DividerCalculator::setTolerance (const int tolerance) {
+    Q_ASSERT_X (tolerance >= ResistorCore::ToleranceBrown &&
+                tolerance <= ResistorCore::ToleranceSilver,
+                __func__, "Invalid argument");
+
+    if (m_tolerance != tolerance) {
+        m_tolerance = tolerance;
+        scheduleSolve();
+    }
+}
+
+/**
+ * Changes the maximum number of dividers returned by each search
+ */
+void DividerCalculator::setMaxResults (const int results) {
+    Q_ASSERT_X (results > 0, __func__, "Invalid argument");
+
+    if (m_maxResults != results) {
+        m_maxResults = results;
+        scheduleSolve();
+    }
+}
+
+/**
+ * Searches again once control returns to the event loop, so that
+ * changing several parameters in a row only runs one search
+ */
+void DividerCalculator::scheduleSolve() {
+    emit parametersChanged();
+
+    if (!m_solvePending) {
+        m_solvePending = true;
+        QMetaObject::invokeMethod (this, "solve", Qt::QueuedConnection);
+    }
+}
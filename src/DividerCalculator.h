@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef DIVIDER_CALCULATOR_H
+#define DIVIDER_CALCULATOR_H
+
+#include <QtQml>
+#include <QObject>
+#include <QVariantList>
+
+#include "DividerSolver.h"
+
+/**
+ * QML front-end of the voltage divider solver.
+ *
+ * The search runs again whenever one of its parameters changes. Searches
+ * take microseconds, so they run in the calling thread, and the ranked
+ * results are delivered one by one through @c resultFound() before
+ * @c resultsChanged() is emitted.
+ */
+class DividerCalculator : public QObject
+{
+    Q_OBJECT
+
+#ifdef QT_QML_LIB
+    Q_PROPERTY (qreal ratio
+                READ ratio
+                WRITE setRatio
+                NOTIFY parametersChanged)
+    Q_PROPERTY (qreal minimumTotal
+                READ minimumTotal
+                WRITE setMinimumTotal
+                NOTIFY parametersChanged)
+    Q_PROPERTY (qreal maximumTotal
+                READ maximumTotal
+                WRITE setMaximumTotal
+                NOTIFY parametersChanged)
+    Q_PROPERTY (int series
+                READ series
+                WRITE setSeries
+                NOTIFY parametersChanged)
+    Q_PROPERTY (int tolerance
+                READ tolerance
+                WRITE setTolerance
+                NOTIFY parametersChanged)
+    Q_PROPERTY (int maxResults
+                READ maxResults
+                WRITE setMaxResults
+                NOTIFY parametersChanged)
+    Q_PROPERTY (QVariantList results
+                READ results
+                NOTIFY resultsChanged)
+#endif
+
+signals:
+    void resultsChanged();
+    void parametersChanged();
+    void resultFound (const QVariantMap& divider);
+
+public:
+    DividerCalculator (QObject* parent = 0);
+
+    static void DeclareQml()
+    {
+#ifdef QT_QML_LIB
+        qmlRegisterType<DividerCalculator> ("ResistanceInfo", 1, 0, "DividerSolver");
+#endif
+    }
+
+    qreal ratio() const;
+    qreal minimumTotal() const;
+    qreal maximumTotal() const;
+    int series() const;
+    int tolerance() const;
+    int maxResults() const;
+    QVariantList results() const;
+
+    Q_INVOKABLE void setCurrentBudget (const qreal voltage, const qreal current);
+
+public slots:
+    void solve();
+    void setRatio (const qreal ratio);
+    void setMinimumTotal (const qreal total);
+    void setMaximumTotal (const qreal total);
+    void setSeries (const int series);
+    void setTolerance (const int tolerance);
+    void setMaxResults (const int results);
+
+private:
+    void scheduleSolve();
+
+private:
+    qreal m_ratio;
+    qreal m_minimumTotal;
+    qreal m_maximumTotal;
+    int m_series;
+    int m_tolerance;
+    int m_maxResults;
+    bool m_solvePending;
+
+    QVariantList m_results;
+    ResistorCore::DividerSolver m_solver;
+};
+
+#endif
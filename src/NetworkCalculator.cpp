@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "NetworkCalculator.h"
+
+/**
+ * Element type names, in the order of the @c ElementType enum
+ */
+static const char* const ELEMENT_TYPES [] = {
+    "resistor", "voltageSource", "currentSource"
+};
+
+NetworkCalculator::NetworkCalculator (QObject* parent) : QObject (parent),
+    m_solvePending (false) {}
+
+/**
+ * @returns The SPICE-like netlist being solved
+ */
+QString NetworkCalculator::netlist() const {
+    return m_netlist;
+}
+
+/**
+ * @returns The reason why the netlist could not be solved, or an empty
+ *          string if the last solution is valid
+ */
+QString NetworkCalculator::error() const {
+    return m_error;
+}
+
+/**
+ * @returns The nodes of the circuit, each node is a map with its "name"
+ *          and "voltage" (relative to ground)
+ */
+QVariantList NetworkCalculator::nodes() const {
+    return m_nodes;
+}
+
+/**
+ * @returns The elements of the circuit, each element is a map with its
+ *          "name", "type", "value", "current" (from its first node to its
+ *          second node) and absorbed "power"
+ */
+QVariantList NetworkCalculator::elements() const {
+    return m_elements;
+}
+
+/**
+ * @returns The resistance between the nodes named @a nodeA and @a nodeB
+ *          with every source turned off, or a negative value if any of
+ *          the nodes does not exist or the netlist is invalid
+ */
+qreal NetworkCalculator::equivalentResistance (const QString& nodeA,
+                                               const QString& nodeB) {
+    if (!m_error.isEmpty())
+        return ResistorCore::UNKNOWN_RESISTANCE;
+
+    const ResistorCore::Netlist& netlist = m_solver.netlist();
+    const size_t a = netlist.nodeIndex (nodeA.trimmed().toStdString());
+    const size_t b = netlist.nodeIndex (nodeB.trimmed().toStdString());
+    if (a == ResistorCore::INVALID_INDEX || b == ResistorCore::INVALID_INDEX)
+        return ResistorCore::UNKNOWN_RESISTANCE;
+
+    return m_solver.equivalentResistance (a, b);
+}
+
+/**
+ * Parses and solves the current netlist
+ */
+void NetworkCalculator::solve() {
+    m_solvePending = false;
+    m_nodes.clear();
+    m_elements.clear();
+    m_error.clear();
+
+    const QByteArray text = m_netlist.toUtf8();
+
+    std::string error;
+    ResistorCore::Netlist netlist;
+    ResistorCore::NetworkSolution solution;
+    if (!ResistorCore::parseNetlist (text.constData(),
+                                     static_cast<size_t> (text.size()),
+                                     &netlist, &error) ||
+            !m_solver.load (netlist, &error)) {
+        m_error = QString::fromStdString (error);
+        emit solutionChanged();
+        return;
+    }
+
+    if (!m_solver.solve (&solution)) {
+        m_error = tr ("The circuit has no solution");
+        emit solutionChanged();
+        return;
+    }
+
+    for (size_t i = 0; i < netlist.nodeCount(); ++i) {
+        QVariantMap map;
+        map.insert ("name", QString::fromStdString (netlist.nodeName (i)));
+        map.insert ("voltage", solution.voltages [i]);
+        m_nodes.append (map);
+    }
+
+    for (size_t i = 0; i < netlist.elementCount(); ++i) {
+        const ResistorCore::NetlistElement& element = netlist.element (i);
+
+        QVariantMap map;
+        map.insert ("name", QString::fromStdString (element.name));
+        map.insert ("type", ELEMENT_TYPES [element.type]);
+        map.insert ("value", element.value);
+        map.insert ("current", solution.currents [i]);
+        map.insert ("power", solution.power [i]);
+        if (element.type == ResistorCore::ElementResistor)
+            map.insert ("valueStr", QString::fromStdString (ResistorCore::formatResistance (element.value)));
+
+        m_elements.append (map);
+    }
+
+    emit solutionChanged();
+}
+
+/**
+ * Changes the @a netlist and solves it once control returns to the
+ * event loop
+ */
+void NetworkCalculator::setNetlist (const QString& netlist) {
+    if (m_netlist == netlist)
+        return;
+
+    m_netlist = netlist;
+    emit netlistChanged();
+
+    if (!m_solvePending) {
+        m_solvePending = true;
+        QMetaObject::invokeMethod (this, "solve", Qt::QueuedConnection);
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef NETWORK_CALCULATOR_H
+#define NETWORK_CALCULATOR_H
+
+#include <QtQml>
+#include <QObject>
+#include <QVariantList>
+
+#include "NetworkSolver.h"
+
+/**
+ * QML front-end of the netlist solver.
+ *
+ * The netlist is parsed, analyzed and solved again whenever its text
+ * changes (once control returns to the event loop, so typing several
+ * characters in a row only solves once). Parse and topology errors are
+ * reported through the @c error property.
+ */
+class NetworkCalculator : public QObject
+{
+    Q_OBJECT
+
+#ifdef QT_QML_LIB
+    Q_PROPERTY (QString netlist
+                READ netlist
+                WRITE setNetlist
+                NOTIFY netlistChanged)
+    Q_PROPERTY (QString error
+                READ error
+                NOTIFY solutionChanged)
+    Q_PROPERTY (QVariantList nodes
+                READ nodes
+                NOTIFY solutionChanged)
+    Q_PROPERTY (QVariantList elements
+                READ elements
+                NOTIFY solutionChanged)
+#endif
+
+signals:
+    void netlistChanged();
+    void solutionChanged();
+
+public:
+    NetworkCalculator (QObject* parent = 0);
+
+    static void DeclareQml()
+    {
+#ifdef QT_QML_LIB
+        qmlRegisterType<NetworkCalculator> ("ResistanceInfo", 1, 0, "NetworkSolver");
+#endif
+    }
+
+    QString netlist() const;
+    QString error() const;
+    QVariantList nodes() const;
+    QVariantList elements() const;
+
+    Q_INVOKABLE qreal equivalentResistance (const QString& nodeA,
+                                            const QString& nodeB);
+
+public slots:
+    void solve();
+    void setNetlist (const QString& netlist);
+
+private:
+    QString m_netlist;
+    QString m_error;
+    bool m_solvePending;
+
+    QVariantList m_nodes;
+    QVariantList m_elements;
+    ResistorCore::NetworkSolver m_solver;
+};
+
+#endif
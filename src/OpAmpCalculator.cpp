@@ -0,0 +1,442 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "OpAmpCalculator.h"
+#include "ResistorCore.h"
+
+#include <algorithm>
+
+/**
+ * Standard values that can be used by the amplifiers
+ */
+static const double MINIMUM_VALUE = 1;
+static const double MAXIMUM_VALUE = 10e6;
+
+OpAmpCalculator::OpAmpCalculator (QObject* parent) : QAbstractListModel (parent),
+    m_type (ResistorCore::AmplifierInverting),
+    m_gain (10),
+    m_minimumInputImpedance (10e3),
+    m_minimumFeedback (1e3),
+    m_maximumFeedback (1e6),
+    m_maximumError (0.05),
+    m_series (ResistorCore::SeriesE24),
+    m_maxResults (10),
+    m_solvePending (false),
+    m_search (0),
+    m_searching (false),
+    m_requestPending (false),
+    m_stopping (false)
+{
+    // The worker thread emits these signals, handle them in this thread
+    connect (this, SIGNAL (stageFound (int, qreal, qreal, qreal, qreal)),
+             this,   SLOT (onStageFound (int, qreal, qreal, qreal, qreal)),
+             Qt::QueuedConnection);
+    connect (this, SIGNAL (searchFinished (int)),
+             this,   SLOT (onSearchFinished (int)),
+             Qt::QueuedConnection);
+
+    m_thread = std::thread (&OpAmpCalculator::workerLoop, this);
+    scheduleSolve();
+}
+
+/**
+ * Cancels the current search (if any) and stops the worker thread
+ */
+OpAmpCalculator::~OpAmpCalculator() {
+    {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        if (m_cancelled)
+            m_cancelled->store (true);
+
+        m_stopping = true;
+    }
+
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+/**
+ * @returns The amplifier topology (see @c ResistorCore::AmplifierType)
+ */
+int OpAmpCalculator::type() const {
+    return m_type;
+}
+
+/**
+ * @returns The magnitude of the target gain
+ */
+qreal OpAmpCalculator::gain() const {
+    return m_gain;
+}
+
+/**
+ * @returns The minimum input impedance of inverting amplifiers, which
+ *          is the minimum value of the gain resistor
+ */
+qreal OpAmpCalculator::minimumInputImpedance() const {
+    return m_minimumInputImpedance;
+}
+
+/**
+ * @returns The minimum value of the feedback resistor
+ */
+qreal OpAmpCalculator::minimumFeedback() const {
+    return m_minimumFeedback;
+}
+
+/**
+ * @returns The maximum value of the feedback resistor
+ */
+qreal OpAmpCalculator::maximumFeedback() const {
+    return m_maximumFeedback;
+}
+
+/**
+ * @returns The maximum relative gain error of the amplifiers
+ */
+qreal OpAmpCalculator::maximumError() const {
+    return m_maximumError;
+}
+
+/**
+ * @returns The standard series used by the amplifiers
+ */
+int OpAmpCalculator::series() const {
+    return m_series;
+}
+
+/**
+ * @returns The maximum number of stages kept by each search
+ */
+int OpAmpCalculator::maxResults() const {
+    return m_maxResults;
+}
+
+/**
+ * @returns @c true while the worker thread runs a search
+ */
+bool OpAmpCalculator::searching() const {
+    return m_searching;
+}
+
+/**
+ * @returns The number of stages found by the current search
+ */
+int OpAmpCalculator::count() const {
+    return m_stages.count();
+}
+
+/**
+ * @returns The number of stages found by the current search
+ */
+int OpAmpCalculator::rowCount (const QModelIndex& parent) const {
+    if (parent.isValid())
+        return 0;
+
+    return m_stages.count();
+}
+
+/**
+ * @returns The given @a role of the stage at the given @a index
+ */
+QVariant OpAmpCalculator::data (const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= m_stages.count())
+        return QVariant();
+
+    const ResistorCore::GainStage& stage = m_stages.at (index.row());
+    switch (role) {
+    case FeedbackRole:
+        return stage.rf;
+    case GainResistorRole:
+        return stage.rg;
+    case GainRole:
+        return stage.gain;
+    case ErrorRole:
+        return stage.error;
+    case FeedbackStrRole:
+        return QString::fromStdString (ResistorCore::formatResistance (stage.rf));
+    case GainResistorStrRole:
+        return QString::fromStdString (ResistorCore::formatResistance (stage.rg));
+    default:
+        return QVariant();
+    }
+}
+
+/**
+ * @returns The role names used by the QML delegates
+ */
+QHash<int, QByteArray> OpAmpCalculator::roleNames() const {
+    QHash<int, QByteArray> names;
+    names.insert (FeedbackRole, "rf");
+    names.insert (GainResistorRole, "rg");
+    names.insert (GainRole, "stageGain");
+    names.insert (ErrorRole, "stageError");
+    names.insert (FeedbackStrRole, "rfStr");
+    names.insert (GainResistorStrRole, "rgStr");
+    return names;
+}
+
+/**
+ * Cancels the running search (if any), clears the model and sends a new
+ * search with the current parameters to the worker thread
+ */
+void OpAmpCalculator::solve() {
+    m_solvePending = false;
+
+    Request request;
+    request.search = ++m_search;
+    request.series = static_cast<ResistorCore::ESeries> (m_series);
+    request.query.type = static_cast<ResistorCore::AmplifierType> (m_type);
+    request.query.gain = m_gain;
+    request.query.minInputImpedance = m_minimumInputImpedance;
+    request.query.minFeedback = m_minimumFeedback;
+    request.query.maxFeedback = m_maximumFeedback;
+    request.query.maxError = m_maximumError;
+    request.query.maxResults = static_cast<size_t> (m_maxResults);
+    request.cancelled = std::make_shared<std::atomic<bool>> (false);
+
+    {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        if (m_cancelled)
+            m_cancelled->store (true);
+
+        m_cancelled = request.cancelled;
+        m_request = request;
+        m_requestPending = true;
+    }
+
+    m_wake.notify_one();
+
+    beginResetModel();
+    m_stages.clear();
+    endResetModel();
+    emit countChanged();
+
+    if (!m_searching) {
+        m_searching = true;
+        emit searchingChanged();
+    }
+}
+
+/**
+ * Cancels the running search (if any), the stages found so far are kept
+ */
+void OpAmpCalculator::cancel() {
+    {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        if (m_cancelled)
+            m_cancelled->store (true);
+
+        m_requestPending = false;
+    }
+
+    ++m_search;
+    if (m_searching) {
+        m_searching = false;
+        emit searchingChanged();
+    }
+}
+
+/**
+ * Changes the amplifier topology (see @c ResistorCore::AmplifierType)
+ */
+void OpAmpCalculator::setType (const int type) {
+    Q_ASSERT_X (type == ResistorCore::AmplifierInverting ||
+                type == ResistorCore::AmplifierNonInverting,
+                __func__, "Invalid argument");
+
+    if (m_type != type) {
+        m_type = type;
+        scheduleSolve();
+    }
+}
+
+/**
+ * Changes the magnitude of the target @a gain
+ */
+void OpAmpCalculator::setGain (const qreal gain) {
+    if (m_gain != gain) {
+        m_gain = gain;
+        scheduleSolve();
+    }
+}
+
+/**
+ * Changes the minimum input @a impedance of inverting amplifiers
+ */
+void OpAmpCalculator::setMinimumInputImpedance (const qreal impedance) {
+    if (m_minimumInputImpedance != impedance) {
+        m_minimumInputImpedance = impedance;
+        scheduleSolve();
+    }
+}
+
+/**
+ * Changes the minimum value of the feedback resistor
+ */
+void OpAmpCalculator::setMinimumFeedback (const qreal resistance) {
+    if (m_minimumFeedback != resistance) {
+        m_minimumFeedback = resistance;
+        scheduleSolve();
+    }
+}
+
+/**
+ * Changes the maximum value of the feedback resistor
+ */
+void OpAmpCalculator::setMaximumFeedback (const qreal resistance) {
+    if (m_maximumFeedback != resistance) {
+        m_maximumFeedback = resistance;
+        scheduleSolve();
+    }
+}
+
+/**
+ * Changes the maximum relative gain @a error of the amplifiers
+ */
+void OpAmpCalculator::setMaximumError (const qreal error) {
+    if (m_maximumError != error) {
+        m_maximumError = error;
+        scheduleSolve();
+    }
+}
+
+/**
+ * Changes the standard @a series used by the amplifiers
+ */
+void OpAmpCalculator::setSeries (const int series) {
+    Q_ASSERT_X (series >= ResistorCore::SeriesE3 && series <= ResistorCore::SeriesE192,
+                __func__, "Invalid argument");
+
+    if (m_series != series) {
+        m_series = series;
+        scheduleSolve();
+    }
+}
+
+/**
+ * Changes the maximum number of stages kept by each search
+ */
+void OpAmpCalculator::setMaxResults (const int results) {
+    Q_ASSERT_X (results > 0, __func__, "Invalid argument");
+
+    if (m_maxResults != results) {
+        m_maxResults = results;
+        scheduleSolve();
+    }
+}
+
+/**
+ * Inserts a stage found by the worker thread in the model (called
+ * through a queued connection), stages of stale searches are dropped
+ */
+void OpAmpCalculator::onStageFound (const int search,
+                                    const qreal rf,
+                                    const qreal rg,
+                                    const qreal gain,
+                                    const qreal error) {
+    if (search != m_search)
+        return;
+
+    ResistorCore::GainStage stage;
+    stage.rf = rf;
+    stage.rg = rg;
+    stage.gain = gain;
+    stage.error = error;
+
+    // Find the position of the stage, skip it if the model is full
+    const auto position = std::upper_bound (m_stages.begin(), m_stages.end(), stage,
+                                            ResistorCore::GainSolver::better);
+    const int row = static_cast<int> (position - m_stages.begin());
+    if (row >= m_maxResults)
+        return;
+
+    // Drop the worst stage to make room for the new one
+    if (m_stages.count() >= m_maxResults) {
+        beginRemoveRows (QModelIndex(), m_stages.count() - 1, m_stages.count() - 1);
+        m_stages.removeLast();
+        endRemoveRows();
+    }
+
+    beginInsertRows (QModelIndex(), row, row);
+    m_stages.insert (row, stage);
+    endInsertRows();
+    emit countChanged();
+}
+
+/**
+ * Marks the search as finished (called through a queued connection)
+ */
+void OpAmpCalculator::onSearchFinished (const int search) {
+    if (search == m_search && m_searching) {
+        m_searching = false;
+        emit searchingChanged();
+    }
+}
+
+/**
+ * Runs the searches sent by @c solve() until the object is destroyed.
+ * Only the latest request is kept, so searches that were replaced
+ * before the worker picked them up are never started.
+ */
+void OpAmpCalculator::workerLoop() {
+    ResistorCore::GainSolver solver;
+    int series = -1;
+
+    for (;;) {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock (m_mutex);
+            m_wake.wait (lock, [this]() { return m_requestPending || m_stopping; });
+            if (m_stopping)
+                return;
+
+            request = m_request;
+            m_requestPending = false;
+        }
+
+        if (request.series != series) {
+            series = request.series;
+            solver.setSeries (request.series, MINIMUM_VALUE, MAXIMUM_VALUE);
+        }
+
+        const int search = request.search;
+        solver.solve (request.query, [this, search](const ResistorCore::GainStage& stage) {
+            emit stageFound (search, stage.rf, stage.rg, stage.gain, stage.error);
+        }, request.cancelled.get());
+
+        emit searchFinished (search);
+    }
+}
+
+/**
+ * Searches again once control returns to the event loop, so that
+ * changing several parameters in a row only runs one search
+ */
+void OpAmpCalculator::scheduleSolve() {
+    emit parametersChanged();
+
+    if (!m_solvePending) {
+        m_solvePending = true;
+        QMetaObject::invokeMethod (this, "solve", Qt::QueuedConnection);
+    }
+}
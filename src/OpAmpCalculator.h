@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef OPAMP_CALCULATOR_H
+#define OPAMP_CALCULATOR_H
+
+#include <QtQml>
+#include <QVector>
+#include <QAbstractListModel>
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <condition_variable>
+
+#include "GainSolver.h"
+
+/**
+ * QML front-end of the op-amp gain solver, which is also the list model
+ * of the stages found by the current search (best first).
+ *
+ * Searches run in a worker thread that is owned by the object. Each
+ * stage found by the worker is delivered through a queued signal and
+ * inserted in the model right away, so the list fills up with better
+ * stages as the search proceeds. Changing a parameter cancels the
+ * running search, and stages of cancelled searches are dropped.
+ */
+class OpAmpCalculator : public QAbstractListModel
+{
+    Q_OBJECT
+
+#ifdef QT_QML_LIB
+    Q_PROPERTY (int type
+                READ type
+                WRITE setType
+                NOTIFY parametersChanged)
+    Q_PROPERTY (qreal gain
+                READ gain
+                WRITE setGain
+                NOTIFY parametersChanged)
+    Q_PROPERTY (qreal minimumInputImpedance
+                READ minimumInputImpedance
+                WRITE setMinimumInputImpedance
+                NOTIFY parametersChanged)
+    Q_PROPERTY (qreal minimumFeedback
+                READ minimumFeedback
+                WRITE setMinimumFeedback
+                NOTIFY parametersChanged)
+    Q_PROPERTY (qreal maximumFeedback
+                READ maximumFeedback
+                WRITE setMaximumFeedback
+                NOTIFY parametersChanged)
+    Q_PROPERTY (qreal maximumError
+                READ maximumError
+                WRITE setMaximumError
+                NOTIFY parametersChanged)
+    Q_PROPERTY (int series
+                READ series
+                WRITE setSeries
+                NOTIFY parametersChanged)
+    Q_PROPERTY (int maxResults
+                READ maxResults
+                WRITE setMaxResults
+                NOTIFY parametersChanged)
+    Q_PROPERTY (bool searching
+                READ searching
+                NOTIFY searchingChanged)
+    Q_PROPERTY (int count
+                READ count
+                NOTIFY countChanged)
+#endif
+
+signals:
+    void countChanged();
+    void searchingChanged();
+    void parametersChanged();
+
+    void stageFound (const int search, const qreal rf, const qreal rg,
+                     const qreal gain, const qreal error);
+    void searchFinished (const int search);
+
+public:
+    enum Roles {
+        FeedbackRole = Qt::UserRole + 1,
+        GainResistorRole,
+        GainRole,
+        ErrorRole,
+        FeedbackStrRole,
+        GainResistorStrRole
+    };
+
+    OpAmpCalculator (QObject* parent = 0);
+    ~OpAmpCalculator();
+
+    static void DeclareQml()
+    {
+#ifdef QT_QML_LIB
+        qmlRegisterType<OpAmpCalculator> ("ResistanceInfo", 1, 0, "GainSolver");
+#endif
+    }
+
+    int type() const;
+    qreal gain() const;
+    qreal minimumInputImpedance() const;
+    qreal minimumFeedback() const;
+    qreal maximumFeedback() const;
+    qreal maximumError() const;
+    int series() const;
+    int maxResults() const;
+    bool searching() const;
+    int count() const;
+
+    int rowCount (const QModelIndex& parent = QModelIndex()) const;
+    QVariant data (const QModelIndex& index, int role) const;
+    QHash<int, QByteArray> roleNames() const;
+
+public slots:
+    void solve();
+    void cancel();
+    void setType (const int type);
+    void setGain (const qreal gain);
+    void setMinimumInputImpedance (const qreal impedance);
+    void setMinimumFeedback (const qreal resistance);
+    void setMaximumFeedback (const qreal resistance);
+    void setMaximumError (const qreal error);
+    void setSeries (const int series);
+    void setMaxResults (const int results);
+
+private slots:
+    void onStageFound (const int search, const qreal rf, const qreal rg,
+                       const qreal gain, const qreal error);
+    void onSearchFinished (const int search);
+
+private:
+    struct Request {
+        int search;
+        ResistorCore::ESeries series;
+        ResistorCore::GainQuery query;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    };
+
+    void workerLoop();
+    void scheduleSolve();
+
+private:
+    int m_type;
+    qreal m_gain;
+    qreal m_minimumInputImpedance;
+    qreal m_minimumFeedback;
+    qreal m_maximumFeedback;
+    qreal m_maximumError;
+    int m_series;
+    int m_maxResults;
+    bool m_solvePending;
+
+    int m_search;
+    bool m_searching;
+    QVector<ResistorCore::GainStage> m_stages;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+    Request m_request;
+    bool m_requestPending;
+    bool m_stopping;
+};
+
+#endif
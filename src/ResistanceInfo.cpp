@@ -20,45 +20,220 @@
  * THE SOFTWARE.
  */
 
+#include "Thermal.h"
+#include "Marking.h"
+#include "BandTable.h"
+#include "SmdDecoder.h"
+#include "ReverseLookup.h"
+#include "ResistanceParser.h"
 #include "ResistanceInfo.h"
+#include "ResistanceFormatter.h"
+
+/*
+ * Untranslated color names, in the same order as the enums of the
+ * ResistanceInfo class. The strings are translated in the
+ * "ResistanceInfo" context when the name tables are built.
+ */
+static const char* const DIGIT_NAMES [] = {
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Black"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Brown"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Red"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Orange"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Yellow"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Green"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Blue"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Violet"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Gray"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "White")
+};
+
+static const char* const TEMPCO_NAMES [] = {
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Brown"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Red"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Orange"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Yellow"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Blue"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Violet")
+};
+
+static const char* const TOLERANCE_NAMES [] = {
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Brown"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Red"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Green"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Blue"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Violet"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Gray"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Gold"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Silver")
+};
+
+static const char* const MULTIPLIER_NAMES [] = {
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Black"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Brown"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Red"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Orange"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Yellow"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Green"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Blue"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Violet"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Gray"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "White"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Gold"),
+    QT_TRANSLATE_NOOP ("ResistanceInfo", "Silver")
+};
+
+/*
+ * Translated name tables, shared by all ResistanceInfo instances.
+ * They are invalidated when the application language changes.
+ */
+struct NameTables {
+    bool valid;
+    QStringList digits;
+    QStringList firstDigits;
+    QStringList tempcos;
+    QStringList tolerances;
+    QStringList multipliers;
+};
+
+static NameTables& sharedNameTables() {
+    static NameTables tables = { false, {}, {}, {}, {}, {} };
+    return tables;
+}
 
 /**
- * Used when the user inputs an invalid SMD code.
- * This helps us to return "Unknown" resistance to the user instead
- * of showing 'NaN' or another cryptic message to the user
+ * Translates the @a count strings of the @a names array
  */
-static const double UNKNOWN_RESISTANCE = -1.0;
+template <int Count>
+static QStringList translateNames (const char* const (&names) [Count]) {
+    QStringList list;
+    list.reserve (Count);
+    for (int i = 0; i < Count; ++i)
+        list.append (ResistanceInfo::tr (names [i]));
+
+    return list;
+}
 
 /**
- * Ordered list of EIA-96 base values.
- * First item is 0 to avoid using an offset to correctly
- * match the EIA-96 code (index num) to the corresponding
- * base resistance value.
+ * @returns The translated name tables for the current language, the
+ *          tables are only rebuilt after a language change
  */
-static const int SMD_EIA96_VALUES [97] = {
-    000, 100, 102, 105, 107, 110, 113, 115, 118, 121,
-    124, 127, 130, 133, 137, 140, 143, 147, 150, 154,
-    158, 162, 165, 169, 174, 178, 182, 187, 191, 196,
-    200, 205, 210, 215, 221, 226, 232, 237, 243, 249,
-    255, 261, 267, 274, 280, 287, 294, 301, 309, 316,
-    324, 332, 340, 348, 357, 365, 374, 383, 392, 402,
-    412, 422, 432, 442, 453, 464, 475, 487, 499, 511,
-    523, 536, 549, 562, 576, 590, 604, 619, 634, 649,
-    665, 681, 698, 715, 732, 750, 768, 787, 806, 825,
-    845, 866, 887, 909, 931, 953, 976
-};
+static const NameTables& nameTables() {
+    NameTables& tables = sharedNameTables();
+    if (!tables.valid) {
+        tables.digits = translateNames (DIGIT_NAMES);
+        tables.firstDigits = tables.digits.mid (1);
+        tables.tempcos = translateNames (TEMPCO_NAMES);
+        tables.tolerances = translateNames (TOLERANCE_NAMES);
+        tables.multipliers = translateNames (MULTIPLIER_NAMES);
+        tables.valid = true;
+    }
+
+    return tables;
+}
 
-ResistanceInfo::ResistanceInfo (QObject *parent) : QObject (parent)
+/*
+ * Color tables, these do not depend on the language and are built once
+ */
+static const QStringList& digitColorTable() {
+    static const QStringList list = {
+        "#000000", // Black
+        "#5d4037", // Brown
+        "#d32f2f", // Red
+        "#f57c00", // Orange
+        "#fbc02d", // Yellow
+        "#388e3c", // Green
+        "#4169e1", // Blue
+        "#512da8", // Violet
+        "#888888", // Gray
+        "#ffffff"  // White
+    };
+
+    return list;
+}
+
+static const QStringList& tempcoColorTable() {
+    static const QStringList list = {
+        "#5d4037", // Brown
+        "#d32f2f", // Red
+        "#f57c00", // Orange
+        "#fbc02d", // Yellow
+        "#4169e1", // Blue
+        "#512da8", // Violet
+    };
+
+    return list;
+}
+
+static const QStringList& toleranceColorTable() {
+    static const QStringList list = {
+        "#5d4037", // Brown
+        "#d32f2f", // Red
+        "#388e3c", // Green
+        "#4169e1", // Blue
+        "#512da8", // Violet
+        "#888888", // Gray
+        "#d4af37", // Gold
+        "#c0c0c0"  // Silver
+    };
+
+    return list;
+}
+
+static const QStringList& multiplierColorTable() {
+    static const QStringList list = {
+        "#000000", // Black
+        "#5d4037", // Brown
+        "#d32f2f", // Red
+        "#f57c00", // Orange
+        "#fbc02d", // Yellow
+        "#388e3c", // Green
+        "#4169e1", // Blue
+        "#512da8", // Violet
+        "#888888", // Gray
+        "#ffffff", // White
+        "#d4af37", // Gold
+        "#c0c0c0"  // Silver
+    };
+
+    return list;
+}
+
+static const QString& transparentColor() {
+    static const QString color = "transparent";
+    return color;
+}
+
+/**
+ * Returns the given @a marking as a map for QML, with the "valid" flag,
+ * the "value" (in farads, henries or ohms), the formatted "text" and the
+ * "tolerance" in percent (zero if the marking does not give it)
+ */
+static QVariantMap markingMap (const ResistorCore::MarkingValue& marking) {
+    QVariantMap map;
+    map.insert ("valid", marking.scheme != ResistorCore::MarkingInvalid);
+    map.insert ("value", ResistorCore::markingValue (marking));
+    map.insert ("text", QString::fromStdString (ResistorCore::formatMarking (marking)));
+    map.insert ("tolerance", marking.tolerance / 100.0);
+    return map;
+}
+
+ResistanceInfo::ResistanceInfo (QObject *parent) : QObject (parent),
+    m_resistance (ResistorCore::UNKNOWN_RESISTANCE),
+    m_minResistance (ResistorCore::UNKNOWN_RESISTANCE),
+    m_maxResistance (ResistorCore::UNKNOWN_RESISTANCE),
+    m_smdResistance (ResistorCore::UNKNOWN_RESISTANCE),
+    m_smdTolerance (0),
+    m_tempco (TempcoBrown),
+    m_digits ({DigitOrange, DigitOrange, DigitOrange}),
+    m_tolerance (ToleranceGold),
+    m_multiplier (MultiplierBrown),
+    m_resistorType (FourStripResistor),
+    m_smdResistanceCode ("102"),
+    m_resistanceLabel (NULL),
+    m_updateDepth (0),
+    m_recalculationPending (false)
 {
-    // Set default values
-    setTempco (TempcoBrown);
-    setDigit (0, DigitOrange);
-    setDigit (1, DigitOrange);
-    setDigit (2, DigitOrange);
-    setSmdResistanceCode ("102");
-    setTolerance (ToleranceGold);
-    setMultiplier (MultiplierBrown);
-    setResistorType (FourStripResistor);
+    resetStatistics();
 
     // Connect signals/slots for future events
     connect (this, SIGNAL (digitsChanged()),
@@ -74,7 +249,11 @@ ResistanceInfo::ResistanceInfo (QObject *parent) : QObject (parent)
     connect (this, SIGNAL (smdResistanceCodeChanged()),
              this,   SLOT (calculateSmdResistance()));
 
-    // Calculate resistances (to force re-draw of UI items)
+    // Get notified when a new translator is installed
+    if (QCoreApplication::instance())
+        QCoreApplication::instance()->installEventFilter (this);
+
+    // Calculate resistances (with the default values set above)
     calculateResistance();
     calculateSmdResistance();
 }
@@ -84,7 +263,11 @@ ResistanceInfo::ResistanceInfo (QObject *parent) : QObject (parent)
  *          resistance and tolerance values
  */
 QString ResistanceInfo::resistanceStr() const {
-    QString str = getResistanceStr (resistance());
+    QString str;
+    if (m_resistanceLabel)
+        str = QString::fromUtf8 (m_resistanceLabel);
+    else
+        str = getResistanceStr (resistance());
 
     if (resistance() > 0) {
         str += " ± ";
@@ -116,7 +299,7 @@ QString ResistanceInfo::maxResistanceStr() const {
  *          SMD resistance value
  */
 QString ResistanceInfo::smdResistanceStr() const {
-    QString smd = getResistanceStr (smdResistance());
+    QString smd = getResistanceStr (smdExactResistance());
 
     if (smdResistance() > 0) {
         smd += " ± ";
@@ -127,6 +310,22 @@ QString ResistanceInfo::smdResistanceStr() const {
     return smd;
 }
 
+/**
+ * @returns The name of the standard series that matches the current
+ *          tolerance strip (e.g. "E24")
+ */
+QString ResistanceInfo::standardSeriesStr() const {
+    return QString::fromLatin1 (ResistorCore::seriesName (standardSeries()));
+}
+
+/**
+ * @returns A nicely formatted string with the standard value that is
+ *          closest to the current resistance
+ */
+QString ResistanceInfo::nearestStandardValueStr() const {
+    return getResistanceStr (nearestStandardValue());
+}
+
 /**
  * @returns The current SMD resistance code
  */
@@ -137,29 +336,36 @@ QString ResistanceInfo::smdResistanceCode() const {
 /**
  * @returns An ordered list with the strip colors that match
  *          the current resistance value and characteristics
+ *
+ * @note The colors are taken from the shared color tables, so no
+ *       intermediate lists are built when the resistance changes
  */
 QStringList ResistanceInfo::resistanceStripColors() const {
+    const QStringList& digitTable = digitColorTable();
+    const QString& transparent = transparentColor();
+
     QStringList list;
+    list.reserve (6);
 
     // Add first two digits
-    list.append (digitColors().at (static_cast<int>(digits().at (0))));
-    list.append (digitColors().at (static_cast<int>(digits().at (1))));
+    list.append (digitTable.at (static_cast<int>(m_digits.at (0))));
+    list.append (digitTable.at (static_cast<int>(m_digits.at (1))));
 
     // Add third digit if resistance is 5-strip or 6-strip
     if (resistorType() != FourStripResistor)
-        list.append (digitColors().at (static_cast<int>(digits().at (2))));
+        list.append (digitTable.at (static_cast<int>(m_digits.at (2))));
     else
-        list.append ("transparent");
+        list.append (transparent);
 
     // Add multiplier and tolerance strips
-    list.append (multiplierColors().at (static_cast<int>(multiplier())));
-    list.append (toleranceColors().at (static_cast<int>(tolerance())));
+    list.append (multiplierColorTable().at (static_cast<int>(multiplier())));
+    list.append (toleranceColorTable().at (static_cast<int>(tolerance())));
 
     // Add tempco strip
     if (resistorType() == SixStripResistor)
-        list.append (tempcoColors().at (static_cast<int>(tempco())));
+        list.append (tempcoColorTable().at (static_cast<int>(tempco())));
     else
-        list.append ("transparent");
+        list.append (transparent);
 
     return list;
 }
@@ -172,20 +378,15 @@ QStringList ResistanceInfo::resistanceStripColors() const {
  *       in this list matches its corresponding enum value
  */
 QStringList ResistanceInfo::digitNames() const {
-    QStringList list = {
-        tr ("Black"),
-        tr ("Brown"),
-        tr ("Red"),
-        tr ("Orange"),
-        tr ("Yellow"),
-        tr ("Green"),
-        tr ("Blue"),
-        tr ("Violet"),
-        tr ("Gray"),
-        tr ("White")
-    };
+    return nameTables().digits;
+}
 
-    return list;
+/**
+ * @returns The same list as @c digitNames(), without the black color
+ *          (which is not valid for the first digit of a resistor)
+ */
+QStringList ResistanceInfo::firstDigitNames() const {
+    return nameTables().firstDigits;
 }
 
 /**
@@ -197,16 +398,7 @@ QStringList ResistanceInfo::digitNames() const {
  *       in this list matches its corresponding enum value
  */
 QStringList ResistanceInfo::tempcoNames() const {
-    QStringList list = {
-        tr ("Brown"),
-        tr ("Red"),
-        tr ("Orange"),
-        tr ("Yellow"),
-        tr ("Blue"),
-        tr ("Violet")
-    };
-
-    return list;
+    return nameTables().tempcos;
 }
 
 /**
@@ -218,18 +410,7 @@ QStringList ResistanceInfo::tempcoNames() const {
  *       in this list matches its corresponding enum value
  */
 QStringList ResistanceInfo::toleranceNames() const {
-    QStringList list = {
-        tr ("Brown"),
-        tr ("Red"),
-        tr ("Green"),
-        tr ("Blue"),
-        tr ("Violet"),
-        tr ("Gray"),
-        tr ("Gold"),
-        tr ("Silver")
-    };
-
-    return list;
+    return nameTables().tolerances;
 }
 
 /**
@@ -241,22 +422,7 @@ QStringList ResistanceInfo::toleranceNames() const {
  *       in this list matches its corresponding enum value
  */
 QStringList ResistanceInfo::multiplierNames() const {
-    QStringList list = {
-        tr ("Black"),
-        tr ("Brown"),
-        tr ("Red"),
-        tr ("Orange"),
-        tr ("Yellow"),
-        tr ("Green"),
-        tr ("Blue"),
-        tr ("Violet"),
-        tr ("Gray"),
-        tr ("White"),
-        tr ("Gold"),
-        tr ("Silver")
-    };
-
-    return list;
+    return nameTables().multipliers;
 }
 
 /**
@@ -268,20 +434,7 @@ QStringList ResistanceInfo::multiplierNames() const {
  *       in this list matches its corresponding enum value
  */
 QStringList ResistanceInfo::digitColors() const {
-    QStringList list = {
-        "#000000", // Black
-        "#5d4037", // Brown
-        "#d32f2f", // Red
-        "#f57c00", // Orange
-        "#fbc02d", // Yellow
-        "#388e3c", // Green
-        "#4169e1", // Blue
-        "#512da8", // Violet
-        "#888888", // Gray
-        "#ffffff"  // White
-    };
-
-    return list;
+    return digitColorTable();
 }
 
 /**
@@ -293,16 +446,7 @@ QStringList ResistanceInfo::digitColors() const {
  *       in this list matches its corresponding enum value
  */
 QStringList ResistanceInfo::tempcoColors() const {
-    QStringList list = {
-        "#5d4037", // Brown
-        "#d32f2f", // Red
-        "#f57c00", // Orange
-        "#fbc02d", // Yellow
-        "#4169e1", // Blue
-        "#512da8", // Violet
-    };
-
-    return list;
+    return tempcoColorTable();
 }
 
 /**
@@ -314,18 +458,7 @@ QStringList ResistanceInfo::tempcoColors() const {
  *       in this list matches its corresponding enum value
  */
 QStringList ResistanceInfo::toleranceColors() const {
-    QStringList list = {
-        "#5d4037", // Brown
-        "#d32f2f", // Red
-        "#388e3c", // Green
-        "#4169e1", // Blue
-        "#512da8", // Violet
-        "#888888", // Gray
-        "#d4af37", // Gold
-        "#c0c0c0"  // Silver
-    };
-
-    return list;
+    return toleranceColorTable();
 }
 
 /**
@@ -337,22 +470,21 @@ QStringList ResistanceInfo::toleranceColors() const {
  *       in this list matches its corresponding enum value
  */
 QStringList ResistanceInfo::multiplierColors() const {
-    QStringList list = {
-        "#000000", // Black
-        "#5d4037", // Brown
-        "#d32f2f", // Red
-        "#f57c00", // Orange
-        "#fbc02d", // Yellow
-        "#388e3c", // Green
-        "#4169e1", // Blue
-        "#512da8", // Violet
-        "#888888", // Gray
-        "#ffffff", // White
-        "#d4af37", // Gold
-        "#c0c0c0"  // Silver
-    };
+    return multiplierColorTable();
+}
 
-    return list;
+/**
+ * Invalidates the translated name tables when the application language
+ * changes, so that they are rebuilt (once) with the new translations.
+ */
+bool ResistanceInfo::eventFilter (QObject* object, QEvent* event) {
+    if (event->type() == QEvent::LanguageChange
+            && object == QCoreApplication::instance()) {
+        sharedNameTables().valid = false;
+        emit namesChanged();
+    }
+
+    return QObject::eventFilter (object, event);
 }
 
 /**
@@ -383,6 +515,14 @@ double ResistanceInfo::maxResistance() const {
     return m_maxResistance;
 }
 
+/**
+ * @returns The range of the calculated resistance value, which can be
+ *          used in interval arithmetic to bound the output of a circuit
+ */
+ResistorCore::Interval ResistanceInfo::resistanceInterval() const {
+    return ResistorCore::Interval (minResistance(), maxResistance());
+}
+
 /**
  * @returns The calculated SMD resistance value as a number
  */
@@ -390,149 +530,72 @@ double ResistanceInfo::smdResistance() const {
     return m_smdResistance;
 }
 
+/**
+ * @returns The exact nominal resistance of the current band code, which
+ *          can be used as a key for hashing and comparisons
+ */
+ResistorCore::ExactResistance ResistanceInfo::exactResistance() const {
+    return resistorCode().decodeExact();
+}
+
+/**
+ * @returns The exact value of the calculated SMD resistance, or an
+ *          invalid value if the SMD code is not valid
+ */
+ResistorCore::ExactResistance ResistanceInfo::smdExactResistance() const {
+    return m_smdExactResistance;
+}
+
+/**
+ * @returns @c true if the current resistance is a value of the
+ *          standard series that matches the current tolerance strip
+ */
+bool ResistanceInfo::isStandardValue() const {
+    return ResistorCore::isStandardValue (resistance(), standardSeries());
+}
+
+/**
+ * @returns The value of the standard series that matches the current
+ *          tolerance strip that is closest to the current resistance
+ */
+double ResistanceInfo::nearestStandardValue() const {
+    return ResistorCore::nearestStandardValue (resistance(), standardSeries());
+}
+
+/**
+ * @returns The standard series that is manufactured with the current
+ *          tolerance (e.g. E24 for 5%, E96 for 1%)
+ */
+ResistorCore::ESeries ResistanceInfo::standardSeries() const {
+    return ResistorCore::seriesForTolerance (getToleranceValue (tolerance()));
+}
+
 /**
  * @returns The numerical value of the given @a digit color
  */
 int ResistanceInfo::getDigitValue (const Digit digit) {
-    Q_ASSERT_X (digit >= DigitBlack && digit <= DigitWhite,
-                __func__,
-                "Invalid argument");
-
-    return static_cast<int> (digit);
+    return ResistorCore::digitValue (static_cast<ResistorCore::Digit> (digit));
 }
 
 /**
  * @returns The numerical value for the given @a tempco strip color
  */
 int ResistanceInfo::getTempcoValue (const Tempco tempco) {
-    Q_ASSERT_X (tempco >= TempcoBrown && tempco <= TempcoViolet,
-                __func__,
-                "Invalid argument");
-
-    int value;
-
-    switch (tempco) {
-    case TempcoBrown:
-        value = 100;
-        break;
-    case TempcoRed:
-        value = 50;
-        break;
-    case TempcoOrange:
-        value = 15;
-        break;
-    case TempcoYellow:
-        value = 25;
-        break;
-    case TempcoBlue:
-        value = 10;
-        break;
-    case TempcoViolet:
-        value = 5;
-        break;
-    default:
-        value = 0;
-        break;
-    }
-
-    return value;
+    return ResistorCore::tempcoValue (static_cast<ResistorCore::Tempco> (tempco));
 }
 
 /**
  * @returns The numerical value for the given @a tolerance strip color
  */
 double ResistanceInfo::getToleranceValue (const Tolerance tolerance) {
-    Q_ASSERT_X (tolerance >= ToleranceBrown && tolerance <= ToleranceSilver,
-                __func__,
-                "Invalid argument");
-
-    double value;
-
-    switch (tolerance) {
-    case ToleranceBrown:
-        value = 1;
-        break;
-    case ToleranceRed:
-        value = 2;
-        break;
-    case ToleranceGreen:
-        value = 0.5;
-        break;
-    case ToleranceBlue:
-        value = 0.25;
-        break;
-    case ToleranceViolet:
-        value = 0.1;
-        break;
-    case ToleranceGray:
-        value = 0.05;
-        break;
-    case ToleranceGold:
-        value = 5;
-        break;
-    case ToleranceSilver:
-        value = 10;
-        break;
-    default:
-        value = 0;
-        break;
-    }
-
-    return value / 100;
+    return ResistorCore::toleranceValue (static_cast<ResistorCore::Tolerance> (tolerance));
 }
 
 /**
  * @returns The numerical value for the given @a multiplier strip color
  */
 double ResistanceInfo::getMultiplierValue (const Multiplier multiplier) {
-    Q_ASSERT_X (multiplier >= MultiplierBlack && multiplier <= MultiplierSilver,
-                __func__,
-                "Invalid argument");
-
-    double value;
-    switch (multiplier) {
-    case MultiplierBlack:
-        value = pow (10, 0);
-        break;
-    case MultiplierBrown:
-        value = pow (10, 1);
-        break;
-    case MultiplierRed:
-        value = pow (10, 2);
-        break;
-    case MultiplierOrange:
-        value = pow (10, 3);
-        break;
-    case MultiplierYellow:
-        value = pow (10, 4);
-        break;
-    case MultiplierGreen:
-        value = pow (10, 5);
-        break;
-    case MultiplierBlue:
-        value = pow (10, 6);
-        break;
-    case MultiplierViolet:
-        value = pow (10, 7);
-        break;
-    case MultiplierGray:
-        value = pow (10, 8);
-        break;
-    case MultiplierWhite:
-        value = pow (10, 9);
-        break;
-    case MultiplierGold:
-        value = pow (10, -1);
-        break;
-    case MultiplierSilver:
-        value = pow (10, -2);
-        break;
-    default:
-        value = 0;
-        break;
-    }
-
-    return value;
+    return ResistorCore::multiplierValue (static_cast<ResistorCore::Multiplier> (multiplier));
 }
 
 /**
@@ -570,6 +633,366 @@ ResistanceInfo::ResistorType ResistanceInfo::resistorType() const {
     return m_resistorType;
 }
 
+/**
+ * @returns The strip colors of the current resistor as a packed code
+ */
+ResistorCore::ResistorCode ResistanceInfo::resistorCode() const {
+    return ResistorCore::ResistorCode (
+                static_cast<ResistorCore::ResistorType> (resistorType()),
+                static_cast<ResistorCore::Digit> (m_digits.at (0)),
+                static_cast<ResistorCore::Digit> (m_digits.at (1)),
+                static_cast<ResistorCore::Digit> (m_digits.at (2)),
+                static_cast<ResistorCore::Multiplier> (multiplier()),
+                static_cast<ResistorCore::Tolerance> (tolerance()),
+                static_cast<ResistorCore::Tempco> (tempco()));
+}
+
+/**
+ * Changes every strip color of the current resistor to match the
+ * given packed @a code
+ */
+void ResistanceInfo::setResistorCode (const ResistorCore::ResistorCode& code) {
+    Q_ASSERT_X (code.isValid(), __func__, "Invalid argument");
+
+    UpdateTransaction transaction (this);
+    setResistorType (static_cast<ResistorType> (code.type()));
+    setDigit (0, static_cast<Digit> (code.digitA()));
+    setDigit (1, static_cast<Digit> (code.digitB()));
+    setDigit (2, static_cast<Digit> (code.digitC()));
+    setMultiplier (static_cast<Multiplier> (code.multiplier()));
+    setTolerance (static_cast<Tolerance> (code.tolerance()));
+    setTempco (static_cast<Tempco> (code.tempco()));
+}
+
+/**
+ * @returns The raw bits of the current resistor code (used for QML apps)
+ */
+quint32 ResistanceInfo::packedCode() const {
+    return resistorCode().bits();
+}
+
+/**
+ * Loads the resistor code with the given raw @a bits (used for QML apps),
+ * invalid codes are ignored
+ */
+void ResistanceInfo::loadPackedCode (const quint32 bits) {
+    const ResistorCore::ResistorCode code = ResistorCore::ResistorCode::fromBits (bits);
+    if (code.isValid())
+        setResistorCode (code);
+}
+
+/**
+ * Returns every encoding of the given @a resistance (used for QML apps):
+ *
+ * - "fourStripCode", "fiveStripCode" and "sixStripCode": packed band codes
+ *   with the current tolerance and tempco strips (only present if the
+ *   value can be written with the digits of the resistor type)
+ * - "threeCharMarking", "fourCharMarking" and "eia96Marking": SMD markings
+ *   (empty if the value cannot be written with the scheme)
+ *
+ * The map is empty if the value has no encoding at all.
+ */
+QVariantMap ResistanceInfo::reverseLookup (const double resistance) const {
+    QVariantMap map;
+
+    const ResistorCore::ReverseLookup& lookup = ResistorCore::ReverseLookup::instance();
+    const ResistorCore::ReverseEntry* entry = lookup.lookup (resistance);
+    if (!entry)
+        return map;
+
+    const char* keys [] = { "fourStripCode", "fiveStripCode", "sixStripCode" };
+    for (int type = FourStripResistor; type <= SixStripResistor; ++type) {
+        ResistorCore::ResistorCode code;
+        if (lookup.bandCode (resistance,
+                             static_cast<ResistorCore::ResistorType> (type),
+                             static_cast<ResistorCore::Tolerance> (tolerance()),
+                             static_cast<ResistorCore::Tempco> (tempco()),
+                             &code))
+            map.insert (keys [type], code.bits());
+    }
+
+    map.insert ("threeCharMarking", QString::fromLatin1 (entry->threeCharMarking));
+    map.insert ("fourCharMarking", QString::fromLatin1 (entry->fourCharMarking));
+    map.insert ("eia96Marking", QString::fromLatin1 (entry->eia96Marking));
+    return map;
+}
+
+/**
+ * Changes the digit and multiplier strips so that the current resistor
+ * type has the given @a resistance, the tolerance and tempco strips are
+ * not modified. Returns @c false if the value cannot be written with the
+ * digits of the current resistor type.
+ */
+bool ResistanceInfo::loadResistance (const double resistance) {
+    ResistorCore::ResistorCode code;
+    const bool found = ResistorCore::ReverseLookup::instance().bandCode (
+                resistance,
+                static_cast<ResistorCore::ResistorType> (resistorType()),
+                static_cast<ResistorCore::Tolerance> (tolerance()),
+                static_cast<ResistorCore::Tempco> (tempco()),
+                &code);
+
+    if (found)
+        setResistorCode (code);
+
+    return found;
+}
+
+/**
+ * Converts a human-written resistance (e.g. "4k7", "1.5M" or
+ * "10kΩ ±1%") to ohms, returns NaN if the text is not valid (used for
+ * QML apps)
+ */
+double ResistanceInfo::parseValue (const QString& text) const {
+    const QByteArray utf8 = text.toUtf8();
+
+    ResistorCore::ParsedResistance parsed;
+    if (!ResistorCore::parseResistance (utf8.constData(), static_cast<size_t> (utf8.size()), &parsed))
+        return qQNaN();
+
+    return parsed.resistance.toDouble();
+}
+
+/**
+ * Changes the strips to the human-written resistance in the given
+ * @a text (e.g. "4k7 ±1%"). Tolerance and tempco annotations change
+ * their strips, the other strips keep their colors.
+ *
+ * Returns @c false (without changing any strip) if the text is not
+ * valid, if an annotation has no strip color or if the value cannot be
+ * written with the digits of the current resistor type.
+ */
+bool ResistanceInfo::loadValue (const QString& text) {
+    const QByteArray utf8 = text.toUtf8();
+
+    ResistorCore::ParsedResistance parsed;
+    if (!ResistorCore::parseResistance (utf8.constData(), static_cast<size_t> (utf8.size()), &parsed))
+        return false;
+
+    ResistorCore::Tolerance toleranceStrip = static_cast<ResistorCore::Tolerance> (tolerance());
+    if ((parsed.flags & ResistorCore::ParsedTolerance) &&
+            !ResistorCore::toleranceBand (parsed.tolerance, &toleranceStrip))
+        return false;
+
+    ResistorCore::Tempco tempcoStrip = static_cast<ResistorCore::Tempco> (tempco());
+    if ((parsed.flags & ResistorCore::ParsedTempco) &&
+            !ResistorCore::tempcoBand (parsed.tempco, &tempcoStrip))
+        return false;
+
+    ResistorCore::ResistorCode code;
+    const bool found = ResistorCore::ReverseLookup::instance().bandCode (
+                parsed.resistance.toDouble(),
+                static_cast<ResistorCore::ResistorType> (resistorType()),
+                toleranceStrip,
+                tempcoStrip,
+                &code);
+
+    if (found)
+        setResistorCode (code);
+
+    return found;
+}
+
+/**
+ * Evaluates an expression such as "(4k7 + 220) || 10k" or
+ * "12V * 10k / (10k + 4k7)", variables are read from @a variables.
+ * Compiled expressions are cached, so calling this function every time
+ * the text changes only decodes the edited values.
+ *
+ * Returns a map with the "valid", "value", "unit" and "error" keys (used
+ * for QML apps)
+ */
+QVariantMap ResistanceInfo::evaluateExpression (const QString& text,
+                                                const QVariantMap& variables) {
+    QVariantMap map;
+    map.insert ("valid", false);
+    map.insert ("value", qQNaN());
+    map.insert ("unit", "");
+    map.insert ("error", "");
+
+    std::string error;
+    const ResistorCore::Expression* expression =
+            m_expressions.compile (text.toStdString(), &error);
+    if (!expression) {
+        map.insert ("error", QString::fromStdString (error));
+        return map;
+    }
+
+    std::vector<double> values (expression->variableCount());
+    for (size_t i = 0; i < values.size(); ++i) {
+        const QString name = QString::fromStdString (expression->variableName (i));
+        if (!variables.contains (name)) {
+            map.insert ("error", tr ("Unknown value \"%1\"").arg (name));
+            return map;
+        }
+
+        values [i] = variables.value (name).toDouble();
+    }
+
+    map.insert ("valid", true);
+    map.insert ("value", expression->evaluate (values.data()));
+    map.insert ("unit", QString::fromStdString (expression->unit()));
+    return map;
+}
+
+/**
+ * Decodes the printed @a code of a ceramic capacitor (e.g. "104", "4n7"
+ * or "A2"), see @c markingMap() for the returned values
+ */
+QVariantMap ResistanceInfo::decodeCapacitorCode (const QString& code) const {
+    const QByteArray text = code.trimmed().toLatin1();
+    return markingMap (ResistorCore::decodeMarking (ResistorCore::FamilyCapacitor,
+                                                    text.constData(),
+                                                    static_cast<size_t> (text.size())));
+}
+
+/**
+ * Decodes the printed @a code of an inductor (e.g. "4R7", "101" or
+ * "R47"), see @c markingMap() for the returned values
+ */
+QVariantMap ResistanceInfo::decodeInductorCode (const QString& code) const {
+    const QByteArray text = code.trimmed().toLatin1();
+    return markingMap (ResistorCore::decodeMarking (ResistorCore::FamilyInductor,
+                                                    text.constData(),
+                                                    static_cast<size_t> (text.size())));
+}
+
+/**
+ * Decodes the color bands of an inductor, @a colors are indices of the
+ * multiplier names (black to white, then gold and silver)
+ */
+QVariantMap ResistanceInfo::decodeInductorColors (const QVariantList& colors) const {
+    uint8_t bands [6] = { 0, 0, 0, 0, 0, 0 };
+    const int count = qMin (colors.count(), 6);
+    for (int i = 0; i < count; ++i)
+        bands [i] = static_cast<uint8_t> (qBound (0, colors.at (i).toInt(), 255));
+
+    return markingMap (ResistorCore::decodeColorMarking (ResistorCore::FamilyInductor,
+                                                         bands,
+                                                         static_cast<size_t> (count)));
+}
+
+/**
+ * Returns the nominal resistance of the current resistor at @a points
+ * evenly spaced temperatures (used for QML apps). Each item of the list
+ * is a map with the "temperature" (°C) and "resistance" (ohms).
+ *
+ * Only six-strip resistors have a tempco strip, the resistance of other
+ * resistors does not change with the temperature.
+ */
+QVariantList ResistanceInfo::temperatureSweep (const double minTemperature,
+                                               const double maxTemperature,
+                                               const int points) const {
+    QVariantList list;
+    if (points <= 0)
+        return list;
+
+    const ResistorCore::ThermalModel model =
+            ResistorCore::ThermalModel::fromBands (resistorCode().toBandCode());
+
+    std::vector<double> temperatures (points);
+    std::vector<double> resistances (points);
+    ResistorCore::temperatureSteps (minTemperature, maxTemperature, points, temperatures.data());
+    model.sweep (temperatures.data(), resistances.data(), points);
+
+    for (int i = 0; i < points; ++i) {
+        QVariantMap point;
+        point.insert ("temperature", temperatures [i]);
+        point.insert ("resistance", resistances [i]);
+        list.append (point);
+    }
+
+    return list;
+}
+
+/**
+ * Returns the min. and max. resistance of the current resistor over the
+ * given temperature range, taking both the tolerance and the tempco
+ * strips into account (used for QML apps). The map contains the "min"
+ * and "max" values and their display strings, "minStr" and "maxStr".
+ */
+QVariantMap ResistanceInfo::temperatureRange (const double minTemperature,
+                                              const double maxTemperature) const {
+    const ResistorCore::ThermalModel model =
+            ResistorCore::ThermalModel::fromBands (resistorCode().toBandCode());
+    const ResistorCore::Interval range = model.bounds (minTemperature,
+                                                       maxTemperature,
+                                                       getToleranceValue (tolerance()));
+
+    QVariantMap map;
+    map.insert ("min", range.lower);
+    map.insert ("max", range.upper);
+    map.insert ("minStr", getResistanceStr (range.lower));
+    map.insert ("maxStr", getResistanceStr (range.upper));
+    return map;
+}
+
+/**
+ * Returns the C source code of a fixed-point R(T) table of the current
+ * resistor with the given number of @a entries, which can be pasted in
+ * firmware to convert ADC readings to temperatures. Returns an empty
+ * string if the table cannot be built.
+ */
+QString ResistanceInfo::temperatureLookupTable (const double minTemperature,
+                                                const double maxTemperature,
+                                                const int entries) const {
+    if (entries <= 0)
+        return QString();
+
+    const ResistorCore::ThermalModel model =
+            ResistorCore::ThermalModel::fromBands (resistorCode().toBandCode());
+
+    ResistorCore::FixedPointTable table;
+    if (!ResistorCore::buildLookupTable (model, minTemperature, maxTemperature,
+                                         entries, -1, &table))
+        return QString();
+
+    return QString::fromStdString (ResistorCore::lookupTableSource (table, "resistance_table"));
+}
+
+/**
+ * Starts an update transaction, the resistance is not recalculated
+ * until the matching call to @c commitUpdate(). Transactions can be
+ * nested, only the outermost one triggers the recalculation.
+ */
+void ResistanceInfo::beginUpdate() {
+    ++m_updateDepth;
+}
+
+/**
+ * Ends the current update transaction and recalculates the resistance
+ * (once) if any of the strips changed while the transaction was open.
+ */
+void ResistanceInfo::commitUpdate() {
+    Q_ASSERT_X (m_updateDepth > 0, __func__, "No update in progress");
+
+    if (m_updateDepth <= 0 || --m_updateDepth > 0)
+        return;
+
+    if (m_recalculationPending) {
+        m_recalculationPending = false;
+        calculateResistance();
+    }
+}
+
+/**
+ * @returns The number of recalculations and notifications that were
+ *          performed or avoided since the last @c resetStatistics()
+ */
+ResistanceInfo::UpdateStatistics ResistanceInfo::statistics() const {
+    return m_statistics;
+}
+
+/**
+ * Resets the update counters
+ */
+void ResistanceInfo::resetStatistics() {
+    m_statistics.recalculations = 0;
+    m_statistics.coalescedRecalculations = 0;
+    m_statistics.notifications = 0;
+    m_statistics.skippedNotifications = 0;
+}
+
 /**
  * Changes the first @a digit of the resistor (used for QML apps)
  */
@@ -599,7 +1022,13 @@ void ResistanceInfo::setTempco (const Tempco tempco) {
                 __func__,
                 "Invalid argument");
 
+    if (m_tempco == tempco) {
+        ++m_statistics.skippedNotifications;
+        return;
+    }
+
     m_tempco = tempco;
+    ++m_statistics.notifications;
     emit tempcoChanged();
 }
 
@@ -611,7 +1040,13 @@ void ResistanceInfo::setTolerance (const Tolerance tolerance) {
                 __func__,
                 "Invalid argument");
 
+    if (m_tolerance == tolerance) {
+        ++m_statistics.skippedNotifications;
+        return;
+    }
+
     m_tolerance = tolerance;
+    ++m_statistics.notifications;
     emit toleranceChanged();
 }
 
@@ -619,7 +1054,13 @@ void ResistanceInfo::setTolerance (const Tolerance tolerance) {
  * Changes the SMD @a code of the current SMD resistor
  */
 void ResistanceInfo::setSmdResistanceCode (const QString& code) {
+    if (m_smdResistanceCode == code) {
+        ++m_statistics.skippedNotifications;
+        return;
+    }
+
     m_smdResistanceCode = code;
+    ++m_statistics.notifications;
     emit smdResistanceCodeChanged();
 }
 
@@ -631,7 +1072,13 @@ void ResistanceInfo::setMultiplier (const Multiplier multiplier) {
                 __func__,
                 "Invalid argument");
 
+    if (m_multiplier == multiplier) {
+        ++m_statistics.skippedNotifications;
+        return;
+    }
+
     m_multiplier = multiplier;
+    ++m_statistics.notifications;
     emit multiplierChanged();
 }
 
@@ -646,7 +1093,13 @@ void ResistanceInfo::setResistorType (const ResistorType type) {
                 __func__,
                 "Invalid argument");
 
+    if (m_resistorType == type) {
+        ++m_statistics.skippedNotifications;
+        return;
+    }
+
     m_resistorType = type;
+    ++m_statistics.notifications;
     emit resistorTypeChanged();
 }
 
@@ -661,15 +1114,15 @@ void ResistanceInfo::setDigit (const int number, const Digit digit) {
                 __func__,
                 "Invalid argument");
 
-    // Digit already exists in list
-    if (m_digits.count() > number)
-        m_digits.replace (number, digit);
-
-    // Digit does not exist, register it to the list
-    else
-        m_digits.insert (number, digit);
+    // Digit did not change
+    if (m_digits.at (number) == digit) {
+        ++m_statistics.skippedNotifications;
+        return;
+    }
 
     // Update UI
+    m_digits.replace (number, digit);
+    ++m_statistics.notifications;
     emit digitsChanged();
 }
 
@@ -678,27 +1131,42 @@ void ResistanceInfo::setDigit (const int number, const Digit digit) {
  * that are currently set by the program.
  */
 void ResistanceInfo::calculateResistance() {
-    double base = 0;
-
-    // Get 4-strip resistance digits
-    if (resistorType() == FourStripResistor) {
-        double digitA = getDigitValue (digits().at (0));
-        double digitB = getDigitValue (digits().at (1));
+    // Wait until the current update transaction is committed
+    if (m_updateDepth > 0) {
+        if (m_recalculationPending)
+            ++m_statistics.coalescedRecalculations;
 
-        base = (10 * digitA) + digitB;
+        m_recalculationPending = true;
+        return;
     }
 
-    // Get 5-strip and 6-strip resistance digits
-    else {
-        double digitA = getDigitValue (digits().at (0));
-        double digitB = getDigitValue (digits().at (1));
-        double digitC = getDigitValue (digits().at (2));
-
-        base = (100 * digitA) + (10 * digitB) + digitC;
+    // This function only runs after a strip changed, update the colors
+    ++m_statistics.recalculations;
+    ++m_statistics.notifications;
+    emit stripColorsChanged();
+
+    const ResistorCore::BandCode code = resistorCode().toBandCode();
+
+    // Use precomputed values & display string (if possible)
+#ifdef ENABLE_BAND_TABLE
+    const ResistorCore::BandTable& table = ResistorCore::BandTable::instance();
+    const ResistorCore::BandTableEntry* entry = table.lookup (code);
+    if (entry) {
+        const ResistorCore::BandResult result = {
+            entry->resistance,
+            entry->minResistance,
+            entry->maxResistance
+        };
+
+        m_resistanceLabel = table.label (*entry);
+        setResistance (result);
+        return;
     }
+#endif
 
-    // Calculate resistance
-    setResistance (base * getMultiplierValue (multiplier()));
+    // Calculate values manually
+    m_resistanceLabel = NULL;
+    setResistance (ResistorCore::decodeBands (code));
 }
 
 /**
@@ -706,285 +1174,77 @@ void ResistanceInfo::calculateResistance() {
  * that is currently set by the user.
  */
 void ResistanceInfo::calculateSmdResistance() {
-    // Handle 0-ohm resistors
-    if (smdResistanceCode() == "0" ||
-            smdResistanceCode() == "00" ||
-            smdResistanceCode() == "000" ||
-            smdResistanceCode() == "0000") {
-        setSmdTolerance (0);
-        setSmdResistance (0);
-        return;
-    }
-
-    // Verify that the SMD code has between 3 and 4 digits
-    int codeLen = smdResistanceCode().length();
-    if (codeLen < 3 || codeLen > 4) {
-        setSmdTolerance (0);
-        setSmdResistance (UNKNOWN_RESISTANCE);
-        return;
-    }
-
-    // Read digits
-    QList<QPair<bool,int>> numbers;
-    for (int i = 0; i < codeLen; ++i) {
-        bool ok;
-        int num = QString (smdResistanceCode().at (i)).toInt (&ok);
-        numbers.append (qMakePair<bool,int> (ok, num));
-    }
-
-    // Check 3 digit SMD code
-    if (codeLen == 3) {
-        // Get digit types
-        bool nanA = !numbers.at (0).first;
-        bool nanB = !numbers.at (1).first;
-        bool nanC = !numbers.at (2).first;
-
-        // Get numbers
-        int numA = numbers.at (0).second;
-        int numB = numbers.at (1).second;
-        int numC = numbers.at (2).second;
-
-        // All digits are numbers (standard SMD)
-        if (!nanA && !nanB && !nanC) {
-            setSmdTolerance (5);
-            setSmdResistance (((numA * 10) + numB) * pow (10, numC));
-        }
-
-        // Radix point is present (digit, char, digit)
-        else if (!nanA && nanB && !nanC) {
-            if (smdResistanceCode().at (1).toUpper() == 'R') {
-                setSmdTolerance (5);
-                setSmdResistance (numA + (static_cast<double>(numC) / 10));
-            } else {
-                setSmdTolerance (0);
-                setSmdResistance (UNKNOWN_RESISTANCE);
-            }
-        }
-
-        // Use EIA-96 standard (digit, digit, char)
-        else if (!nanA && !nanB && nanC) {
-            // Get two-digit code and calculate base value
-            int value = 0;
-            int digit = (numA * 10) + numB;
-            int maxEIA96Code = (sizeof (SMD_EIA96_VALUES) / sizeof (int));
-            if (digit < maxEIA96Code)
-                value = SMD_EIA96_VALUES [digit];
-            else {
-                setSmdTolerance (0);
-                setSmdResistance (UNKNOWN_RESISTANCE);
-                return;
-            }
-
-            // Get multiplier value
-            double multiplier = -1;
-            QChar c = smdResistanceCode().at (2);
-            switch (c.toUpper().toLatin1()) {
-            case 'Z':
-                multiplier = 0.001;
-                break;
-            case 'Y':
-            case 'R':
-                multiplier = 0.01;
-                break;
-            case 'X':
-            case 'S':
-                multiplier = 0.1;
-                break;
-            case 'A':
-                multiplier = 1;
-                break;
-            case 'B':
-            case 'H':
-                multiplier = 10;
-                break;
-            case 'C':
-                multiplier = 100;
-                break;
-            case 'D':
-                multiplier = 1000;
-                break;
-            case 'E':
-                multiplier = 10000;
-                break;
-            case 'F':
-                multiplier = 100000;
-                break;
-            default:
-                setSmdTolerance (0);
-                setSmdResistance (UNKNOWN_RESISTANCE);
-                break;
-            }
-
-            // Calculate resistance
-            if (multiplier > 0.0) {
-                setSmdTolerance (1);
-                setSmdResistance (value * multiplier);
-            }
-        }
-
-        // Error
-        else {
-            setSmdTolerance (0);
-            setSmdResistance (UNKNOWN_RESISTANCE);
-        }
-    }
-
-    // Check 4 digit SMD code
-    if (codeLen == 4) {
-        // Get digit types
-        bool nanA = !numbers.at (0).first;
-        bool nanB = !numbers.at (1).first;
-        bool nanC = !numbers.at (2).first;
-        bool nanD = !numbers.at (3).first;
-
-        // Get numbers
-        int numA = numbers.at (0).second;
-        int numB = numbers.at (1).second;
-        int numC = numbers.at (2).second;
-        int numD = numbers.at (3).second;
-
-        // All digits are numbers (standard SMD)
-        if (!nanA && !nanB && !nanC && !nanD) {
-            setSmdTolerance (1);
-            setSmdResistance (((numA * 100) + (numB * 10) + numC) * pow (10, numD));
-        }
-
-        // Radix point is on second digit (digit, char, digit, digit)
-        else if (!nanA && nanB && !nanC && !nanD) {
-            if (smdResistanceCode().at (1).toUpper() == 'R') {
-                double n = numA
-                        + (static_cast<double>(numC) / 10)
-                        + (static_cast<double>(numD) / 100);
-
-                setSmdTolerance (1);
-                setSmdResistance (n);
-            } else {
-                setSmdTolerance (0);
-                setSmdResistance (UNKNOWN_RESISTANCE);
-            }
-        }
-
-        // Radix point is on third digit (digit, digit, char, digit)
-        else if (!nanA && !nanB && nanC && !nanD) {
-            if (smdResistanceCode().at (2).toUpper() == 'R') {
-                double n = (numA * 10) + numB + (static_cast<double>(numD) / 10);
-                setSmdTolerance (1);
-                setSmdResistance (n);
-            } else {
-                setSmdTolerance (0);
-                setSmdResistance (UNKNOWN_RESISTANCE);
-            }
-        }
-
-        // Error
-        else {
-            setSmdTolerance (0);
-            setSmdResistance (UNKNOWN_RESISTANCE);
-        }
-    }
-}
-
-/**
- * Returns the scientific prefix adequate for the given
- * scientific @a exponent.
- *
- * If no adequate prefix is found, the function shall return
- * "E^exponent".
- */
-QString ResistanceInfo::prefixStr (const int exponent) const {
-    QString str;
-
-    switch (exponent) {
-    case -9:
-        str = "n";
-        break;
-    case -6:
-        str = "µ";
-        break;
-    case -3:
-        str = "m";
-        break;
-    case 0:
-        str = "";
-        break;
-    case 3:
-        str = "k";
-        break;
-    case 6:
-        str = "M";
-        break;
-    case 9:
-        str = "G";
-        break;
-    default:
-        str = QString ("E%1").arg (exponent);
-        break;
-    }
-
-    return str;
-}
-
-/**
- * Changes the @a tolerance value for the SMD resistor
- */
-void ResistanceInfo::setSmdTolerance(const int tolerance) {
-    Q_ASSERT_X (tolerance >= 0, __func__, "Invalid tolerance");
-
-    m_smdTolerance = tolerance;
-    emit smdToleranceChanged();
+    // Convert the code to Latin-1 without allocating memory, codes with
+    // more than 4 characters are rejected by the decoder
+    char code [5];
+    const int length = qMin (m_smdResistanceCode.length(), 5);
+    for (int i = 0; i < length; ++i)
+        code [i] = m_smdResistanceCode.at (i).toLatin1();
+
+    int tolerance = 0;
+    const ResistorCore::ExactResistance resistance =
+            ResistorCore::decodeSmdExact (code, static_cast<size_t> (length), &tolerance);
+
+    setSmdResistance (resistance, tolerance);
 }
 
 /**
- * Changes the @a resistance and updates the minimum and maximum resistance
- * values of the class.
+ * Changes the resistance and the minimum and maximum resistance
+ * values of the class with the given band decoding @a result.
  */
-void ResistanceInfo::setResistance (const double resistance) {
-    Q_ASSERT_X (resistance >= UNKNOWN_RESISTANCE,
+void ResistanceInfo::setResistance (const ResistorCore::BandResult& result) {
+    Q_ASSERT_X (result.resistance >= ResistorCore::UNKNOWN_RESISTANCE,
                 __func__,
                 "Invalid resistance");
 
-    m_resistance = resistance;
-    m_minResistance = (1 - getToleranceValue (m_tolerance)) * resistance;
-    m_maxResistance = (1 + getToleranceValue (m_tolerance)) * resistance;
+    if (m_resistance == result.resistance
+            && m_minResistance == result.minResistance
+            && m_maxResistance == result.maxResistance) {
+        ++m_statistics.skippedNotifications;
+        return;
+    }
+
+    m_resistance = result.resistance;
+    m_minResistance = result.minResistance;
+    m_maxResistance = result.maxResistance;
 
+    ++m_statistics.notifications;
     emit resistanceCalculated();
 }
 
 /**
- * Changes the SMD @a resistance of the class.
+ * Changes the SMD @a resistance and @a tolerance of the class. The
+ * displayed SMD resistance includes the tolerance, so it is notified
+ * when either of them changes.
  */
-void ResistanceInfo::setSmdResistance (const double resistance) {
-    Q_ASSERT_X (resistance >= UNKNOWN_RESISTANCE,
-                __func__,
-                "Invalid SMD resistance");
-
-    m_smdResistance = resistance;
-    emit smdResistanceCalculated();
-}
+void ResistanceInfo::setSmdResistance (const ResistorCore::ExactResistance& resistance,
+                                       const int tolerance) {
+    Q_ASSERT_X (tolerance >= 0, __func__, "Invalid tolerance");
 
-/**
- * Returns the most adequate scientific exponent for the given
- * @a resistance value.
- */
-int ResistanceInfo::scientificExp (const double resistance) const {
-    int x = 9;
-    int exp = -1;
+    const bool toleranceChanged = m_smdTolerance != tolerance;
+    if (m_smdExactResistance == resistance && !toleranceChanged) {
+        ++m_statistics.skippedNotifications;
+        return;
+    }
 
-    while (exp == -1) {
-        if (resistance >= pow (10, x))
-            exp = x;
+    m_smdExactResistance = resistance;
+    m_smdResistance = resistance.toDouble();
 
-        x -= 3;
+    if (toleranceChanged) {
+        m_smdTolerance = tolerance;
+        ++m_statistics.notifications;
+        emit smdToleranceChanged();
     }
 
-    return exp;
+    ++m_statistics.notifications;
+    emit smdResistanceCalculated();
 }
 
 /**
  * Returns a nicely formatted string with the givn @a resistance value
  */
 QString ResistanceInfo::getResistanceStr (const double resistance) const {
-    Q_ASSERT_X (resistance >= UNKNOWN_RESISTANCE,
+    Q_ASSERT_X (resistance >= ResistorCore::UNKNOWN_RESISTANCE,
                 __func__,
                 "Invalid argument");
 
@@ -996,17 +1256,33 @@ QString ResistanceInfo::getResistanceStr (const double resistance) const {
     if (resistance == 0.0)
         return tr ("%1 (jumper)").arg ("0 Ω");
 
-    // Get scientific exponent for the resitance
-    int power = scientificExp (resistance);
+    // Format the resistance directly into a UTF-16 buffer
+    char16_t buffer [ResistorCore::RESISTANCE_STR_CAPACITY];
+    const size_t length = ResistorCore::formatResistanceUtf16 (resistance,
+                                                               buffer,
+                                                               sizeof (buffer) / sizeof (char16_t));
 
-    // Get base number (e.g. 2.2 for 2.2 kΩ)
-    QString number;
-    double base = resistance / pow (10, power);
-    if (base == static_cast<int> (base))
-        number = QString::number (int (base));
-    else
-        number = QString::number (base, 'f', 2);
+    return QString (reinterpret_cast<const QChar*> (buffer), static_cast<int> (length));
+}
+
+/**
+ * Returns the text of the given exact @a resistance value, every
+ * significant digit is shown
+ */
+QString ResistanceInfo::getResistanceStr (const ResistorCore::ExactResistance& resistance) const {
+    // Resistance is unknown
+    if (!resistance.isValid())
+        return tr ("Unknown");
+
+    // Resistance is 0 ohms
+    if (resistance.microohms() == 0)
+        return tr ("%1 (jumper)").arg ("0 Ω");
+
+    // Format the resistance directly into a UTF-16 buffer
+    char16_t buffer [ResistorCore::RESISTANCE_STR_CAPACITY];
+    const size_t length = ResistorCore::formatResistanceUtf16 (resistance,
+                                                               buffer,
+                                                               sizeof (buffer) / sizeof (char16_t));
 
-    // Get formatted resistance expression string
-    return QString ("%1 %2Ω").arg (number).arg (prefixStr (power));
+    return QString (reinterpret_cast<const QChar*> (buffer), static_cast<int> (length));
 }
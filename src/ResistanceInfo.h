@@ -23,13 +23,17 @@
 #ifndef RESISTANCE_INFO_H
 #define RESISTANCE_INFO_H
 
-#include <math.h>
-
 #include <QtQml>
 #include <QList>
 #include <QObject>
 #include <QStringList>
 
+#include "ESeries.h"
+#include "Interval.h"
+#include "Expression.h"
+#include "ResistorCode.h"
+#include "ResistorCore.h"
+
 class ResistanceInfo : public QObject
 {
     Q_OBJECT
@@ -73,6 +77,15 @@ class ResistanceInfo : public QObject
     Q_PROPERTY (QString resistance
                 READ resistanceStr
                 NOTIFY resistanceCalculated)
+    Q_PROPERTY (QString standardSeries
+                READ standardSeriesStr
+                NOTIFY toleranceChanged)
+    Q_PROPERTY (QString nearestStandardValue
+                READ nearestStandardValueStr
+                NOTIFY resistanceCalculated)
+    Q_PROPERTY (bool isStandardValue
+                READ isStandardValue
+                NOTIFY resistanceCalculated)
     Q_PROPERTY (QString minimumResistance
                 READ minResistanceStr
                 NOTIFY resistanceCalculated)
@@ -87,22 +100,22 @@ class ResistanceInfo : public QObject
                 NOTIFY smdToleranceChanged)
     Q_PROPERTY (QStringList resistanceStripColors
                 READ resistanceStripColors
-                NOTIFY resistanceCalculated)
+                NOTIFY stripColorsChanged)
     Q_PROPERTY (QStringList digitNames
                 READ digitNames
-                CONSTANT)
+                NOTIFY namesChanged)
     Q_PROPERTY (QStringList firstDigitNames
                 READ firstDigitNames
-                CONSTANT)
+                NOTIFY namesChanged)
     Q_PROPERTY (QStringList tempcoNames
                 READ tempcoNames
-                CONSTANT)
+                NOTIFY namesChanged)
     Q_PROPERTY (QStringList toleranceNames
                 READ toleranceNames
-                CONSTANT)
+                NOTIFY namesChanged)
     Q_PROPERTY (QStringList multiplierNames
                 READ multiplierNames
-                CONSTANT)
+                NOTIFY namesChanged)
     Q_PROPERTY (QStringList digitColors
                 READ digitColors
                 CONSTANT)
@@ -118,11 +131,13 @@ class ResistanceInfo : public QObject
 #endif
 
 signals:
+    void namesChanged();
     void tempcoChanged();
     void digitsChanged();
     void toleranceChanged();
     void multiplierChanged();
     void smdToleranceChanged();
+    void stripColorsChanged();
     void resistanceCalculated();
     void resistorTypeChanged();
     void smdResistanceCalculated();
@@ -188,6 +203,37 @@ public:
     };
     Q_ENUMS (Tolerance)
 
+    /**
+     * Counters used to measure how much work is saved by update
+     * transactions and by skipping notifications for unchanged values
+     */
+    struct UpdateStatistics {
+        quint64 recalculations;
+        quint64 coalescedRecalculations;
+        quint64 notifications;
+        quint64 skippedNotifications;
+    };
+
+    /**
+     * Groups several property changes so that the resistance is only
+     * calculated once, when the outermost transaction goes out of scope
+     */
+    class UpdateTransaction
+    {
+    public:
+        explicit UpdateTransaction (ResistanceInfo* info) : m_info (info) {
+            m_info->beginUpdate();
+        }
+
+        ~UpdateTransaction() {
+            m_info->commitUpdate();
+        }
+
+    private:
+        Q_DISABLE_COPY (UpdateTransaction)
+        ResistanceInfo* m_info;
+    };
+
 public:
     ResistanceInfo (QObject* parent = 0);
     
@@ -202,11 +248,14 @@ public:
     QString minResistanceStr() const;
     QString maxResistanceStr() const;
     QString smdResistanceStr() const;
+    QString standardSeriesStr() const;
+    QString nearestStandardValueStr() const;
 
     QString smdResistanceCode() const;
     QStringList resistanceStripColors() const;
 
     QStringList digitNames() const;
+    QStringList firstDigitNames() const;
     QStringList tempcoNames() const;
     QStringList toleranceNames() const;
     QStringList multiplierNames() const;
@@ -221,18 +270,19 @@ public:
     double minResistance() const;
     double maxResistance() const;
     double smdResistance() const;
+    ResistorCore::Interval resistanceInterval() const;
+    ResistorCore::ExactResistance exactResistance() const;
+    ResistorCore::ExactResistance smdExactResistance() const;
+
+    bool isStandardValue() const;
+    double nearestStandardValue() const;
+    ResistorCore::ESeries standardSeries() const;
 
     static int getDigitValue (const Digit digit);
     static int getTempcoValue (const Tempco tempco);
     static double getToleranceValue (const Tolerance tolerance);
     static double getMultiplierValue (const Multiplier multiplier);
 
-    inline QStringList firstDigitNames() const {
-        QStringList list = digitNames();
-        list.removeFirst();
-        return list;
-    }
-
     inline QString tempcoStr() const {
         return QString ("%1 PPM/°C").arg (getTempcoValue (tempco()));
     }
@@ -255,6 +305,38 @@ public:
     Multiplier multiplier() const;
     ResistorType resistorType() const;
 
+    ResistorCore::ResistorCode resistorCode() const;
+    void setResistorCode (const ResistorCore::ResistorCode& code);
+
+    Q_INVOKABLE quint32 packedCode() const;
+    Q_INVOKABLE void loadPackedCode (const quint32 bits);
+
+    Q_INVOKABLE QVariantMap reverseLookup (const double resistance) const;
+    Q_INVOKABLE bool loadResistance (const double resistance);
+    Q_INVOKABLE double parseValue (const QString& text) const;
+    Q_INVOKABLE bool loadValue (const QString& text);
+    Q_INVOKABLE QVariantMap evaluateExpression (const QString& text,
+                                                const QVariantMap& variables = QVariantMap());
+
+    Q_INVOKABLE QVariantMap decodeCapacitorCode (const QString& code) const;
+    Q_INVOKABLE QVariantMap decodeInductorCode (const QString& code) const;
+    Q_INVOKABLE QVariantMap decodeInductorColors (const QVariantList& colors) const;
+
+    Q_INVOKABLE QVariantList temperatureSweep (const double minTemperature,
+                                               const double maxTemperature,
+                                               const int points) const;
+    Q_INVOKABLE QVariantMap temperatureRange (const double minTemperature,
+                                              const double maxTemperature) const;
+    Q_INVOKABLE QString temperatureLookupTable (const double minTemperature,
+                                                const double maxTemperature,
+                                                const int entries) const;
+
+    Q_INVOKABLE void beginUpdate();
+    Q_INVOKABLE void commitUpdate();
+
+    UpdateStatistics statistics() const;
+    void resetStatistics();
+
 public slots:
     void setDigitA (const Digit digit);
     void setDigitB (const Digit digit);
@@ -266,23 +348,26 @@ public slots:
     void setResistorType (const ResistorType type);
     void setDigit (const int number, const Digit digit);
 
+protected:
+    bool eventFilter (QObject* object, QEvent* event);
+
 private slots:
     void calculateResistance();
     void calculateSmdResistance();
 
 private:
-    QString prefixStr (const int exponent) const;
-    void setSmdTolerance (const int tolerance);
-    void setResistance (const double resistance);
-    void setSmdResistance (const double resistance);
-    int scientificExp (const double resistance) const;
+    void setSmdResistance (const ResistorCore::ExactResistance& resistance,
+                           const int tolerance);
     QString getResistanceStr (const double resistance) const;
+    QString getResistanceStr (const ResistorCore::ExactResistance& resistance) const;
+    void setResistance (const ResistorCore::BandResult& result);
 
 private:
     double m_resistance;
     double m_minResistance;
     double m_maxResistance;
     double m_smdResistance;
+    ResistorCore::ExactResistance m_smdExactResistance;
 
     int m_smdTolerance;
 
@@ -293,6 +378,12 @@ private:
     ResistorType m_resistorType;
 
     QString m_smdResistanceCode;
+    const char* m_resistanceLabel;
+
+    int m_updateDepth;
+    bool m_recalculationPending;
+    UpdateStatistics m_statistics;
+    ResistorCore::ExpressionCache m_expressions;
 };
 
 #endif
@@ -0,0 +1,489 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "ToleranceAnalysis.h"
+#include "WorstCase.h"
+#include "ResistorCore.h"
+
+#include <QElapsedTimer>
+
+/**
+ * Seed of the random number generator, fixed so that analyses can be
+ * repeated
+ */
+static const uint64_t SEED = 0x5EED2018;
+
+/**
+ * Quantiles that bound the central 3-sigma range of a normal distribution
+ */
+static const double LOW_QUANTILE = 0.00135;
+static const double HIGH_QUANTILE = 0.99865;
+
+ToleranceAnalysis::ToleranceAnalysis (QObject* parent) : QObject (parent),
+    m_model (ResistorCore::ModelDivider),
+    m_tolerance (ResistorCore::ToleranceGold),
+    m_tempco (NO_TEMPCO),
+    m_distribution (ResistorCore::DistributionUniform),
+    m_minimumTemperature (25),
+    m_maximumTemperature (25),
+    m_samples (1e6),
+    m_specification (0.01),
+    m_running (false),
+    m_progress (0),
+    m_cancelled (false),
+    m_jobSeconds (0),
+    m_executor (new ResistorCore::BatchExecutor)
+{
+    m_values << 10e3 << 10e3;
+
+    // The job thread emits these signals, handle them in this thread
+    connect (this, SIGNAL (jobProgress (qreal)),
+             this,   SLOT (onJobProgress (qreal)),
+             Qt::QueuedConnection);
+    connect (this, SIGNAL (jobFinished (bool)),
+             this,   SLOT (onJobFinished (bool)),
+             Qt::QueuedConnection);
+}
+
+/**
+ * Cancels the current analysis (if any) and waits for it to stop
+ */
+ToleranceAnalysis::~ToleranceAnalysis() {
+    cancel();
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+/**
+ * @returns The network model (see @c ResistorCore::NetworkModel)
+ */
+int ToleranceAnalysis::model() const {
+    return m_model;
+}
+
+/**
+ * @returns The nominal values of the parts of the network
+ */
+QVariantList ToleranceAnalysis::values() const {
+    return m_values;
+}
+
+/**
+ * @returns The tolerance strip of the parts
+ */
+int ToleranceAnalysis::tolerance() const {
+    return m_tolerance;
+}
+
+/**
+ * @returns The tempco strip of the parts, or @c NO_TEMPCO if the parts
+ *          do not drift with temperature
+ */
+int ToleranceAnalysis::tempco() const {
+    return m_tempco;
+}
+
+/**
+ * @returns The distribution of the parts within their tolerance
+ *          (see @c ResistorCore::Distribution)
+ */
+int ToleranceAnalysis::distribution() const {
+    return m_distribution;
+}
+
+/**
+ * @returns The lowest ambient temperature of the samples, in °C
+ */
+qreal ToleranceAnalysis::minimumTemperature() const {
+    return m_minimumTemperature;
+}
+
+/**
+ * @returns The highest ambient temperature of the samples, in °C
+ */
+qreal ToleranceAnalysis::maximumTemperature() const {
+    return m_maximumTemperature;
+}
+
+/**
+ * @returns The number of samples of each analysis
+ */
+qreal ToleranceAnalysis::samples() const {
+    return m_samples;
+}
+
+/**
+ * @returns The largest relative deviation from the nominal output that
+ *          counts towards the yield
+ */
+qreal ToleranceAnalysis::specification() const {
+    return m_specification;
+}
+
+/**
+ * @returns @c true while an analysis is running
+ */
+bool ToleranceAnalysis::running() const {
+    return m_running;
+}
+
+/**
+ * @returns The progress of the current analysis, from 0 to 1
+ */
+qreal ToleranceAnalysis::progress() const {
+    return m_progress;
+}
+
+/**
+ * @returns The summary of the last analysis, with its "nominal", "mean",
+ *          "stddev", "min", "max", "yield", "low" and "high" (3-sigma
+ *          quantiles), "median", "histogramMin", "histogramMax",
+ *          "samples", "elapsed" (in ms) and "throughput" (samples/s)
+ */
+QVariantMap ToleranceAnalysis::result() const {
+    return m_result;
+}
+
+/**
+ * @returns The heights of the @c HISTOGRAM_BARS bars of the histogram of
+ *          the last analysis, scaled so that the tallest bar is 1
+ */
+QVariantList ToleranceAnalysis::histogram() const {
+    return m_histogram;
+}
+
+/**
+ * @returns The deterministic worst-case analysis of the network, with its
+ *          "nominal" output, its "lower" and "upper" bounds, the
+ *          "linearDeviation" (first-order worst-case deviation), the
+ *          index of the "dominantPart" and the "parts" list, with the
+ *          "sensitivity", "contribution" and "share" of each part. The
+ *          map is empty if the parameters are invalid.
+ */
+QVariantMap ToleranceAnalysis::worstCase() const {
+    QVariantMap map;
+    std::vector<ResistorCore::MonteCarloPart> parts;
+    if (!getParts (&parts))
+        return map;
+
+    ResistorCore::WorstCaseReport report;
+    if (!ResistorCore::analyzeWorstCase (static_cast<ResistorCore::NetworkModel> (m_model),
+                                         parts.data(), parts.size(),
+                                         m_minimumTemperature, m_maximumTemperature,
+                                         &report))
+        return map;
+
+    QVariantList list;
+    for (size_t i = 0; i < report.partCount; ++i) {
+        QVariantMap part;
+        part.insert ("sensitivity", report.parts [i].sensitivity);
+        part.insert ("contribution", report.parts [i].contribution);
+        part.insert ("share", report.parts [i].share);
+        list.append (part);
+    }
+
+    map.insert ("nominal", report.nominal);
+    map.insert ("lower", report.bounds.lower);
+    map.insert ("upper", report.bounds.upper);
+    map.insert ("linearDeviation", report.linearDeviation);
+    map.insert ("dominantPart", static_cast<int> (report.dominantPart));
+    map.insert ("parts", list);
+    return map;
+}
+
+/**
+ * Starts an analysis with the current parameters, returns @c false if
+ * another analysis is still running or if the parameters are invalid
+ */
+bool ToleranceAnalysis::start() {
+    if (m_running)
+        return false;
+
+    if (m_thread.joinable())
+        m_thread.join();
+
+    // Get the parts of the network
+    std::vector<ResistorCore::MonteCarloPart> parts;
+    if (!getParts (&parts))
+        return false;
+
+    // Build the setup, the pointer to the parts is set by the job thread
+    ResistorCore::MonteCarloSetup setup;
+    setup.model = static_cast<ResistorCore::NetworkModel> (m_model);
+    setup.parts = NULL;
+    setup.partCount = parts.size();
+    setup.minTemperature = m_minimumTemperature;
+    setup.maxTemperature = m_maximumTemperature;
+    setup.samples = static_cast<uint64_t> (m_samples);
+    setup.seed = SEED;
+    setup.bins = ResistorCore::MonteCarloEngine::DEFAULT_BINS;
+
+    std::vector<double> nominal (parts.size());
+    for (size_t i = 0; i < parts.size(); ++i)
+        nominal [i] = parts [i].nominal;
+
+    const double output = ResistorCore::MonteCarloEngine::evaluate (setup.model, nominal.data(),
+                                                                    nominal.size());
+    setup.specMin = output * (1 - m_specification);
+    setup.specMax = output * (1 + m_specification);
+
+    m_cancelled = false;
+    m_running = true;
+    m_progress = 0;
+    emit runningChanged();
+    emit progressChanged();
+
+    m_thread = std::thread (&ToleranceAnalysis::runJob, this, setup, parts);
+    return true;
+}
+
+/**
+ * Cancels the current analysis (if any)
+ */
+void ToleranceAnalysis::cancel() {
+    m_cancelled = true;
+    m_executor->cancel();
+}
+
+/**
+ * Changes the network @a model (see @c ResistorCore::NetworkModel)
+ */
+void ToleranceAnalysis::setModel (const int model) {
+    Q_ASSERT_X (model >= ResistorCore::ModelSeries &&
+                model <= ResistorCore::ModelNonInvertingGain,
+                __func__, "Invalid argument");
+
+    if (m_model != model) {
+        m_model = model;
+        emit parametersChanged();
+    }
+}
+
+/**
+ * Changes the nominal @a values of the parts of the network
+ */
+void ToleranceAnalysis::setValues (const QVariantList& values) {
+    if (m_values != values) {
+        m_values = values;
+        emit parametersChanged();
+    }
+}
+
+/**
+ * Changes the @a tolerance strip of the parts
+ */
+void ToleranceAnalysis::setTolerance (const int tolerance) {
+    Q_ASSERT_X (tolerance >= ResistorCore::ToleranceBrown &&
+                tolerance <= ResistorCore::ToleranceSilver,
+                __func__, "Invalid argument");
+
+    if (m_tolerance != tolerance) {
+        m_tolerance = tolerance;
+        emit parametersChanged();
+    }
+}
+
+/**
+ * Changes the @a tempco strip of the parts, use @c NO_TEMPCO for parts
+ * that do not drift with temperature
+ */
+void ToleranceAnalysis::setTempco (const int tempco) {
+    Q_ASSERT_X (tempco == NO_TEMPCO ||
+                (tempco >= ResistorCore::TempcoBrown && tempco <= ResistorCore::TempcoViolet),
+                __func__, "Invalid argument");
+
+    if (m_tempco != tempco) {
+        m_tempco = tempco;
+        emit parametersChanged();
+    }
+}
+
+/**
+ * Changes the @a distribution of the parts within their tolerance
+ */
+void ToleranceAnalysis::setDistribution (const int distribution) {
+    Q_ASSERT_X (distribution >= ResistorCore::DistributionUniform &&
+                distribution <= ResistorCore::DistributionTruncatedNormal,
+                __func__, "Invalid argument");
+
+    if (m_distribution != distribution) {
+        m_distribution = distribution;
+        emit parametersChanged();
+    }
+}
+
+/**
+ * Changes the lowest ambient @a temperature of the samples
+ */
+void ToleranceAnalysis::setMinimumTemperature (const qreal temperature) {
+    if (m_minimumTemperature != temperature) {
+        m_minimumTemperature = temperature;
+        emit parametersChanged();
+    }
+}
+
+/**
+ * Changes the highest ambient @a temperature of the samples
+ */
+void ToleranceAnalysis::setMaximumTemperature (const qreal temperature) {
+    if (m_maximumTemperature != temperature) {
+        m_maximumTemperature = temperature;
+        emit parametersChanged();
+    }
+}
+
+/**
+ * Changes the number of @a samples of each analysis
+ */
+void ToleranceAnalysis::setSamples (const qreal samples) {
+    Q_ASSERT_X (samples >= 1, __func__, "Invalid argument");
+
+    if (m_samples != samples) {
+        m_samples = samples;
+        emit parametersChanged();
+    }
+}
+
+/**
+ * Changes the largest relative deviation from the nominal output that
+ * counts towards the yield
+ */
+void ToleranceAnalysis::setSpecification (const qreal specification) {
+    Q_ASSERT_X (specification >= 0, __func__, "Invalid argument");
+
+    if (m_specification != specification) {
+        m_specification = specification;
+        emit parametersChanged();
+    }
+}
+
+/**
+ * Updates the progress of the analysis (called through a queued
+ * connection)
+ */
+void ToleranceAnalysis::onJobProgress (const qreal progress) {
+    if (m_running && m_progress != progress) {
+        m_progress = progress;
+        emit progressChanged();
+    }
+}
+
+/**
+ * Publishes the result of the analysis (called through a queued
+ * connection)
+ */
+void ToleranceAnalysis::onJobFinished (const bool completed) {
+    if (m_thread.joinable())
+        m_thread.join();
+
+    m_running = false;
+    emit runningChanged();
+
+    if (!completed)
+        return;
+
+    const ResistorCore::MonteCarloResult& r = m_jobResult;
+    m_result.clear();
+    m_result.insert ("nominal", r.nominal);
+    m_result.insert ("mean", r.mean);
+    m_result.insert ("stddev", r.stddev);
+    m_result.insert ("min", r.min);
+    m_result.insert ("max", r.max);
+    m_result.insert ("yield", r.yield);
+    m_result.insert ("low", ResistorCore::MonteCarloEngine::quantile (r, LOW_QUANTILE));
+    m_result.insert ("median", ResistorCore::MonteCarloEngine::quantile (r, 0.5));
+    m_result.insert ("high", ResistorCore::MonteCarloEngine::quantile (r, HIGH_QUANTILE));
+    m_result.insert ("histogramMin", r.histogramMin);
+    m_result.insert ("histogramMax", r.histogramMax);
+    m_result.insert ("samples", static_cast<qreal> (r.samples));
+    m_result.insert ("elapsed", m_jobSeconds * 1000);
+    m_result.insert ("throughput", m_jobSeconds > 0 ? r.samples / m_jobSeconds : 0);
+
+    // Merge the bins of the histogram into bars
+    QVector<quint64> bars (HISTOGRAM_BARS, 0);
+    const size_t bins = r.histogram.size();
+    for (size_t i = 0; i < bins; ++i)
+        bars [static_cast<int> (i * HISTOGRAM_BARS / bins)] += r.histogram [i];
+
+    quint64 tallest = 1;
+    foreach (const quint64 bar, bars)
+        tallest = qMax (tallest, bar);
+
+    m_histogram.clear();
+    foreach (const quint64 bar, bars)
+        m_histogram.append (static_cast<qreal> (bar) / tallest);
+
+    emit resultChanged();
+}
+
+/**
+ * Builds the parts of the network from the current parameters, returns
+ * @c false if a value is not a positive number or if there are no
+ * parts (or too many of them)
+ */
+bool ToleranceAnalysis::getParts (std::vector<ResistorCore::MonteCarloPart>* parts) const {
+    Q_ASSERT_X (parts != NULL, __func__, "Invalid argument");
+
+    const double tolerance = ResistorCore::toleranceValue (
+                static_cast<ResistorCore::Tolerance> (m_tolerance));
+    const double tempco = m_tempco == NO_TEMPCO ? 0 :
+                          ResistorCore::tempcoValue (static_cast<ResistorCore::Tempco> (m_tempco));
+
+    parts->clear();
+    foreach (const QVariant& value, m_values) {
+        ResistorCore::MonteCarloPart part;
+        part.nominal = value.toDouble();
+        part.tolerance = tolerance;
+        part.tempco = tempco;
+        part.distribution = static_cast<ResistorCore::Distribution> (m_distribution);
+        if (!(part.nominal > 0))
+            return false;
+
+        parts->push_back (part);
+    }
+
+    return !parts->empty() && parts->size() <= ResistorCore::MonteCarloEngine::MAX_PARTS;
+}
+
+/**
+ * Runs the analysis on the threads of the executor. Runs in the job
+ * thread, so it only communicates with the rest of the object through
+ * signals.
+ */
+void ToleranceAnalysis::runJob (ResistorCore::MonteCarloSetup setup,
+                                const std::vector<ResistorCore::MonteCarloPart> parts) {
+    setup.parts = parts.data();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const ResistorCore::MonteCarloEngine engine (m_executor.get());
+    const bool completed = engine.run (setup, &m_jobResult, [this](const size_t done, const size_t total) {
+        if (m_cancelled)
+            m_executor->cancel();
+
+        emit jobProgress (static_cast<qreal> (done) / total);
+    });
+
+    m_jobSeconds = timer.nsecsElapsed() / 1e9;
+    emit jobFinished (completed && !m_cancelled);
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2018 Alex Spataru <https://github.com/alex-spataru>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef TOLERANCE_ANALYSIS_H
+#define TOLERANCE_ANALYSIS_H
+
+#include <QtQml>
+#include <QObject>
+#include <QVariantMap>
+#include <QVariantList>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "MonteCarlo.h"
+
+/**
+ * QML front-end of the Monte Carlo tolerance engine.
+ *
+ * Every part of the network has the same tolerance and tempco strips.
+ * The worst-case bounds and part sensitivities are recalculated when
+ * the parameters change, Monte Carlo analyses run outside of the main thread (on every CPU core), their
+ * progress and results are delivered through queued signals.
+ */
+class ToleranceAnalysis : public QObject
+{
+    Q_OBJECT
+
+#ifdef QT_QML_LIB
+    Q_PROPERTY (int model
+                READ model
+                WRITE setModel
+                NOTIFY parametersChanged)
+    Q_PROPERTY (QVariantList values
+                READ values
+                WRITE setValues
+                NOTIFY parametersChanged)
+    Q_PROPERTY (int tolerance
+                READ tolerance
+                WRITE setTolerance
+                NOTIFY parametersChanged)
+    Q_PROPERTY (int tempco
+                READ tempco
+                WRITE setTempco
+                NOTIFY parametersChanged)
+    Q_PROPERTY (int distribution
+                READ distribution
+                WRITE setDistribution
+                NOTIFY parametersChanged)
+    Q_PROPERTY (qreal minimumTemperature
+                READ minimumTemperature
+                WRITE setMinimumTemperature
+                NOTIFY parametersChanged)
+    Q_PROPERTY (qreal maximumTemperature
+                READ maximumTemperature
+                WRITE setMaximumTemperature
+                NOTIFY parametersChanged)
+    Q_PROPERTY (qreal samples
+                READ samples
+                WRITE setSamples
+                NOTIFY parametersChanged)
+    Q_PROPERTY (qreal specification
+                READ specification
+                WRITE setSpecification
+                NOTIFY parametersChanged)
+    Q_PROPERTY (bool running
+                READ running
+                NOTIFY runningChanged)
+    Q_PROPERTY (qreal progress
+                READ progress
+                NOTIFY progressChanged)
+    Q_PROPERTY (QVariantMap result
+                READ result
+                NOTIFY resultChanged)
+    Q_PROPERTY (QVariantList histogram
+                READ histogram
+                NOTIFY resultChanged)
+    Q_PROPERTY (QVariantMap worstCase
+                READ worstCase
+                NOTIFY parametersChanged)
+#endif
+
+signals:
+    void resultChanged();
+    void runningChanged();
+    void progressChanged();
+    void parametersChanged();
+
+    void jobProgress (const qreal progress);
+    void jobFinished (const bool completed);
+
+public:
+    static const int NO_TEMPCO = -1;
+    static const int HISTOGRAM_BARS = 64;
+
+    ToleranceAnalysis (QObject* parent = 0);
+    ~ToleranceAnalysis();
+
+    static void DeclareQml()
+    {
+#ifdef QT_QML_LIB
+        qmlRegisterType<ToleranceAnalysis> ("ResistanceInfo", 1, 0, "MonteCarloAnalysis");
+#endif
+    }
+
+    int model() const;
+    QVariantList values() const;
+    int tolerance() const;
+    int tempco() const;
+    int distribution() const;
+    qreal minimumTemperature() const;
+    qreal maximumTemperature() const;
+    qreal samples() const;
+    qreal specification() const;
+    bool running() const;
+    qreal progress() const;
+    QVariantMap result() const;
+    QVariantList histogram() const;
+    QVariantMap worstCase() const;
+
+public slots:
+    bool start();
+    void cancel();
+    void setModel (const int model);
+    void setValues (const QVariantList& values);
+    void setTolerance (const int tolerance);
+    void setTempco (const int tempco);
+    void setDistribution (const int distribution);
+    void setMinimumTemperature (const qreal temperature);
+    void setMaximumTemperature (const qreal temperature);
+    void setSamples (const qreal samples);
+    void setSpecification (const qreal specification);
+
+private slots:
+    void onJobProgress (const qreal progress);
+    void onJobFinished (const bool completed);
+
+private:
+    bool getParts (std::vector<ResistorCore::MonteCarloPart>* parts) const;
+    void runJob (ResistorCore::MonteCarloSetup setup,
+                 const std::vector<ResistorCore::MonteCarloPart> parts);
+
+private:
+    int m_model;
+    QVariantList m_values;
+    int m_tolerance;
+    int m_tempco;
+    int m_distribution;
+    qreal m_minimumTemperature;
+    qreal m_maximumTemperature;
+    qreal m_samples;
+    qreal m_specification;
+
+    bool m_running;
+    qreal m_progress;
+    QVariantMap m_result;
+    QVariantList m_histogram;
+
+    std::thread m_thread;
+    std::atomic<bool> m_cancelled;
+    ResistorCore::MonteCarloResult m_jobResult;
+    qreal m_jobSeconds;
+    std::unique_ptr<ResistorCore::BatchExecutor> m_executor;
+};
+
+#endif
@@ -32,8 +32,14 @@
 #endif
 
 #include "AppInfo.h"
+#include "BatchDecoder.h"
+#include "DividerCalculator.h"
+#include "CombinationCalculator.h"
+#include "NetworkCalculator.h"
+#include "OpAmpCalculator.h"
 #include "QtAdMobBanner.h"
 #include "ResistanceInfo.h"
+#include "ToleranceAnalysis.h"
 
 int main (int argc, char** argv) {
     // Set application options
@@ -60,6 +66,12 @@ int main (int argc, char** argv) {
     // Register QML modules
     QmlAdMobBanner::DeclareQML();
     ResistanceInfo::DeclareQml();
+    BatchDecoder::DeclareQml();
+    CombinationCalculator::DeclareQml();
+    DividerCalculator::DeclareQml();
+    NetworkCalculator::DeclareQml();
+    OpAmpCalculator::DeclareQml();
+    ToleranceAnalysis::DeclareQml();
 
     // Create QML modules
     ResistanceInfo info;